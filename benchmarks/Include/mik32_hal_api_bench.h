@@ -0,0 +1,74 @@
+#ifndef MIK32_HAL_API_BENCH
+#define MIK32_HAL_API_BENCH
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_spi.h"
+#include "mik32_hal_usart.h"
+#include "mik32_hal_i2c.h"
+#include "mik32_hal_crc32.h"
+#include "mik32_hal_crc32_ref.h"
+#include "mik32_hal_crypto.h"
+#include "mik32_hal_eeprom.h"
+#include "mik32_hal_spifi_w25.h"
+#include "mik32_hal_ssd1306.h"
+#include "mik32_hal_bench.h"
+
+
+#define API_BENCH_TIMEOUT           1000000     /**< Тайм-аут функций HAL в измерениях. */
+#define API_BENCH_EEPROM_WORDS      32          /**< Наибольшее количество слов в измерениях EEPROM (одна страница). */
+#define API_BENCH_SPIFI_PAGE        256         /**< Наибольшее количество байт в измерениях SPIFI (одна страница W25). */
+
+/**
+ * @brief Структура набора измерений функций HAL.
+ *
+ * Каждая функция вызывается Repeat раз подряд, в отчет выводится среднее количество тактов на вызов
+ * (cycles), количество байт за вызов (bytes) и скорость в байтах в секунду при текущей частоте ядра (bytes_per_s).
+ * Модули, для которых указатель равен NULL, пропускаются. Все модули должны быть проинициализированы.
+ *
+ * Измерения EEPROM и SPIFI стирают и перезаписывают заданные области.
+ *
+ * Пример (модули и USART отчета проинициализированы приложением):
+ *     static uint8_t buffer[256], buffer_b[256];
+ *     API_Bench_HandleTypeDef hbench = {
+ *         .Buffer = buffer, .BufferB = buffer_b, .Length = sizeof(buffer), .Repeat = 16,
+ *         .Spi = &hspi0, .Crc = &hcrc, .Eeprom = &heeprom, .EepromAddress = 0x1F00,
+ *         .Report = { .Usart = &husart0, .Timeout = 1000000 },
+ *     };
+ *     HAL_API_Bench_RunAll(&hbench);
+ */
+typedef struct __API_Bench_HandleTypeDef
+{
+    uint8_t *Buffer;                        /**< Буфер данных. Адрес выравнивается на 4 байта. */
+    uint8_t *BufferB;                       /**< Второй буфер для приема. */
+    uint32_t Length;                        /**< Размер каждого буфера в байтах, кратен 16. */
+    uint32_t Repeat;                        /**< Количество вызовов в одном измерении. 0 - один вызов. */
+
+    SPI_HandleTypeDef *Spi;                 /**< SPI в режиме ведущего. */
+    USART_HandleTypeDef *Usart;             /**< USART для передачи. Не должен совпадать с модулем вывода отчета. */
+    I2C_HandleTypeDef *I2c;                 /**< I2C в режиме ведущего. */
+    uint16_t I2cAddress;                    /**< Адрес ведомого, отвечающего на запись и чтение. */
+    CRC_HandleTypeDef *Crc;                 /**< CRC32. Результат сравнивается с программной моделью. */
+    Crypto_HandleTypeDef *Crypto;           /**< Crypto. Алгоритм и режим перебираются набором, поля SwapMode и OrderMode задаются пользователем. */
+    HAL_EEPROM_HandleTypeDef *Eeprom;       /**< EEPROM. */
+    uint16_t EepromAddress;                 /**< Адрес страницы EEPROM для измерений. */
+    SPIFI_HandleTypeDef *Spifi;             /**< SPIFI с микросхемой W25 в режиме команд. */
+    uint32_t SpifiAddress;                  /**< Адрес сектора 4 КБ микросхемы W25 для измерений. */
+    uint8_t SpifiQuad;                      /**< 1 - измерять четырехпроводные команды. Режим QE должен быть включен. */
+    HAL_SSD1306_HandleTypeDef *Ssd1306;     /**< Дисплей SSD1306, проинициализированный @ref ssd1306_Init. */
+
+    uint32_t CoreFreq;                      /**< Частота ядра, Гц. 0 - рассчитывается в @ref HAL_API_Bench_RunAll. */
+    Bench_ReportTypeDef Report;             /**< Вывод отчета. */
+} API_Bench_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_API_Bench_Spi(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Usart(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_I2c(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Crc(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Crypto(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Eeprom(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Spifi(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_Ssd1306(API_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_API_Bench_RunAll(API_Bench_HandleTypeDef *hbench);
+
+#endif // MIK32_HAL_API_BENCH
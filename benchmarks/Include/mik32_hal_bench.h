@@ -0,0 +1,65 @@
+#ifndef MIK32_HAL_BENCH
+#define MIK32_HAL_BENCH
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_usart.h"
+#include <stdint.h>
+
+
+#define BENCH_USART_TIMEOUT 1000000     /**< Количество циклов ожидания при передаче отчета. */
+
+/**
+ * @brief Структура вывода отчета измерений.
+ *
+ * Каждое измерение выводится одной строкой вида
+ * @code
+ * BENCH <набор> <имя> <ключ>=<значение> ... \r\n
+ * @endcode
+ * Значения выводятся десятичными беззнаковыми числами, что упрощает разбор отчета на стороне ПК.
+ */
+typedef struct __Bench_ReportTypeDef
+{
+    USART_HandleTypeDef *Usart;     /**< Модуль USART для вывода отчета. Модуль должен быть проинициализирован. */
+    uint32_t Timeout;               /**< Количество циклов ожидания передачи одного байта. */
+} Bench_ReportTypeDef;
+
+/**
+ * @brief Получить значение счетчика тактов ядра mcycle.
+ * @return Младшие 32 бита счетчика тактов.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Bench_GetCycles()
+{
+    uint32_t cycles;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (cycles));
+    return cycles;
+}
+
+/**
+ * @brief Получить производительность в байтах на 1000 тактов.
+ * @param Bytes Количество байт.
+ * @param Cycles Количество тактов.
+ * @return Количество байт на 1000 тактов.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Bench_BytesPerKCycle(uint32_t Bytes, uint32_t Cycles)
+{
+    return (Cycles == 0) ? 0 : (uint32_t)(((uint64_t)Bytes * 1000) / Cycles);
+}
+
+/**
+ * @brief Получить производительность в байтах в секунду.
+ * @param Bytes Количество байт.
+ * @param Cycles Количество тактов.
+ * @param CoreFreq Частота ядра, Гц.
+ * @return Количество байт в секунду.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Bench_BytesPerSecond(uint32_t Bytes, uint32_t Cycles, uint32_t CoreFreq)
+{
+    return (Cycles == 0) ? 0 : (uint32_t)(((uint64_t)Bytes * CoreFreq) / Cycles);
+}
+
+void HAL_Bench_ReportBegin(Bench_ReportTypeDef *report, const char *suite, const char *name);
+void HAL_Bench_ReportField(Bench_ReportTypeDef *report, const char *key, uint32_t value);
+void HAL_Bench_ReportString(Bench_ReportTypeDef *report, const char *key, const char *value);
+void HAL_Bench_ReportEnd(Bench_ReportTypeDef *report);
+
+#endif // MIK32_HAL_BENCH
@@ -0,0 +1,46 @@
+#ifndef MIK32_HAL_DMA_BENCH
+#define MIK32_HAL_DMA_BENCH
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_dma.h"
+#include "mik32_hal_usart.h"
+#include "mik32_hal_bench.h"
+
+
+#define DMA_BENCH_SUITE             "dma"   /**< Имя набора измерений в отчете. */
+#define DMA_BENCH_BURST_MAX         4       /**< Наибольший размер пакета в измерениях, 2^4 = 16 байт. */
+#define DMA_BENCH_LENGTH_ALIGN      (1 << DMA_BENCH_BURST_MAX)  /**< Кратность длины буферов. */
+#define DMA_BENCH_PERIPHERY_LENGTH  32      /**< Наибольшее количество байт в измерениях с USART. */
+
+/**
+ * @brief Структура набора измерений DMA.
+ *
+ * Все измерения выполняются опросом готовности канала без прерываний DMA.
+ * Время измеряется счетчиком тактов ядра mcycle и включает настройку канала в @ref HAL_DMA_Start.
+ */
+typedef struct __DMA_Bench_HandleTypeDef
+{
+    DMA_ChannelHandleTypeDef *ChannelA;     /**< Основной канал. Поля dma и Channel задаются пользователем. */
+    DMA_ChannelHandleTypeDef *ChannelB;     /**< Второй канал для измерения арбитража и приема из периферии. NULL - измерения с двумя каналами пропускаются. */
+
+    uint8_t *RamSource;                     /**< Буфер источника в ОЗУ. Адрес выравнивается на 4 байта. */
+    uint8_t *RamDestination;                /**< Буфер назначения в ОЗУ для канала A. */
+    uint8_t *RamDestinationB;               /**< Буфер назначения в ОЗУ для канала B. */
+    uint32_t Length;                        /**< Размер каждого буфера в байтах. Должен быть кратен #DMA_BENCH_LENGTH_ALIGN. */
+
+    const void *EepromSource;               /**< Адрес источника в области EEPROM. NULL - измерение пропускается. */
+    const void *SpifiSource;                /**< Адрес источника в области SPIFI. SPIFI должен работать в режиме памяти. NULL - измерение пропускается. */
+
+    USART_HandleTypeDef *LoopbackUsart;     /**< USART с включенной внутренней петлей (lbm) и запросами DMA (dma_tx_request, dma_rx_request). NULL - измерение пропускается. */
+
+    Bench_ReportTypeDef Report;             /**< Вывод отчета. */
+} DMA_Bench_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_DMA_Bench_MemoryToMemory(DMA_Bench_HandleTypeDef *hbench, const char *name, const void *Source);
+HAL_StatusTypeDef HAL_DMA_Bench_Latency(DMA_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DMA_Bench_Arbitration(DMA_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DMA_Bench_Periphery(DMA_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DMA_Bench_RunAll(DMA_Bench_HandleTypeDef *hbench);
+
+#endif // MIK32_HAL_DMA_BENCH
@@ -0,0 +1,46 @@
+#ifndef MIK32_HAL_DSP_BENCH
+#define MIK32_HAL_DSP_BENCH
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_pcc.h"
+#include "mik32_hal_dsp.h"
+#include "mik32_hal_fft.h"
+#include "mik32_hal_bench.h"
+
+
+#define DSP_BENCH_SUITE             "dsp"   /**< Имя набора измерений в отчете. */
+#define DSP_BENCH_BLOCK             64      /**< Количество отсчетов в блоке одного вызова. */
+#define DSP_BENCH_MAX_TAPS          64      /**< Наибольшее количество отводов КИХ-фильтра в измерениях. */
+#define DSP_BENCH_MAX_STAGES        4       /**< Наибольшее количество звеньев биквадратного фильтра в измерениях. */
+#define DSP_BENCH_RMS_LOG2_LENGTH   8       /**< log2 длины окна скользящего СКЗ в измерениях. */
+
+/**
+ * @brief Структура набора измерений библиотеки DSP.
+ *
+ * Каждая функция обрабатывает блок из #DSP_BENCH_BLOCK отсчетов Repeat раз подряд. В отчет выводится среднее
+ * количество тактов на вызов (cycles), тактов на отсчет (cycles_per_sample) и наибольшая частота дискретизации,
+ * при которой обработка занимает все время ядра (samples_per_s). Буферы и коэффициенты размещаются в ОЗУ набора,
+ * время выполнения функций не зависит от значений отсчетов.
+ *
+ * Преобразование Фурье измеряется для длин от #FFT_MIN_LENGTH до FftMaxLength в буфере пользователя:
+ * отдельно загрузка отсчетов АЦП с окном Ханна, само преобразование и поиск наибольшего бина.
+ */
+typedef struct __DSP_Bench_HandleTypeDef
+{
+    uint32_t Repeat;                        /**< Количество вызовов в одном измерении. 0 - один вызов. */
+    q15_t *FftBuffer;                       /**< Буфер преобразования Фурье из FftMaxLength комплексных отсчетов. NULL - измерения FFT пропускаются. */
+    uint16_t FftMaxLength;                  /**< Наибольшая длина преобразования в измерениях, от #FFT_MIN_LENGTH до #FFT_MAX_LENGTH. */
+    uint32_t CoreFreq;                      /**< Частота ядра, Гц. 0 - рассчитывается в @ref HAL_DSP_Bench_RunAll. */
+    Bench_ReportTypeDef Report;             /**< Вывод отчета. */
+} DSP_Bench_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_DSP_Bench_Convert(DSP_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DSP_Bench_FIR(DSP_Bench_HandleTypeDef *hbench, uint16_t NumTaps);
+HAL_StatusTypeDef HAL_DSP_Bench_Biquad(DSP_Bench_HandleTypeDef *hbench, uint8_t NumStages);
+HAL_StatusTypeDef HAL_DSP_Bench_DCBlock(DSP_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DSP_Bench_RMS(DSP_Bench_HandleTypeDef *hbench);
+HAL_StatusTypeDef HAL_DSP_Bench_FFT(DSP_Bench_HandleTypeDef *hbench, uint16_t Length);
+HAL_StatusTypeDef HAL_DSP_Bench_RunAll(DSP_Bench_HandleTypeDef *hbench);
+
+#endif // MIK32_HAL_DSP_BENCH
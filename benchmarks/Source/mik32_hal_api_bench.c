@@ -0,0 +1,488 @@
+#include "mik32_hal_api_bench.h"
+
+
+/**
+ * @brief Имена алгоритмов и режимов Crypto для отчета.
+ */
+static const char *const API_Bench_CryptoAlgName[] = {"kuznechik", "magma", "aes"};
+static const char *const API_Bench_CryptoModeName[] = {"ecb", "cbc", "ctr"};
+
+/**
+ * @brief Ключ и вектор инициализации Crypto. Значение не влияет на время шифрования.
+ */
+static uint32_t API_Bench_CryptoKey[MAXIMUM_KEY_LENGTH];
+static uint32_t API_Bench_CryptoIV[CRYPTO_BLOCK_AES];
+
+
+/**
+ * @brief Количество вызовов в одном измерении.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Количество вызовов, не меньше 1.
+ */
+static inline uint32_t HAL_API_Bench_Repeat(API_Bench_HandleTypeDef *hbench)
+{
+    return (hbench->Repeat == 0) ? 1 : hbench->Repeat;
+}
+
+/**
+ * @brief Начать строку отчета и вывести общие поля измерения.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param suite Имя набора.
+ * @param name Имя измерения.
+ * @param Bytes Количество байт за вызов.
+ * @param Cycles Количество тактов всех вызовов.
+ * @param Calls Количество вызовов.
+ * @param status Статус последнего вызова.
+ */
+static void HAL_API_Bench_ReportBegin(API_Bench_HandleTypeDef *hbench, const char *suite, const char *name,
+    uint32_t Bytes, uint32_t Cycles, uint32_t Calls, HAL_StatusTypeDef status)
+{
+    uint32_t cycles_per_call = Cycles / Calls;
+
+    HAL_Bench_ReportBegin(&hbench->Report, suite, name);
+    HAL_Bench_ReportField(&hbench->Report, "bytes", Bytes);
+    HAL_Bench_ReportField(&hbench->Report, "calls", Calls);
+    HAL_Bench_ReportField(&hbench->Report, "cycles", cycles_per_call);
+    HAL_Bench_ReportField(&hbench->Report, "bytes_per_s", HAL_Bench_BytesPerSecond(Bytes, cycles_per_call, hbench->CoreFreq));
+    HAL_Bench_ReportField(&hbench->Report, "status", status);
+}
+
+/**
+ * @brief Вывести строку отчета с общими полями измерения.
+ */
+static void HAL_API_Bench_Report(API_Bench_HandleTypeDef *hbench, const char *suite, const char *name,
+    uint32_t Bytes, uint32_t Cycles, uint32_t Calls, HAL_StatusTypeDef status)
+{
+    HAL_API_Bench_ReportBegin(hbench, suite, name, Bytes, Cycles, Calls, status);
+    HAL_Bench_ReportEnd(&hbench->Report);
+}
+
+/**
+ * @brief Измерить HAL_SPI_Exchange и HAL_SPI_Transmit.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы один вызов завершился с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Spi(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    HAL_StatusTypeDef status = HAL_OK;
+    HAL_StatusTypeDef result = HAL_OK;
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_SPI_Exchange(hbench->Spi, hbench->Buffer, hbench->BufferB, hbench->Length, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "spi", "exchange", hbench->Length, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    status = HAL_OK;
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_SPI_Transmit(hbench->Spi, hbench->Buffer, hbench->Length, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "spi", "transmit", hbench->Length, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    return result;
+}
+
+/**
+ * @brief Измерить HAL_USART_Write и HAL_USART_Transmit.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы один вызов завершился с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Usart(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    HAL_StatusTypeDef result = HAL_OK;
+    bool ok = true;
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && ok; i++)
+    {
+        ok = HAL_USART_Write(hbench->Usart, (char *)hbench->Buffer, hbench->Length, USART_TIMEOUT_DEFAULT);
+    }
+    HAL_API_Bench_Report(hbench, "usart", "write", hbench->Length, HAL_Bench_GetCycles() - start, repeat, ok ? HAL_OK : HAL_TIMEOUT);
+    if (!ok) result = HAL_ERROR;
+
+    ok = true;
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && ok; i++)
+    {
+        ok = HAL_USART_Transmit(hbench->Usart, (char)hbench->Buffer[0], USART_TIMEOUT_DEFAULT);
+    }
+    HAL_API_Bench_Report(hbench, "usart", "transmit", 1, HAL_Bench_GetCycles() - start, repeat, ok ? HAL_OK : HAL_TIMEOUT);
+    if (!ok) result = HAL_ERROR;
+
+    return result;
+}
+
+/**
+ * @brief Измерить HAL_I2C_Master_Transmit и HAL_I2C_Master_Receive.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы один вызов завершился с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_I2c(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    uint16_t length = (hbench->Length > 0xFFFF) ? 0xFFFF : hbench->Length;
+    HAL_StatusTypeDef status = HAL_OK;
+    HAL_StatusTypeDef result = HAL_OK;
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_I2C_Master_Transmit(hbench->I2c, hbench->I2cAddress, hbench->Buffer, length, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "i2c", "master_transmit", length, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    status = HAL_OK;
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_I2C_Master_Receive(hbench->I2c, hbench->I2cAddress, hbench->BufferB, length, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "i2c", "master_receive", length, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    return result;
+}
+
+/**
+ * @brief Измерить HAL_CRC_WriteData и HAL_CRC_WriteData32 с чтением результата и эталонный программный расчет.
+ *
+ * Длина данных ограничена буфером блока CRC32 (CRC_MAX_BYTES). Результаты HAL_CRC_WriteData и HAL_CRC_WriteData32
+ * сравниваются с @ref HAL_CRC_Ref_Calculate при тех же настройках, поле match отчета равно 1 при совпадении.
+ * Эталон для HAL_CRC_WriteData32 рассчитывается по второму буферу, в который записываются байты слов
+ * в порядке подачи на блок.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если результат блока не совпал с эталоном.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Crc(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    uint32_t length = (hbench->Length > CRC_MAX_BYTES) ? CRC_MAX_BYTES : hbench->Length;
+    CRC_Ref_ConfigTypeDef config = {
+        .Poly = hbench->Crc->Poly,
+        .Init = hbench->Crc->Init,
+        .RefIn = (hbench->Crc->InputReverse == CRC_REFIN_TRUE),
+        .RefOut = (hbench->Crc->OutputReverse == CRC_REFOUT_TRUE),
+        .XorOut = (hbench->Crc->OutputInversion == CRC_OUTPUTINVERSION_ON) ? 0xFFFFFFFF : 0,
+    };
+    volatile uint32_t crc = 0;
+    uint32_t reference = 0;
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        reference = HAL_CRC_Ref_Calculate(&config, hbench->Buffer, length);
+    }
+    HAL_API_Bench_Report(hbench, "crc", "reference", length, HAL_Bench_GetCycles() - start, repeat, HAL_OK);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_CRC_WriteData(hbench->Crc, hbench->Buffer, length);
+        crc = HAL_CRC_ReadCRC(hbench->Crc);
+    }
+    uint32_t cycles = HAL_Bench_GetCycles() - start;
+    HAL_StatusTypeDef status = (crc == reference) ? HAL_OK : HAL_ERROR;
+
+    HAL_API_Bench_ReportBegin(hbench, "crc", "write_data", length, cycles, repeat, status);
+    HAL_Bench_ReportField(&hbench->Report, "match", status == HAL_OK);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    /* Слово DATA32 подается на блок старшим байтом вперед: эталон для слов буфера в порядке little-endian */
+    uint32_t length32 = length & ~3UL;
+    for (uint32_t i = 0; i < length32; i++)
+    {
+        hbench->BufferB[i] = hbench->Buffer[i ^ 3];
+    }
+    uint32_t reference32 = HAL_CRC_Ref_Calculate(&config, hbench->BufferB, length32);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_CRC_WriteData32(hbench->Crc, (uint32_t *)hbench->Buffer, length32 / 4);
+        crc = HAL_CRC_ReadCRC(hbench->Crc);
+    }
+    cycles = HAL_Bench_GetCycles() - start;
+    HAL_StatusTypeDef status32 = (crc == reference32) ? HAL_OK : HAL_ERROR;
+
+    HAL_API_Bench_ReportBegin(hbench, "crc", "write_data32", length32, cycles, repeat, status32);
+    HAL_Bench_ReportField(&hbench->Report, "match", status32 == HAL_OK);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return (status32 != HAL_OK) ? status32 : status;
+}
+
+/**
+ * @brief Измерить HAL_Crypto_Encode для всех алгоритмов и режимов.
+ *
+ * Настройки алгоритма, режима, ключа и вектора инициализации выполняются вне измерения.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Crypto(API_Bench_HandleTypeDef *hbench)
+{
+    static const uint8_t block_size[] = {CRYPTO_BLOCK_KUZNECHIK, CRYPTO_BLOCK_MAGMA, CRYPTO_BLOCK_AES};
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    /* Длина текста кратна блоку всех алгоритмов */
+    uint32_t words = (hbench->Length / 4) & ~(CRYPTO_BLOCK_AES - 1);
+    Crypto_HandleTypeDef *hcrypto = hbench->Crypto;
+
+    for (uint8_t alg = CRYPTO_ALG_KUZNECHIK; alg <= CRYPTO_ALG_AES; alg++)
+    {
+        for (uint8_t mode = CRYPTO_CIPHER_MODE_ECB; mode <= CRYPTO_CIPHER_MODE_CTR; mode++)
+        {
+            hcrypto->Algorithm = alg;
+            hcrypto->CipherMode = mode;
+            HAL_Crypto_Init(hcrypto);
+            HAL_Crypto_SetKey(hcrypto, API_Bench_CryptoKey);
+            if (mode == CRYPTO_CIPHER_MODE_CBC)
+            {
+                HAL_Crypto_SetIV(hcrypto, API_Bench_CryptoIV, block_size[alg]);
+            }
+            else if (mode == CRYPTO_CIPHER_MODE_CTR)
+            {
+                HAL_Crypto_SetIV(hcrypto, API_Bench_CryptoIV, block_size[alg] >> 1);
+            }
+
+            uint32_t start = HAL_Bench_GetCycles();
+            for (uint32_t i = 0; i < repeat; i++)
+            {
+                HAL_Crypto_Encode(hcrypto, (uint32_t *)hbench->Buffer, (uint32_t *)hbench->BufferB, words);
+            }
+            uint32_t cycles = HAL_Bench_GetCycles() - start;
+
+            HAL_API_Bench_ReportBegin(hbench, "crypto", "encode", words * 4, cycles, repeat, HAL_OK);
+            HAL_Bench_ReportString(&hbench->Report, "alg", API_Bench_CryptoAlgName[alg]);
+            HAL_Bench_ReportString(&hbench->Report, "mode", API_Bench_CryptoModeName[mode]);
+            HAL_Bench_ReportEnd(&hbench->Report);
+        }
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить HAL_EEPROM_Erase, HAL_EEPROM_Write и HAL_EEPROM_Read для одной страницы.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы один вызов завершился с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Eeprom(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    uint8_t words = (hbench->Length / 4 > API_BENCH_EEPROM_WORDS) ? API_BENCH_EEPROM_WORDS : hbench->Length / 4;
+    HAL_StatusTypeDef status = HAL_OK;
+    HAL_StatusTypeDef result = HAL_OK;
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_EEPROM_Erase(hbench->Eeprom, hbench->EepromAddress, words, HAL_EEPROM_WRITE_SINGLE, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "eeprom", "erase", words * 4, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    status = HAL_OK;
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_EEPROM_Write(hbench->Eeprom, hbench->EepromAddress, (uint32_t *)hbench->Buffer, words,
+            HAL_EEPROM_WRITE_SINGLE, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "eeprom", "write", words * 4, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    status = HAL_OK;
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = HAL_EEPROM_Read(hbench->Eeprom, hbench->EepromAddress, (uint32_t *)hbench->BufferB, words, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "eeprom", "read", words * 4, HAL_Bench_GetCycles() - start, repeat, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    return result;
+}
+
+/**
+ * @brief Измерить функцию чтения SPIFI W25.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param name Имя измерения.
+ * @param read Функция чтения.
+ * @param length Количество байт.
+ */
+static void HAL_API_Bench_SpifiRead(API_Bench_HandleTypeDef *hbench, const char *name,
+    void (*read)(SPIFI_HandleTypeDef *, uint32_t, uint16_t, uint8_t *), uint16_t length)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+
+    uint32_t start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        read(hbench->Spifi, hbench->SpifiAddress, length, hbench->BufferB);
+    }
+    HAL_API_Bench_Report(hbench, "spifi_w25", name, length, HAL_Bench_GetCycles() - start, repeat, HAL_OK);
+}
+
+/**
+ * @brief Измерить программирование страниц SPIFI W25 с ожиданием готовности.
+ *
+ * Каждый вызов программирует следующую страницу сектора, количество вызовов ограничено размером сектора.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param name Имя измерения.
+ * @param program Функция программирования.
+ * @param length Количество байт.
+ * @return Статус HAL.
+ */
+static HAL_StatusTypeDef HAL_API_Bench_SpifiProgram(API_Bench_HandleTypeDef *hbench, const char *name,
+    void (*program)(SPIFI_HandleTypeDef *, uint32_t, uint16_t, uint8_t *), uint16_t length)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    HAL_StatusTypeDef status;
+
+    if (repeat > (4096 / API_BENCH_SPIFI_PAGE))
+    {
+        repeat = 4096 / API_BENCH_SPIFI_PAGE;
+    }
+
+    /* Стирание вне измерения */
+    HAL_SPIFI_W25_SectorErase4K(hbench->Spifi, hbench->SpifiAddress);
+    status = HAL_SPIFI_W25_WaitBusy(hbench->Spifi, API_BENCH_TIMEOUT);
+
+    uint32_t start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        program(hbench->Spifi, hbench->SpifiAddress + i * API_BENCH_SPIFI_PAGE, length, hbench->Buffer);
+        status = HAL_SPIFI_W25_WaitBusy(hbench->Spifi, API_BENCH_TIMEOUT);
+    }
+    HAL_API_Bench_Report(hbench, "spifi_w25", name, length, HAL_Bench_GetCycles() - start, repeat, status);
+
+    return status;
+}
+
+/**
+ * @brief Измерить стирание, программирование и чтение микросхемы W25 через SPIFI.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы одна операция не завершилась.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Spifi(API_Bench_HandleTypeDef *hbench)
+{
+    uint16_t length = (hbench->Length > API_BENCH_SPIFI_PAGE) ? API_BENCH_SPIFI_PAGE : hbench->Length;
+    HAL_StatusTypeDef result = HAL_OK;
+
+    uint32_t start = HAL_Bench_GetCycles();
+    HAL_SPIFI_W25_SectorErase4K(hbench->Spifi, hbench->SpifiAddress);
+    HAL_StatusTypeDef status = HAL_SPIFI_W25_WaitBusy(hbench->Spifi, API_BENCH_TIMEOUT);
+    HAL_API_Bench_Report(hbench, "spifi_w25", "sector_erase_4k", 4096, HAL_Bench_GetCycles() - start, 1, status);
+    if (status != HAL_OK) result = HAL_ERROR;
+
+    if (HAL_API_Bench_SpifiProgram(hbench, "page_program", HAL_SPIFI_W25_PageProgram, length) != HAL_OK) result = HAL_ERROR;
+    HAL_API_Bench_SpifiRead(hbench, "read_data", HAL_SPIFI_W25_ReadData, length);
+
+    if (hbench->SpifiQuad)
+    {
+        if (HAL_API_Bench_SpifiProgram(hbench, "page_program_quad", HAL_SPIFI_W25_PageProgram_Quad, length) != HAL_OK) result = HAL_ERROR;
+        HAL_API_Bench_SpifiRead(hbench, "read_data_quad", HAL_SPIFI_W25_ReadData_Quad, length);
+        HAL_API_Bench_SpifiRead(hbench, "read_data_quad_io", HAL_SPIFI_W25_ReadData_Quad_IO, length);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Измерить ssd1306_UpdateScreen.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы один вызов завершился с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_Ssd1306(API_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_API_Bench_Repeat(hbench);
+    HAL_StatusTypeDef status = HAL_OK;
+
+    uint32_t start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; (i < repeat) && (status == HAL_OK); i++)
+    {
+        status = ssd1306_UpdateScreen(hbench->Ssd1306);
+    }
+    HAL_API_Bench_Report(hbench, "ssd1306", "update_screen", SSD1306_BUFFER_SIZE, HAL_Bench_GetCycles() - start, repeat, status);
+
+    return (status == HAL_OK) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ * @brief Выполнить все измерения для заданных модулей.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если параметры заданы неверно или хотя бы одно измерение завершилось с ошибкой.
+ */
+HAL_StatusTypeDef HAL_API_Bench_RunAll(API_Bench_HandleTypeDef *hbench)
+{
+    HAL_StatusTypeDef result = HAL_OK;
+
+    if ((hbench == NULL) || (hbench->Buffer == NULL) || (hbench->BufferB == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hbench->Length == 0) || ((hbench->Length % 16) != 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if (hbench->CoreFreq == 0)
+    {
+        hbench->CoreFreq = HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB + 1);
+    }
+
+    if (hbench->Spi != NULL)
+    {
+        if (HAL_API_Bench_Spi(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Usart != NULL)
+    {
+        if (HAL_API_Bench_Usart(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->I2c != NULL)
+    {
+        if (HAL_API_Bench_I2c(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Crc != NULL)
+    {
+        if (HAL_API_Bench_Crc(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Crypto != NULL)
+    {
+        if (HAL_API_Bench_Crypto(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Eeprom != NULL)
+    {
+        if (HAL_API_Bench_Eeprom(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Spifi != NULL)
+    {
+        if (HAL_API_Bench_Spifi(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->Ssd1306 != NULL)
+    {
+        if (HAL_API_Bench_Ssd1306(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    return result;
+}
@@ -0,0 +1,88 @@
+#include "mik32_hal_bench.h"
+
+
+/**
+ * @brief Вывести строку отчета.
+ * @param report Указатель на структуру вывода отчета.
+ * @param str Строка, оканчивающаяся нулем.
+ */
+static void HAL_Bench_Print(Bench_ReportTypeDef *report, const char *str)
+{
+    if ((report == NULL) || (report->Usart == NULL))
+    {
+        return;
+    }
+
+    HAL_USART_Print(report->Usart, (char *)str, report->Timeout);
+}
+
+/**
+ * @brief Вывести беззнаковое число в десятичном виде.
+ * @param report Указатель на структуру вывода отчета.
+ * @param value Выводимое значение.
+ */
+static void HAL_Bench_PrintUInt(Bench_ReportTypeDef *report, uint32_t value)
+{
+    char buffer[11];
+    uint32_t i = sizeof(buffer) - 1;
+
+    buffer[i] = '\0';
+    do
+    {
+        buffer[--i] = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    HAL_Bench_Print(report, &buffer[i]);
+}
+
+/**
+ * @brief Начать строку отчета.
+ * @param report Указатель на структуру вывода отчета.
+ * @param suite Имя набора измерений.
+ * @param name Имя измерения.
+ */
+void HAL_Bench_ReportBegin(Bench_ReportTypeDef *report, const char *suite, const char *name)
+{
+    HAL_Bench_Print(report, "BENCH ");
+    HAL_Bench_Print(report, suite);
+    HAL_Bench_Print(report, " ");
+    HAL_Bench_Print(report, name);
+}
+
+/**
+ * @brief Добавить поле в строку отчета.
+ * @param report Указатель на структуру вывода отчета.
+ * @param key Имя поля.
+ * @param value Значение поля.
+ */
+void HAL_Bench_ReportField(Bench_ReportTypeDef *report, const char *key, uint32_t value)
+{
+    HAL_Bench_Print(report, " ");
+    HAL_Bench_Print(report, key);
+    HAL_Bench_Print(report, "=");
+    HAL_Bench_PrintUInt(report, value);
+}
+
+/**
+ * @brief Добавить текстовое поле в строку отчета.
+ * @param report Указатель на структуру вывода отчета.
+ * @param key Имя поля.
+ * @param value Значение поля. Строка не должна содержать пробелов.
+ */
+void HAL_Bench_ReportString(Bench_ReportTypeDef *report, const char *key, const char *value)
+{
+    HAL_Bench_Print(report, " ");
+    HAL_Bench_Print(report, key);
+    HAL_Bench_Print(report, "=");
+    HAL_Bench_Print(report, value);
+}
+
+/**
+ * @brief Завершить строку отчета.
+ * @param report Указатель на структуру вывода отчета.
+ */
+void HAL_Bench_ReportEnd(Bench_ReportTypeDef *report)
+{
+    HAL_Bench_Print(report, "\r\n");
+}
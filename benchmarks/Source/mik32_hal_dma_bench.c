@@ -0,0 +1,348 @@
+#include "mik32_hal_dma_bench.h"
+
+
+/**
+ * @brief Имена разрядностей для отчета.
+ */
+static const char *const DMA_Bench_SizeName[] = {"byte", "halfword", "word"};
+
+/**
+ * @brief Настроить канал на пересылку память - память.
+ * @param hdma_channel Структура для инициализации канала DMA.
+ * @param Size Разрядность источника и назначения.
+ * @param Burst Размер пакета, 2^Burst байт.
+ * @param Priority Приоритет канала.
+ */
+static void HAL_DMA_Bench_SetMemoryToMemory(DMA_ChannelHandleTypeDef *hdma_channel, HAL_DMA_ChannelSizeTypeDef Size,
+    uint32_t Burst, HAL_DMA_ChannelPriorityTypeDef Priority)
+{
+    DMA_ChannelInitHandleTypeDef *init = &hdma_channel->ChannelInit;
+
+    init->Priority = Priority;
+
+    init->ReadMode = DMA_CHANNEL_MODE_MEMORY;
+    init->ReadInc = DMA_CHANNEL_INC_ENABLE;
+    init->ReadSize = Size;
+    init->ReadBurstSize = Burst;
+    init->ReadRequest = DMA_CHANNEL_USART_0_REQUEST;
+    init->ReadAck = DMA_CHANNEL_ACK_DISABLE;
+
+    init->WriteMode = DMA_CHANNEL_MODE_MEMORY;
+    init->WriteInc = DMA_CHANNEL_INC_ENABLE;
+    init->WriteSize = Size;
+    init->WriteBurstSize = Burst;
+    init->WriteRequest = DMA_CHANNEL_USART_0_REQUEST;
+    init->WriteAck = DMA_CHANNEL_ACK_DISABLE;
+}
+
+/**
+ * @brief Выполнить одну пересылку и измерить время.
+ * @param hdma_channel Структура для инициализации канала DMA.
+ * @param Source Адрес источника.
+ * @param Destination Адрес назначения.
+ * @param Bytes Количество байт.
+ * @param Cycles Указатель на количество тактов.
+ * @return Статус HAL.
+ */
+static HAL_StatusTypeDef HAL_DMA_Bench_Transfer(DMA_ChannelHandleTypeDef *hdma_channel, const void *Source, void *Destination,
+    uint32_t Bytes, uint32_t *Cycles)
+{
+    uint32_t start = HAL_Bench_GetCycles();
+    HAL_DMA_Start(hdma_channel, (void *)Source, Destination, Bytes - 1);
+    HAL_StatusTypeDef status = HAL_DMA_Wait(hdma_channel, DMA_TIMEOUT_DEFAULT);
+    *Cycles = HAL_Bench_GetCycles() - start;
+
+    if (status != HAL_OK)
+    {
+        HAL_DMA_ChannelDisable(hdma_channel);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Вывести результат одного измерения.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param name Имя измерения.
+ * @param Size Разрядность.
+ * @param Burst Размер пакета, 2^Burst байт.
+ * @param Bytes Количество байт.
+ * @param Cycles Количество тактов.
+ * @param status Статус пересылки.
+ */
+static void HAL_DMA_Bench_Report(DMA_Bench_HandleTypeDef *hbench, const char *name, HAL_DMA_ChannelSizeTypeDef Size,
+    uint32_t Burst, uint32_t Bytes, uint32_t Cycles, HAL_StatusTypeDef status)
+{
+    HAL_Bench_ReportBegin(&hbench->Report, DMA_BENCH_SUITE, name);
+    HAL_Bench_ReportString(&hbench->Report, "size", DMA_Bench_SizeName[Size]);
+    HAL_Bench_ReportField(&hbench->Report, "burst", 1 << Burst);
+    HAL_Bench_ReportField(&hbench->Report, "bytes", Bytes);
+    HAL_Bench_ReportField(&hbench->Report, "cycles", Cycles);
+    HAL_Bench_ReportField(&hbench->Report, "bytes_per_kcycle", HAL_Bench_BytesPerKCycle(Bytes, Cycles));
+    HAL_Bench_ReportField(&hbench->Report, "status", status);
+    HAL_Bench_ReportEnd(&hbench->Report);
+}
+
+/**
+ * @brief Получить линию запроса DMA модуля USART.
+ * @param usart Указатель на структуру-дескриптор модуля USART.
+ * @param Request Указатель на линию запроса.
+ * @return Статус HAL.
+ */
+static HAL_StatusTypeDef HAL_DMA_Bench_GetUsartRequest(USART_HandleTypeDef *usart, HAL_DMA_ChannelRequestTypeDef *Request)
+{
+    if (usart->Instance == UART_0)
+    {
+        *Request = DMA_CHANNEL_USART_0_REQUEST;
+        return HAL_OK;
+    }
+
+    if (usart->Instance == UART_1)
+    {
+        *Request = DMA_CHANNEL_USART_1_REQUEST;
+        return HAL_OK;
+    }
+
+    return HAL_ERROR;
+}
+
+/**
+ * @brief Измерить пересылки память - память из указанного источника в ОЗУ.
+ *
+ * Перебираются все разрядности и размеры пакета от разрядности до 2^#DMA_BENCH_BURST_MAX байт.
+ * Каждое измерение выводится отдельной строкой отчета.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param name Имя измерения в отчете.
+ * @param Source Адрес источника. Из источника читается hbench->Length байт.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы одна пересылка не завершилась.
+ */
+HAL_StatusTypeDef HAL_DMA_Bench_MemoryToMemory(DMA_Bench_HandleTypeDef *hbench, const char *name, const void *Source)
+{
+    HAL_StatusTypeDef result = HAL_OK;
+
+    if ((hbench->Length == 0) || ((hbench->Length % DMA_BENCH_LENGTH_ALIGN) != 0))
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint32_t size = DMA_CHANNEL_SIZE_BYTE; size <= DMA_CHANNEL_SIZE_WORD; size++)
+    {
+        for (uint32_t burst = size; burst <= DMA_BENCH_BURST_MAX; burst++)
+        {
+            uint32_t cycles;
+
+            HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelA, size, burst, DMA_CHANNEL_PRIORITY_VERY_HIGH);
+            HAL_StatusTypeDef status = HAL_DMA_Bench_Transfer(hbench->ChannelA, Source, hbench->RamDestination, hbench->Length, &cycles);
+            HAL_DMA_Bench_Report(hbench, name, size, burst, hbench->Length, cycles, status);
+
+            if (status != HAL_OK)
+            {
+                result = HAL_ERROR;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Измерить задержку запуска канала.
+ *
+ * Пересылается одно слово ОЗУ - ОЗУ. Результат показывает накладные расходы
+ * на настройку канала и ожидание готовности.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DMA_Bench_Latency(DMA_Bench_HandleTypeDef *hbench)
+{
+    uint32_t cycles;
+
+    HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelA, DMA_CHANNEL_SIZE_WORD, 2, DMA_CHANNEL_PRIORITY_VERY_HIGH);
+    HAL_StatusTypeDef status = HAL_DMA_Bench_Transfer(hbench->ChannelA, hbench->RamSource, hbench->RamDestination, 4, &cycles);
+    HAL_DMA_Bench_Report(hbench, "latency", DMA_CHANNEL_SIZE_WORD, 2, 4, cycles, status);
+
+    return status;
+}
+
+/**
+ * @brief Измерить арбитраж двух одновременно работающих каналов.
+ *
+ * Каналы A и B одновременно пересылают hbench->Length байт ОЗУ - ОЗУ словами пакетами по 16 байт.
+ * Измерение повторяется при равных приоритетах, при приоритете канала A и при приоритете канала B.
+ * Для каждого канала выводится время от запуска до завершения.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DMA_Bench_Arbitration(DMA_Bench_HandleTypeDef *hbench)
+{
+    static const HAL_DMA_ChannelPriorityTypeDef priority[3][2] = {
+        {DMA_CHANNEL_PRIORITY_MEDIUM, DMA_CHANNEL_PRIORITY_MEDIUM},
+        {DMA_CHANNEL_PRIORITY_VERY_HIGH, DMA_CHANNEL_PRIORITY_LOW},
+        {DMA_CHANNEL_PRIORITY_LOW, DMA_CHANNEL_PRIORITY_VERY_HIGH},
+    };
+    static const char *const name[3] = {"arbitration_equal", "arbitration_a_high", "arbitration_b_high"};
+    HAL_StatusTypeDef result = HAL_OK;
+
+    if ((hbench->ChannelB == NULL) || (hbench->RamDestinationB == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint32_t cycles_a = 0;
+        uint32_t cycles_b = 0;
+        uint32_t timeout = DMA_TIMEOUT_DEFAULT;
+
+        HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelA, DMA_CHANNEL_SIZE_WORD, DMA_BENCH_BURST_MAX, priority[i][0]);
+        HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelB, DMA_CHANNEL_SIZE_WORD, DMA_BENCH_BURST_MAX, priority[i][1]);
+
+        uint32_t start = HAL_Bench_GetCycles();
+        HAL_DMA_Start(hbench->ChannelA, hbench->RamSource, hbench->RamDestination, hbench->Length - 1);
+        HAL_DMA_Start(hbench->ChannelB, hbench->RamSource, hbench->RamDestinationB, hbench->Length - 1);
+
+        while (((cycles_a == 0) || (cycles_b == 0)) && (timeout-- != 0))
+        {
+            if ((cycles_a == 0) && HAL_DMA_GetChannelReadyStatus(hbench->ChannelA))
+            {
+                cycles_a = HAL_Bench_GetCycles() - start;
+            }
+            if ((cycles_b == 0) && HAL_DMA_GetChannelReadyStatus(hbench->ChannelB))
+            {
+                cycles_b = HAL_Bench_GetCycles() - start;
+            }
+        }
+
+        HAL_StatusTypeDef status = ((cycles_a != 0) && (cycles_b != 0)) ? HAL_OK : HAL_TIMEOUT;
+        if (status != HAL_OK)
+        {
+            HAL_DMA_ChannelDisable(hbench->ChannelA);
+            HAL_DMA_ChannelDisable(hbench->ChannelB);
+            result = HAL_ERROR;
+        }
+
+        HAL_Bench_ReportBegin(&hbench->Report, DMA_BENCH_SUITE, name[i]);
+        HAL_Bench_ReportField(&hbench->Report, "bytes", hbench->Length);
+        HAL_Bench_ReportField(&hbench->Report, "cycles_a", cycles_a);
+        HAL_Bench_ReportField(&hbench->Report, "cycles_b", cycles_b);
+        HAL_Bench_ReportField(&hbench->Report, "bytes_per_kcycle", HAL_Bench_BytesPerKCycle(2 * hbench->Length,
+            (cycles_a > cycles_b) ? cycles_a : cycles_b));
+        HAL_Bench_ReportField(&hbench->Report, "status", status);
+        HAL_Bench_ReportEnd(&hbench->Report);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Измерить пересылки память - периферия и периферия - память.
+ *
+ * Канал B принимает байты из RXDATA в ОЗУ, канал A передает байты из ОЗУ в TXDATA.
+ * USART должен работать с внутренней петлей, поэтому скорость ограничена частотой обмена USART
+ * и результат показывает накладные расходы DMA относительно времени передачи кадров.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DMA_Bench_Periphery(DMA_Bench_HandleTypeDef *hbench)
+{
+    HAL_DMA_ChannelRequestTypeDef request;
+    uint32_t bytes = (hbench->Length < DMA_BENCH_PERIPHERY_LENGTH) ? hbench->Length : DMA_BENCH_PERIPHERY_LENGTH;
+    uint32_t cycles_tx = 0;
+    uint32_t cycles_rx = 0;
+    uint32_t timeout = DMA_TIMEOUT_DEFAULT;
+
+    if ((hbench->LoopbackUsart == NULL) || (hbench->ChannelB == NULL) || (hbench->RamDestinationB == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_DMA_Bench_GetUsartRequest(hbench->LoopbackUsart, &request) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    /* Канал A: ОЗУ -> TXDATA */
+    HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelA, DMA_CHANNEL_SIZE_BYTE, 0, DMA_CHANNEL_PRIORITY_HIGH);
+    hbench->ChannelA->ChannelInit.WriteMode = DMA_CHANNEL_MODE_PERIPHERY;
+    hbench->ChannelA->ChannelInit.WriteInc = DMA_CHANNEL_INC_DISABLE;
+    hbench->ChannelA->ChannelInit.WriteRequest = request;
+
+    /* Канал B: RXDATA -> ОЗУ */
+    HAL_DMA_Bench_SetMemoryToMemory(hbench->ChannelB, DMA_CHANNEL_SIZE_BYTE, 0, DMA_CHANNEL_PRIORITY_VERY_HIGH);
+    hbench->ChannelB->ChannelInit.ReadMode = DMA_CHANNEL_MODE_PERIPHERY;
+    hbench->ChannelB->ChannelInit.ReadInc = DMA_CHANNEL_INC_DISABLE;
+    hbench->ChannelB->ChannelInit.ReadRequest = request;
+
+    uint32_t start = HAL_Bench_GetCycles();
+    HAL_DMA_Start(hbench->ChannelB, (void *)&hbench->LoopbackUsart->Instance->RXDATA, hbench->RamDestinationB, bytes - 1);
+    HAL_DMA_Start(hbench->ChannelA, hbench->RamSource, (void *)&hbench->LoopbackUsart->Instance->TXDATA, bytes - 1);
+
+    while (((cycles_tx == 0) || (cycles_rx == 0)) && (timeout-- != 0))
+    {
+        if ((cycles_tx == 0) && HAL_DMA_GetChannelReadyStatus(hbench->ChannelA))
+        {
+            cycles_tx = HAL_Bench_GetCycles() - start;
+        }
+        if ((cycles_rx == 0) && HAL_DMA_GetChannelReadyStatus(hbench->ChannelB))
+        {
+            cycles_rx = HAL_Bench_GetCycles() - start;
+        }
+    }
+
+    HAL_StatusTypeDef status = ((cycles_tx != 0) && (cycles_rx != 0)) ? HAL_OK : HAL_TIMEOUT;
+    if (status != HAL_OK)
+    {
+        HAL_DMA_ChannelDisable(hbench->ChannelA);
+        HAL_DMA_ChannelDisable(hbench->ChannelB);
+    }
+
+    HAL_DMA_Bench_Report(hbench, "memory_to_periphery", DMA_CHANNEL_SIZE_BYTE, 0, bytes, cycles_tx, status);
+    HAL_DMA_Bench_Report(hbench, "periphery_to_memory", DMA_CHANNEL_SIZE_BYTE, 0, bytes, cycles_rx, status);
+
+    return status;
+}
+
+/**
+ * @brief Выполнить все измерения, для которых заданы источники и каналы.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы одно измерение завершилось с ошибкой.
+ */
+HAL_StatusTypeDef HAL_DMA_Bench_RunAll(DMA_Bench_HandleTypeDef *hbench)
+{
+    HAL_StatusTypeDef result = HAL_OK;
+
+    if ((hbench == NULL) || (hbench->ChannelA == NULL) || (hbench->RamSource == NULL) || (hbench->RamDestination == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hbench->Length == 0) || ((hbench->Length % DMA_BENCH_LENGTH_ALIGN) != 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_DMA_Bench_Latency(hbench) != HAL_OK) result = HAL_ERROR;
+    if (HAL_DMA_Bench_MemoryToMemory(hbench, "ram_to_ram", hbench->RamSource) != HAL_OK) result = HAL_ERROR;
+
+    if (hbench->EepromSource != NULL)
+    {
+        if (HAL_DMA_Bench_MemoryToMemory(hbench, "eeprom_to_ram", hbench->EepromSource) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->SpifiSource != NULL)
+    {
+        if (HAL_DMA_Bench_MemoryToMemory(hbench, "spifi_to_ram", hbench->SpifiSource) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->ChannelB != NULL)
+    {
+        if (HAL_DMA_Bench_Arbitration(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    if (hbench->LoopbackUsart != NULL)
+    {
+        if (HAL_DMA_Bench_Periphery(hbench) != HAL_OK) result = HAL_ERROR;
+    }
+
+    return result;
+}
@@ -0,0 +1,360 @@
+#include "mik32_hal_dsp_bench.h"
+
+
+/**
+ * @brief Коэффициенты звена ФНЧ Баттерворта второго порядка с частотой среза 0.02 Fs, PostShift = 1.
+ * Все звенья каскада в измерениях одинаковы.
+ */
+static const q15_t DSP_Bench_BiquadQ15[DSP_BIQUAD_COEFFS] = {59, 119, 59, -29863, 13716};
+static const q31_t DSP_Bench_BiquadQ31[DSP_BIQUAD_COEFFS] = {3888748, 7777496, 3888748, -1957102246, 898915413};
+
+/**
+ * @brief Буферы измерений.
+ */
+static uint16_t DSP_Bench_Adc[DSP_BENCH_BLOCK];
+static q15_t DSP_Bench_Q15[DSP_BENCH_BLOCK];
+static q31_t DSP_Bench_Q31[DSP_BENCH_BLOCK];
+static q15_t DSP_Bench_FirCoeffs[DSP_BENCH_MAX_TAPS];
+static q15_t DSP_Bench_FirState[2 * DSP_BENCH_MAX_TAPS];
+static q15_t DSP_Bench_BiquadCoeffsQ15[DSP_BIQUAD_COEFFS * DSP_BENCH_MAX_STAGES];
+static q31_t DSP_Bench_BiquadCoeffsQ31[DSP_BIQUAD_COEFFS * DSP_BENCH_MAX_STAGES];
+static q15_t DSP_Bench_BiquadStateQ15[DSP_BIQUAD_STATE * DSP_BENCH_MAX_STAGES];
+static q31_t DSP_Bench_BiquadStateQ31[DSP_BIQUAD_STATE * DSP_BENCH_MAX_STAGES];
+static q15_t DSP_Bench_RmsWindow[1 << DSP_BENCH_RMS_LOG2_LENGTH];
+
+
+/**
+ * @brief Количество вызовов в одном измерении.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Количество вызовов, не меньше 1.
+ */
+static inline uint32_t HAL_DSP_Bench_Repeat(DSP_Bench_HandleTypeDef *hbench)
+{
+    return (hbench->Repeat == 0) ? 1 : hbench->Repeat;
+}
+
+/**
+ * @brief Заполнить входные буферы отсчетами 12-битного АЦП.
+ *
+ * Отсчеты формируются линейным конгруэнтным генератором и не зависят от предыдущих измерений.
+ */
+static void HAL_DSP_Bench_Fill(void)
+{
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < DSP_BENCH_BLOCK; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        DSP_Bench_Adc[i] = (uint16_t)(seed >> 20);
+    }
+
+    HAL_DSP_ADC_ToQ15(DSP_Bench_Adc, DSP_Bench_Q15, DSP_BENCH_BLOCK, 1, 2048, 4);
+    HAL_DSP_ADC_ToQ31(DSP_Bench_Adc, DSP_Bench_Q31, DSP_BENCH_BLOCK, 1, 2048, 20);
+}
+
+/**
+ * @brief Начать строку отчета и вывести общие поля измерения.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param name Имя измерения.
+ * @param Samples Количество отсчетов за вызов.
+ * @param Cycles Количество тактов всех вызовов.
+ * @param Calls Количество вызовов.
+ */
+static void HAL_DSP_Bench_ReportBegin(DSP_Bench_HandleTypeDef *hbench, const char *name, uint32_t Samples, uint32_t Cycles, uint32_t Calls)
+{
+    uint32_t cycles_per_call = Cycles / Calls;
+
+    HAL_Bench_ReportBegin(&hbench->Report, DSP_BENCH_SUITE, name);
+    HAL_Bench_ReportField(&hbench->Report, "samples", Samples);
+    HAL_Bench_ReportField(&hbench->Report, "calls", Calls);
+    HAL_Bench_ReportField(&hbench->Report, "cycles", cycles_per_call);
+    HAL_Bench_ReportField(&hbench->Report, "cycles_per_sample", (cycles_per_call + Samples / 2) / Samples);
+    HAL_Bench_ReportField(&hbench->Report, "samples_per_s", HAL_Bench_BytesPerSecond(Samples, cycles_per_call, hbench->CoreFreq));
+}
+
+/**
+ * @brief Измерить преобразование отсчетов АЦП в Q15 и Q31.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_Convert(DSP_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    uint32_t start;
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_ADC_ToQ15(DSP_Bench_Adc, DSP_Bench_Q15, DSP_BENCH_BLOCK, 1, 2048, 4);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "adc_to_q15", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_ADC_ToQ31(DSP_Bench_Adc, DSP_Bench_Q31, DSP_BENCH_BLOCK, 1, 2048, 20);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "adc_to_q31", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить КИХ-фильтр Q15.
+ *
+ * Коэффициенты одинаковы, сумма их модулей равна 1.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param NumTaps Количество отводов, не больше #DSP_BENCH_MAX_TAPS.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_FIR(DSP_Bench_HandleTypeDef *hbench, uint16_t NumTaps)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    DSP_FIR_Q15_TypeDef fir;
+    uint32_t start;
+
+    if (NumTaps > DSP_BENCH_MAX_TAPS)
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint32_t i = 0; i < NumTaps; i++)
+    {
+        DSP_Bench_FirCoeffs[i] = (q15_t)(32768 / NumTaps);
+    }
+
+    if (HAL_DSP_FIR_Q15_Init(&fir, NumTaps, DSP_Bench_FirCoeffs, DSP_Bench_FirState) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_FIR_Q15(&fir, DSP_Bench_Q15, DSP_Bench_Q15, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "fir_q15", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "taps", NumTaps);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить каскады биквадратных фильтров Q15 и Q31.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param NumStages Количество звеньев, не больше #DSP_BENCH_MAX_STAGES.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_Biquad(DSP_Bench_HandleTypeDef *hbench, uint8_t NumStages)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    DSP_Biquad_Q15_TypeDef biquad_q15;
+    DSP_Biquad_Q31_TypeDef biquad_q31;
+    uint32_t start;
+
+    if (NumStages > DSP_BENCH_MAX_STAGES)
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint32_t i = 0; i < DSP_BIQUAD_COEFFS * (uint32_t)NumStages; i++)
+    {
+        DSP_Bench_BiquadCoeffsQ15[i] = DSP_Bench_BiquadQ15[i % DSP_BIQUAD_COEFFS];
+        DSP_Bench_BiquadCoeffsQ31[i] = DSP_Bench_BiquadQ31[i % DSP_BIQUAD_COEFFS];
+    }
+
+    if ((HAL_DSP_Biquad_Q15_Init(&biquad_q15, NumStages, DSP_Bench_BiquadCoeffsQ15, DSP_Bench_BiquadStateQ15, 1) != HAL_OK) ||
+        (HAL_DSP_Biquad_Q31_Init(&biquad_q31, NumStages, DSP_Bench_BiquadCoeffsQ31, DSP_Bench_BiquadStateQ31, 1) != HAL_OK))
+    {
+        return HAL_ERROR;
+    }
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_Biquad_Q15(&biquad_q15, DSP_Bench_Q15, DSP_Bench_Q15, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "biquad_q15", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "stages", NumStages);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_Biquad_Q31(&biquad_q31, DSP_Bench_Q31, DSP_Bench_Q31, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "biquad_q31", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "stages", NumStages);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить фильтр удаления постоянной составляющей.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_DCBlock(DSP_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    DSP_DCBlock_Q15_TypeDef dc;
+    uint32_t start;
+
+    if (HAL_DSP_DCBlock_Q15_Init(&dc, 32604) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_DCBlock_Q15(&dc, DSP_Bench_Q15, DSP_Bench_Q15, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "dcblock_q15", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить скользящее СКЗ с извлечением корня на каждом отсчете и один раз на блок.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_RMS(DSP_Bench_HandleTypeDef *hbench)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    DSP_RMS_Q15_TypeDef rms;
+    uint32_t start;
+
+    if (HAL_DSP_RMS_Q15_Init(&rms, DSP_Bench_RmsWindow, DSP_BENCH_RMS_LOG2_LENGTH) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_RMS_Q15(&rms, DSP_Bench_Q15, NULL, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "rms_q15_block", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "window", 1 << DSP_BENCH_RMS_LOG2_LENGTH);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_DSP_RMS_Q15(&rms, DSP_Bench_Q15, DSP_Bench_Q15, DSP_BENCH_BLOCK);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "rms_q15_sample", DSP_BENCH_BLOCK, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "window", 1 << DSP_BENCH_RMS_LOG2_LENGTH);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Измерить загрузку отсчетов АЦП, преобразование Фурье и поиск наибольшего бина.
+ *
+ * Время выполнения не зависит от значений отсчетов, поэтому все отсчеты загружаются из одного элемента
+ * входного буфера, а повторные преобразования выполняются над результатом предыдущего.
+ * @param hbench Указатель на структуру набора измерений.
+ * @param Length Количество точек, не больше FftMaxLength.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_FFT(DSP_Bench_HandleTypeDef *hbench, uint16_t Length)
+{
+    uint32_t repeat = HAL_DSP_Bench_Repeat(hbench);
+    FFT_HandleTypeDef fft;
+    uint32_t start;
+
+    if ((hbench->FftBuffer == NULL) || (Length > hbench->FftMaxLength) || (HAL_FFT_Init(&fft, Length) != HAL_OK))
+    {
+        return HAL_ERROR;
+    }
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_FFT_LoadADC(&fft, DSP_Bench_Adc, 0, 2048, 4, FFT_WINDOW_HANN, hbench->FftBuffer);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "fft_load_hann", Length, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_FFT_Forward(&fft, hbench->FftBuffer);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "fft_q15", Length, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportField(&hbench->Report, "buffer_bytes", Length * 2 * sizeof(q15_t));
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    start = HAL_Bench_GetCycles();
+    for (uint32_t i = 0; i < repeat; i++)
+    {
+        HAL_FFT_PeakBin(hbench->FftBuffer, 1, Length / 2 - 1, NULL);
+    }
+    HAL_DSP_Bench_ReportBegin(hbench, "fft_peak", Length / 2 - 1, HAL_Bench_GetCycles() - start, repeat);
+    HAL_Bench_ReportEnd(&hbench->Report);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Выполнить все измерения набора.
+ *
+ * КИХ-фильтр измеряется с 8, 16, 32 и 64 отводами, каскады биквадратных фильтров - с 1, 2 и 4 звеньями,
+ * преобразование Фурье - со всеми длинами от #FFT_MIN_LENGTH до FftMaxLength.
+ * @param hbench Указатель на структуру набора измерений.
+ * @return Статус HAL. @ref HAL_ERROR, если хотя бы одно измерение завершилось с ошибкой.
+ */
+HAL_StatusTypeDef HAL_DSP_Bench_RunAll(DSP_Bench_HandleTypeDef *hbench)
+{
+    HAL_StatusTypeDef result = HAL_OK;
+
+    if (hbench == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    if (hbench->CoreFreq == 0)
+    {
+        hbench->CoreFreq = HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB + 1);
+    }
+
+    HAL_DSP_Bench_Fill();
+    if (HAL_DSP_Bench_Convert(hbench) != HAL_OK) result = HAL_ERROR;
+
+    for (uint16_t taps = 8; taps <= DSP_BENCH_MAX_TAPS; taps *= 2)
+    {
+        HAL_DSP_Bench_Fill();
+        if (HAL_DSP_Bench_FIR(hbench, taps) != HAL_OK) result = HAL_ERROR;
+    }
+
+    for (uint8_t stages = 1; stages <= DSP_BENCH_MAX_STAGES; stages *= 2)
+    {
+        HAL_DSP_Bench_Fill();
+        if (HAL_DSP_Bench_Biquad(hbench, stages) != HAL_OK) result = HAL_ERROR;
+    }
+
+    HAL_DSP_Bench_Fill();
+    if (HAL_DSP_Bench_DCBlock(hbench) != HAL_OK) result = HAL_ERROR;
+
+    HAL_DSP_Bench_Fill();
+    if (HAL_DSP_Bench_RMS(hbench) != HAL_OK) result = HAL_ERROR;
+
+    if (hbench->FftBuffer != NULL)
+    {
+        for (uint32_t length = FFT_MIN_LENGTH; length <= hbench->FftMaxLength; length *= 2)
+        {
+            if (HAL_DSP_Bench_FFT(hbench, (uint16_t)length) != HAL_OK) result = HAL_ERROR;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,123 @@
+#ifndef MIK32_HAL_PROF
+#define MIK32_HAL_PROF
+
+#include "inttypes.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal_usart.h"
+
+
+/*
+ * Профилирование по счетчикам ядра mcycle и minstret.
+ *
+ * Включается определением MIK32_HAL_PROFILE при сборке. Без него макросы HAL_PROF_BEGIN и HAL_PROF_END
+ * не генерируют кода, а функции модуля не используют память.
+ *
+ * Пример:
+ *     HAL_PROF_BEGIN(uart_send);
+ *     ...
+ *     HAL_PROF_END(uart_send);
+ *
+ * Начало и конец точки должны находиться в одной функции, HAL_PROF_END ставится перед каждым выходом.
+ */
+
+#ifndef HAL_PROF_MAX_PROBES
+#define HAL_PROF_MAX_PROBES     16      /**< Размер таблицы точек. Точки сверх размера не учитываются. */
+#endif
+
+#define HAL_PROF_HIST_BINS      16      /**< Количество интервалов гистограммы. Интервал k содержит длительности от 2^(k-1) до 2^k-1 тактов, последний - все большие. */
+
+
+/**
+ * @brief Статистика точки профилирования.
+ */
+typedef struct __HAL_Prof_ProbeTypeDef
+{
+    const char *Name;                       /**< Имя точки. */
+    uint32_t Count;                         /**< Количество измерений. */
+    uint32_t Min;                           /**< Минимальная длительность, такты. */
+    uint32_t Max;                           /**< Максимальная длительность, такты. */
+    uint64_t CyclesSum;                     /**< Сумма длительностей, такты. */
+    uint64_t InstretSum;                    /**< Сумма выполненных инструкций. */
+    uint32_t Hist[HAL_PROF_HIST_BINS];      /**< Гистограмма длительностей. */
+    uint8_t Registered;                     /**< Точка внесена в таблицу. */
+} HAL_Prof_ProbeTypeDef;
+
+/**
+ * @brief Значения счетчиков в начале измерения.
+ */
+typedef struct __HAL_Prof_MarkTypeDef
+{
+    uint32_t Cycles;
+    uint32_t Instret;
+} HAL_Prof_MarkTypeDef;
+
+
+/**
+ * @brief Получить значение счетчика тактов ядра mcycle.
+ * @return Младшие 32 бита счетчика тактов.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Prof_GetCycles()
+{
+    uint32_t cycles;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (cycles));
+    return cycles;
+}
+
+/**
+ * @brief Получить значение счетчика выполненных инструкций minstret.
+ * @return Младшие 32 бита счетчика инструкций.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Prof_GetInstret()
+{
+    uint32_t instret;
+    __asm__ volatile ("csrr %0, minstret" : "=r" (instret));
+    return instret;
+}
+
+
+#ifdef MIK32_HAL_PROFILE
+
+void HAL_Prof_Record(HAL_Prof_ProbeTypeDef *probe, uint32_t Cycles, uint32_t Instret);
+void HAL_Prof_Reset();
+void HAL_Prof_Dump(USART_HandleTypeDef *husart, uint32_t Timeout);
+
+/**
+ * @brief Начать измерение.
+ * @param mark Значения счетчиков в начале измерения.
+ */
+static inline __attribute__((always_inline)) void HAL_Prof_Begin(HAL_Prof_MarkTypeDef *mark)
+{
+    mark->Instret = HAL_Prof_GetInstret();
+    mark->Cycles = HAL_Prof_GetCycles();
+}
+
+/**
+ * @brief Закончить измерение и учесть его в статистике точки.
+ * @param probe Точка профилирования.
+ * @param mark Значения счетчиков в начале измерения.
+ */
+static inline __attribute__((always_inline)) void HAL_Prof_End(HAL_Prof_ProbeTypeDef *probe, HAL_Prof_MarkTypeDef *mark)
+{
+    uint32_t cycles = HAL_Prof_GetCycles() - mark->Cycles;
+    uint32_t instret = HAL_Prof_GetInstret() - mark->Instret;
+    HAL_Prof_Record(probe, cycles, instret);
+}
+
+#define HAL_PROF_BEGIN(__NAME__)                                                        \
+    static HAL_Prof_ProbeTypeDef hal_prof_probe_##__NAME__ = { .Name = #__NAME__ };     \
+    HAL_Prof_MarkTypeDef hal_prof_mark_##__NAME__;                                      \
+    HAL_Prof_Begin(&hal_prof_mark_##__NAME__)
+
+#define HAL_PROF_END(__NAME__)  HAL_Prof_End(&hal_prof_probe_##__NAME__, &hal_prof_mark_##__NAME__)
+
+#else
+
+static inline __attribute__((always_inline)) void HAL_Prof_Reset() {}
+static inline __attribute__((always_inline)) void HAL_Prof_Dump(USART_HandleTypeDef *husart, uint32_t Timeout) { (void)husart; (void)Timeout; }
+
+#define HAL_PROF_BEGIN(__NAME__)    do {} while (0)
+#define HAL_PROF_END(__NAME__)      do {} while (0)
+
+#endif // MIK32_HAL_PROFILE
+
+#endif // MIK32_HAL_PROF
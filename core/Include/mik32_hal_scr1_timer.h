@@ -5,6 +5,8 @@
 #include "power_manager.h"
 #include "inttypes.h"
 #include "mik32_hal_pcc.h"
+#include "mik32_hal_time.h"
+#include "mik32_hal_irq.h"
 
 #include "csr.h"
 #include "scr1_csr_encoding.h"
@@ -161,11 +163,32 @@ static inline __attribute__((always_inline)) void HAL_SCR1_Timer_Init(HAL_SCR1_T
 }
 
 
+/**
+ * @brief Статистика задержки пробуждения после WFI.
+ *
+ * Задержка - разность значения счетчика после выхода из WFI и значения сравнения, в тактах таймера.
+ * Перевести в микросекунды можно функцией @ref HAL_Time_TicksToUs.
+ */
+typedef struct __HAL_Time_SCR1TIM_WakeStatsTypeDef
+{
+    uint32_t Last;      /**< Задержка последнего пробуждения. */
+    uint32_t Min;       /**< Минимальная задержка. */
+    uint32_t Max;       /**< Максимальная задержка. */
+    uint32_t Count;     /**< Количество измерений. */
+} HAL_Time_SCR1TIM_WakeStatsTypeDef;
+
+
 void HAL_Time_SCR1TIM_Init();
+uint64_t HAL_Time_SCR1TIM_Ticks64();
 uint32_t HAL_Time_SCR1TIM_Micros();
 uint32_t HAL_Time_SCR1TIM_Millis();
 void HAL_Time_SCR1TIM_DelayUs(uint32_t time_us);
 void HAL_Time_SCR1TIM_DelayMs(uint32_t time_ms);
+void HAL_Time_SCR1TIM_SleepUntil(uint64_t ticks);
+void HAL_Time_SCR1TIM_SleepUs(uint32_t time_us);
+void HAL_Time_SCR1TIM_SleepMs(uint32_t time_ms);
+void HAL_Time_SCR1TIM_SetWakeMargin(uint32_t ticks);
+void HAL_Time_SCR1TIM_SetWakeStats(HAL_Time_SCR1TIM_WakeStatsTypeDef *stats);
 
 
 #endif // MIK32_HAL_SCR1_TIMER
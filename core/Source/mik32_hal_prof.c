@@ -0,0 +1,150 @@
+#include "mik32_hal_prof.h"
+#include "mik32_hal_irq.h"
+
+#ifdef MIK32_HAL_PROFILE
+
+/* Таблица точек профилирования, заполняется при первом измерении каждой точки */
+static HAL_Prof_ProbeTypeDef *HAL_Prof_Table[HAL_PROF_MAX_PROBES];
+static uint32_t HAL_Prof_TableSize;
+
+
+/**
+ * @brief Учесть измерение в статистике точки.
+ *
+ * Вызывается из @ref HAL_PROF_END, в том числе из прерываний.
+ * @param probe Точка профилирования.
+ * @param Cycles Длительность, такты.
+ * @param Instret Количество выполненных инструкций.
+ */
+void HAL_Prof_Record(HAL_Prof_ProbeTypeDef *probe, uint32_t Cycles, uint32_t Instret)
+{
+    uint32_t bin = (Cycles == 0) ? 0 : (32 - __builtin_clz(Cycles));
+    if (bin >= HAL_PROF_HIST_BINS)
+    {
+        bin = HAL_PROF_HIST_BINS - 1;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (!probe->Registered)
+    {
+        if (HAL_Prof_TableSize >= HAL_PROF_MAX_PROBES)
+        {
+            HAL_IRQ_Restore(mstatus);
+            return;
+        }
+        HAL_Prof_Table[HAL_Prof_TableSize++] = probe;
+        probe->Registered = 1;
+    }
+
+    if ((probe->Count == 0) || (Cycles < probe->Min))
+    {
+        probe->Min = Cycles;
+    }
+    if (Cycles > probe->Max)
+    {
+        probe->Max = Cycles;
+    }
+    probe->Count++;
+    probe->CyclesSum += Cycles;
+    probe->InstretSum += Instret;
+    probe->Hist[bin]++;
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Сбросить статистику всех точек.
+ *
+ * Точки остаются в таблице.
+ */
+void HAL_Prof_Reset()
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    for (uint32_t i = 0; i < HAL_Prof_TableSize; i++)
+    {
+        HAL_Prof_ProbeTypeDef *probe = HAL_Prof_Table[i];
+
+        probe->Count = 0;
+        probe->Min = 0;
+        probe->Max = 0;
+        probe->CyclesSum = 0;
+        probe->InstretSum = 0;
+        for (uint32_t bin = 0; bin < HAL_PROF_HIST_BINS; bin++)
+        {
+            probe->Hist[bin] = 0;
+        }
+    }
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Вывести беззнаковое число в десятичном виде.
+ * @param husart Модуль USART.
+ * @param value Выводимое значение.
+ * @param Timeout Количество циклов ожидания передачи одного байта.
+ */
+static void HAL_Prof_PrintUInt(USART_HandleTypeDef *husart, uint32_t value, uint32_t Timeout)
+{
+    char buffer[11];
+    uint32_t i = sizeof(buffer) - 1;
+
+    buffer[i] = '\0';
+    do
+    {
+        buffer[--i] = '0' + (value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    HAL_USART_Print(husart, &buffer[i], Timeout);
+}
+
+/**
+ * @brief Вывести статистику всех точек через USART.
+ *
+ * Каждая точка выводится одной строкой вида
+ * @code
+ * PROF <имя> count=<n> min=<такты> max=<такты> mean=<такты> instret=<инструкций в среднем> hist=<h0>,<h1>,...\r\n
+ * @endcode
+ * Статистика копируется при запрещенных прерываниях, вывод выполняется при разрешенных.
+ * @param husart Модуль USART. Модуль должен быть проинициализирован.
+ * @param Timeout Количество циклов ожидания передачи одного байта.
+ */
+void HAL_Prof_Dump(USART_HandleTypeDef *husart, uint32_t Timeout)
+{
+    for (uint32_t i = 0; i < HAL_Prof_TableSize; i++)
+    {
+        HAL_Prof_ProbeTypeDef probe;
+
+        uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+        probe = *HAL_Prof_Table[i];
+        HAL_IRQ_Restore(mstatus);
+
+        HAL_USART_Print(husart, "PROF ", Timeout);
+        HAL_USART_Print(husart, (char *)probe.Name, Timeout);
+        HAL_USART_Print(husart, " count=", Timeout);
+        HAL_Prof_PrintUInt(husart, probe.Count, Timeout);
+        HAL_USART_Print(husart, " min=", Timeout);
+        HAL_Prof_PrintUInt(husart, probe.Min, Timeout);
+        HAL_USART_Print(husart, " max=", Timeout);
+        HAL_Prof_PrintUInt(husart, probe.Max, Timeout);
+        HAL_USART_Print(husart, " mean=", Timeout);
+        HAL_Prof_PrintUInt(husart, (probe.Count == 0) ? 0 : (uint32_t)(probe.CyclesSum / probe.Count), Timeout);
+        HAL_USART_Print(husart, " instret=", Timeout);
+        HAL_Prof_PrintUInt(husart, (probe.Count == 0) ? 0 : (uint32_t)(probe.InstretSum / probe.Count), Timeout);
+        HAL_USART_Print(husart, " hist=", Timeout);
+        for (uint32_t bin = 0; bin < HAL_PROF_HIST_BINS; bin++)
+        {
+            if (bin != 0)
+            {
+                HAL_USART_Print(husart, ",", Timeout);
+            }
+            HAL_Prof_PrintUInt(husart, probe.Hist[bin], Timeout);
+        }
+        HAL_USART_Print(husart, "\r\n", Timeout);
+    }
+}
+
+#endif // MIK32_HAL_PROFILE
@@ -5,6 +5,11 @@ struct __HAL_Time_SCR1TIM_Handler
     uint32_t presc;     // AHB prescaler
     uint32_t pt;        // Timer divider
     uint32_t clock_freq; // Clock frequency
+    HAL_Time_ScaleTypeDef micros; // Ticks to microseconds
+    HAL_Time_ScaleTypeDef millis; // Ticks to milliseconds
+    HAL_Time_ScaleTypeDef us_to_ticks; // Microseconds to ticks
+    uint32_t wake_margin; // Ticks of busy-wait after WFI
+    HAL_Time_SCR1TIM_WakeStatsTypeDef *wake_stats; // Wake-up latency, NULL - measurement disabled
 } HAL_Time_SCR1TIM_Handler;
 
 /**
@@ -29,10 +34,36 @@ void HAL_Time_SCR1TIM_Init()
         else HAL_Time_SCR1TIM_Handler.pt = pt_raw;
     }
     __HAL_SCR1_TIMER_SET_DIVIDER(HAL_Time_SCR1TIM_Handler.pt-1);
+    /* Conversion coefficients */
+    uint32_t tick_freq = HAL_Time_SCR1TIM_Handler.clock_freq / (HAL_Time_SCR1TIM_Handler.presc * HAL_Time_SCR1TIM_Handler.pt);
+    HAL_Time_ScaleInit(&HAL_Time_SCR1TIM_Handler.micros, tick_freq, 1000000UL);
+    HAL_Time_ScaleInit(&HAL_Time_SCR1TIM_Handler.millis, tick_freq, 1000UL);
+    HAL_Time_ScaleInit(&HAL_Time_SCR1TIM_Handler.us_to_ticks, 1000000UL, tick_freq);
     /* Timer enable */
     __HAL_SCR1_TIMER_ENABLE();
     /* Clear the timer */
     __HAL_SCR1_TIMER_SET_TIME(0);
+
+    HAL_Time_SetSource(HAL_Time_SCR1TIM_Ticks64, tick_freq);
+}
+
+/**
+ * @brief 64-р значение счетчика таймера SCR1.
+ * 
+ * Старшее слово читается до и после младшего, при переносе чтение повторяется. 
+ * Функцию можно вызывать из прерываний.
+*/
+uint64_t HAL_Time_SCR1TIM_Ticks64()
+{
+    uint32_t high, low;
+
+    do
+    {
+        high = SCR1_TIMER->MTIMEH;
+        low = SCR1_TIMER->MTIME;
+    } while (high != SCR1_TIMER->MTIMEH);
+
+    return ((uint64_t)high << 32) | low;
 }
 
 /**
@@ -40,8 +71,7 @@ void HAL_Time_SCR1TIM_Init()
 */
 uint32_t HAL_Time_SCR1TIM_Micros()
 {
-    return (uint32_t)(__HAL_SCR1_TIMER_GET_TIME() * (1000000UL * HAL_Time_SCR1TIM_Handler.presc *
-        HAL_Time_SCR1TIM_Handler.pt) / HAL_Time_SCR1TIM_Handler.clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_SCR1TIM_Handler.micros, HAL_Time_SCR1TIM_Ticks64());
 }
 
 /**
@@ -49,8 +79,7 @@ uint32_t HAL_Time_SCR1TIM_Micros()
 */
 uint32_t HAL_Time_SCR1TIM_Millis()
 {
-    return (uint32_t)(__HAL_SCR1_TIMER_GET_TIME() * (1000UL * HAL_Time_SCR1TIM_Handler.presc *
-        HAL_Time_SCR1TIM_Handler.pt) / HAL_Time_SCR1TIM_Handler.clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_SCR1TIM_Handler.millis, HAL_Time_SCR1TIM_Ticks64());
 }
 
 /**
@@ -70,3 +99,126 @@ void HAL_Time_SCR1TIM_DelayMs(uint32_t time_ms)
     uint32_t time_metka = HAL_Time_SCR1TIM_Millis();
     while (HAL_Time_SCR1TIM_Millis() - time_metka < time_ms);
 }
+
+/**
+ * @brief Учесть задержку пробуждения в статистике.
+ * @param latency Задержка в тактах таймера.
+*/
+static void HAL_Time_SCR1TIM_WakeStatsUpdate(uint32_t latency)
+{
+    HAL_Time_SCR1TIM_WakeStatsTypeDef *stats = HAL_Time_SCR1TIM_Handler.wake_stats;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    if ((stats->Count == 0) || (latency < stats->Min))
+    {
+        stats->Min = latency;
+    }
+    if ((stats->Count == 0) || (latency > stats->Max))
+    {
+        stats->Max = latency;
+    }
+    stats->Last = latency;
+    stats->Count++;
+}
+
+/**
+ * @brief Сон до заданного значения счетчика таймера SCR1.
+ * 
+ * Ядро останавливается инструкцией WFI и пробуждается по сравнению mtimecmp. Прерывание таймера при этом 
+ * не вызывается: MTIE разрешается только на время WFI при запрещенных прерываниях, WFI завершается
+ * по ожидающему прерыванию независимо от MIE. Между WFI прерывания разрешаются, поэтому другие прерывания 
+ * обслуживаются во время сна без задержки.
+ * 
+ * Пробуждение выполняется на wake margin тактов раньше заданного значения (см. @ref HAL_Time_SCR1TIM_SetWakeMargin),
+ * остаток ожидается в цикле. Прежние значения mtimecmp и MTIE восстанавливаются.
+ * @param ticks Значение счетчика (см. @ref HAL_Time_SCR1TIM_Ticks64), до которого выполняется сон.
+*/
+void HAL_Time_SCR1TIM_SleepUntil(uint64_t ticks)
+{
+    uint64_t wake = ticks;
+    uint64_t woke = 0;
+    int slept = 0;
+
+    if (wake > HAL_Time_SCR1TIM_Handler.wake_margin)
+    {
+        wake -= HAL_Time_SCR1TIM_Handler.wake_margin;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    uint64_t cmp_prev = __HAL_SCR1_TIMER_GET_CMP();
+    uint32_t mtie_prev = read_csr(mie) & MIE_MTIE;
+
+    __HAL_SCR1_TIMER_SET_CMP(wake);
+
+    while (HAL_Time_SCR1TIM_Ticks64() < wake)
+    {
+        set_csr(mie, MIE_MTIE);
+        __asm__ volatile ("wfi" : : : "memory");
+        woke = HAL_Time_SCR1TIM_Ticks64();
+        clear_csr(mie, MIE_MTIE);
+        slept = 1;
+
+        /* Обслуживание прерываний, разбудивших ядро раньше срока */
+        HAL_IRQ_Restore(mstatus);
+        mstatus = HAL_IRQ_SaveAndDisable();
+    }
+
+    __HAL_SCR1_TIMER_SET_CMP(cmp_prev);
+    if (mtie_prev)
+    {
+        set_csr(mie, MIE_MTIE);
+    }
+    HAL_IRQ_Restore(mstatus);
+
+    if (slept && (woke >= wake))
+    {
+        HAL_Time_SCR1TIM_WakeStatsUpdate((uint32_t)(woke - wake));
+    }
+
+    while (HAL_Time_SCR1TIM_Ticks64() < ticks);
+}
+
+/**
+ * @brief Сон в микросекундах, используется таймер SCR1 в качестве системных часов
+*/
+void HAL_Time_SCR1TIM_SleepUs(uint32_t time_us)
+{
+    uint64_t start = HAL_Time_SCR1TIM_Ticks64();
+    HAL_Time_SCR1TIM_SleepUntil(start + HAL_Time_Scale(&HAL_Time_SCR1TIM_Handler.us_to_ticks, time_us));
+}
+
+/**
+ * @brief Сон в миллисекундах, используется таймер SCR1 в качестве системных часов
+*/
+void HAL_Time_SCR1TIM_SleepMs(uint32_t time_ms)
+{
+    uint64_t start = HAL_Time_SCR1TIM_Ticks64();
+    HAL_Time_SCR1TIM_SleepUntil(start + HAL_Time_Scale(&HAL_Time_SCR1TIM_Handler.us_to_ticks, (uint64_t)time_ms * 1000UL));
+}
+
+/**
+ * @brief Задать запас пробуждения для функций сна.
+ * 
+ * Ядро пробуждается на @p ticks тактов раньше срока, остаток ожидается в цикле. Значение выбирается
+ * не меньше максимальной задержки пробуждения, измеренной с помощью @ref HAL_Time_SCR1TIM_SetWakeStats.
+ * @param ticks Запас в тактах таймера. По умолчанию 0.
+*/
+void HAL_Time_SCR1TIM_SetWakeMargin(uint32_t ticks)
+{
+    HAL_Time_SCR1TIM_Handler.wake_margin = ticks;
+}
+
+/**
+ * @brief Включить режим измерения задержки пробуждения.
+ * 
+ * При каждом пробуждении по таймеру в функциях сна обновляется статистика @p stats.
+ * @param stats Указатель на статистику, обнуленную пользователем. NULL - измерение выключено.
+*/
+void HAL_Time_SCR1TIM_SetWakeStats(HAL_Time_SCR1TIM_WakeStatsTypeDef *stats)
+{
+    HAL_Time_SCR1TIM_Handler.wake_stats = stats;
+}
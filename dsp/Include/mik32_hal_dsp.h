@@ -0,0 +1,172 @@
+#ifndef MIK32_HAL_DSP
+#define MIK32_HAL_DSP
+
+#include <stdint.h>
+#include "stddef.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal.h"
+
+
+#define DSP_Q15_MAX                 32767           /**< Наибольшее значение формата Q15. */
+#define DSP_Q15_MIN                 (-32768)        /**< Наименьшее значение формата Q15. */
+#define DSP_Q31_MAX                 2147483647      /**< Наибольшее значение формата Q31. */
+#define DSP_Q31_MIN                 (-2147483647 - 1)   /**< Наименьшее значение формата Q31. */
+
+#define DSP_BIQUAD_COEFFS           5               /**< Количество коэффициентов звена биквадратного фильтра. */
+#define DSP_BIQUAD_STATE            4               /**< Количество отсчетов состояния звена биквадратного фильтра. */
+#define DSP_BIQUAD_Q15_MAX_SHIFT    3               /**< Наибольший сдвиг PostShift звена Q15. */
+#define DSP_BIQUAD_Q31_MAX_SHIFT    7               /**< Наибольший сдвиг PostShift звена Q31. */
+#define DSP_RMS_MAX_LOG2_LENGTH     12              /**< Наибольший log2 длины окна скользящего СКЗ, 4096 отсчетов. */
+
+/**
+ * @brief Число с фиксированной точкой в формате Q15: 1 знаковый бит, 15 дробных, диапазон [-1, 1).
+ */
+typedef int16_t q15_t;
+
+/**
+ * @brief Число с фиксированной точкой в формате Q31: 1 знаковый бит, 31 дробный, диапазон [-1, 1).
+ */
+typedef int32_t q31_t;
+
+/**
+ * @brief КИХ-фильтр в формате Q15.
+ *
+ * y[n] = sum(h[k] * x[n - k]), k = 0..NumTaps-1. Линия задержки хранится дважды подряд: каждый отсчет
+ * записывается по индексам Index и Index + NumTaps, поэтому окно из NumTaps последних отсчетов всегда
+ * непрерывно и свертка выполняется без проверки границы буфера.
+ *
+ * Накопление ведется в 32-битном аккумуляторе: на отвод приходится одна пара mul/add без обращения
+ * к старшей половине произведения. Переполнение исключено, если сумма модулей коэффициентов меньше 2
+ * (сумма модулей в Q15 не больше 65535), что выполняется для фильтров нижних частот и полосовых фильтров
+ * с единичным усилением.
+ */
+typedef struct __DSP_FIR_Q15_TypeDef
+{
+    const q15_t *pCoeffs;   /**< Коэффициенты h[0..NumTaps-1], h[0] умножается на последний отсчет. */
+    q15_t *pState;          /**< Линия задержки размером 2 * NumTaps отсчетов. */
+    uint16_t NumTaps;       /**< Количество отводов. */
+    uint16_t Index;         /**< Служебное поле: позиция последнего отсчета в линии задержки. */
+} DSP_FIR_Q15_TypeDef;
+
+/**
+ * @brief Каскад биквадратных фильтров (БИХ второго порядка) в формате Q15.
+ *
+ * Каждое звено - прямая форма I:
+ * y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2].
+ * Коэффициенты звена хранятся подряд в порядке {b0, b1, b2, a1, a2} и масштабированы на 2^-PostShift,
+ * т.е. заданы в формате Q(15 - PostShift), что позволяет задавать |a1| до 2^PostShift. Знаки a1 и a2
+ * совпадают с коэффициентами знаменателя 1 + a1 * z^-1 + a2 * z^-2 (как в scipy.signal).
+ *
+ * Накопление ведется в 32-битном аккумуляторе. Переполнение исключено, если сумма модулей
+ * коэффициентов звена в Q(15 - PostShift) не больше 65535. Для фильтров с низкой частотой среза
+ * погрешность округления Q15 велика, в этом случае следует использовать @ref DSP_Biquad_Q31_TypeDef.
+ */
+typedef struct __DSP_Biquad_Q15_TypeDef
+{
+    const q15_t *pCoeffs;   /**< Коэффициенты, #DSP_BIQUAD_COEFFS на звено. */
+    q15_t *pState;          /**< Состояние {x[n-1], x[n-2], y[n-1], y[n-2]}, #DSP_BIQUAD_STATE отсчетов на звено. */
+    uint8_t NumStages;      /**< Количество звеньев. */
+    uint8_t PostShift;      /**< Масштаб коэффициентов, не больше #DSP_BIQUAD_Q15_MAX_SHIFT. */
+} DSP_Biquad_Q15_TypeDef;
+
+/**
+ * @brief Каскад биквадратных фильтров в формате Q31.
+ *
+ * Структура звена и порядок коэффициентов совпадают с @ref DSP_Biquad_Q15_TypeDef, коэффициенты заданы
+ * в формате Q(31 - PostShift). Произведения 32x32 накапливаются в 64-битном аккумуляторе (пара инструкций
+ * mul/mulh на умножение). Переполнение исключено, если сумма модулей коэффициентов звена в Q(31 - PostShift)
+ * меньше 2^32. Точность достаточна для фильтров с частотой среза до 10^-4 частоты дискретизации.
+ */
+typedef struct __DSP_Biquad_Q31_TypeDef
+{
+    const q31_t *pCoeffs;   /**< Коэффициенты, #DSP_BIQUAD_COEFFS на звено. */
+    q31_t *pState;          /**< Состояние {x[n-1], x[n-2], y[n-1], y[n-2]}, #DSP_BIQUAD_STATE отсчетов на звено. */
+    uint8_t NumStages;      /**< Количество звеньев. */
+    uint8_t PostShift;      /**< Масштаб коэффициентов, не больше #DSP_BIQUAD_Q31_MAX_SHIFT. */
+} DSP_Biquad_Q31_TypeDef;
+
+/**
+ * @brief Фильтр удаления постоянной составляющей в формате Q15.
+ *
+ * y[n] = x[n] - x[n-1] + R * y[n-1]. Частота среза fc = (1 - R) * Fs / (2 * pi). Выход хранится
+ * с 14 дополнительными дробными битами, поэтому при R, близком к 1, ошибка округления не накапливается
+ * и на выходе нет остаточного смещения.
+ */
+typedef struct __DSP_DCBlock_Q15_TypeDef
+{
+    q15_t R;                /**< Коэффициент полюса в формате Q15, например 32604 (0.995). */
+    q15_t X1;               /**< Служебное поле: предыдущий входной отсчет. */
+    int32_t Acc;            /**< Служебное поле: предыдущий выходной отсчет в формате Q29. */
+} DSP_DCBlock_Q15_TypeDef;
+
+/**
+ * @brief Скользящее среднеквадратичное значение (СКЗ) в формате Q15.
+ *
+ * Сумма квадратов отсчетов окна обновляется на каждом отсчете: добавляется квадрат нового и вычитается
+ * квадрат вышедшего из окна, поэтому стоимость отсчета не зависит от длины окна. Длина окна - степень
+ * двойки, деление заменяется сдвигом. Корень извлекается целочисленно только для выходных значений.
+ */
+typedef struct __DSP_RMS_Q15_TypeDef
+{
+    q15_t *pWindow;         /**< Буфер окна размером 2^Log2Length отсчетов. */
+    uint8_t Log2Length;     /**< log2 длины окна, от 0 до #DSP_RMS_MAX_LOG2_LENGTH. */
+    uint16_t Index;         /**< Служебное поле: позиция самого старого отсчета в окне. */
+    uint64_t SumSquares;    /**< Служебное поле: сумма квадратов отсчетов окна в формате Q30. */
+} DSP_RMS_Q15_TypeDef;
+
+
+/**
+ * @brief Ограничить значение диапазоном Q15.
+ * @param x Значение.
+ * @return Значение в диапазоне [#DSP_Q15_MIN, #DSP_Q15_MAX].
+ */
+static inline __attribute__((always_inline)) q15_t HAL_DSP_Sat15(int32_t x)
+{
+    if (x > DSP_Q15_MAX) return DSP_Q15_MAX;
+    if (x < DSP_Q15_MIN) return DSP_Q15_MIN;
+    return (q15_t)x;
+}
+
+/**
+ * @brief Ограничить значение диапазоном Q31.
+ * @param x Значение.
+ * @return Значение в диапазоне [#DSP_Q31_MIN, #DSP_Q31_MAX].
+ */
+static inline __attribute__((always_inline)) q31_t HAL_DSP_Sat31(int64_t x)
+{
+    if (x > DSP_Q31_MAX) return DSP_Q31_MAX;
+    if (x < DSP_Q31_MIN) return DSP_Q31_MIN;
+    return (q31_t)x;
+}
+
+/**
+ * @brief Умножить два числа Q15 с округлением.
+ * @param a Множитель.
+ * @param b Множитель.
+ * @return Произведение в формате Q15. -1 * -1 ограничивается до #DSP_Q15_MAX.
+ */
+static inline __attribute__((always_inline)) q15_t HAL_DSP_MulQ15(q15_t a, q15_t b)
+{
+    return HAL_DSP_Sat15(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+
+void HAL_DSP_ADC_ToQ15(const uint16_t *pSrc, q15_t *pDst, uint32_t BlockSize, uint32_t Stride, uint16_t Offset, uint8_t Shift);
+void HAL_DSP_ADC_ToQ31(const uint16_t *pSrc, q31_t *pDst, uint32_t BlockSize, uint32_t Stride, uint16_t Offset, uint8_t Shift);
+void HAL_DSP_Q31_ToQ15(const q31_t *pSrc, q15_t *pDst, uint32_t BlockSize);
+
+HAL_StatusTypeDef HAL_DSP_FIR_Q15_Init(DSP_FIR_Q15_TypeDef *fir, uint16_t NumTaps, const q15_t *pCoeffs, q15_t *pState);
+void HAL_DSP_FIR_Q15(DSP_FIR_Q15_TypeDef *fir, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize);
+
+HAL_StatusTypeDef HAL_DSP_Biquad_Q15_Init(DSP_Biquad_Q15_TypeDef *biquad, uint8_t NumStages, const q15_t *pCoeffs, q15_t *pState, uint8_t PostShift);
+void HAL_DSP_Biquad_Q15(DSP_Biquad_Q15_TypeDef *biquad, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize);
+HAL_StatusTypeDef HAL_DSP_Biquad_Q31_Init(DSP_Biquad_Q31_TypeDef *biquad, uint8_t NumStages, const q31_t *pCoeffs, q31_t *pState, uint8_t PostShift);
+void HAL_DSP_Biquad_Q31(DSP_Biquad_Q31_TypeDef *biquad, const q31_t *pSrc, q31_t *pDst, uint32_t BlockSize);
+
+HAL_StatusTypeDef HAL_DSP_DCBlock_Q15_Init(DSP_DCBlock_Q15_TypeDef *dc, q15_t R);
+void HAL_DSP_DCBlock_Q15(DSP_DCBlock_Q15_TypeDef *dc, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize);
+
+HAL_StatusTypeDef HAL_DSP_RMS_Q15_Init(DSP_RMS_Q15_TypeDef *rms, q15_t *pWindow, uint8_t Log2Length);
+q15_t HAL_DSP_RMS_Q15(DSP_RMS_Q15_TypeDef *rms, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize);
+
+#endif // MIK32_HAL_DSP
@@ -0,0 +1,78 @@
+#ifndef MIK32_HAL_FFT
+#define MIK32_HAL_FFT
+
+#include "mik32_hal_dsp.h"
+
+
+#define FFT_MIN_LENGTH              64      /**< Наименьшее количество точек. */
+#define FFT_MAX_LENGTH              1024    /**< Наибольшее количество точек и период таблицы синусов. */
+#define FFT_TABLE_LENGTH            (FFT_MAX_LENGTH + 1)    /**< Количество значений таблицы синусов. */
+
+#define FFT_WINDOW_NONE             0       /**< Прямоугольное окно. */
+#define FFT_WINDOW_HANN             1       /**< Окно Ханна. Рассчитывается по таблице синусов. */
+
+/**
+ * @brief Таблица sin(2 * pi * m / 1024), m = 0..1024, в формате Q15.
+ *
+ * Размещается в константной памяти (2050 байт) и используется для всех длин преобразования с шагом
+ * 1024 / L. cos(2 * pi * m / 1024) берется по индексу m + 256.
+ */
+extern const q15_t HAL_FFT_SinTable[FFT_TABLE_LENGTH];
+
+/**
+ * @brief Структура быстрого преобразования Фурье в формате Q15.
+ *
+ * Преобразование выполняется на месте над буфером из Length комплексных отсчетов {re, im} (2 * Length
+ * значений q15_t). Используется прореживание по частоте со звеньями radix-2^2: пара соседних этапов
+ * radix-2 выполняется одной бабочкой radix-4 с тремя комплексными умножениями вместо четырех, порядок
+ * результата остается двоично-инверсным. При нечетном log2(Length) последний этап - radix-2 без умножений.
+ * Затем выполняется двоично-инверсная перестановка.
+ *
+ * На каждом этапе radix-2 результат делится на 2, поэтому выход равен X[k] / Length. Если модуль каждого
+ * входного комплексного отсчета не больше 1 (для вещественного входа выполняется всегда), точное значение
+ * не выходит за [-1, 1], но после округления может получиться +1 (32768), например при отсчетах, равных -1.
+ * Результаты бабочек и поворотов насыщаются до диапазона q15_t, поэтому +1 заменяется на 32767 (ошибка
+ * 1 младший разряд) без смены знака. При модуле входа больше 1 выход также насыщается.
+ *
+ * Память и количество операций (умножения 16x16 в поворотах, бабочки без поворота не умножают):
+ * | Length | Буфер, байт | Бабочек radix-4 | Бабочек radix-2 | Умножений |
+ * |--------|-------------|-----------------|-----------------|-----------|
+ * | 64     | 256         | 48              | 0               | 324       |
+ * | 128    | 512         | 96              | 64              | 900       |
+ * | 256    | 1024        | 256             | 0               | 2052      |
+ * | 512    | 2048        | 512             | 256             | 5124      |
+ * | 1024   | 4096        | 1280            | 0               | 11268     |
+ *
+ * Таблица синусов общая для всех длин, дополнительной памяти ОЗУ, кроме буфера, не требуется.
+ * Количество тактов для каждой длины выводится набором измерений dsp (@ref HAL_DSP_Bench_FFT): оно зависит
+ * от размещения кода и таблицы (ОЗУ, EEPROM или SPIFI) и от настроек кэша SPIFI.
+ */
+typedef struct __FFT_HandleTypeDef
+{
+    uint16_t Length;            /**< Количество точек, степень двойки от #FFT_MIN_LENGTH до #FFT_MAX_LENGTH. */
+    uint8_t Log2Length;         /**< Служебное поле: log2(Length). */
+    uint16_t TableStride;       /**< Служебное поле: шаг по таблице синусов, #FFT_MAX_LENGTH / Length. */
+} FFT_HandleTypeDef;
+
+
+/**
+ * @brief Частота бина преобразования.
+ * @param hfft Указатель на структуру преобразования.
+ * @param Bin Номер бина.
+ * @param SampleRate Частота дискретизации, Гц.
+ * @return Частота бина, Гц, с округлением вниз.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_FFT_BinFrequency(FFT_HandleTypeDef *hfft, uint32_t Bin, uint32_t SampleRate)
+{
+    return (uint32_t)(((uint64_t)Bin * SampleRate) >> hfft->Log2Length);
+}
+
+
+HAL_StatusTypeDef HAL_FFT_Init(FFT_HandleTypeDef *hfft, uint16_t Length);
+void HAL_FFT_LoadADC(FFT_HandleTypeDef *hfft, const uint16_t *pSrc, uint32_t Stride, uint16_t Offset, uint8_t Shift, uint8_t Window, q15_t *pBuffer);
+void HAL_FFT_Forward(FFT_HandleTypeDef *hfft, q15_t *pBuffer);
+void HAL_FFT_MagnitudeSquared(const q15_t *pBuffer, uint32_t *pDst, uint32_t Bins);
+void HAL_FFT_Magnitude(const q15_t *pBuffer, q15_t *pDst, uint32_t Bins);
+uint32_t HAL_FFT_PeakBin(const q15_t *pBuffer, uint32_t FirstBin, uint32_t LastBin, uint32_t *pMagnitudeSquared);
+
+#endif // MIK32_HAL_FFT
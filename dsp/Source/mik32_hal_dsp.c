@@ -0,0 +1,398 @@
+#include "mik32_hal_dsp.h"
+
+
+/**
+ * @brief Преобразовать отсчеты АЦП в формат Q15.
+ *
+ * pDst[i] = (pSrc[i * Stride] - Offset) << Shift с насыщением. Для 12-битного АЦП без передискретизации
+ * Offset = 2048, Shift = 4. Для буфера @ref HAL_ADC_Sampler с N каналами сканирования Stride = N,
+ * pSrc указывает на отсчет нужного канала в первом кадре - разделение каналов совмещено с преобразованием.
+ * @param pSrc Отсчеты АЦП.
+ * @param pDst Результат. Может совпадать с pSrc только при Stride = 1.
+ * @param BlockSize Количество выходных отсчетов.
+ * @param Stride Шаг между входными отсчетами.
+ * @param Offset Код АЦП, соответствующий нулю.
+ * @param Shift Сдвиг влево, не больше 15.
+ */
+void HAL_DSP_ADC_ToQ15(const uint16_t *pSrc, q15_t *pDst, uint32_t BlockSize, uint32_t Stride, uint16_t Offset, uint8_t Shift)
+{
+    while (BlockSize-- != 0)
+    {
+        *pDst++ = HAL_DSP_Sat15(((int32_t)*pSrc - Offset) << Shift);
+        pSrc += Stride;
+    }
+}
+
+/**
+ * @brief Преобразовать отсчеты АЦП в формат Q31.
+ *
+ * pDst[i] = (pSrc[i * Stride] - Offset) << Shift с насыщением. Для 12-битного АЦП Offset = 2048, Shift = 20.
+ * @param pSrc Отсчеты АЦП.
+ * @param pDst Результат.
+ * @param BlockSize Количество выходных отсчетов.
+ * @param Stride Шаг между входными отсчетами.
+ * @param Offset Код АЦП, соответствующий нулю.
+ * @param Shift Сдвиг влево, не больше 31.
+ */
+void HAL_DSP_ADC_ToQ31(const uint16_t *pSrc, q31_t *pDst, uint32_t BlockSize, uint32_t Stride, uint16_t Offset, uint8_t Shift)
+{
+    while (BlockSize-- != 0)
+    {
+        *pDst++ = HAL_DSP_Sat31((int64_t)((int32_t)*pSrc - Offset) << Shift);
+        pSrc += Stride;
+    }
+}
+
+/**
+ * @brief Преобразовать отсчеты Q31 в формат Q15 с округлением.
+ * @param pSrc Исходные отсчеты.
+ * @param pDst Результат. Может совпадать с pSrc.
+ * @param BlockSize Количество отсчетов.
+ */
+void HAL_DSP_Q31_ToQ15(const q31_t *pSrc, q15_t *pDst, uint32_t BlockSize)
+{
+    while (BlockSize-- != 0)
+    {
+        *pDst++ = HAL_DSP_Sat15(((*pSrc++ >> 15) + 1) >> 1);
+    }
+}
+
+/**
+ * @brief Инициализировать КИХ-фильтр Q15.
+ * @param fir Указатель на структуру фильтра.
+ * @param NumTaps Количество отводов, не меньше 1.
+ * @param pCoeffs Коэффициенты.
+ * @param pState Линия задержки размером 2 * NumTaps отсчетов. Обнуляется.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_FIR_Q15_Init(DSP_FIR_Q15_TypeDef *fir, uint16_t NumTaps, const q15_t *pCoeffs, q15_t *pState)
+{
+    if ((fir == NULL) || (pCoeffs == NULL) || (pState == NULL) || (NumTaps == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    fir->pCoeffs = pCoeffs;
+    fir->pState = pState;
+    fir->NumTaps = NumTaps;
+    fir->Index = 0;
+
+    for (uint32_t i = 0; i < 2 * (uint32_t)NumTaps; i++)
+    {
+        pState[i] = 0;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Обработать блок отсчетов КИХ-фильтром Q15.
+ *
+ * Свертка развернута на 4 отвода: указатели на отсчеты и коэффициенты увеличиваются один раз
+ * за 4 умножения, смещения загрузок кодируются в инструкциях lh.
+ * @param fir Указатель на структуру фильтра.
+ * @param pSrc Входные отсчеты.
+ * @param pDst Выходные отсчеты. Может совпадать с pSrc.
+ * @param BlockSize Количество отсчетов.
+ */
+void HAL_DSP_FIR_Q15(DSP_FIR_Q15_TypeDef *fir, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize)
+{
+    uint32_t taps = fir->NumTaps;
+    uint32_t index = fir->Index;
+    q15_t *state = fir->pState;
+
+    while (BlockSize-- != 0)
+    {
+        index = ((index == 0) ? taps : index) - 1;
+        state[index] = *pSrc;
+        state[index + taps] = *pSrc++;
+
+        const q15_t *px = &state[index];
+        const q15_t *ph = fir->pCoeffs;
+        int32_t acc = 1 << 14;
+        uint32_t k = taps >> 2;
+
+        while (k-- != 0)
+        {
+            acc += (int32_t)px[0] * ph[0];
+            acc += (int32_t)px[1] * ph[1];
+            acc += (int32_t)px[2] * ph[2];
+            acc += (int32_t)px[3] * ph[3];
+            px += 4;
+            ph += 4;
+        }
+
+        k = taps & 3;
+        while (k-- != 0)
+        {
+            acc += (int32_t)*px++ * *ph++;
+        }
+
+        *pDst++ = HAL_DSP_Sat15(acc >> 15);
+    }
+
+    fir->Index = index;
+}
+
+/**
+ * @brief Инициализировать каскад биквадратных фильтров Q15.
+ * @param biquad Указатель на структуру фильтра.
+ * @param NumStages Количество звеньев, не меньше 1.
+ * @param pCoeffs Коэффициенты, #DSP_BIQUAD_COEFFS на звено.
+ * @param pState Состояние, #DSP_BIQUAD_STATE отсчетов на звено. Обнуляется.
+ * @param PostShift Масштаб коэффициентов, не больше #DSP_BIQUAD_Q15_MAX_SHIFT.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Biquad_Q15_Init(DSP_Biquad_Q15_TypeDef *biquad, uint8_t NumStages, const q15_t *pCoeffs, q15_t *pState, uint8_t PostShift)
+{
+    if ((biquad == NULL) || (pCoeffs == NULL) || (pState == NULL) || (NumStages == 0) || (PostShift > DSP_BIQUAD_Q15_MAX_SHIFT))
+    {
+        return HAL_ERROR;
+    }
+
+    biquad->pCoeffs = pCoeffs;
+    biquad->pState = pState;
+    biquad->NumStages = NumStages;
+    biquad->PostShift = PostShift;
+
+    for (uint32_t i = 0; i < DSP_BIQUAD_STATE * (uint32_t)NumStages; i++)
+    {
+        pState[i] = 0;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Обработать блок отсчетов каскадом биквадратных фильтров Q15.
+ *
+ * Внешний цикл идет по звеньям: коэффициенты и состояние звена загружаются в регистры один раз
+ * на блок, внутренний цикл содержит 5 умножений и не обращается к памяти, кроме входа и выхода.
+ * Второе и последующие звенья обрабатывают pDst на месте.
+ * @param biquad Указатель на структуру фильтра.
+ * @param pSrc Входные отсчеты.
+ * @param pDst Выходные отсчеты. Может совпадать с pSrc.
+ * @param BlockSize Количество отсчетов.
+ */
+void HAL_DSP_Biquad_Q15(DSP_Biquad_Q15_TypeDef *biquad, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize)
+{
+    const q15_t *coeffs = biquad->pCoeffs;
+    q15_t *state = biquad->pState;
+    uint32_t shift = 15 - biquad->PostShift;
+    int32_t round = 1L << (shift - 1);
+
+    for (uint32_t stage = 0; stage < biquad->NumStages; stage++)
+    {
+        int32_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+        int32_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+        const q15_t *src = pSrc;
+        q15_t *dst = pDst;
+
+        for (uint32_t n = 0; n < BlockSize; n++)
+        {
+            int32_t x = *src++;
+            int32_t acc = round + b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            int32_t y = HAL_DSP_Sat15(acc >> shift);
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            *dst++ = (q15_t)y;
+        }
+
+        state[0] = (q15_t)x1;
+        state[1] = (q15_t)x2;
+        state[2] = (q15_t)y1;
+        state[3] = (q15_t)y2;
+
+        coeffs += DSP_BIQUAD_COEFFS;
+        state += DSP_BIQUAD_STATE;
+        pSrc = pDst;
+    }
+}
+
+/**
+ * @brief Инициализировать каскад биквадратных фильтров Q31.
+ * @param biquad Указатель на структуру фильтра.
+ * @param NumStages Количество звеньев, не меньше 1.
+ * @param pCoeffs Коэффициенты, #DSP_BIQUAD_COEFFS на звено.
+ * @param pState Состояние, #DSP_BIQUAD_STATE отсчетов на звено. Обнуляется.
+ * @param PostShift Масштаб коэффициентов, не больше #DSP_BIQUAD_Q31_MAX_SHIFT.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_Biquad_Q31_Init(DSP_Biquad_Q31_TypeDef *biquad, uint8_t NumStages, const q31_t *pCoeffs, q31_t *pState, uint8_t PostShift)
+{
+    if ((biquad == NULL) || (pCoeffs == NULL) || (pState == NULL) || (NumStages == 0) || (PostShift > DSP_BIQUAD_Q31_MAX_SHIFT))
+    {
+        return HAL_ERROR;
+    }
+
+    biquad->pCoeffs = pCoeffs;
+    biquad->pState = pState;
+    biquad->NumStages = NumStages;
+    biquad->PostShift = PostShift;
+
+    for (uint32_t i = 0; i < DSP_BIQUAD_STATE * (uint32_t)NumStages; i++)
+    {
+        pState[i] = 0;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Обработать блок отсчетов каскадом биквадратных фильтров Q31.
+ * @param biquad Указатель на структуру фильтра.
+ * @param pSrc Входные отсчеты.
+ * @param pDst Выходные отсчеты. Может совпадать с pSrc.
+ * @param BlockSize Количество отсчетов.
+ */
+void HAL_DSP_Biquad_Q31(DSP_Biquad_Q31_TypeDef *biquad, const q31_t *pSrc, q31_t *pDst, uint32_t BlockSize)
+{
+    const q31_t *coeffs = biquad->pCoeffs;
+    q31_t *state = biquad->pState;
+    uint32_t shift = 31 - biquad->PostShift;
+    int64_t round = 1LL << (shift - 1);
+
+    for (uint32_t stage = 0; stage < biquad->NumStages; stage++)
+    {
+        int32_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+        int32_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+        const q31_t *src = pSrc;
+        q31_t *dst = pDst;
+
+        for (uint32_t n = 0; n < BlockSize; n++)
+        {
+            int32_t x = *src++;
+            int64_t acc = round + (int64_t)b0 * x + (int64_t)b1 * x1 + (int64_t)b2 * x2
+                - (int64_t)a1 * y1 - (int64_t)a2 * y2;
+            int32_t y = HAL_DSP_Sat31(acc >> shift);
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            *dst++ = y;
+        }
+
+        state[0] = x1;
+        state[1] = x2;
+        state[2] = y1;
+        state[3] = y2;
+
+        coeffs += DSP_BIQUAD_COEFFS;
+        state += DSP_BIQUAD_STATE;
+        pSrc = pDst;
+    }
+}
+
+/**
+ * @brief Инициализировать фильтр удаления постоянной составляющей.
+ * @param dc Указатель на структуру фильтра.
+ * @param R Коэффициент полюса в формате Q15, больше 0.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_DCBlock_Q15_Init(DSP_DCBlock_Q15_TypeDef *dc, q15_t R)
+{
+    if ((dc == NULL) || (R <= 0))
+    {
+        return HAL_ERROR;
+    }
+
+    dc->R = R;
+    dc->X1 = 0;
+    dc->Acc = 0;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Обработать блок отсчетов фильтром удаления постоянной составляющей.
+ * @param dc Указатель на структуру фильтра.
+ * @param pSrc Входные отсчеты.
+ * @param pDst Выходные отсчеты. Может совпадать с pSrc.
+ * @param BlockSize Количество отсчетов.
+ */
+void HAL_DSP_DCBlock_Q15(DSP_DCBlock_Q15_TypeDef *dc, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize)
+{
+    int32_t r = dc->R;
+    int32_t x1 = dc->X1;
+    int32_t acc = dc->Acc;
+
+    while (BlockSize-- != 0)
+    {
+        int32_t x = *pSrc++;
+
+        acc = ((x - x1) << 14) + (int32_t)(((int64_t)r * acc) >> 15);
+        x1 = x;
+        *pDst++ = HAL_DSP_Sat15((acc + (1 << 13)) >> 14);
+    }
+
+    dc->X1 = (q15_t)x1;
+    dc->Acc = acc;
+}
+
+/**
+ * @brief Инициализировать скользящее СКЗ.
+ * @param rms Указатель на структуру СКЗ.
+ * @param pWindow Буфер окна размером 2^Log2Length отсчетов. Обнуляется.
+ * @param Log2Length log2 длины окна, не больше #DSP_RMS_MAX_LOG2_LENGTH.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_DSP_RMS_Q15_Init(DSP_RMS_Q15_TypeDef *rms, q15_t *pWindow, uint8_t Log2Length)
+{
+    if ((rms == NULL) || (pWindow == NULL) || (Log2Length > DSP_RMS_MAX_LOG2_LENGTH))
+    {
+        return HAL_ERROR;
+    }
+
+    rms->pWindow = pWindow;
+    rms->Log2Length = Log2Length;
+    rms->Index = 0;
+    rms->SumSquares = 0;
+
+    for (uint32_t i = 0; i < (1UL << Log2Length); i++)
+    {
+        pWindow[i] = 0;
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Обработать блок отсчетов скользящим СКЗ.
+ * @param rms Указатель на структуру СКЗ.
+ * @param pSrc Входные отсчеты.
+ * @param pDst СКЗ после каждого отсчета. NULL - корень извлекается только для последнего отсчета блока.
+ * @param BlockSize Количество отсчетов.
+ * @return СКЗ окна после последнего отсчета блока в формате Q15.
+ */
+q15_t HAL_DSP_RMS_Q15(DSP_RMS_Q15_TypeDef *rms, const q15_t *pSrc, q15_t *pDst, uint32_t BlockSize)
+{
+    uint32_t mask = (1UL << rms->Log2Length) - 1;
+    uint32_t index = rms->Index;
+    uint64_t sum = rms->SumSquares;
+    q15_t *window = rms->pWindow;
+
+    while (BlockSize-- != 0)
+    {
+        int32_t x = *pSrc++;
+        int32_t old = window[index];
+
+        window[index] = (q15_t)x;
+        index = (index + 1) & mask;
+        /* Оба квадрата не больше 2^30, разность помещается в int32_t */
+        sum += (int64_t)(x * x - old * old);
+
+        if (pDst != NULL)
+        {
+            *pDst++ = HAL_DSP_Sat15(HAL_Sqrt((uint32_t)(sum >> rms->Log2Length)));
+        }
+    }
+
+    rms->Index = index;
+    rms->SumSquares = sum;
+
+    return HAL_DSP_Sat15(HAL_Sqrt((uint32_t)(sum >> rms->Log2Length)));
+}
@@ -0,0 +1,331 @@
+#include "mik32_hal_fft.h"
+
+
+const q15_t HAL_FFT_SinTable[FFT_TABLE_LENGTH] =
+{
+    0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+    3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+    6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+    9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+    12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+    15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+    18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+    20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+    23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+    25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+    27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+    28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+    30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+    31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+    32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+    32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+    32767, 32766, 32765, 32761, 32757, 32752, 32745, 32737, 32728, 32717, 32705, 32692, 32678, 32663, 32646, 32628,
+    32609, 32589, 32567, 32545, 32521, 32495, 32469, 32441, 32412, 32382, 32351, 32318, 32285, 32250, 32213, 32176,
+    32137, 32098, 32057, 32014, 31971, 31926, 31880, 31833, 31785, 31736, 31685, 31633, 31580, 31526, 31470, 31414,
+    31356, 31297, 31237, 31176, 31113, 31050, 30985, 30919, 30852, 30783, 30714, 30643, 30571, 30498, 30424, 30349,
+    30273, 30195, 30117, 30037, 29956, 29874, 29791, 29706, 29621, 29534, 29447, 29358, 29268, 29177, 29085, 28992,
+    28898, 28803, 28706, 28609, 28510, 28411, 28310, 28208, 28105, 28001, 27896, 27790, 27683, 27575, 27466, 27356,
+    27245, 27133, 27019, 26905, 26790, 26674, 26556, 26438, 26319, 26198, 26077, 25955, 25832, 25708, 25582, 25456,
+    25329, 25201, 25072, 24942, 24811, 24680, 24547, 24413, 24279, 24143, 24007, 23870, 23731, 23592, 23452, 23311,
+    23170, 23027, 22884, 22739, 22594, 22448, 22301, 22154, 22005, 21856, 21705, 21554, 21403, 21250, 21096, 20942,
+    20787, 20631, 20475, 20317, 20159, 20000, 19841, 19680, 19519, 19357, 19195, 19032, 18868, 18703, 18537, 18371,
+    18204, 18037, 17869, 17700, 17530, 17360, 17189, 17018, 16846, 16673, 16499, 16325, 16151, 15976, 15800, 15623,
+    15446, 15269, 15090, 14912, 14732, 14553, 14372, 14191, 14010, 13828, 13645, 13462, 13279, 13094, 12910, 12725,
+    12539, 12353, 12167, 11980, 11793, 11605, 11417, 11228, 11039, 10849, 10659, 10469, 10278, 10087, 9896, 9704,
+    9512, 9319, 9126, 8933, 8739, 8545, 8351, 8157, 7962, 7767, 7571, 7375, 7179, 6983, 6786, 6590,
+    6393, 6195, 5998, 5800, 5602, 5404, 5205, 5007, 4808, 4609, 4410, 4210, 4011, 3811, 3612, 3412,
+    3212, 3012, 2811, 2611, 2410, 2210, 2009, 1809, 1608, 1407, 1206, 1005, 804, 603, 402, 201,
+    0, -201, -402, -603, -804, -1005, -1206, -1407, -1608, -1809, -2009, -2210, -2410, -2611, -2811, -3012,
+    -3212, -3412, -3612, -3811, -4011, -4210, -4410, -4609, -4808, -5007, -5205, -5404, -5602, -5800, -5998, -6195,
+    -6393, -6590, -6786, -6983, -7179, -7375, -7571, -7767, -7962, -8157, -8351, -8545, -8739, -8933, -9126, -9319,
+    -9512, -9704, -9896, -10087, -10278, -10469, -10659, -10849, -11039, -11228, -11417, -11605, -11793, -11980, -12167, -12353,
+    -12539, -12725, -12910, -13094, -13279, -13462, -13645, -13828, -14010, -14191, -14372, -14553, -14732, -14912, -15090, -15269,
+    -15446, -15623, -15800, -15976, -16151, -16325, -16499, -16673, -16846, -17018, -17189, -17360, -17530, -17700, -17869, -18037,
+    -18204, -18371, -18537, -18703, -18868, -19032, -19195, -19357, -19519, -19680, -19841, -20000, -20159, -20317, -20475, -20631,
+    -20787, -20942, -21096, -21250, -21403, -21554, -21705, -21856, -22005, -22154, -22301, -22448, -22594, -22739, -22884, -23027,
+    -23170, -23311, -23452, -23592, -23731, -23870, -24007, -24143, -24279, -24413, -24547, -24680, -24811, -24942, -25072, -25201,
+    -25329, -25456, -25582, -25708, -25832, -25955, -26077, -26198, -26319, -26438, -26556, -26674, -26790, -26905, -27019, -27133,
+    -27245, -27356, -27466, -27575, -27683, -27790, -27896, -28001, -28105, -28208, -28310, -28411, -28510, -28609, -28706, -28803,
+    -28898, -28992, -29085, -29177, -29268, -29358, -29447, -29534, -29621, -29706, -29791, -29874, -29956, -30037, -30117, -30195,
+    -30273, -30349, -30424, -30498, -30571, -30643, -30714, -30783, -30852, -30919, -30985, -31050, -31113, -31176, -31237, -31297,
+    -31356, -31414, -31470, -31526, -31580, -31633, -31685, -31736, -31785, -31833, -31880, -31926, -31971, -32014, -32057, -32098,
+    -32137, -32176, -32213, -32250, -32285, -32318, -32351, -32382, -32412, -32441, -32469, -32495, -32521, -32545, -32567, -32589,
+    -32609, -32628, -32646, -32663, -32678, -32692, -32705, -32717, -32728, -32737, -32745, -32752, -32757, -32761, -32765, -32766,
+    -32767, -32766, -32765, -32761, -32757, -32752, -32745, -32737, -32728, -32717, -32705, -32692, -32678, -32663, -32646, -32628,
+    -32609, -32589, -32567, -32545, -32521, -32495, -32469, -32441, -32412, -32382, -32351, -32318, -32285, -32250, -32213, -32176,
+    -32137, -32098, -32057, -32014, -31971, -31926, -31880, -31833, -31785, -31736, -31685, -31633, -31580, -31526, -31470, -31414,
+    -31356, -31297, -31237, -31176, -31113, -31050, -30985, -30919, -30852, -30783, -30714, -30643, -30571, -30498, -30424, -30349,
+    -30273, -30195, -30117, -30037, -29956, -29874, -29791, -29706, -29621, -29534, -29447, -29358, -29268, -29177, -29085, -28992,
+    -28898, -28803, -28706, -28609, -28510, -28411, -28310, -28208, -28105, -28001, -27896, -27790, -27683, -27575, -27466, -27356,
+    -27245, -27133, -27019, -26905, -26790, -26674, -26556, -26438, -26319, -26198, -26077, -25955, -25832, -25708, -25582, -25456,
+    -25329, -25201, -25072, -24942, -24811, -24680, -24547, -24413, -24279, -24143, -24007, -23870, -23731, -23592, -23452, -23311,
+    -23170, -23027, -22884, -22739, -22594, -22448, -22301, -22154, -22005, -21856, -21705, -21554, -21403, -21250, -21096, -20942,
+    -20787, -20631, -20475, -20317, -20159, -20000, -19841, -19680, -19519, -19357, -19195, -19032, -18868, -18703, -18537, -18371,
+    -18204, -18037, -17869, -17700, -17530, -17360, -17189, -17018, -16846, -16673, -16499, -16325, -16151, -15976, -15800, -15623,
+    -15446, -15269, -15090, -14912, -14732, -14553, -14372, -14191, -14010, -13828, -13645, -13462, -13279, -13094, -12910, -12725,
+    -12539, -12353, -12167, -11980, -11793, -11605, -11417, -11228, -11039, -10849, -10659, -10469, -10278, -10087, -9896, -9704,
+    -9512, -9319, -9126, -8933, -8739, -8545, -8351, -8157, -7962, -7767, -7571, -7375, -7179, -6983, -6786, -6590,
+    -6393, -6195, -5998, -5800, -5602, -5404, -5205, -5007, -4808, -4609, -4410, -4210, -4011, -3811, -3612, -3412,
+    -3212, -3012, -2811, -2611, -2410, -2210, -2009, -1809, -1608, -1407, -1206, -1005, -804, -603, -402, -201,
+    0
+};
+
+
+/**
+ * @brief Инициализировать быстрое преобразование Фурье.
+ * @param hfft Указатель на структуру преобразования.
+ * @param Length Количество точек, степень двойки от #FFT_MIN_LENGTH до #FFT_MAX_LENGTH.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_FFT_Init(FFT_HandleTypeDef *hfft, uint16_t Length)
+{
+    uint8_t log2 = 0;
+
+    if ((hfft == NULL) || (Length < FFT_MIN_LENGTH) || (Length > FFT_MAX_LENGTH) || ((Length & (Length - 1)) != 0))
+    {
+        return HAL_ERROR;
+    }
+
+    while ((1UL << log2) < Length)
+    {
+        log2++;
+    }
+
+    hfft->Length = Length;
+    hfft->Log2Length = log2;
+    hfft->TableStride = FFT_MAX_LENGTH / Length;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Заполнить буфер преобразования отсчетами АЦП.
+ *
+ * Отсчеты преобразуются как в @ref HAL_DSP_ADC_ToQ15, умножаются на окно и записываются в действительные
+ * части, мнимые части обнуляются. Окно Ханна w[n] = (1 - cos(2 * pi * n / Length)) / 2 рассчитывается
+ * по таблице синусов с учетом симметрии w[n] = w[Length - n].
+ * @param hfft Указатель на структуру преобразования.
+ * @param pSrc Отсчеты АЦП, Length отсчетов с шагом Stride. Например, блок @ref HAL_ADC_Sampler_Read.
+ * @param Stride Шаг между входными отсчетами, равен количеству каналов сканирования.
+ * @param Offset Код АЦП, соответствующий нулю.
+ * @param Shift Сдвиг влево, не больше 15.
+ * @param Window Окно, #FFT_WINDOW_NONE или #FFT_WINDOW_HANN.
+ * @param pBuffer Буфер преобразования из Length комплексных отсчетов.
+ */
+void HAL_FFT_LoadADC(FFT_HandleTypeDef *hfft, const uint16_t *pSrc, uint32_t Stride, uint16_t Offset, uint8_t Shift, uint8_t Window, q15_t *pBuffer)
+{
+    uint32_t length = hfft->Length;
+
+    for (uint32_t n = 0; n < length; n++)
+    {
+        int32_t x = HAL_DSP_Sat15(((int32_t)*pSrc - Offset) << Shift);
+
+        if (Window == FFT_WINDOW_HANN)
+        {
+            uint32_t m = ((n <= length / 2) ? n : (length - n)) * hfft->TableStride;
+            int32_t w = (DSP_Q15_MAX - HAL_FFT_SinTable[m + FFT_MAX_LENGTH / 4] + 1) >> 1;
+
+            x = (x * w + (1 << 14)) >> 15;
+        }
+
+        pBuffer[2 * n] = (q15_t)x;
+        pBuffer[2 * n + 1] = 0;
+        pSrc += Stride;
+    }
+}
+
+/**
+ * @brief Умножить комплексный отсчет на поворачивающий множитель exp(-2 * pi * i * m / 1024).
+ * @param p Комплексный отсчет {re, im} для записи результата.
+ * @param re Действительная часть множимого.
+ * @param im Мнимая часть множимого.
+ * @param m Индекс множителя в таблице синусов, не больше 3 * #FFT_MAX_LENGTH / 4.
+ */
+static inline __attribute__((always_inline)) void HAL_FFT_Rotate(q15_t *p, int32_t re, int32_t im, uint32_t m)
+{
+    int32_t c = HAL_FFT_SinTable[m + FFT_MAX_LENGTH / 4];
+    int32_t s = HAL_FFT_SinTable[m];
+
+    p[0] = HAL_DSP_Sat15((re * c + im * s + (1 << 14)) >> 15);
+    p[1] = HAL_DSP_Sat15((im * c - re * s + (1 << 14)) >> 15);
+}
+
+/**
+ * @brief Выполнить прямое преобразование Фурье на месте.
+ *
+ * Бабочки radix-4 сгруппированы по поворачивающим множителям: три множителя загружаются из таблицы один
+ * раз для всех бабочек этапа с одинаковым смещением, при нулевом смещении умножения не выполняются.
+ * @param hfft Указатель на структуру преобразования.
+ * @param pBuffer Буфер из Length комплексных отсчетов. Содержит X[k] / Length в естественном порядке.
+ */
+void HAL_FFT_Forward(FFT_HandleTypeDef *hfft, q15_t *pBuffer)
+{
+    uint32_t length = hfft->Length;
+    uint32_t stride = hfft->TableStride;
+    uint32_t span;
+
+    for (span = length; span >= 4; span >>= 2, stride <<= 2)
+    {
+        uint32_t quarter = span >> 2;
+
+        for (uint32_t j = 0; j < quarter; j++)
+        {
+            uint32_t m = j * stride;
+
+            for (uint32_t base = j; base < length; base += span)
+            {
+                q15_t *p0 = &pBuffer[2 * base];
+                q15_t *p1 = p0 + 2 * quarter;
+                q15_t *p2 = p1 + 2 * quarter;
+                q15_t *p3 = p2 + 2 * quarter;
+
+                int32_t s02r = (int32_t)p0[0] + p2[0];
+                int32_t s02i = (int32_t)p0[1] + p2[1];
+                int32_t d02r = (int32_t)p0[0] - p2[0];
+                int32_t d02i = (int32_t)p0[1] - p2[1];
+                int32_t s13r = (int32_t)p1[0] + p3[0];
+                int32_t s13i = (int32_t)p1[1] + p3[1];
+                int32_t d13r = (int32_t)p1[0] - p3[0];
+                int32_t d13i = (int32_t)p1[1] - p3[1];
+
+                /* Два этапа radix-2 с делением на 2 на каждом. Округление может дать +1 (32768), если среди
+                 * отсчетов есть -1, поэтому результат насыщается */
+                int32_t y1r = HAL_DSP_Sat15((s02r - s13r + 2) >> 2);
+                int32_t y1i = HAL_DSP_Sat15((s02i - s13i + 2) >> 2);
+                int32_t y2r = HAL_DSP_Sat15((d02r + d13i + 2) >> 2);
+                int32_t y2i = HAL_DSP_Sat15((d02i - d13r + 2) >> 2);
+                int32_t y3r = HAL_DSP_Sat15((d02r - d13i + 2) >> 2);
+                int32_t y3i = HAL_DSP_Sat15((d02i + d13r + 2) >> 2);
+
+                p0[0] = HAL_DSP_Sat15((s02r + s13r + 2) >> 2);
+                p0[1] = HAL_DSP_Sat15((s02i + s13i + 2) >> 2);
+
+                if (m == 0)
+                {
+                    p1[0] = (q15_t)y1r;
+                    p1[1] = (q15_t)y1i;
+                    p2[0] = (q15_t)y2r;
+                    p2[1] = (q15_t)y2i;
+                    p3[0] = (q15_t)y3r;
+                    p3[1] = (q15_t)y3i;
+                }
+                else
+                {
+                    HAL_FFT_Rotate(p1, y1r, y1i, 2 * m);
+                    HAL_FFT_Rotate(p2, y2r, y2i, m);
+                    HAL_FFT_Rotate(p3, y3r, y3i, 3 * m);
+                }
+            }
+        }
+    }
+
+    if (span == 2)
+    {
+        for (uint32_t n = 0; n < 2 * length; n += 4)
+        {
+            int32_t ar = pBuffer[n], ai = pBuffer[n + 1];
+            int32_t br = pBuffer[n + 2], bi = pBuffer[n + 3];
+
+            pBuffer[n] = HAL_DSP_Sat15((ar + br + 1) >> 1);
+            pBuffer[n + 1] = HAL_DSP_Sat15((ai + bi + 1) >> 1);
+            pBuffer[n + 2] = HAL_DSP_Sat15((ar - br + 1) >> 1);
+            pBuffer[n + 3] = HAL_DSP_Sat15((ai - bi + 1) >> 1);
+        }
+    }
+
+    /* Двоично-инверсная перестановка, обратный индекс j увеличивается с переносом от старшего разряда */
+    for (uint32_t i = 0, j = 0; i < length; i++)
+    {
+        if (i < j)
+        {
+            q15_t re = pBuffer[2 * i];
+            q15_t im = pBuffer[2 * i + 1];
+
+            pBuffer[2 * i] = pBuffer[2 * j];
+            pBuffer[2 * i + 1] = pBuffer[2 * j + 1];
+            pBuffer[2 * j] = re;
+            pBuffer[2 * j + 1] = im;
+        }
+
+        uint32_t bit = length >> 1;
+        while ((bit != 0) && ((j & bit) != 0))
+        {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+}
+
+/**
+ * @brief Рассчитать квадраты модулей бинов.
+ * @param pBuffer Результат @ref HAL_FFT_Forward.
+ * @param pDst Квадраты модулей в формате Q30.
+ * @param Bins Количество бинов, обычно Length / 2 для вещественного входа.
+ */
+void HAL_FFT_MagnitudeSquared(const q15_t *pBuffer, uint32_t *pDst, uint32_t Bins)
+{
+    while (Bins-- != 0)
+    {
+        int32_t re = pBuffer[0];
+        int32_t im = pBuffer[1];
+
+        *pDst++ = (uint32_t)(re * re) + (uint32_t)(im * im);
+        pBuffer += 2;
+    }
+}
+
+/**
+ * @brief Рассчитать модули бинов.
+ * @param pBuffer Результат @ref HAL_FFT_Forward.
+ * @param pDst Модули в формате Q15. Может совпадать с pBuffer.
+ * @param Bins Количество бинов, обычно Length / 2 для вещественного входа.
+ */
+void HAL_FFT_Magnitude(const q15_t *pBuffer, q15_t *pDst, uint32_t Bins)
+{
+    while (Bins-- != 0)
+    {
+        int32_t re = pBuffer[0];
+        int32_t im = pBuffer[1];
+
+        *pDst++ = HAL_DSP_Sat15(HAL_Sqrt((uint32_t)(re * re) + (uint32_t)(im * im)));
+        pBuffer += 2;
+    }
+}
+
+/**
+ * @brief Найти бин с наибольшим модулем.
+ *
+ * Сравниваются квадраты модулей, корень не извлекается. Для вещественного входа обычно FirstBin = 1
+ * (без постоянной составляющей) и LastBin = Length / 2 - 1.
+ * @param pBuffer Результат @ref HAL_FFT_Forward.
+ * @param FirstBin Первый бин поиска.
+ * @param LastBin Последний бин поиска включительно, не меньше FirstBin.
+ * @param pMagnitudeSquared Квадрат модуля найденного бина в формате Q30. NULL - не сохраняется.
+ * @return Номер бина. При равных модулях - наименьший.
+ */
+uint32_t HAL_FFT_PeakBin(const q15_t *pBuffer, uint32_t FirstBin, uint32_t LastBin, uint32_t *pMagnitudeSquared)
+{
+    uint32_t peak = FirstBin;
+    uint32_t peak_value = 0;
+
+    for (uint32_t bin = FirstBin; bin <= LastBin; bin++)
+    {
+        int32_t re = pBuffer[2 * bin];
+        int32_t im = pBuffer[2 * bin + 1];
+        uint32_t value = (uint32_t)(re * re) + (uint32_t)(im * im);
+
+        if ((value > peak_value) || (bin == FirstBin))
+        {
+            peak = bin;
+            peak_value = value;
+        }
+    }
+
+    if (pMagnitudeSquared != NULL)
+    {
+        *pMagnitudeSquared = peak_value;
+    }
+
+    return peak;
+}
@@ -23,11 +23,74 @@
     #define LSI_VALUE ((uint32_t)32768U) // Значение частоты часового внутреннего источника по умолчанию.
 #endif
 
+#ifndef HAL_PROGRAM_DELAY_NOMINAL_CYCLES
+    #define HAL_PROGRAM_DELAY_NOMINAL_CYCLES    3   // Тактов ядра на итерацию цикла задержки до калибровки.
+#endif
+
+/**
+ * @brief Коэффициенты программной задержки, рассчитанные @ref HAL_ProgramDelay_Calibrate.
+ */
+typedef struct __HAL_ProgramDelay_CalibrationTypeDef
+{
+    uint32_t Key;               /**< Настройка тактирования, для которой рассчитаны коэффициенты. */
+    uint32_t CoreFreq;          /**< Частота ядра, Гц. */
+    uint32_t CyclesPerIterQ16;  /**< Тактов ядра на итерацию цикла задержки, Q16. 0 - коэффициенты не рассчитывались. */
+    uint32_t OverheadCycles;    /**< Накладные расходы вызова функции задержки, такты ядра. */
+    uint32_t IterPerUsQ16;      /**< Итераций на микросекунду, Q16. */
+    uint32_t OverheadIterQ16;   /**< Накладные расходы в итерациях, Q16. */
+    uint32_t IterPerCycleQ16;   /**< Итераций на такт ядра, Q16. */
+} HAL_ProgramDelay_CalibrationTypeDef;
+
+/**
+ * Задержка на @p __N__ тактов ядра инструкциями nop.
+ * Значение @p __N__ - константа времени компиляции. Задержка точна до такта при выполнении из ОЗУ
+ * и используется для формирования коротких интервалов при программной реализации интерфейсов.
+ */
+#define HAL_PROGRAM_DELAY_NOPS(__N__)   __asm__ volatile (".rept %0\n\tnop\n\t.endr" : : "i" (__N__))
+
+/**
+ * @brief Целочисленный квадратный корень.
+ *
+ * Поразрядный алгоритм: 16 итераций сравнения и вычитания без умножений и делений.
+ * Используется генератором шагов и библиотекой dsp.
+ * @param x Подкоренное значение.
+ * @return floor(sqrt(x)).
+ */
+static inline uint16_t HAL_Sqrt(uint32_t x)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (x >= result + bit)
+        {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint16_t)result;
+}
+
 void HAL_MspInit();
 HAL_StatusTypeDef HAL_Init();
 /* Функции программных задержек */
 void HAL_ProgramDelayMs(uint32_t time_ms);
 void HAL_ProgramDelayUs(uint32_t time_us);
+void HAL_ProgramDelayCycles(uint32_t cycles);
+void HAL_ProgramDelay_Calibrate();
+const HAL_ProgramDelay_CalibrationTypeDef *HAL_ProgramDelay_GetCalibration();
 /* Переопределяемые функции времени */
 uint32_t HAL_Micros();
 uint32_t HAL_Millis();
@@ -0,0 +1,465 @@
+#ifndef MIK32_HAL_ADC_SAMPLER
+#define MIK32_HAL_ADC_SAMPLER
+
+#include "stddef.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal_adc.h"
+#include "mik32_hal_irq.h"
+#include "mik32_hal_timer16.h"
+#include "mik32_hal_timer32.h"
+
+
+/* Title: Запуск АЦП по таймеру */
+
+/*
+ * Преобразования АЦП запускаются в прерывании таймера с постоянным периодом. Обработчик первым действием
+ * читает ADC_VALUE предыдущего преобразования и записывает ADC_SINGLE, поэтому момент выборки отстает от
+ * события таймера на постоянную задержку входа в прерывание и не зависит от опроса <HAL_ADC_WaitValid>.
+ * Результат каждого преобразования читается на следующем событии таймера, период таймера должен превышать
+ * время преобразования АЦП.
+ *
+ * Результаты записываются в кольцевой буфер и читаются функцией <HAL_ADC_Sampler_Read>. При передискретизации
+ * в буфер записываются только выходные отсчеты фильтра децимации.
+ *
+ * Сторож сравнивает каждый результат с порогами канала в том же прерывании, поэтому защита срабатывает
+ * не позже чем через период таймера после окончания преобразования и не требует опроса.
+ *
+ * Если задан список каналов, АЦП перебирает каналы по кругу и результаты записываются в буфер с чередованием
+ * в порядке списка. Слова ADC_CONFIG для каждого шага списка рассчитываются при запуске, переключение канала
+ * в прерывании - одна запись регистра. Как и в <HAL_ADC_SINGLE_AND_SET_CH>, выбранный канал применяется
+ * к следующему запуску, поэтому канал успевает установиться за период таймера и холостые преобразования
+ * не нужны. Время выборки SAH_TIME применяется к запускаемому преобразованию и записывается вместе
+ * с выбором следующего канала.
+ */
+
+/*
+ * Defines: Фильтр децимации
+ *
+ * Каждые Oversample результатов канала заменяются одним выходным отсчетом. Значение равно порядку фильтра.
+ *
+ * ADC_SAMPLER_FILTER_NONE - Без децимации
+ * ADC_SAMPLER_FILTER_BOXCAR - Сумма Oversample результатов, усиление Oversample
+ * ADC_SAMPLER_FILTER_CIC2 - CIC-фильтр второго порядка, усиление Oversample^2
+ * ADC_SAMPLER_FILTER_CIC3 - CIC-фильтр третьего порядка, усиление Oversample^3
+ *
+ */
+#define ADC_SAMPLER_FILTER_NONE 0   /* Без децимации */
+#define ADC_SAMPLER_FILTER_BOXCAR 1 /* Сумма Oversample результатов */
+#define ADC_SAMPLER_FILTER_CIC2 2   /* CIC-фильтр второго порядка */
+#define ADC_SAMPLER_FILTER_CIC3 3   /* CIC-фильтр третьего порядка */
+
+/*
+ * Define: ADC_SAMPLER_MAX_CHANNELS
+ * Наибольшая длина списка каналов. Канал может входить в список несколько раз.
+ */
+#define ADC_SAMPLER_MAX_CHANNELS 16
+
+/*
+ * Define: ADC_SAMPLER_WATCHDOG_CHANNELS
+ * Количество каналов АЦП со сторожем.
+ */
+#define ADC_SAMPLER_WATCHDOG_CHANNELS 8
+
+/*
+ * Defines: Зоны сторожа
+ *
+ * ADC_SAMPLER_WATCHDOG_NORMAL - Результат между порогами
+ * ADC_SAMPLER_WATCHDOG_LOW - Результат ниже порога Low
+ * ADC_SAMPLER_WATCHDOG_HIGH - Результат выше порога High
+ *
+ */
+#define ADC_SAMPLER_WATCHDOG_NORMAL 0 /* Результат между порогами */
+#define ADC_SAMPLER_WATCHDOG_LOW 1    /* Результат ниже порога Low */
+#define ADC_SAMPLER_WATCHDOG_HIGH 2   /* Результат выше порога High */
+
+struct __ADC_Sampler_HandleTypeDef;
+
+/*
+ * Type: HAL_ADC_Sampler_CallbackTypeDef
+ * Функция обратного вызова, вызываемая из <HAL_ADC_Sampler_IRQHandler> после записи каждых BlockSize результатов.
+ */
+typedef void (*HAL_ADC_Sampler_CallbackTypeDef)(struct __ADC_Sampler_HandleTypeDef *hsampler);
+
+/*
+ * Type: HAL_ADC_Sampler_WatchdogCallbackTypeDef
+ * Функция обратного вызова сторожа, вызываемая из <HAL_ADC_Sampler_IRQHandler> при смене зоны канала.
+ *
+ * Вызывается в том же прерывании, в котором прочитан результат, до записи результата в буфер.
+ * Параметры: канал АЦП, новая зона <ADC_SAMPLER_WATCHDOG_NORMAL>..<ADC_SAMPLER_WATCHDOG_HIGH> и результат.
+ */
+typedef void (*HAL_ADC_Sampler_WatchdogCallbackTypeDef)(struct __ADC_Sampler_HandleTypeDef *hsampler, uint8_t channel,
+                                                        uint8_t zone, uint16_t value);
+
+/* Title: Структуры */
+
+/*
+ * Struct: ADC_Sampler_WatchdogTypeDef
+ * Пороги сторожа канала АЦП
+ *
+ * Зона HIGH наступает при результате больше High и сменяется на NORMAL при результате меньше High - Hysteresis.
+ * Зона LOW наступает при результате меньше Low и сменяется на NORMAL при результате больше Low + Hysteresis.
+ * Результат сравнивается до фильтра децимации. Пороги задаются функцией <HAL_ADC_Sampler_WatchdogSet>.
+ */
+typedef struct __ADC_Sampler_WatchdogTypeDef
+{
+    /*
+     * Variable: Low
+     * Нижний порог.
+     *
+     */
+    uint16_t Low;
+
+    /*
+     * Variable: High
+     * Верхний порог.
+     *
+     */
+    uint16_t High;
+
+    /*
+     * Variable: Hysteresis
+     * Гистерезис возврата в зону NORMAL.
+     *
+     */
+    uint16_t Hysteresis;
+
+    /*
+     * Variable: Zone
+     * Текущая зона канала.
+     *
+     */
+    volatile uint8_t Zone;
+
+} ADC_Sampler_WatchdogTypeDef;
+
+/*
+ * Struct: ADC_Sampler_HandleTypeDef
+ * Настройки и состояние запуска АЦП по таймеру
+ */
+typedef struct __ADC_Sampler_HandleTypeDef
+{
+    /*
+     * Variable: hadc
+     * АЦП, проинициализированный <HAL_ADC_Init>. Непрерывный режим выключается при запуске.
+     *
+     */
+    ADC_HandleTypeDef *hadc;
+
+    /*
+     * Variable: htimer32
+     * Таймер Timer32, проинициализированный HAL_Timer32_Init. NULL - используется htimer16.
+     *
+     * Поле Top задается в <HAL_ADC_Sampler_Start>.
+     *
+     */
+    TIMER32_HandleTypeDef *htimer32;
+
+    /*
+     * Variable: htimer16
+     * Таймер Timer16, проинициализированный HAL_Timer16_Init. Используется, если htimer32 равен NULL.
+     *
+     */
+    Timer16_HandleTypeDef *htimer16;
+
+    /*
+     * Variable: Period
+     * Период выборки в тактах таймера. Для Timer16 - не больше 65536.
+     *
+     */
+    uint32_t Period;
+
+    /*
+     * Variable: Channels
+     * Список каналов <ADC_CHANNEL0>..<ADC_CHANNEL7>. Выводы каналов переводятся в аналоговый режим при запуске.
+     *
+     */
+    const uint8_t *Channels;
+
+    /*
+     * Variable: SahTimes
+     * Время выборки для каждого элемента списка в формате <HAL_ADC_SAH_TIMESet>. NULL - текущее значение <HAL_ADC_SAH_TIMEGet>.
+     *
+     */
+    const uint8_t *SahTimes;
+
+    /*
+     * Variable: ChannelCount
+     * Длина списка каналов, не больше <ADC_SAMPLER_MAX_CHANNELS>. 0 - канал hadc->Init.Sel без переключения.
+     *
+     */
+    uint32_t ChannelCount;
+
+    /*
+     * Variable: Filter
+     * Фильтр децимации <ADC_SAMPLER_FILTER_NONE>..<ADC_SAMPLER_FILTER_CIC3>.
+     *
+     */
+    uint8_t Filter;
+
+    /*
+     * Variable: Oversample
+     * Коэффициент децимации: количество результатов канала на один выходной отсчет. Не меньше 2.
+     *
+     * Усиление фильтра Oversample^порядок должно помещаться в 20 бит, чтобы выход не превышал 32 бит.
+     * Первые Filter - 1 выходных отсчетов CIC-фильтра содержат переходный процесс.
+     *
+     */
+    uint32_t Oversample;
+
+    /*
+     * Variable: Shift
+     * Сдвиг выходного отсчета фильтра вправо. Результат ограничивается значением 0xFFFF.
+     *
+     * Например, Oversample = 16 и Shift = 2 с фильтром <ADC_SAMPLER_FILTER_BOXCAR> дают 14-битный результат.
+     *
+     */
+    uint8_t Shift;
+
+    /*
+     * Variable: Buffer
+     * Кольцевой буфер результатов.
+     *
+     */
+    uint16_t *Buffer;
+
+    /*
+     * Variable: Size
+     * Размер буфера в отсчетах. При сканировании кратен ChannelCount.
+     *
+     */
+    uint32_t Size;
+
+    /*
+     * Variable: BlockSize
+     * Количество записанных в буфер отсчетов между вызовами BlockCallback.
+     *
+     */
+    uint32_t BlockSize;
+
+    /*
+     * Variable: BlockCallback
+     * Функция обратного вызова. NULL - не вызывается.
+     *
+     */
+    HAL_ADC_Sampler_CallbackTypeDef BlockCallback;
+
+    /*
+     * Variable: WatchdogCallback
+     * Функция обратного вызова сторожа. NULL - зоны отслеживаются без вызова.
+     *
+     */
+    HAL_ADC_Sampler_WatchdogCallbackTypeDef WatchdogCallback;
+
+    /*
+     * Variable: Watchdog
+     * Пороги и зоны сторожа по номерам каналов АЦП.
+     *
+     */
+    ADC_Sampler_WatchdogTypeDef Watchdog[ADC_SAMPLER_WATCHDOG_CHANNELS];
+
+    /*
+     * Variable: WatchdogMask
+     * Служебное поле: маска каналов с включенным сторожем.
+     *
+     */
+    volatile uint32_t WatchdogMask;
+
+    /*
+     * Variable: WriteCount
+     * Служебное поле: количество записанных результатов.
+     *
+     */
+    volatile uint32_t WriteCount;
+
+    /*
+     * Variable: WriteIndex
+     * Служебное поле: индекс следующего записываемого отсчета буфера.
+     *
+     */
+    uint32_t WriteIndex;
+
+    /*
+     * Variable: ReadCount
+     * Служебное поле: количество прочитанных и пропущенных результатов.
+     *
+     */
+    uint32_t ReadCount;
+
+    /*
+     * Variable: ReadIndex
+     * Служебное поле: индекс следующего читаемого отсчета буфера.
+     *
+     */
+    uint32_t ReadIndex;
+
+    /*
+     * Variable: Overruns
+     * Количество результатов, перезаписанных до чтения.
+     *
+     */
+    uint32_t Overruns;
+
+    /*
+     * Variable: BlockCount
+     * Служебное поле: количество результатов с последнего вызова BlockCallback.
+     *
+     */
+    uint32_t BlockCount;
+
+    /*
+     * Variable: ConfigWords
+     * Служебное поле: слова ADC_CONFIG шагов списка каналов.
+     *
+     */
+    uint32_t ConfigWords[ADC_SAMPLER_MAX_CHANNELS];
+
+    /*
+     * Variable: ScanIndex
+     * Служебное поле: шаг списка, слово которого записывается на следующем событии таймера.
+     *
+     */
+    uint32_t ScanIndex;
+
+    /*
+     * Variable: ResultIndex
+     * Служебное поле: шаг списка каналов, к которому относится следующий результат.
+     *
+     */
+    uint32_t ResultIndex;
+
+    /*
+     * Variable: Phase
+     * Служебное поле: номер кадра в окне децимации.
+     *
+     */
+    uint32_t Phase;
+
+    /*
+     * Variable: Integrator
+     * Служебное поле: интеграторы фильтра децимации для каждого шага списка.
+     *
+     */
+    uint32_t Integrator[ADC_SAMPLER_MAX_CHANNELS][ADC_SAMPLER_FILTER_CIC3];
+
+    /*
+     * Variable: Comb
+     * Служебное поле: задержки гребенчатых звеньев фильтра децимации для каждого шага списка.
+     *
+     */
+    uint32_t Comb[ADC_SAMPLER_MAX_CHANNELS][ADC_SAMPLER_FILTER_CIC3];
+
+    /*
+     * Variable: Primed
+     * Служебное поле: 1 - первое преобразование запущено и ADC_VALUE содержит его результат.
+     *
+     */
+    uint8_t Primed;
+
+} ADC_Sampler_HandleTypeDef;
+
+/* Title: Функции */
+
+/*
+ * Function: HAL_ADC_Sampler_Start
+ * Запустить преобразования АЦП по таймеру.
+ *
+ * Таймер перезапускается с периодом Period, разрешается прерывание переполнения Timer32 или ARRM Timer16.
+ * Если задан список каналов, выбирается первый канал и выполняется одно холостое преобразование с ожиданием.
+ * Линия прерывания таймера в EPIC разрешается пользователем, из обработчика вызывается <HAL_ADC_Sampler_IRQHandler>.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ *
+ * Returns:
+ * (HAL_StatusTypeDef ) - Статус HAL.
+ */
+HAL_StatusTypeDef HAL_ADC_Sampler_Start(ADC_Sampler_HandleTypeDef *hsampler);
+
+/*
+ * Function: HAL_ADC_Sampler_Stop
+ * Остановить таймер и запретить его прерывание.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ *
+ * Returns:
+ * void
+ */
+void HAL_ADC_Sampler_Stop(ADC_Sampler_HandleTypeDef *hsampler);
+
+/*
+ * Function: HAL_ADC_Sampler_IRQHandler
+ * Обработчик прерывания таймера: прочитать результат предыдущего преобразования и запустить следующее.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ *
+ * Returns:
+ * void
+ */
+void HAL_ADC_Sampler_IRQHandler(ADC_Sampler_HandleTypeDef *hsampler);
+
+/*
+ * Function: HAL_ADC_Sampler_Available
+ * Получить количество непрочитанных результатов.
+ *
+ * Если буфер переполнен, самые старые результаты пропускаются и учитываются в поле Overruns.
+ * При сканировании пропускаются целые кадры из ChannelCount результатов.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ *
+ * Returns:
+ * (uint32_t ) - Количество результатов, не больше Size.
+ */
+uint32_t HAL_ADC_Sampler_Available(ADC_Sampler_HandleTypeDef *hsampler);
+
+/*
+ * Function: HAL_ADC_Sampler_Read
+ * Прочитать результаты из кольцевого буфера.
+ *
+ * При сканировании читаются только целые кадры, первый результат кадра относится к Channels[0].
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * pData - Массив для результатов.
+ * MaxCount - Размер массива.
+ *
+ * Returns:
+ * (uint32_t ) - Количество прочитанных результатов.
+ */
+uint32_t HAL_ADC_Sampler_Read(ADC_Sampler_HandleTypeDef *hsampler, uint16_t *pData, uint32_t MaxCount);
+
+/*
+ * Function: HAL_ADC_Sampler_WatchdogSet
+ * Задать пороги сторожа канала и включить его.
+ *
+ * Зона канала сбрасывается в <ADC_SAMPLER_WATCHDOG_NORMAL>. Функцию можно вызывать во время преобразований.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * channel - Канал АЦП <ADC_CHANNEL0>..<ADC_CHANNEL7>.
+ * low - Нижний порог.
+ * high - Верхний порог, не меньше low.
+ * hysteresis - Гистерезис, не больше high - low.
+ *
+ * Returns:
+ * (HAL_StatusTypeDef ) - Статус HAL.
+ */
+HAL_StatusTypeDef HAL_ADC_Sampler_WatchdogSet(ADC_Sampler_HandleTypeDef *hsampler, uint8_t channel, uint16_t low,
+                                              uint16_t high, uint16_t hysteresis);
+
+/*
+ * Function: HAL_ADC_Sampler_WatchdogDisable
+ * Выключить сторож канала.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * channel - Канал АЦП <ADC_CHANNEL0>..<ADC_CHANNEL7>.
+ *
+ * Returns:
+ * void
+ */
+void HAL_ADC_Sampler_WatchdogDisable(ADC_Sampler_HandleTypeDef *hsampler, uint8_t channel);
+
+#endif // MIK32_HAL_ADC_SAMPLER
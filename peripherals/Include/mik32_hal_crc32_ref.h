@@ -0,0 +1,92 @@
+#ifndef MIK32_HAL_CRC32_REF
+#define MIK32_HAL_CRC32_REF
+
+#include "inttypes.h"
+
+
+/* Title: Эталонный расчет CRC32 */
+
+/*
+ * Программная модель блока CRC32. Модуль не обращается к регистрам и не зависит от заголовков
+ * микроконтроллера, поэтому может собираться и на целевом устройстве, и на рабочей машине.
+ * Используется для проверки настроек <CRC_HandleTypeDef> и как исходный уровень в измерениях
+ * производительности блока CRC32.
+ */
+
+/* Title: Структуры */
+
+/*
+ * Struct: CRC_Ref_ConfigTypeDef
+ * Параметры модели CRC в обозначениях Rocksoft (Poly, Init, RefIn, RefOut, XorOut).
+ *
+ */
+typedef struct
+{
+    /*
+    * Variable: Poly
+    * Порождающий многочлен без старшего бита.
+    *
+    */
+    uint32_t Poly;
+
+    /*
+    * Variable: Init
+    * Стартовое значение.
+    *
+    */
+    uint32_t Init;
+
+    /*
+    * Variable: RefIn
+    * 1 - биты каждого входного байта обрабатываются начиная с младшего (соответствует CRC_REFIN_TRUE).
+    *
+    */
+    uint8_t RefIn;
+
+    /*
+    * Variable: RefOut
+    * 1 - биты результата переставляются в обратном порядке (соответствует CRC_REFOUT_TRUE).
+    *
+    */
+    uint8_t RefOut;
+
+    /*
+    * Variable: XorOut
+    * Значение, с которым складывается по модулю 2 результат (0xFFFFFFFF соответствует CRC_OUTPUTINVERSION_ON).
+    *
+    */
+    uint32_t XorOut;
+
+} CRC_Ref_ConfigTypeDef;
+
+/* Title: Функции */
+
+/*
+ * Function: HAL_CRC_Ref_Reflect32
+ * Переставить биты 32-битного значения в обратном порядке.
+ *
+ * Parameters:
+ * value - Исходное значение.
+ *
+ * Returns:
+ * (uint32_t ) - Значение с обратным порядком битов.
+ */
+uint32_t HAL_CRC_Ref_Reflect32(uint32_t value);
+
+/*
+ * Function: HAL_CRC_Ref_Calculate
+ * Рассчитать CRC последовательности байтов побитовым алгоритмом.
+ *
+ * Результат совпадает со значением <HAL_CRC_ReadCRC> после <HAL_CRC_WriteData> с теми же настройками.
+ *
+ * Parameters:
+ * config - Параметры модели CRC.
+ * message - Массив с данными.
+ * message_length - Количество байтов. Ограничение CRC_MAX_BYTES к модели не применяется.
+ *
+ * Returns:
+ * (uint32_t ) - Значение CRC.
+ */
+uint32_t HAL_CRC_Ref_Calculate(const CRC_Ref_ConfigTypeDef *config, const uint8_t message[], uint32_t message_length);
+
+#endif
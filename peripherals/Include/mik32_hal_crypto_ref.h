@@ -0,0 +1,44 @@
+#ifndef MIK32_HAL_CRYPTO_REF
+#define MIK32_HAL_CRYPTO_REF
+
+#include "inttypes.h"
+
+
+/*
+ * Программная реализация шифров крипто-блока: Кузнечик и Магма (ГОСТ Р 34.12-2015), AES-128 (FIPS-197).
+ * Модуль не обращается к регистрам и не зависит от заголовков микроконтроллера, поэтому может собираться
+ * и на целевом устройстве, и на рабочей машине. Используется для проверки результатов крипто-блока.
+ *
+ * Блок и ключ задаются массивом байтов в порядке записи тестовых примеров стандартов: первый байт - старший.
+ */
+
+/**
+ * @name Алгоритмы шифрования
+ *  @{
+ */
+#define CRYPTO_REF_KUZNECHIK        0       /**< Кузнечик, совпадает с CRYPTO_ALG_KUZNECHIK. */
+#define CRYPTO_REF_MAGMA            1       /**< Магма, совпадает с CRYPTO_ALG_MAGMA. */
+#define CRYPTO_REF_AES              2       /**< AES-128, совпадает с CRYPTO_ALG_AES. */
+/** @} */
+
+#define CRYPTO_REF_BLOCK_BYTES_MAX  16      /**< Наибольшая длина блока, байт. */
+#define CRYPTO_REF_KEY_BYTES_MAX    32      /**< Наибольшая длина ключа, байт. */
+
+/**
+ * @brief Развернутый ключ.
+ */
+typedef struct __Crypto_Ref_KeyTypeDef
+{
+    uint8_t Algorithm;          /**< Алгоритм шифрования: #CRYPTO_REF_KUZNECHIK, #CRYPTO_REF_MAGMA, #CRYPTO_REF_AES. */
+
+    uint8_t RoundKeys[176];     /**< Итерационные ключи: 10 по 16 байт (Кузнечик), 8 по 4 байта (Магма), 11 по 16 байт (AES). */
+
+} Crypto_Ref_KeyTypeDef;
+
+uint32_t HAL_Crypto_Ref_BlockBytes(uint8_t Algorithm);
+uint32_t HAL_Crypto_Ref_KeyBytes(uint8_t Algorithm);
+void HAL_Crypto_Ref_SetKey(Crypto_Ref_KeyTypeDef *key, uint8_t Algorithm, const uint8_t Key[]);
+void HAL_Crypto_Ref_EncryptBlock(const Crypto_Ref_KeyTypeDef *key, uint8_t block[]);
+void HAL_Crypto_Ref_DecryptBlock(const Crypto_Ref_KeyTypeDef *key, uint8_t block[]);
+
+#endif
@@ -7,6 +7,7 @@
 #include "dma_config.h"
 #include "mik32_memory_map.h"
 #include "mik32_hal_def.h"
+#include "mik32_hal_irq.h"
 
 
 
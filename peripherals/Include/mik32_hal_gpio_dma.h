@@ -0,0 +1,41 @@
+#ifndef MIK32_HAL_GPIO_DMA
+#define MIK32_HAL_GPIO_DMA
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_gpio.h"
+#include "mik32_hal_dma.h"
+#include "mik32_hal_timer32.h"
+
+
+/**
+ * @brief Регистр порта GPIO, в который DMA записывает слова шаблона.
+ */
+typedef enum __HAL_GPIO_DMA_TargetTypeDef
+{
+	GPIO_DMA_TARGET_OUTPUT = 0,	/**< Регистр OUTPUT. Каждое слово шаблона задает состояние всех выводов порта. */
+	GPIO_DMA_TARGET_SET = 1,	/**< Регистр SET. Единичные биты слова устанавливают выводы в 1, остальные выводы не изменяются. */
+	GPIO_DMA_TARGET_CLEAR = 2	/**< Регистр CLEAR. Единичные биты слова сбрасывают выводы в 0, остальные выводы не изменяются. */
+} HAL_GPIO_DMA_TargetTypeDef;
+
+/**
+ * @brief Структура вывода шаблона в порт GPIO с помощью DMA.
+ *
+ * Слова шаблона пересылаются в порт по одному на каждое переполнение таймера Timer32.
+ * Частота вывода определяется частотой тактирования и значением Top таймера.
+ */
+typedef struct __GPIO_DMA_HandleTypeDef
+{
+	GPIO_TypeDef *Port;							/**< Порт GPIO. Этот параметр может иметь значение GPIO_0, GPIO_1 или GPIO_2. */
+	HAL_GPIO_DMA_TargetTypeDef Target;			/**< Регистр порта, в который записывается шаблон. Данный параметр может быть одним из значений перечисления @ref HAL_GPIO_DMA_TargetTypeDef. */
+	TIMER32_HandleTypeDef *htimer32;			/**< Таймер, задающий темп вывода. Таймер должен быть проинициализирован с помощью @ref HAL_Timer32_Init. */
+	DMA_ChannelHandleTypeDef *hdma;				/**< Канал DMA. Поля dma, Channel и Priority задаются пользователем, остальные настройки канала заполняются в @ref HAL_GPIO_DMA_Init. */
+} GPIO_DMA_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_GPIO_DMA_Init(GPIO_DMA_HandleTypeDef *hgpio_dma);
+HAL_StatusTypeDef HAL_GPIO_DMA_Start(GPIO_DMA_HandleTypeDef *hgpio_dma, const uint32_t *pPattern, uint32_t Count);
+void HAL_GPIO_DMA_Stop(GPIO_DMA_HandleTypeDef *hgpio_dma);
+HAL_StatusTypeDef HAL_GPIO_DMA_Wait(GPIO_DMA_HandleTypeDef *hgpio_dma, uint32_t Timeout);
+int HAL_GPIO_DMA_IsBusy(GPIO_DMA_HandleTypeDef *hgpio_dma);
+
+#endif // MIK32_HAL_GPIO_DMA
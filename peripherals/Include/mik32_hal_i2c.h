@@ -16,12 +16,6 @@
  */
 #define I2C_TIMEOUT_DEFAULT 	1000000		/* Количество циклов ожидания установки флага TXIS или RXNE */
 
-/*
- * Define: TSYNC_SIGMA_FACTOR
- * Суммарное количество тактов i2cclk, уходящих на ожидание установки лог.1 на SCL
- */
-#define TSYNC_SIGMA_FACTOR		10
-
 /*
  * Define: I2C_NBYTE_MAX
  * Максимальлное количество байт в посылке (NBYTES)
@@ -132,6 +126,13 @@ typedef enum
 	I2C_ANALOGFILTER_DISABLE = 0
 } HAL_I2C_AnalogFilterTypeDef;
 
+/* I2C_memory_address_size - Размер адреса регистра ведомого в функциях HAL_I2C_Mem_* */
+typedef enum
+{
+	I2C_MEMADD_SIZE_8BIT = 1,    /* Адрес регистра 8 бит */
+	I2C_MEMADD_SIZE_16BIT = 2    /* Адрес регистра 16 бит, старший байт передается первым */
+} HAL_I2C_MemAddSizeTypeDef;
+
 typedef enum 
 {
   HAL_I2C_MODE_MASTER = 0, /* Режим ведущего */
@@ -262,6 +263,9 @@ typedef struct
 
 	/*
 	* Frequency - частота SCL
+	*
+	* Используется только в <HAL_I2C_calcFreqCoef>. <HAL_I2C_Init> и <HAL_I2C_SetClockSpeed> не рассчитывают
+	* тайминги и записывают в TIMINGR значения Clock, поэтому <HAL_I2C_calcFreqCoef> вызывается пользователем до них.
 	*/
 	uint32_t frequency;
 	
@@ -270,6 +274,14 @@ typedef struct
 	*/
 	uint32_t duty_factor;
 
+	/*
+	* Variable: RiseTime
+	* Время нарастания SCL и SDA на шине, нс
+	*
+	* Учитывается в <HAL_I2C_calcFreqCoef>. 0 - максимальное значение по спецификации режима.
+	*/
+	uint32_t RiseTime;
+
 } I2C_InitTypeDef;
 
 /*
@@ -341,6 +353,15 @@ typedef enum
   HAL_I2C_STATE_ERROR    /* Ошибка при передаче */
 } HAL_I2C_StateTypeDef;
 
+typedef enum
+{
+  HAL_I2C_MEM_NONE,         /* Адрес регистра не передается */
+  HAL_I2C_MEM_WRITE_IT,     /* Передача адреса регистра, затем запись данных в прерываниях */
+  HAL_I2C_MEM_WRITE_DMA,    /* Передача адреса регистра, затем запись данных через DMA */
+  HAL_I2C_MEM_READ_IT,      /* Передача адреса регистра, затем повторный START и чтение в прерываниях */
+  HAL_I2C_MEM_READ_DMA      /* Передача адреса регистра, затем повторный START и чтение через DMA */
+} HAL_I2C_MemModeTypeDef;
+
 typedef struct
 {
 	/*
@@ -389,6 +410,24 @@ typedef struct
 	uint32_t TransferSize;
     uint32_t TransferCount;
 
+	/*
+	* Variable: MemMode
+	* Этап передачи адреса регистра в функциях HAL_I2C_Mem_*_IT и HAL_I2C_Mem_*_DMA
+	*/
+	volatile HAL_I2C_MemModeTypeDef MemMode;
+
+	/*
+	* Variable: MemAddress
+	* Адрес регистра ведомого
+	*/
+	uint16_t MemAddress;
+
+	/*
+	* Variable: MemAddressCount
+	* Количество байт адреса регистра, которые осталось передать
+	*/
+	uint8_t MemAddressCount;
+
 } I2C_HandleTypeDef;
 
 
@@ -404,7 +443,7 @@ void HAL_I2C_OwnAddress1(I2C_HandleTypeDef *hi2c);
 void HAL_I2C_OwnAddress2(I2C_HandleTypeDef *hi2c);
 void HAL_I2C_GeneralCall(I2C_HandleTypeDef *hi2c, HAL_I2C_GeneralCallTypeDef GeneralCall);
 void HAL_I2C_SBCMode(I2C_HandleTypeDef *hi2c, HAL_I2C_SBCModeTypeDef SBCMode);
-void HAL_I2C_calcFreqCoef(I2C_HandleTypeDef *hi2c);
+uint32_t HAL_I2C_calcFreqCoef(I2C_HandleTypeDef *hi2c);
 void HAL_I2C_SlaveInit(I2C_HandleTypeDef *hi2c);
 void HAL_I2C_MasterInit(I2C_HandleTypeDef *hi2c);
 HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
@@ -416,6 +455,8 @@ HAL_StatusTypeDef HAL_I2C_WaitBusy(I2C_HandleTypeDef *hi2c, uint32_t Timeout);
 void HAL_I2C_Master_NBYTES(I2C_HandleTypeDef *hi2c);
 HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
 HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
 HAL_StatusTypeDef HAL_I2C_Slave_WaitADDR(I2C_HandleTypeDef *hi2c, uint32_t Timeout);
 HAL_StatusTypeDef HAL_I2C_Slave_WaitTXIS(I2C_HandleTypeDef *hi2c, uint32_t Timeout);
 HAL_StatusTypeDef HAL_I2C_Slave_WaitRXNE(I2C_HandleTypeDef *hi2c, uint32_t Timeout);
@@ -430,11 +471,16 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t
 HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize);
 HAL_StatusTypeDef HAL_I2C_Slave_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
 HAL_StatusTypeDef HAL_I2C_Slave_Receive_DMA(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize);
 
 void HAL_I2C_InterruptDisable(I2C_HandleTypeDef *hi2c, uint32_t IntDisMask);
 void HAL_I2C_InterruptEnable(I2C_HandleTypeDef *hi2c, uint32_t IntEnMask);
 HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize);
 HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize);
+void HAL_I2C_Mem_AddressComplete(I2C_HandleTypeDef *hi2c);
 HAL_StatusTypeDef HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize);
 HAL_StatusTypeDef HAL_I2C_Slave_Transmit_NOSTRETCH_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize);
 HAL_StatusTypeDef HAL_I2C_Slave_Receive_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize);
@@ -456,6 +502,7 @@ static inline __attribute__((always_inline)) void HAL_I2C_ADDR_IRQ(I2C_HandleTyp
 static inline __attribute__((always_inline)) void HAL_I2C_ERR_IRQ(I2C_HandleTypeDef *hi2c)
 {
     hi2c->State = HAL_I2C_STATE_ERROR;
+    hi2c->MemMode = HAL_I2C_MEM_NONE;
     /* Выключить все прерывания I2C */
     hi2c->Instance->CR1 &= ~I2C_INTMASK;
 	/* Сброс I2C */
@@ -467,6 +514,7 @@ static inline __attribute__((always_inline)) void HAL_I2C_ERR_IRQ(I2C_HandleType
 static inline __attribute__((always_inline)) void HAL_I2C_NACK_IRQ(I2C_HandleTypeDef *hi2c)
 {
     hi2c->State = HAL_I2C_STATE_ERROR;
+    hi2c->MemMode = HAL_I2C_MEM_NONE;
     /* Выключить все прерывания I2C */
     hi2c->Instance->CR1 &= ~I2C_INTMASK;
 	/* Сброс I2C */
@@ -484,9 +532,46 @@ static inline __attribute__((always_inline)) void HAL_I2C_STOP_IRQ(I2C_HandleTyp
     hi2c->Instance->ICR |= I2C_ICR_STOPCF_M;
 }
 
+static inline __attribute__((always_inline)) void HAL_I2C_Mem_TXIS_IRQ(I2C_HandleTypeDef *hi2c)
+{
+	/* Адрес регистра передается старшим байтом вперед */
+	hi2c->MemAddressCount--;
+	hi2c->Instance->TXDR = (uint8_t)(hi2c->MemAddress >> (8 * hi2c->MemAddressCount));
+
+	if (hi2c->MemAddressCount != 0)
+	{
+		return;
+	}
+
+	if (hi2c->MemMode == HAL_I2C_MEM_WRITE_IT)
+	{
+		/* Далее данные передаются в HAL_I2C_TXIS_IRQ */
+		hi2c->MemMode = HAL_I2C_MEM_NONE;
+		if (hi2c->TransferCount == hi2c->TransferSize)
+		{
+			hi2c->State = HAL_I2C_STATE_END;
+		}
+	}
+	else if (hi2c->MemMode == HAL_I2C_MEM_WRITE_DMA)
+	{
+		HAL_I2C_Mem_AddressComplete(hi2c);
+	}
+	else
+	{
+		/* Чтение: повторный START формируется в HAL_I2C_TC_IRQ */
+		HAL_I2C_InterruptDisable(hi2c, I2C_CR1_TXIE_M);
+	}
+}
+
 static inline __attribute__((always_inline)) void HAL_I2C_TXIS_IRQ(I2C_HandleTypeDef *hi2c)
 {
 	hi2c->TransferCount++;
+	if (hi2c->MemMode != HAL_I2C_MEM_NONE)
+	{
+		HAL_I2C_Mem_TXIS_IRQ(hi2c);
+		return;
+	}
+
 	if ((hi2c->TransferCount > hi2c->TransferSize) && (hi2c->Init.Mode == HAL_I2C_MODE_SLAVE))
     {
 		hi2c->Instance->CR1 &= ~I2C_CR1_PE_M;
@@ -567,6 +652,12 @@ static inline __attribute__((always_inline)) void HAL_I2C_TCR_IRQ(I2C_HandleType
     }
     else
     {
+		if (hi2c->Instance->CR1 & (I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M))
+		{
+			/* Данные пересылает DMA, завершена очередная часть из I2C_NBYTE_MAX байт */
+			hi2c->TransferCount += I2C_NBYTE_MAX;
+		}
+
 		hi2c->Instance->CR2 &= ~I2C_CR2_NBYTES_M;
 		/* Подготовка перед отправкой */
 		
@@ -590,6 +681,13 @@ static inline __attribute__((always_inline)) void HAL_I2C_TCR_IRQ(I2C_HandleType
 
 static inline __attribute__((always_inline)) void HAL_I2C_TC_IRQ(I2C_HandleTypeDef *hi2c)
 {
+    if ((hi2c->MemMode == HAL_I2C_MEM_READ_IT) || (hi2c->MemMode == HAL_I2C_MEM_READ_DMA))
+    {
+        /* Адрес регистра передан, повторный START для чтения */
+        HAL_I2C_Mem_AddressComplete(hi2c);
+        return;
+    }
+
     hi2c->State = HAL_I2C_STATE_END;
 }
 
@@ -0,0 +1,69 @@
+#ifndef MIK32_HAL_I2C_QUEUE
+#define MIK32_HAL_I2C_QUEUE
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_i2c.h"
+#include "mik32_hal_irq.h"
+
+
+struct __I2C_Queue_TransactionTypeDef;
+
+/**
+ * @brief Функция обратного вызова по завершении транзакции.
+ *
+ * Вызывается из @ref HAL_I2C_Queue_IRQHandler. Из нее допускается ставить в очередь новые транзакции.
+ */
+typedef void (*HAL_I2C_Queue_CallbackTypeDef)(struct __I2C_Queue_TransactionTypeDef *transaction);
+
+/**
+ * @brief Этап обслуживания транзакции.
+ */
+typedef enum __HAL_I2C_Queue_PhaseTypeDef
+{
+	I2C_QUEUE_PHASE_WRITE = 0,	/**< Передача сегмента записи. */
+	I2C_QUEUE_PHASE_READ = 1	/**< Прием сегмента чтения после START или повторного START. */
+} HAL_I2C_Queue_PhaseTypeDef;
+
+/**
+ * @brief Описатель транзакции I2C в режиме ведущего.
+ *
+ * Транзакция состоит из сегмента записи и сегмента чтения. Если заданы оба сегмента, между ними
+ * формируется повторный START без STOP. Транзакция без сегментов передает только адрес ведомого.
+ * Описатель и буферы должны оставаться доступными до вызова Callback.
+ */
+typedef struct __I2C_Queue_TransactionTypeDef
+{
+	uint16_t SlaveAddress;							/**< Адрес ведомого, 7 или 10 бит. */
+	const uint8_t *pWriteData;						/**< Данные сегмента записи. */
+	uint16_t WriteSize;								/**< Количество байт сегмента записи. 0 - сегмент отсутствует. */
+	uint8_t *pReadData;								/**< Буфер сегмента чтения. */
+	uint16_t ReadSize;								/**< Количество байт сегмента чтения. 0 - сегмент отсутствует. */
+	HAL_I2C_Queue_CallbackTypeDef Callback;			/**< Функция обратного вызова, может быть NULL. */
+	void *Context;									/**< Данные пользователя для Callback. */
+	volatile HAL_I2C_StateTypeDef State;			/**< Состояние: @ref HAL_I2C_STATE_BUSY в очереди, @ref HAL_I2C_STATE_END или @ref HAL_I2C_STATE_ERROR по завершении. Перед первой постановкой в очередь - @ref HAL_I2C_STATE_READY. */
+	HAL_I2C_ErrorTypeDef ErrorCode;					/**< Код ошибки при State = @ref HAL_I2C_STATE_ERROR. */
+	struct __I2C_Queue_TransactionTypeDef *Next;	/**< Служебное поле очереди. */
+} I2C_Queue_TransactionTypeDef;
+
+/**
+ * @brief Структура очереди транзакций I2C.
+ *
+ * Очередь обслуживается целиком в прерывании: после STOP очередной транзакции следующая
+ * запускается в том же обработчике без возврата в основной поток.
+ */
+typedef struct __I2C_Queue_HandleTypeDef
+{
+	I2C_HandleTypeDef *hi2c;							/**< Модуль I2C в режиме ведущего, проинициализированный @ref HAL_I2C_Init. */
+	I2C_Queue_TransactionTypeDef *volatile Head;		/**< Текущая транзакция. */
+	I2C_Queue_TransactionTypeDef *volatile Tail;		/**< Последняя транзакция в очереди. */
+	HAL_I2C_Queue_PhaseTypeDef Phase;					/**< Этап текущей транзакции. */
+	uint32_t TransferCount;								/**< Количество переданных байт текущего сегмента. */
+} I2C_Queue_HandleTypeDef;
+
+
+void HAL_I2C_Queue_Init(I2C_Queue_HandleTypeDef *hqueue, I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Queue_Submit(I2C_Queue_HandleTypeDef *hqueue, I2C_Queue_TransactionTypeDef *transaction);
+int HAL_I2C_Queue_IsIdle(I2C_Queue_HandleTypeDef *hqueue);
+void HAL_I2C_Queue_IRQHandler(I2C_Queue_HandleTypeDef *hqueue);
+
+#endif // MIK32_HAL_I2C_QUEUE
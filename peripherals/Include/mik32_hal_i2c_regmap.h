@@ -0,0 +1,70 @@
+#ifndef MIK32_HAL_I2C_REGMAP
+#define MIK32_HAL_I2C_REGMAP
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_i2c.h"
+#include "mik32_hal_dma.h"
+
+
+/* Доступ к регистру со стороны ведущего */
+#define I2C_REGMAP_ACCESS_READ		0		/* Регистр только для чтения, запись ведущего игнорируется */
+#define I2C_REGMAP_ACCESS_WRITE		(1 << 0)	/* Регистр доступен для записи */
+#define I2C_REGMAP_ACCESS_NOTIFY	(1 << 1)	/* После STOP вызывается WriteCallback, если регистр был записан */
+
+
+struct __I2C_RegMap_HandleTypeDef;
+
+/**
+ * @brief Функция обратного вызова по окончании записи ведущим.
+ *
+ * Вызывается из прерывания после STOP, если был записан хотя бы один регистр с флагом @ref I2C_REGMAP_ACCESS_NOTIFY.
+ * Start и Count задают непрерывный диапазон записанных регистров с учетом перехода через конец карты.
+ */
+typedef void (*HAL_I2C_RegMap_WriteCallbackTypeDef)(struct __I2C_RegMap_HandleTypeDef *hregmap, uint16_t Start, uint16_t Count);
+
+/**
+ * @brief Функция обратного вызова в начале чтения ведущим.
+ *
+ * Вызывается из прерывания при совпадении адреса до отправки первого байта. Используется для
+ * согласованного обновления многобайтовых значений, начиная с регистра Pointer.
+ */
+typedef void (*HAL_I2C_RegMap_ReadCallbackTypeDef)(struct __I2C_RegMap_HandleTypeDef *hregmap, uint16_t Pointer);
+
+/**
+ * @brief Структура ведомого с картой регистров.
+ *
+ * Транзакция записи начинается с AddressSize байт указателя регистра, старший байт первым.
+ * Последующие байты записываются в регистры с автоинкрементом указателя. Транзакция чтения
+ * передает регистры, начиная с указателя, также с автоинкрементом. При достижении конца карты указатель
+ * переходит на регистр 0. После чтения указатель указывает на регистр, следующий за последним переданным.
+ *
+ * Если задан hi2c->hdmatx, регистры до конца карты передает DMA и растяжение SCL между байтами не зависит
+ * от задержки прерываний. Из обработчика прерывания DMA должен вызываться @ref HAL_I2C_RegMap_DMA_IRQHandler:
+ * после конца карты чтение продолжается с регистра 0 в прерывании TXIS. Если чтение закончилось до конца
+ * карты, указатель не изменяется.
+ */
+typedef struct __I2C_RegMap_HandleTypeDef
+{
+	I2C_HandleTypeDef *hi2c;							/**< Модуль I2C в режиме ведомого с NOSTRETCH = 0 и SBC = 0, проинициализированный @ref HAL_I2C_Init. */
+	uint8_t *pRegisters;								/**< Карта регистров. */
+	uint16_t Size;										/**< Количество регистров. */
+	const uint8_t *pAccess;								/**< Флаги доступа I2C_REGMAP_ACCESS_* для каждого регистра. NULL - все регистры доступны для записи без уведомления. */
+	HAL_I2C_MemAddSizeTypeDef AddressSize;				/**< Размер указателя регистра. */
+	HAL_I2C_RegMap_WriteCallbackTypeDef WriteCallback;	/**< Функция обратного вызова по окончании записи, может быть NULL. */
+	HAL_I2C_RegMap_ReadCallbackTypeDef ReadCallback;	/**< Функция обратного вызова в начале чтения, может быть NULL. */
+	void *Context;										/**< Данные пользователя. */
+
+	volatile uint16_t Pointer;							/**< Указатель регистра. */
+	uint8_t AddressCount;								/**< Количество принятых байт указателя в текущей записи. */
+	uint8_t WriteNotify;								/**< Записан регистр с флагом @ref I2C_REGMAP_ACCESS_NOTIFY. */
+	uint16_t WriteStart;								/**< Первый записанный регистр. */
+	uint16_t WriteCount;								/**< Количество записанных регистров. */
+} I2C_RegMap_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_I2C_RegMap_Start(I2C_RegMap_HandleTypeDef *hregmap);
+void HAL_I2C_RegMap_Stop(I2C_RegMap_HandleTypeDef *hregmap);
+void HAL_I2C_RegMap_IRQHandler(I2C_RegMap_HandleTypeDef *hregmap);
+void HAL_I2C_RegMap_DMA_IRQHandler(I2C_RegMap_HandleTypeDef *hregmap);
+
+#endif // MIK32_HAL_I2C_REGMAP
@@ -237,6 +237,53 @@ void HAL_IRQ_EnableInterrupts();
  * void.
  */
 void HAL_IRQ_DisableInterrupts();
+
+/*
+ * Function: HAL_IRQ_SaveAndDisable
+ * Запретить глобальные прерывания и вернуть предыдущее состояние регистра mstatus.
+ *
+ * Используется для коротких критических секций внутри драйверов. Допускается вложенный вызов,
+ * в том числе из обработчика прерывания.
+ *
+ * Returns:
+ * (uint32_t ) - значение mstatus до запрета прерываний, передается в <HAL_IRQ_Restore>.
+ */
+#ifdef MIK32_HAL_HOST
+/* При сборке на рабочей машине регистр mstatus заменяется переменной модели прерываний */
+extern volatile uint32_t HAL_Host_MStatus;
+#endif // MIK32_HAL_HOST
+
+static inline __attribute__((always_inline)) uint32_t HAL_IRQ_SaveAndDisable()
+{
+    uint32_t mstatus;
+#ifdef MIK32_HAL_HOST
+    mstatus = HAL_Host_MStatus;
+    HAL_Host_MStatus = mstatus & ~MSTATUS_MIE;
+#else
+    __asm__ volatile ("csrrci %0, mstatus, %1" : "=r" (mstatus) : "i" (MSTATUS_MIE) : "memory");
+#endif // MIK32_HAL_HOST
+    return mstatus;
+}
+
+/*
+ * Function: HAL_IRQ_Restore
+ * Восстановить состояние глобальных прерываний, сохраненное <HAL_IRQ_SaveAndDisable>.
+ *
+ * Parameters:
+ * mstatus - Значение, возвращенное <HAL_IRQ_SaveAndDisable>.
+ *
+ * Returns:
+ * void.
+ */
+static inline __attribute__((always_inline)) void HAL_IRQ_Restore(uint32_t mstatus)
+{
+#ifdef MIK32_HAL_HOST
+    HAL_Host_MStatus |= mstatus & MSTATUS_MIE;
+#else
+    __asm__ volatile ("csrs mstatus, %0" : : "r" (mstatus & MSTATUS_MIE) : "memory");
+#endif // MIK32_HAL_HOST
+}
+
 /* Прерывание по фронту */
 
 /*
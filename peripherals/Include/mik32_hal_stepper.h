@@ -0,0 +1,127 @@
+#ifndef MIK32_HAL_STEPPER
+#define MIK32_HAL_STEPPER
+
+#include "stddef.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal_gpio.h"
+#include "mik32_hal_irq.h"
+#include "mik32_hal_timer32.h"
+
+
+#define STEPPER_AXES                4       /**< Количество осей на таймер - по одной на канал сравнения. */
+#define STEPPER_MIN_DELTA           8       /**< Минимальный запас в тактах таймера при записи OCR. */
+#define STEPPER_MIN_INTERVAL        64      /**< Наименьший период шага в тактах таймера при MaxSpeed. */
+#define STEPPER_MIN_TICK_FREQ       65536   /**< Наименьшая частота счета таймера, Гц. */
+
+/**
+ * @brief Форма профиля скорости.
+ */
+typedef enum __HAL_Stepper_ProfileTypeDef
+{
+    STEPPER_PROFILE_TRAPEZOID = 0,  /**< Трапеция: постоянное ускорение Accel. */
+    STEPPER_PROFILE_SCURVE = 1,     /**< S-кривая: ускорение нарастает и спадает с рывком Jerk. */
+} HAL_Stepper_ProfileTypeDef;
+
+/**
+ * @brief Этап движения оси.
+ */
+typedef enum __HAL_Stepper_StateTypeDef
+{
+    STEPPER_STATE_IDLE = 0,         /**< Ось остановлена. */
+    STEPPER_STATE_ACCEL = 1,        /**< Разгон. */
+    STEPPER_STATE_CRUISE = 2,       /**< Движение с MaxSpeed. */
+    STEPPER_STATE_DECEL = 3,        /**< Торможение. */
+} HAL_Stepper_StateTypeDef;
+
+/**
+ * @brief Ось шагового двигателя.
+ *
+ * Поля параметров задаются пользователем и применяются при следующем запуске движения. Выводы STEP и DIR
+ * настраиваются пользователем на выход. Скорость задается в шагах в секунду, ускорение - в шагах в секунду
+ * за секунду, рывок - в шагах в секунду за секунду в квадрате.
+ */
+typedef struct __Stepper_AxisTypeDef
+{
+    GPIO_TypeDef *StepPort;                     /**< Порт вывода STEP. */
+    HAL_PinsTypeDef StepPin;                    /**< Вывод STEP. Шаг выполняется по переднему фронту. */
+    GPIO_TypeDef *DirPort;                      /**< Порт вывода DIR. NULL - вывод направления не используется. */
+    HAL_PinsTypeDef DirPin;                     /**< Вывод DIR. 1 - движение в положительную сторону. */
+    HAL_Stepper_ProfileTypeDef Profile;         /**< Форма профиля скорости. */
+    uint32_t StartSpeed;                        /**< Начальная и конечная скорость. Повышается до sqrt(8 * Accel). */
+    uint32_t MaxSpeed;                          /**< Наибольшая скорость. Период шага при ней не меньше #STEPPER_MIN_INTERVAL тактов. */
+    uint32_t Accel;                             /**< Наибольшее ускорение. Не больше 0xFFFFFF. */
+    uint32_t Jerk;                              /**< Рывок для S-кривой. Не меньше Accel и не больше 0xFFFFFF. */
+    uint32_t PulseWidth;                        /**< Наименьшая длительность импульса STEP в тактах таймера. 0 - без ожидания. */
+
+    volatile int32_t Position;                  /**< Положение в шагах. */
+    volatile HAL_Stepper_StateTypeDef State;    /**< Этап движения. */
+    volatile uint32_t Remaining;                /**< Служебное поле: количество оставшихся шагов. */
+    int32_t Direction;                          /**< Служебное поле: приращение положения за шаг, 1 или -1. */
+    uint32_t Speed;                             /**< Служебное поле: текущая скорость в формате Q8. */
+    uint32_t CurAccel;                          /**< Служебное поле: текущее ускорение в формате Q8. */
+    uint32_t Interval;                          /**< Служебное поле: период шага в тактах таймера в формате Q8. */
+    uint32_t Compare;                           /**< Служебное поле: значение OCR следующего шага. */
+    uint32_t Frac;                              /**< Служебное поле: накопленная дробная часть периода. */
+    uint32_t SpeedMin;                          /**< Служебное поле: начальная скорость в формате Q8. */
+    uint32_t SpeedMax;                          /**< Служебное поле: наибольшая скорость в формате Q8. */
+    uint32_t AccelMax;                          /**< Служебное поле: наибольшее ускорение в формате Q8. */
+    uint32_t InvTwoAccel;                       /**< Служебное поле: 2^31 / Accel. */
+    uint32_t InvAccel;                          /**< Служебное поле: 2^32 / Accel. */
+    uint32_t InvJerk;                           /**< Служебное поле: 2^32 / Jerk. */
+} Stepper_AxisTypeDef;
+
+/**
+ * @brief Структура генератора шагов.
+ *
+ * Каждая ось использует свой канал сравнения таймера, таймер считает вперед с Top = 0xFFFFFFFF. В прерывании
+ * сравнения выдается импульс STEP, рассчитывается период следующего шага и OCR канала сдвигается на этот период.
+ *
+ * Период шага рассчитывается без деления и извлечения корня: скорость интегрируется по времени шага
+ * (v += a * c / F), период c = F / v уточняется одной итерацией Ньютона c = c * (2 - v * c / F) от периода
+ * предыдущего шага. Относительное изменение скорости за шаг не превышает 1/8, поэтому погрешность итерации
+ * не превышает 2 % и не накапливается. Деления выполняются один раз при запуске движения.
+ *
+ * Торможение начинается, когда оставшееся количество шагов не превышает тормозного пути с текущей скорости.
+ * Для S-кривой тормозной путь рассчитывается с запасом, если ускорение не успевает достичь Accel.
+ * Линия прерывания таймера в EPIC разрешается пользователем, из обработчика вызывается @ref HAL_Stepper_IRQHandler.
+ */
+typedef struct __Stepper_HandleTypeDef
+{
+    TIMER32_HandleTypeDef *htimer32;                        /**< Таймер TIMER32_1 или TIMER32_2. Поля Instance и Clock задаются пользователем, остальные заполняются в @ref HAL_Stepper_Init. */
+    uint32_t TickFreq;                                      /**< Частота счета таймера, Гц. Не меньше #STEPPER_MIN_TICK_FREQ. */
+    Stepper_AxisTypeDef *Axis[STEPPER_AXES];                /**< Оси по номерам каналов таймера. NULL - канал не используется. */
+
+    TIMER32_CHANNEL_HandleTypeDef Channel[STEPPER_AXES];    /**< Служебное поле: каналы сравнения. */
+    uint32_t InvFreq;                                       /**< Служебное поле: 2^48 / TickFreq. */
+} Stepper_HandleTypeDef;
+
+
+/**
+ * @brief Проверить, движется ли ось.
+ * @param axis Указатель на ось.
+ * @return 1, если ось движется.
+ */
+static inline __attribute__((always_inline)) int HAL_Stepper_IsBusy(Stepper_AxisTypeDef *axis)
+{
+    return axis->State != STEPPER_STATE_IDLE;
+}
+
+/**
+ * @brief Текущая скорость оси.
+ * @param axis Указатель на ось.
+ * @return Скорость в шагах в секунду. 0, если ось остановлена.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_Stepper_GetSpeed(Stepper_AxisTypeDef *axis)
+{
+    return (axis->State == STEPPER_STATE_IDLE) ? 0 : (axis->Speed >> 8);
+}
+
+
+HAL_StatusTypeDef HAL_Stepper_Init(Stepper_HandleTypeDef *hstepper);
+HAL_StatusTypeDef HAL_Stepper_Move(Stepper_HandleTypeDef *hstepper, uint32_t index, int32_t Steps);
+HAL_StatusTypeDef HAL_Stepper_MoveTo(Stepper_HandleTypeDef *hstepper, uint32_t index, int32_t Position);
+void HAL_Stepper_Stop(Stepper_HandleTypeDef *hstepper, uint32_t index);
+void HAL_Stepper_Abort(Stepper_HandleTypeDef *hstepper, uint32_t index);
+void HAL_Stepper_IRQHandler(Stepper_HandleTypeDef *hstepper);
+
+#endif // MIK32_HAL_STEPPER
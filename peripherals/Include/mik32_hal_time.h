@@ -0,0 +1,61 @@
+#ifndef MIK32_HAL_TIME
+#define MIK32_HAL_TIME
+
+#include "mik32_hal_def.h"
+#include "inttypes.h"
+#include "stddef.h"
+
+
+/**
+ * @brief Функция чтения 64-р счетчика тактов источника системного времени.
+ *
+ * Должна быть безопасна для вызова из прерываний и возвращать монотонно неубывающее значение.
+ */
+typedef uint64_t (*HAL_Time_Ticks64TypeDef)(void);
+
+/**
+ * @brief Коэффициент перевода тактов одной частоты в такты другой без деления.
+ *
+ * Результат вычисляется как (ticks * Mult) >> Shift. Mult и Shift рассчитываются один раз в @ref HAL_Time_ScaleInit.
+ */
+typedef struct __HAL_Time_ScaleTypeDef
+{
+	uint32_t Mult;		/**< Множитель с фиксированной точкой. */
+	uint32_t Shift;		/**< Количество дробных бит множителя. */
+} HAL_Time_ScaleTypeDef;
+
+
+/**
+ * @brief Перевести значение счетчика с помощью коэффициента.
+ *
+ * Используются только умножения 32x32 бит, деление не выполняется.
+ * @param scale Указатель на коэффициент.
+ * @param ticks Значение счетчика.
+ * @return Значение в единицах, заданных при расчете коэффициента.
+ */
+static inline __attribute__((always_inline)) uint64_t HAL_Time_Scale(const HAL_Time_ScaleTypeDef *scale, uint64_t ticks)
+{
+    uint64_t low = ((uint64_t)(uint32_t)ticks * scale->Mult) >> scale->Shift;
+    uint64_t high = (uint64_t)(uint32_t)(ticks >> 32) * scale->Mult;
+
+    if (scale->Shift >= 32)
+    {
+        high >>= scale->Shift - 32;
+    }
+    else
+    {
+        high <<= 32 - scale->Shift;
+    }
+
+    return high + low;
+}
+
+
+void HAL_Time_ScaleInit(HAL_Time_ScaleTypeDef *scale, uint32_t FromFreq, uint32_t ToFreq);
+void HAL_Time_SetSource(HAL_Time_Ticks64TypeDef Ticks64, uint32_t TickFreq);
+uint32_t HAL_Time_GetTickFreq();
+uint64_t HAL_Time_Ticks64();
+uint64_t HAL_Time_TicksToUs(uint64_t ticks);
+uint64_t HAL_Time_Now64();
+
+#endif // MIK32_HAL_TIME
@@ -8,6 +8,7 @@
 #include "pad_config.h"
 #include "stdbool.h"
 #include "mik32_hal_irq.h"
+#include "mik32_hal_time.h"
 #include "mik32_memory_map.h"
 
 
@@ -333,6 +334,7 @@ void HAL_Timer16_InterruptInit(Timer16_HandleTypeDef *htimer16);
 void HAL_Time_TIM16_InterruptHandler();
 void HAL_Time_TIM16_Init(TIMER16_TypeDef* timer);
 // uint32_t HAL_Time_TIM16_GetTick();
+uint64_t HAL_Time_TIM16_Ticks64();
 uint32_t HAL_Time_TIM16_Micros();
 uint32_t HAL_Time_TIM16_Millis();
 void HAL_Time_TIM16_DelayUs(uint32_t time_us);
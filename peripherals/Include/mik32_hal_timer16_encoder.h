@@ -0,0 +1,67 @@
+#ifndef MIK32_HAL_TIMER16_ENCODER
+#define MIK32_HAL_TIMER16_ENCODER
+
+#include "stddef.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal_irq.h"
+#include "mik32_hal_timer16.h"
+#include "mik32_hal_timer32.h"
+
+
+#define TIMER16_ENCODER_VELOCITY_SHIFT  8       /**< Количество дробных бит скорости. */
+
+/**
+ * @brief Структура энкодера с расширенным счетом положения и оценкой скорости.
+ *
+ * 16-р счетчик Timer16 в режиме энкодера расширяется до 64 бит по разности отсчетов между выборками.
+ * Выборка @ref HAL_Timer16_Encoder_Sample вызывается периодически, между выборками счетчик должен изменяться
+ * меньше чем на 32768 отсчетов. Положение между выборками читается из счетчика, поэтому не зависит от
+ * периода выборки.
+ *
+ * Скорость оценивается методом M/T: количество отсчетов M делится на время T между последними фронтами фазы
+ * энкодера, захваченными каналом Timer32 с периодом 2^32. Без канала захвата T - время между выборками.
+ */
+typedef struct __Timer16_Encoder_HandleTypeDef
+{
+    Timer16_HandleTypeDef *htimer16;            /**< Timer16, проинициализированный @ref HAL_Timer16_Init с EncoderMode = TIMER16_ENCODER_ENABLE. */
+    TIMER32_HandleTypeDef *htimer32;            /**< Timer32 меток времени, проинициализированный @ref HAL_Timer32_Init с Top = 0xFFFFFFFF. */
+    TIMER32_CHANNEL_HandleTypeDef *hchannel;    /**< Канал захвата фазы энкодера. NULL - время измеряется между выборками. */
+    uint32_t TickFreq;                          /**< Частота счета Timer32, Гц. */
+    uint32_t EdgeCounts;                        /**< Количество отсчетов Timer16 на период захватываемого сигнала. 0 или 1 - без округления M. */
+    uint32_t Timeout;                           /**< Время без фронтов, после которого скорость равна 0, такты Timer32. 0 - скорость только ограничивается. */
+
+    int64_t Position;                           /**< Положение на момент последней выборки. */
+    uint16_t LastCount;                         /**< Значение счетчика Timer16 при последней выборке. */
+    int64_t EdgePosition;                       /**< Положение на момент выборки, в которой зафиксирован последний фронт. */
+    uint32_t EdgeTime;                          /**< Время последнего фронта, такты Timer32. */
+    uint32_t EdgePeriod;                        /**< Время T последнего расчета скорости, такты Timer32. */
+    volatile int32_t Velocity;                  /**< Скорость, отсчетов в секунду в формате с #TIMER16_ENCODER_VELOCITY_SHIFT дробными битами. */
+} Timer16_Encoder_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_Timer16_Encoder_Init(Timer16_Encoder_HandleTypeDef *hencoder);
+void HAL_Timer16_Encoder_Sample(Timer16_Encoder_HandleTypeDef *hencoder);
+int64_t HAL_Timer16_Encoder_GetPosition(Timer16_Encoder_HandleTypeDef *hencoder);
+void HAL_Timer16_Encoder_SetPosition(Timer16_Encoder_HandleTypeDef *hencoder, int64_t Position);
+
+/**
+ * @brief Получить младшие 32 бита положения.
+ * @param hencoder Указатель на структуру энкодера.
+ * @return Положение, отсчеты.
+ */
+static inline int32_t HAL_Timer16_Encoder_GetPosition32(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    return (int32_t)HAL_Timer16_Encoder_GetPosition(hencoder);
+}
+
+/**
+ * @brief Получить скорость, рассчитанную в последней выборке.
+ * @param hencoder Указатель на структуру энкодера.
+ * @return Скорость, отсчетов в секунду с #TIMER16_ENCODER_VELOCITY_SHIFT дробными битами.
+ */
+static inline int32_t HAL_Timer16_Encoder_GetVelocity(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    return hencoder->Velocity;
+}
+
+#endif // MIK32_HAL_TIMER16_ENCODER
@@ -6,6 +6,8 @@
 #include <timer32.h>
 #include <power_manager.h>
 #include "mik32_hal_def.h"
+#include "mik32_hal_irq.h"
+#include "mik32_hal_time.h"
 #include <mik32_memory_map.h>
 
 #define TIMER32_TIMEOUT 10000000
@@ -255,7 +257,9 @@ void HAL_Timer32_Capture_Stop_IT(TIMER32_HandleTypeDef *timer, TIMER32_CHANNEL_H
 void HAL_Timer32_Start_IT(TIMER32_HandleTypeDef *timer, uint32_t intMask);
 void HAL_Timer32_Stop_IT(TIMER32_HandleTypeDef *timer, uint32_t intMask);
 
+void HAL_Time_TIM32_InterruptHandler();
 void HAL_Time_TIM32_Init(TIMER32_TypeDef* timer);
+uint64_t HAL_Time_TIM32_Ticks64();
 uint32_t HAL_Time_TIM32_Micros();
 uint32_t HAL_Time_TIM32_Millis();
 void HAL_Time_TIM32_DelayUs(uint32_t time_us);
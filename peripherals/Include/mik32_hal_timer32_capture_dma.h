@@ -0,0 +1,68 @@
+#ifndef MIK32_HAL_TIMER32_CAPTURE_DMA
+#define MIK32_HAL_TIMER32_CAPTURE_DMA
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_dma.h"
+#include "mik32_hal_irq.h"
+#include "mik32_hal_timer32.h"
+
+
+#define TIMER32_CAPTURE_DMA_MAX_SIZE    4096    /**< Наибольший размер кольцевого буфера, слов. */
+
+/**
+ * @brief Структура захвата фронтов канала Timer32 в кольцевой буфер с помощью DMA.
+ *
+ * На каждый захват канал DMA пересылает значение ICR в следующее слово буфера. По заполнении буфера
+ * канал DMA перезапускается с начала буфера в @ref HAL_Timer32_CaptureDMA_IRQHandler, поэтому прерывание
+ * возникает один раз на Size захватов, а не на каждый фронт. Фронты, пришедшие между заполнением буфера
+ * и перезапуском канала, теряются; время перезапуска определяется задержкой обработчика прерывания DMA.
+ *
+ * Запрос DMA у таймера один на все события, поэтому таймер используется только одним захватом.
+ * Линия прерывания таймера в EPIC должна быть запрещена.
+ */
+typedef struct __Timer32_CaptureDMA_HandleTypeDef
+{
+    TIMER32_HandleTypeDef *htimer32;            /**< Таймер TIMER32_1 или TIMER32_2, проинициализированный @ref HAL_Timer32_Init. */
+    TIMER32_CHANNEL_HandleTypeDef *hchannel;    /**< Канал таймера в режиме захвата, проинициализированный @ref HAL_Timer32_Channel_Init. */
+    DMA_ChannelHandleTypeDef *hdma;             /**< Канал DMA. Поля dma, Channel и Priority задаются пользователем, DMA должен быть проинициализирован с CurrentValue = DMA_CURRENT_VALUE_ENABLE. */
+    uint32_t *Buffer;                           /**< Кольцевой буфер захваченных значений. */
+    uint32_t Size;                              /**< Размер буфера, слов. Не больше #TIMER32_CAPTURE_DMA_MAX_SIZE. */
+    uint32_t TickFreq;                          /**< Частота счета таймера, Гц. 0 - частота в статистике не рассчитывается. */
+
+    volatile uint32_t Laps;                     /**< Количество заполнений буфера. */
+    uint32_t ReadCount;                         /**< Количество прочитанных и пропущенных захватов. */
+    uint32_t ReadIndex;                         /**< Индекс следующего читаемого слова буфера. */
+    uint32_t Overruns;                          /**< Количество захватов, перезаписанных до чтения. */
+    uint64_t Last;                              /**< Время последнего прочитанного захвата в тактах таймера с учетом переполнений. */
+    uint32_t LastRaw;                           /**< Значение ICR последнего прочитанного захвата. */
+    uint8_t HasLast;                            /**< 1 - поле Last действительно. */
+} Timer32_CaptureDMA_HandleTypeDef;
+
+/**
+ * @brief Статистика пачки захватов.
+ */
+typedef struct __Timer32_CaptureDMA_StatsTypeDef
+{
+    uint32_t Count;                             /**< Количество периодов в пачке. */
+    uint32_t PeriodMin;                         /**< Наименьший период, такты таймера. */
+    uint32_t PeriodMax;                         /**< Наибольший период, такты таймера. */
+    uint32_t PeriodMean;                        /**< Средний период, такты таймера. */
+    uint32_t Frequency;                         /**< Средняя частота, мГц. 0, если TickFreq не задан. */
+    uint32_t HighMean;                          /**< Средняя длительность высокого уровня, такты таймера. Только в @ref HAL_Timer32_CaptureDMA_GetDutyStats. */
+    uint32_t Duty;                              /**< Коэффициент заполнения в формате Q16 (65536 - 100 %). Только в @ref HAL_Timer32_CaptureDMA_GetDutyStats. */
+} Timer32_CaptureDMA_StatsTypeDef;
+
+
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_Init(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_Start(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_StartSync(Timer32_CaptureDMA_HandleTypeDef *hrise, Timer32_CaptureDMA_HandleTypeDef *hfall);
+void HAL_Timer32_CaptureDMA_Stop(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+void HAL_Timer32_CaptureDMA_IRQHandler(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+uint32_t HAL_Timer32_CaptureDMA_GetCount(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+uint32_t HAL_Timer32_CaptureDMA_Available(Timer32_CaptureDMA_HandleTypeDef *hcapture);
+uint32_t HAL_Timer32_CaptureDMA_Read(Timer32_CaptureDMA_HandleTypeDef *hcapture, uint32_t *pData, uint32_t MaxCount);
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_GetStats(Timer32_CaptureDMA_HandleTypeDef *hcapture, Timer32_CaptureDMA_StatsTypeDef *stats, uint32_t MaxCount);
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_GetDutyStats(Timer32_CaptureDMA_HandleTypeDef *hrise, Timer32_CaptureDMA_HandleTypeDef *hfall,
+    Timer32_CaptureDMA_StatsTypeDef *stats, uint32_t MaxCount);
+
+#endif // MIK32_HAL_TIMER32_CAPTURE_DMA
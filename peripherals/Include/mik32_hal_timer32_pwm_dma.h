@@ -0,0 +1,42 @@
+#ifndef MIK32_HAL_TIMER32_PWM_DMA
+#define MIK32_HAL_TIMER32_PWM_DMA
+
+#include "mik32_hal_def.h"
+#include "mik32_hal_dma.h"
+#include "mik32_hal_timer32.h"
+
+
+/**
+ * @brief Структура вывода последовательности значений сравнения канала ШИМ Timer32 с помощью DMA.
+ *
+ * На каждое переполнение таймера канал DMA записывает следующее слово буфера в регистр OCR канала,
+ * поэтому значение меняется каждый период ШИМ без участия ядра. В режиме повтора канал DMA перезапускается
+ * с начала буфера в @ref HAL_Timer32_PWM_DMA_IRQHandler; перезапуск должен выполниться в течение одного
+ * периода ШИМ после пересылки последнего слова, иначе последнее значение действует дольше одного периода.
+ *
+ * Запрос DMA у таймера один, поэтому последовательность выводится в один канал таймера.
+ * Линия прерывания таймера в EPIC должна быть запрещена.
+ */
+typedef struct __Timer32_PWM_DMA_HandleTypeDef
+{
+    TIMER32_HandleTypeDef *htimer32;            /**< Таймер TIMER32_1 или TIMER32_2, проинициализированный @ref HAL_Timer32_Init. Период ШИМ задается Top. */
+    TIMER32_CHANNEL_HandleTypeDef *hchannel;    /**< Канал таймера в режиме ШИМ, проинициализированный @ref HAL_Timer32_Channel_Init. */
+    DMA_ChannelHandleTypeDef *hdma;             /**< Канал DMA. Поля dma, Channel и Priority задаются пользователем, остальные настройки канала заполняются в @ref HAL_Timer32_PWM_DMA_Init. */
+
+    void (*CpltCallback)(struct __Timer32_PWM_DMA_HandleTypeDef *hpwm_dma);  /**< Вызывается из @ref HAL_Timer32_PWM_DMA_IRQHandler после вывода всего буфера, для буфера из одного слова - из @ref HAL_Timer32_PWM_DMA_Start. Может быть NULL. */
+
+    const uint32_t *pData;                      /**< Выводимый буфер. */
+    uint32_t Count;                             /**< Количество слов буфера. */
+    uint8_t Loop;                               /**< 1 - буфер выводится повторно до вызова @ref HAL_Timer32_PWM_DMA_Stop. */
+    volatile uint32_t Passes;                   /**< Количество выведенных проходов буфера. */
+} Timer32_PWM_DMA_HandleTypeDef;
+
+
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Init(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma);
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Start(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma, const uint32_t *pData, uint32_t Count, uint8_t Loop);
+void HAL_Timer32_PWM_DMA_Stop(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma);
+void HAL_Timer32_PWM_DMA_IRQHandler(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma);
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Wait(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma, uint32_t Timeout);
+int HAL_Timer32_PWM_DMA_IsBusy(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma);
+
+#endif // MIK32_HAL_TIMER32_PWM_DMA
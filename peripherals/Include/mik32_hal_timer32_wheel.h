@@ -0,0 +1,95 @@
+#ifndef MIK32_HAL_TIMER32_WHEEL
+#define MIK32_HAL_TIMER32_WHEEL
+
+#include "stddef.h"
+#include "mik32_hal_def.h"
+#include "mik32_hal_timer32.h"
+#include "mik32_hal_irq.h"
+
+
+/* Количество бит времени на уровень колеса. Уровень содержит 32 ячейки, занятость ячеек хранится в одном слове */
+#define TIMER32_WHEEL_LEVEL_BITS	5
+#define TIMER32_WHEEL_SLOTS			(1 << TIMER32_WHEEL_LEVEL_BITS)
+/* Количество уровней. 7 уровней по 5 бит покрывают интервал 2^35 тактов таймера */
+#define TIMER32_WHEEL_LEVELS		7
+/* Количество бит времени, покрываемых уровнями. Таймеры за границей текущего интервала хранятся в списке Far */
+#define TIMER32_WHEEL_RANGE_BITS	(TIMER32_WHEEL_LEVEL_BITS * TIMER32_WHEEL_LEVELS)
+/* Минимальный запас в тактах таймера при записи OCR вне прерывания */
+#define TIMER32_WHEEL_MIN_DELTA		2
+
+
+struct __Timer32_Wheel_TimerTypeDef;
+
+/**
+ * @brief Функция обратного вызова программного таймера.
+ *
+ * Вызывается из @ref HAL_Timer32_Wheel_IRQHandler. Из нее допускается запускать и останавливать любые таймеры,
+ * в том числе вызвавший.
+ */
+typedef void (*HAL_Timer32_Wheel_CallbackTypeDef)(struct __Timer32_Wheel_TimerTypeDef *timer);
+
+/**
+ * @brief Программный таймер.
+ *
+ * Описатель должен оставаться доступным, пока таймер запущен. Перед первым запуском служебные поля
+ * должны быть обнулены.
+ */
+typedef struct __Timer32_Wheel_TimerTypeDef
+{
+	HAL_Timer32_Wheel_CallbackTypeDef Callback;		/**< Функция обратного вызова. */
+	void *Context;									/**< Данные пользователя для Callback. */
+	uint32_t Period;								/**< Период в тактах таймера, задается в @ref HAL_Timer32_Wheel_Start. 0 - однократный таймер. */
+
+	uint64_t Expires;								/**< Служебное поле: время срабатывания. */
+	struct __Timer32_Wheel_TimerTypeDef *Next;		/**< Служебное поле: следующий таймер в ячейке. */
+	struct __Timer32_Wheel_TimerTypeDef **PPrev;	/**< Служебное поле: ссылка на таймер в ячейке. NULL - таймер не запущен. */
+	uint8_t Level;									/**< Служебное поле: уровень колеса, #TIMER32_WHEEL_LEVELS - список Far. */
+	uint8_t Slot;									/**< Служебное поле: ячейка уровня. */
+} Timer32_Wheel_TimerTypeDef;
+
+/**
+ * @brief Структура службы программных таймеров.
+ *
+ * Таймеры хранятся в иерархическом колесе: уровень L содержит таймеры, время срабатывания которых
+ * совпадает с текущим временем во всех битах старше 5(L+1), ячейка определяется битами 5L..5L+4.
+ * Таймеры, время срабатывания которых отличается от текущего в битах старше 35, хранятся в списке Far
+ * и переносятся в колесо при переходе границы интервала 2^35 тактов.
+ * Запуск и остановка таймера выполняются за постоянное время. В OCR канала записывается время ближайшего
+ * события колеса: срабатывания таймера нулевого уровня или переноса ячейки верхнего уровня на нижние.
+ *
+ * Таймер Timer32 считает вперед с Top = 0xFFFFFFFF, время расширяется до 64 бит по прерыванию переполнения.
+ * Единица времени - такт таймера, частота задается полями Clock.Source и Clock.Prescaler.
+ * Линия прерывания таймера в EPIC разрешается пользователем, из обработчика вызывается @ref HAL_Timer32_Wheel_IRQHandler.
+ */
+typedef struct __Timer32_Wheel_HandleTypeDef
+{
+	TIMER32_HandleTypeDef *htimer32;				/**< Таймер TIMER32_1 или TIMER32_2. Поля Instance и Clock задаются пользователем, остальные заполняются в @ref HAL_Timer32_Wheel_Init. */
+	HAL_TIMER32_CHANNEL_IndexTypeDef ChannelIndex;	/**< Канал сравнения. Вывод канала настраивается в @ref HAL_TIMER32_Channel_MspInit. */
+
+	TIMER32_CHANNEL_HandleTypeDef Channel;			/**< Служебное поле: канал сравнения. */
+	uint64_t Now;									/**< Служебное поле: время, до которого обработаны события колеса. */
+	uint32_t High;									/**< Служебное поле: количество переполнений таймера. */
+	uint32_t Bitmap[TIMER32_WHEEL_LEVELS];			/**< Служебное поле: занятые ячейки уровней. */
+	Timer32_Wheel_TimerTypeDef *Slots[TIMER32_WHEEL_LEVELS][TIMER32_WHEEL_SLOTS];	/**< Служебное поле: ячейки колеса. */
+	Timer32_Wheel_TimerTypeDef *Far;				/**< Служебное поле: таймеры за границей текущего интервала 2^35 тактов. */
+} Timer32_Wheel_HandleTypeDef;
+
+
+/**
+ * @brief Проверить, запущен ли программный таймер.
+ * @param timer Указатель на программный таймер.
+ * @return 1, если таймер запущен.
+ */
+static inline __attribute__((always_inline)) int HAL_Timer32_Wheel_IsActive(Timer32_Wheel_TimerTypeDef *timer)
+{
+    return timer->PPrev != NULL;
+}
+
+
+HAL_StatusTypeDef HAL_Timer32_Wheel_Init(Timer32_Wheel_HandleTypeDef *hwheel);
+uint64_t HAL_Timer32_Wheel_GetTime(Timer32_Wheel_HandleTypeDef *hwheel);
+HAL_StatusTypeDef HAL_Timer32_Wheel_Start(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer, uint32_t Delay, uint32_t Period);
+void HAL_Timer32_Wheel_Stop(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer);
+void HAL_Timer32_Wheel_IRQHandler(Timer32_Wheel_HandleTypeDef *hwheel);
+
+#endif // MIK32_HAL_TIMER32_WHEEL
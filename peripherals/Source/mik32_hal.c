@@ -1,4 +1,6 @@
 #include "mik32_hal.h"
+#include "mik32_hal_irq.h"
+#include "scr1_timer.h"
 
 
 __attribute__((weak)) void HAL_MspInit()
@@ -15,59 +17,223 @@ HAL_StatusTypeDef HAL_Init()
 }
 
 
+/* Калибровка программной задержки для текущей настройки тактирования */
+static HAL_ProgramDelay_CalibrationTypeDef HAL_ProgramDelay_Calibration;
+
+
 /**
- * @brief Функция программной задержки в миллисекундах
- * @p time_ms - время в миллисекундах. Максимальное значение - 0xFFFFFFFF
+ * @brief Ключ настройки тактирования ядра.
+ * 
+ * Изменение источника системной частоты или делителя AHB требует повторной калибровки.
+ */
+static inline __attribute__((always_inline)) uint32_t HAL_ProgramDelay_ClockKey()
+{
+    return (PM->AHB_CLK_MUX & PM_AHB_CLK_MUX_M) | ((PM->DIV_AHB & 0xFF) << 8) | (1UL << 31);
+}
+
+/**
+ * @brief Цикл программной задержки.
  * 
+ * Выполняется из ОЗУ, чтобы время итерации не зависело от ожидания SPIFI и EEPROM.
+ * @param count Количество итераций, 0 - без задержки.
  */
-// __attribute__((section(".ram_text")))void HAL_ProgramDelayMs(uint32_t time_ms)
-void RAM_ATTR HAL_ProgramDelayMs(uint32_t time_ms)
+static void __attribute__((noinline)) RAM_ATTR HAL_ProgramDelay_Loop(uint32_t count)
 {
-    //register uint32_t del = 1777 * (HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB+1) / 1000UL) / 16000;
-    register uint32_t del = 10695 * (HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB+1) / 1000UL) / 32000;
     asm volatile(
-        "beq    %[count], x0, end_metka_%="         "\n\t"
-        "cycle_main_%=:"
-        //"lui    t0, 0"                              "\n\t"
-        //"addi   t0, %[temp], 1777"                  "\n\t"
-        //"li     %[del], 3555/2"                     "\n\t"
-        //"li     t0,10695"                            "\n\t"
-        "mv     t0, %[del]"                         "\n\t"
-        "cycle_internal_%=:"
-        "addi   t0, t0, -1"                         "\n\t"
-        "bne    t0, x0, cycle_internal_%="          "\n\t"
+        "beqz   %[count], end_metka_%="             "\n\t"
+        "cycle_%=:"
         "addi   %[count], %[count], -1"             "\n\t"
-        "bne    %[count], x0, cycle_main_%="        "\n\t"
+        "bnez   %[count], cycle_%="                 "\n\t"
         "end_metka_%=:"
-        ::
-        [count] "r" (time_ms), [del] "r" (del) : "t0"
+        : [count] "+r" (count)
     );
 }
 
+/**
+ * @brief Время выполнения цикла задержки по счетчику таймера SCR1.
+ * @param count Количество итераций.
+ * @return Количество тактов таймера SCR1.
+ */
+static uint32_t HAL_ProgramDelay_Measure(uint32_t count)
+{
+    uint32_t start = SCR1_TIMER->MTIME;
+    HAL_ProgramDelay_Loop(count);
+    return SCR1_TIMER->MTIME - start;
+}
+
+/**
+ * @brief Рассчитать коэффициенты задержки для частоты ядра.
+ * @param cal Коэффициенты калибровки.
+ * @param core_freq Частота ядра, Гц.
+ * @param iter_q16 Тактов ядра на итерацию цикла задержки, Q16.
+ * @param overhead Накладные расходы вызова, такты ядра.
+ */
+static void HAL_ProgramDelay_SetCoefficients(HAL_ProgramDelay_CalibrationTypeDef *cal, uint32_t core_freq, uint32_t iter_q16, uint32_t overhead)
+{
+    cal->CoreFreq = core_freq;
+    cal->CyclesPerIterQ16 = iter_q16;
+    cal->OverheadCycles = overhead;
+    cal->IterPerUsQ16 = (uint32_t)(((uint64_t)core_freq << 32) / (1000000ULL * iter_q16));
+    cal->OverheadIterQ16 = (uint32_t)(((uint64_t)overhead << 32) / iter_q16);
+    cal->IterPerCycleQ16 = (uint32_t)((1ULL << 32) / iter_q16);
+    cal->Key = HAL_ProgramDelay_ClockKey();
+}
+
+/**
+ * @brief Калибровка программной задержки.
+ * 
+ * Время итерации цикла задержки и накладные расходы вызова измеряются по счетчику таймера SCR1 
+ * при запрещенных прерываниях. Настройки таймера не изменяются, если таймер выключен, он включается 
+ * на время измерения. Функция вызывается из @ref HAL_PCC_Config и может быть вызвана повторно
+ * после изменения тактирования ядра без HAL_PCC_Config.
+ * 
+ * Точность измерения определяется частотой таймера: при тактировании от ядра - 1 такт, при тактировании
+ * от RTC - около 1000 тактов ядра на 32 МГц, в этом случае накладные расходы не учитываются.
+ * 
+ * @warning Прерывания запрещены на все время измерения: несколько тысяч тактов ядра при тактировании таймера
+ * от ядра, около 100 мс при тактировании от RTC.
+ */
+void HAL_ProgramDelay_Calibrate()
+{
+    uint32_t core_freq = HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB + 1);
+    uint32_t timer_ctrl = SCR1_TIMER->TIMER_CTRL;
+    uint32_t timer_freq = (timer_ctrl & SCR1_TIMER_CTRL_CLKSRC_M) ? OSC_CLOCK_VALUE : core_freq;
+    timer_freq /= (SCR1_TIMER->TIMER_DIV & 0x3FF) + 1;
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (!(timer_ctrl & SCR1_TIMER_CTRL_ENABLE_M))
+    {
+        SCR1_TIMER->TIMER_CTRL = timer_ctrl | SCR1_TIMER_CTRL_ENABLE_M;
+    }
+
+    /* Количество итераций подбирается так, чтобы измерение заняло не менее 1024 тактов таймера */
+    uint32_t count = 256;
+    uint32_t ticks = HAL_ProgramDelay_Measure(count);
+    while ((ticks < 1024) && (count < (1UL << 24)))
+    {
+        count <<= 1;
+        ticks = HAL_ProgramDelay_Measure(count);
+    }
+    uint32_t ticks2 = HAL_ProgramDelay_Measure(count * 2);
+
+    SCR1_TIMER->TIMER_CTRL = timer_ctrl;
+    HAL_IRQ_Restore(mstatus);
+
+    /* Разность двух измерений исключает время чтения таймера и вызова */
+    uint64_t timer_cycles_q16 = ((uint64_t)core_freq << 16) / timer_freq;
+    uint32_t iter_q16 = (uint32_t)(((uint64_t)(ticks2 - ticks) * timer_cycles_q16) / count);
+    if (iter_q16 < (1UL << 16))
+    {
+        iter_q16 = 1UL << 16;
+    }
+    uint64_t total_q16 = (uint64_t)ticks * timer_cycles_q16;
+    uint64_t loop_q16 = (uint64_t)iter_q16 * count;
+    uint32_t overhead = (total_q16 > loop_q16) ? (uint32_t)((total_q16 - loop_q16) >> 16) : 0;
+    if (timer_freq < core_freq)
+    {
+        overhead = 0;
+    }
+
+    HAL_ProgramDelay_SetCoefficients(&HAL_ProgramDelay_Calibration, core_freq, iter_q16, overhead);
+}
+
+/**
+ * @brief Получить коэффициенты программной задержки.
+ * 
+ * Функция не выполняет измерений. Время итерации цикла задержки в тактах ядра не зависит от частоты,
+ * поэтому при изменении настройки тактирования коэффициенты пересчитываются для новой частоты ядра.
+ * Если калибровка не выполнялась, используется номинальное время итерации #HAL_PROGRAM_DELAY_NOMINAL_CYCLES
+ * без учета накладных расходов.
+ * @return Указатель на коэффициенты калибровки.
+ */
+const HAL_ProgramDelay_CalibrationTypeDef *HAL_ProgramDelay_GetCalibration()
+{
+    HAL_ProgramDelay_CalibrationTypeDef *cal = &HAL_ProgramDelay_Calibration;
+
+    if (cal->Key != HAL_ProgramDelay_ClockKey())
+    {
+        uint32_t core_freq = HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB + 1);
+        if (cal->CyclesPerIterQ16 == 0)
+        {
+            HAL_ProgramDelay_SetCoefficients(cal, core_freq, HAL_PROGRAM_DELAY_NOMINAL_CYCLES << 16, 0);
+        }
+        else
+        {
+            HAL_ProgramDelay_SetCoefficients(cal, core_freq, cal->CyclesPerIterQ16, cal->OverheadCycles);
+        }
+    }
+
+    return cal;
+}
+
+/**
+ * @brief Выполнить заданное количество итераций цикла задержки.
+ * @param iter_q16 Количество итераций в формате Q16.
+ */
+static void HAL_ProgramDelay_Iterations(uint64_t iter_q16)
+{
+    uint64_t iter = iter_q16 >> 16;
+
+    while (iter > 0x80000000ULL)
+    {
+        HAL_ProgramDelay_Loop(0x80000000UL);
+        iter -= 0x80000000ULL;
+    }
+    HAL_ProgramDelay_Loop((uint32_t)iter);
+}
+
+/**
+ * @brief Функция программной задержки в миллисекундах
+ * @p time_ms - время в миллисекундах. Максимальное значение - 0xFFFFFFFF
+ * 
+ * Коэффициенты задержки рассчитываются функцией @ref HAL_ProgramDelay_Calibrate при настройке тактирования.
+ */
+void HAL_ProgramDelayMs(uint32_t time_ms)
+{
+    const HAL_ProgramDelay_CalibrationTypeDef *cal = HAL_ProgramDelay_GetCalibration();
+    uint64_t iter_q16 = (uint64_t)cal->IterPerUsQ16 * 1000UL;
+
+    while (time_ms > 0)
+    {
+        HAL_ProgramDelay_Iterations(iter_q16);
+        time_ms--;
+    }
+}
+
 /**
  * @brief Функция программной задержки в микросекундах
- * @p time_us - время в миллисекундах. Максимальное значение - 0xFFFFFFFF
+ * @p time_us - время в микросекундах. Максимальное значение - 0xFFFFFFFF
  * 
- * Чем меньше частота AHB, тем больше будет погрешность задержки
+ * Накладные расходы вызова вычитаются из задержки, поэтому короткие задержки выдерживаются с точностью
+ * до итерации цикла. Задержка меньше накладных расходов не выполняется.
  */
-void RAM_ATTR HAL_ProgramDelayUs(uint32_t time_us)
+void HAL_ProgramDelayUs(uint32_t time_us)
 {
-    //time_us >>= 3;
-    //register uint32_t del = 14 * (HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB+1) / 1000UL) / 16000;
-    register uint32_t del = 10 * (HAL_PCC_GetSysClockFreq() / (PM->DIV_AHB+1) / 1000UL) / 32000;
-    asm volatile(
-        "beq    %[count], x0, end_metka_%="         "\n\t"
-        "cycle_main_%=:"
-        "mv     t0, %[del]"                         "\n\t"
-        "cycle_internal_%=:"
-        "addi   t0, t0, -1"                         "\n\t"
-        "bne    t0, x0, cycle_internal_%="          "\n\t"
-        "addi   %[count], %[count], -1"             "\n\t"
-        "bne    %[count], x0, cycle_main_%="        "\n\t"
-        "end_metka_%=:"
-        ::
-        [count] "r" (time_us), [del] "r" (del) : "t0"
-    );
+    const HAL_ProgramDelay_CalibrationTypeDef *cal = HAL_ProgramDelay_GetCalibration();
+    uint64_t iter_q16 = (uint64_t)cal->IterPerUsQ16 * time_us;
+
+    if (iter_q16 > cal->OverheadIterQ16)
+    {
+        HAL_ProgramDelay_Iterations(iter_q16 - cal->OverheadIterQ16);
+    }
+}
+
+/**
+ * @brief Функция программной задержки в тактах ядра
+ * @p cycles - количество тактов ядра.
+ * 
+ * Дискретность задержки - одна итерация цикла (CyclesPerIterQ16). Для задержек в единицы тактов
+ * с точностью до такта используется макрос @ref HAL_PROGRAM_DELAY_NOPS.
+ */
+void HAL_ProgramDelayCycles(uint32_t cycles)
+{
+    const HAL_ProgramDelay_CalibrationTypeDef *cal = HAL_ProgramDelay_GetCalibration();
+
+    if (cycles > cal->OverheadCycles)
+    {
+        HAL_ProgramDelay_Loop((uint32_t)(((uint64_t)(cycles - cal->OverheadCycles) * cal->IterPerCycleQ16) >> 16));
+    }
 }
 
 __attribute__((weak)) uint32_t HAL_Micros()
@@ -0,0 +1,436 @@
+#include "mik32_hal_adc_sampler.h"
+
+
+/*
+ * Порты и выводы каналов АЦП.
+ */
+static GPIO_TypeDef *const HAL_ADC_Sampler_Ports[8] = {GPIO_1, GPIO_1, GPIO_0, GPIO_0, GPIO_0, GPIO_0, GPIO_0, GPIO_0};
+static const HAL_PinsTypeDef HAL_ADC_Sampler_Pins[8] = {
+    1 << ADC_CHANNEL0_PORT_1_5, 1 << ADC_CHANNEL1_PORT_1_7, 1 << ADC_CHANNEL2_PORT_0_2, 1 << ADC_CHANNEL3_PORT_0_4,
+    1 << ADC_CHANNEL4_PORT_0_7, 1 << ADC_CHANNEL5_PORT_0_9, 1 << ADC_CHANNEL6_PORT_0_11, 1 << ADC_CHANNEL7_PORT_0_13};
+
+/*
+ * Function: HAL_ADC_Sampler_ScanInit
+ * Рассчитать слова ADC_CONFIG списка каналов и выбрать первый канал холостым преобразованием.
+ *
+ * Слово шага j выбирает канал Channels[j] и задает время выборки шага j - 1, преобразование которого
+ * запускается той же записью.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ *
+ * Returns:
+ * void
+ */
+static void HAL_ADC_Sampler_ScanInit(ADC_Sampler_HandleTypeDef *hsampler)
+{
+    ANALOG_REG_TypeDef *adc = hsampler->hadc->Instance;
+    uint32_t count = hsampler->ChannelCount;
+    uint8_t sah_default = HAL_ADC_SAH_TIMEGet(hsampler->hadc);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint8_t channel = hsampler->Channels[i];
+        HAL_GPIO_PinConfig(HAL_ADC_Sampler_Ports[channel], HAL_ADC_Sampler_Pins[channel], HAL_GPIO_MODE_ANALOG,
+                           HAL_GPIO_PULL_NONE, HAL_GPIO_DS_2MA);
+    }
+
+#ifdef MIK32V0
+    uint32_t base = adc->ADC_CONFIG & ~(ADC_CONFIG_SEL_M | ADC_CONFIG_SAH_TIME_READ_M);
+#else  // MIK32V2
+    uint32_t base = adc->ADC_CONFIG & ~(ADC_CONFIG_SEL_M | ADC_CONFIG_SAH_TIME_READ_M | ADC_CONFIG_SAH_TIME_WRITE_M);
+#endif // MIK32V0
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t previous = (i == 0) ? (count - 1) : (i - 1);
+        uint8_t sah = (hsampler->SahTimes != NULL) ? hsampler->SahTimes[previous] : sah_default;
+
+        hsampler->ConfigWords[i] = base | ((uint32_t)hsampler->Channels[i] << ADC_CONFIG_SEL_S) |
+                                   (((uint32_t)sah << ADC_CONFIG_SAH_TIME_WRITE_S) & ADC_CONFIG_SAH_TIME_WRITE_M);
+    }
+
+    /* Холостое преобразование для переключения на первый канал, как в HAL_ADC_Init */
+    uint8_t sah = (hsampler->SahTimes != NULL) ? hsampler->SahTimes[0] : sah_default;
+    adc->ADC_CONFIG = base | ((uint32_t)hsampler->Channels[0] << ADC_CONFIG_SEL_S) |
+                      (((uint32_t)sah << ADC_CONFIG_SAH_TIME_WRITE_S) & ADC_CONFIG_SAH_TIME_WRITE_M);
+    adc->ADC_SINGLE = 1;
+    HAL_ADC_WaitValid(hsampler->hadc);
+
+    hsampler->ScanIndex = (count > 1) ? 1 : 0;
+}
+
+/*
+ * Function: HAL_ADC_Sampler_Push
+ * Записать результат в кольцевой буфер и вызвать BlockCallback.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * value - Результат преобразования.
+ *
+ * Returns:
+ * void
+ */
+static inline void HAL_ADC_Sampler_Push(ADC_Sampler_HandleTypeDef *hsampler, uint16_t value)
+{
+    uint32_t index = hsampler->WriteIndex;
+
+    hsampler->Buffer[index] = value;
+    hsampler->WriteIndex = (index + 1 == hsampler->Size) ? 0 : (index + 1);
+    hsampler->WriteCount++;
+
+    if ((hsampler->BlockCallback != NULL) && (++hsampler->BlockCount >= hsampler->BlockSize))
+    {
+        hsampler->BlockCount = 0;
+        hsampler->BlockCallback(hsampler);
+    }
+}
+
+/*
+ * Function: HAL_ADC_Sampler_Process
+ * Пропустить результат через фильтр децимации и записать выходной отсчет.
+ *
+ * Интеграторы работают на частоте результатов канала, гребенчатые звенья - на выходной частоте.
+ * Переполнение интеграторов допустимо: арифметика по модулю 2^32 дает точный выход, если он помещается в 32 бита.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * index - Шаг списка каналов, к которому относится результат.
+ * value - Результат преобразования.
+ *
+ * Returns:
+ * void
+ */
+static inline void HAL_ADC_Sampler_Process(ADC_Sampler_HandleTypeDef *hsampler, uint32_t index, uint16_t value)
+{
+    uint32_t order = hsampler->Filter;
+
+    if (order == ADC_SAMPLER_FILTER_NONE)
+    {
+        HAL_ADC_Sampler_Push(hsampler, value);
+        return;
+    }
+
+    uint32_t phase = hsampler->Phase;
+    uint32_t *integrator = hsampler->Integrator[index];
+    uint32_t sum = value;
+
+    for (uint32_t k = 0; k < order; k++)
+    {
+        integrator[k] += sum;
+        sum = integrator[k];
+    }
+
+    if (hsampler->ResultIndex == 0)
+    {
+        hsampler->Phase = (phase + 1 == hsampler->Oversample) ? 0 : (phase + 1);
+    }
+
+    if (phase + 1 != hsampler->Oversample)
+    {
+        return;
+    }
+
+    uint32_t *comb = hsampler->Comb[index];
+    for (uint32_t k = 0; k < order; k++)
+    {
+        uint32_t previous = comb[k];
+        comb[k] = sum;
+        sum -= previous;
+    }
+
+    sum >>= hsampler->Shift;
+    HAL_ADC_Sampler_Push(hsampler, (sum > 0xFFFF) ? 0xFFFF : (uint16_t)sum);
+}
+
+/*
+ * Function: HAL_ADC_Sampler_Watchdog
+ * Сравнить результат с порогами сторожа канала и вызвать WatchdogCallback при смене зоны.
+ *
+ * Parameters:
+ * hsampler - Указатель на структуру запуска АЦП по таймеру.
+ * index - Шаг списка каналов, к которому относится результат.
+ * value - Результат преобразования.
+ *
+ * Returns:
+ * void
+ */
+static inline void HAL_ADC_Sampler_Watchdog(ADC_Sampler_HandleTypeDef *hsampler, uint32_t index, uint16_t value)
+{
+    uint8_t channel = (hsampler->ChannelCount != 0) ? hsampler->Channels[index] : hsampler->hadc->Init.Sel;
+
+    if (!(hsampler->WatchdogMask & (1 << channel)))
+    {
+        return;
+    }
+
+    ADC_Sampler_WatchdogTypeDef *watchdog = &hsampler->Watchdog[channel];
+    uint8_t zone = watchdog->Zone;
+
+    if (value > watchdog->High)
+    {
+        zone = ADC_SAMPLER_WATCHDOG_HIGH;
+    }
+    else if (value < watchdog->Low)
+    {
+        zone = ADC_SAMPLER_WATCHDOG_LOW;
+    }
+    else if (((zone == ADC_SAMPLER_WATCHDOG_HIGH) && (value + watchdog->Hysteresis < watchdog->High)) ||
+             ((zone == ADC_SAMPLER_WATCHDOG_LOW) && (value > watchdog->Low + watchdog->Hysteresis)))
+    {
+        zone = ADC_SAMPLER_WATCHDOG_NORMAL;
+    }
+
+    if (zone != watchdog->Zone)
+    {
+        watchdog->Zone = zone;
+        if (hsampler->WatchdogCallback != NULL)
+        {
+            hsampler->WatchdogCallback(hsampler, channel, zone, value);
+        }
+    }
+}
+
+HAL_StatusTypeDef HAL_ADC_Sampler_Start(ADC_Sampler_HandleTypeDef *hsampler)
+{
+    if ((hsampler == NULL) || (hsampler->hadc == NULL) || (hsampler->Buffer == NULL) || (hsampler->Size == 0) ||
+        (hsampler->Period == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hsampler->htimer32 == NULL) && ((hsampler->htimer16 == NULL) || (hsampler->Period > 0x10000)))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hsampler->BlockCallback != NULL) && (hsampler->BlockSize == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if (hsampler->ChannelCount != 0)
+    {
+        if ((hsampler->Channels == NULL) || (hsampler->ChannelCount > ADC_SAMPLER_MAX_CHANNELS) ||
+            ((hsampler->Size % hsampler->ChannelCount) != 0))
+        {
+            return HAL_ERROR;
+        }
+
+        for (uint32_t i = 0; i < hsampler->ChannelCount; i++)
+        {
+            if (hsampler->Channels[i] > ADC_CHANNEL7)
+            {
+                return HAL_ERROR;
+            }
+        }
+    }
+
+    if (hsampler->Filter > ADC_SAMPLER_FILTER_CIC3)
+    {
+        return HAL_ERROR;
+    }
+
+    if (hsampler->Filter != ADC_SAMPLER_FILTER_NONE)
+    {
+        /* Усиление Oversample^порядок не больше 2^20: выход 12-битного АЦП помещается в 32 бита */
+        uint64_t gain = 1;
+        for (uint32_t k = 0; k < hsampler->Filter; k++)
+        {
+            gain *= hsampler->Oversample;
+        }
+
+        if ((hsampler->Oversample < 2) || (hsampler->Oversample > (1 << 20)) || (gain > (1 << 20)) ||
+            (hsampler->Shift > 31))
+        {
+            return HAL_ERROR;
+        }
+    }
+
+    HAL_ADC_Sampler_Stop(hsampler);
+    HAL_ADC_ContinuousDisable(hsampler->hadc);
+
+    hsampler->WriteCount = 0;
+    hsampler->WriteIndex = 0;
+    hsampler->ReadCount = 0;
+    hsampler->ReadIndex = 0;
+    hsampler->Overruns = 0;
+    hsampler->BlockCount = 0;
+    hsampler->Primed = 0;
+    hsampler->ResultIndex = 0;
+    hsampler->Phase = 0;
+    for (uint32_t i = 0; i < ADC_SAMPLER_WATCHDOG_CHANNELS; i++)
+    {
+        hsampler->Watchdog[i].Zone = ADC_SAMPLER_WATCHDOG_NORMAL;
+    }
+    for (uint32_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++)
+    {
+        for (uint32_t k = 0; k < ADC_SAMPLER_FILTER_CIC3; k++)
+        {
+            hsampler->Integrator[i][k] = 0;
+            hsampler->Comb[i][k] = 0;
+        }
+    }
+
+    if (hsampler->ChannelCount != 0)
+    {
+        HAL_ADC_Sampler_ScanInit(hsampler);
+    }
+
+    if (hsampler->htimer32 != NULL)
+    {
+        HAL_Timer32_Top_Set(hsampler->htimer32, hsampler->Period - 1);
+        HAL_Timer32_Value_Clear(hsampler->htimer32);
+        HAL_Timer32_InterruptFlags_ClearMask(hsampler->htimer32, TIMER32_INT_OVERFLOW_M);
+        HAL_Timer32_InterruptMask_Set(hsampler->htimer32, TIMER32_INT_OVERFLOW_M);
+        HAL_Timer32_Start(hsampler->htimer32);
+    }
+    else
+    {
+        HAL_Timer16_Counter_Start(hsampler->htimer16, hsampler->Period - 1);
+        hsampler->htimer16->Instance->ICR = TIMER16_ICR_ARRMCF_M;
+        hsampler->htimer16->Instance->IER |= TIMER16_IER_ARRMIE_M;
+    }
+
+    return HAL_OK;
+}
+
+void HAL_ADC_Sampler_Stop(ADC_Sampler_HandleTypeDef *hsampler)
+{
+    if (hsampler->htimer32 != NULL)
+    {
+        HAL_Timer32_InterruptMask_Clear(hsampler->htimer32, TIMER32_INT_OVERFLOW_M);
+        HAL_Timer32_Stop(hsampler->htimer32);
+    }
+    else
+    {
+        hsampler->htimer16->Instance->IER &= ~TIMER16_IER_ARRMIE_M;
+        HAL_Timer16_Disable(hsampler->htimer16);
+    }
+}
+
+void HAL_ADC_Sampler_IRQHandler(ADC_Sampler_HandleTypeDef *hsampler)
+{
+    ANALOG_REG_TypeDef *adc = hsampler->hadc->Instance;
+
+    /* Чтение результата, выбор следующего канала и запуск преобразования - первыми, чтобы задержка выборки была постоянной */
+    uint16_t value = adc->ADC_VALUE;
+    if (hsampler->ChannelCount > 1)
+    {
+        uint32_t index = hsampler->ScanIndex;
+
+        adc->ADC_CONFIG = hsampler->ConfigWords[index];
+        adc->ADC_SINGLE = 1;
+        hsampler->ScanIndex = (index + 1 == hsampler->ChannelCount) ? 0 : (index + 1);
+    }
+    else
+    {
+        adc->ADC_SINGLE = 1;
+    }
+
+    if (hsampler->htimer32 != NULL)
+    {
+        HAL_Timer32_InterruptFlags_ClearMask(hsampler->htimer32, TIMER32_INT_OVERFLOW_M);
+    }
+    else
+    {
+        hsampler->htimer16->Instance->ICR = TIMER16_ICR_ARRMCF_M;
+    }
+
+    /* На первом событии таймера ADC_VALUE содержит результат, полученный до запуска */
+    if (!hsampler->Primed)
+    {
+        hsampler->Primed = 1;
+        return;
+    }
+
+    uint32_t index = hsampler->ResultIndex;
+    hsampler->ResultIndex = (index + 1 >= hsampler->ChannelCount) ? 0 : (index + 1);
+
+    if (hsampler->WatchdogMask != 0)
+    {
+        HAL_ADC_Sampler_Watchdog(hsampler, index, value);
+    }
+
+    HAL_ADC_Sampler_Process(hsampler, index, value);
+}
+
+uint32_t HAL_ADC_Sampler_Available(ADC_Sampler_HandleTypeDef *hsampler)
+{
+    uint32_t available = hsampler->WriteCount - hsampler->ReadCount;
+
+    if (available > hsampler->Size)
+    {
+        uint32_t lost = available - hsampler->Size;
+
+        /* Пропускаются целые кадры, чтобы чтение начиналось с первого канала списка */
+        if (hsampler->ChannelCount > 1)
+        {
+            lost += (hsampler->ChannelCount - (lost % hsampler->ChannelCount)) % hsampler->ChannelCount;
+        }
+
+        hsampler->Overruns += lost;
+        hsampler->ReadCount += lost;
+        hsampler->ReadIndex = (hsampler->ReadIndex + lost) % hsampler->Size;
+        available -= lost;
+    }
+
+    return available;
+}
+
+uint32_t HAL_ADC_Sampler_Read(ADC_Sampler_HandleTypeDef *hsampler, uint16_t *pData, uint32_t MaxCount)
+{
+    uint32_t count = HAL_ADC_Sampler_Available(hsampler);
+    if (count > MaxCount)
+    {
+        count = MaxCount;
+    }
+    if (hsampler->ChannelCount > 1)
+    {
+        count -= count % hsampler->ChannelCount;
+    }
+
+    uint32_t index = hsampler->ReadIndex;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pData[i] = hsampler->Buffer[index];
+        index = (index + 1 == hsampler->Size) ? 0 : (index + 1);
+    }
+    hsampler->ReadIndex = index;
+    hsampler->ReadCount += count;
+
+    return count;
+}
+
+HAL_StatusTypeDef HAL_ADC_Sampler_WatchdogSet(ADC_Sampler_HandleTypeDef *hsampler, uint8_t channel, uint16_t low,
+                                              uint16_t high, uint16_t hysteresis)
+{
+    if ((channel >= ADC_SAMPLER_WATCHDOG_CHANNELS) || (low > high) || (hysteresis > high - low))
+    {
+        return HAL_ERROR;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    hsampler->Watchdog[channel].Low = low;
+    hsampler->Watchdog[channel].High = high;
+    hsampler->Watchdog[channel].Hysteresis = hysteresis;
+    hsampler->Watchdog[channel].Zone = ADC_SAMPLER_WATCHDOG_NORMAL;
+    hsampler->WatchdogMask |= 1 << channel;
+
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+void HAL_ADC_Sampler_WatchdogDisable(ADC_Sampler_HandleTypeDef *hsampler, uint8_t channel)
+{
+    if (channel >= ADC_SAMPLER_WATCHDOG_CHANNELS)
+    {
+        return;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    hsampler->WatchdogMask &= ~(1 << channel);
+    HAL_IRQ_Restore(mstatus);
+}
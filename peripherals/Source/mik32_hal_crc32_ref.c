@@ -0,0 +1,40 @@
+#include "mik32_hal_crc32_ref.h"
+
+
+uint32_t HAL_CRC_Ref_Reflect32(uint32_t value)
+{
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+    value = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+    return (value >> 16) | (value << 16);
+}
+
+uint32_t HAL_CRC_Ref_Calculate(const CRC_Ref_ConfigTypeDef *config, const uint8_t message[], uint32_t message_length)
+{
+    uint32_t crc = config->Init;
+
+    for (uint32_t i = 0; i < message_length; i++)
+    {
+        uint32_t byte = message[i];
+
+        /* Биты байта подаются начиная со старшего, при RefIn - начиная с младшего */
+        if (config->RefIn)
+        {
+            byte = HAL_CRC_Ref_Reflect32(byte) >> 24;
+        }
+
+        crc ^= byte << 24;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80000000) ? ((crc << 1) ^ config->Poly) : (crc << 1);
+        }
+    }
+
+    if (config->RefOut)
+    {
+        crc = HAL_CRC_Ref_Reflect32(crc);
+    }
+
+    return crc ^ config->XorOut;
+}
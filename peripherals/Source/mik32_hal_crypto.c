@@ -1,4 +1,5 @@
 #include "mik32_hal_crypto.h"
+#include "mik32_hal_prof.h"
 
 /**
  * @brief Включение тактирования модуля Crypto. 
@@ -217,6 +218,8 @@ void HAL_Crypto_Init(Crypto_HandleTypeDef *hcrypto)
  */
 void HAL_Crypto_Encode(Crypto_HandleTypeDef *hcrypto, uint32_t plain_text[], uint32_t cipher_text[], uint32_t text_length)
 {
+    HAL_PROF_BEGIN(crypto_encode);
+
     uint8_t block_size = 0;
 
     switch (hcrypto->Algorithm)
@@ -238,6 +241,7 @@ void HAL_Crypto_Encode(Crypto_HandleTypeDef *hcrypto, uint32_t plain_text[], uin
         xprintf("Длина текста не кратна длине блока\n");
         #endif
         
+        HAL_PROF_END(crypto_encode);
         return;
     }
 
@@ -267,7 +271,8 @@ void HAL_Crypto_Encode(Crypto_HandleTypeDef *hcrypto, uint32_t plain_text[], uin
             cipher_text[word_index] = hcrypto->Instance->BLOCK;
         }
     }
-     
+
+    HAL_PROF_END(crypto_encode);
 }
 
 /**
@@ -0,0 +1,523 @@
+#include "mik32_hal_crypto_ref.h"
+
+
+/**
+ * @brief Нелинейная подстановка Pi Кузнечика.
+ */
+static const uint8_t Kuznechik_Pi[256] =
+{
+    252, 238, 221,  17, 207, 110,  49,  22, 251, 196, 250, 218,  35, 197,   4,  77,
+    233, 119, 240, 219, 147,  46, 153, 186,  23,  54, 241, 187,  20, 205,  95, 193,
+    249,  24, 101,  90, 226,  92, 239,  33, 129,  28,  60,  66, 139,   1, 142,  79,
+      5, 132,   2, 174, 227, 106, 143, 160,   6,  11, 237, 152, 127, 212, 211,  31,
+    235,  52,  44,  81, 234, 200,  72, 171, 242,  42, 104, 162, 253,  58, 206, 204,
+    181, 112,  14,  86,   8,  12, 118,  18, 191, 114,  19,  71, 156, 183,  93, 135,
+     21, 161, 150,  41,  16, 123, 154, 199, 243, 145, 120, 111, 157, 158, 178, 177,
+     50, 117,  25,  61, 255,  53, 138, 126, 109,  84, 198, 128, 195, 189,  13,  87,
+    223, 245,  36, 169,  62, 168,  67, 201, 215, 121, 214, 246, 124,  34, 185,   3,
+    224,  15, 236, 222, 122, 148, 176, 188, 220, 232,  40,  80,  78,  51,  10,  74,
+    167, 151,  96, 115,  30,   0,  98,  68,  26, 184,  56, 130, 100, 159,  38,  65,
+    173,  69,  70, 146,  39,  94,  85,  47, 140, 163, 165, 125, 105, 213, 149,  59,
+      7,  88, 179,  64, 134, 172,  29, 247,  48,  55, 107, 228, 136, 217, 231, 137,
+    225,  27, 131,  73,  76,  63, 248, 254, 141,  83, 170, 144, 202, 216, 133,  97,
+     32, 113, 103, 164,  45,  43,   9,  91, 203, 155,  37, 208, 190, 229, 108,  82,
+     89, 166, 116, 210, 230, 244, 180, 192, 209, 102, 175, 194,  57,  75,  99, 182,
+};
+
+/**
+ * @brief Коэффициенты линейного преобразования l Кузнечика, начиная со старшего байта.
+ */
+static const uint8_t Kuznechik_L[16] = {148, 32, 133, 16, 194, 192, 1, 251, 1, 192, 194, 16, 133, 32, 148, 1};
+
+/**
+ * @brief Подстановки Pi0..Pi7 Магмы, Pi0 применяется к младшим 4 битам.
+ */
+static const uint8_t Magma_Pi[8][16] =
+{
+    {12, 4, 6, 2, 10, 5, 11, 9, 14, 8, 13, 7, 0, 3, 15, 1},
+    {6, 8, 2, 3, 9, 10, 5, 12, 1, 14, 4, 7, 11, 13, 0, 15},
+    {11, 3, 5, 8, 2, 15, 10, 13, 14, 1, 7, 4, 12, 9, 6, 0},
+    {12, 8, 2, 1, 13, 4, 15, 6, 7, 0, 10, 5, 3, 14, 9, 11},
+    {7, 15, 5, 10, 8, 1, 6, 13, 0, 9, 3, 14, 11, 4, 2, 12},
+    {5, 13, 15, 6, 9, 2, 12, 10, 11, 7, 8, 1, 4, 3, 14, 0},
+    {8, 14, 2, 5, 6, 9, 1, 12, 15, 4, 11, 0, 13, 10, 3, 7},
+    {1, 7, 14, 13, 0, 5, 8, 3, 4, 15, 10, 6, 9, 12, 11, 2},
+};
+
+/* Обратные подстановки и S-блок AES строятся при первой установке ключа */
+static uint8_t Kuznechik_PiInv[256];
+static uint8_t Aes_Sbox[256];
+static uint8_t Aes_SboxInv[256];
+static uint8_t Tables_Ready = 0;
+
+/**
+ * @brief Умножение в поле GF(2^8).
+ * @param poly Младшие 8 бит порождающего многочлена: 0x1B для AES, 0xC3 для Кузнечика.
+ */
+static uint8_t HAL_Crypto_Ref_GfMul(uint8_t a, uint8_t b, uint8_t poly)
+{
+    uint8_t result = 0;
+
+    while (b != 0)
+    {
+        if (b & 1)
+        {
+            result ^= a;
+        }
+        a = (a & 0x80) ? (uint8_t)((a << 1) ^ poly) : (uint8_t)(a << 1);
+        b >>= 1;
+    }
+
+    return result;
+}
+
+static void HAL_Crypto_Ref_BuildTables(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        Kuznechik_PiInv[Kuznechik_Pi[i]] = (uint8_t)i;
+    }
+
+    /* S-блок AES: обратный элемент в GF(2^8) и аффинное преобразование */
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint8_t inverse = 0;
+        if (i != 0)
+        {
+            /* x^254 = x^-1 */
+            uint8_t power = (uint8_t)i;
+            inverse = 1;
+            for (uint32_t bit = 0; bit < 8; bit++)
+            {
+                if ((254 >> bit) & 1)
+                {
+                    inverse = HAL_Crypto_Ref_GfMul(inverse, power, 0x1B);
+                }
+                power = HAL_Crypto_Ref_GfMul(power, power, 0x1B);
+            }
+        }
+
+        uint8_t s = inverse;
+        for (uint32_t shift = 1; shift < 5; shift++)
+        {
+            s ^= (uint8_t)((inverse << shift) | (inverse >> (8 - shift)));
+        }
+        s ^= 0x63;
+
+        Aes_Sbox[i] = s;
+        Aes_SboxInv[s] = (uint8_t)i;
+    }
+
+    Tables_Ready = 1;
+}
+
+/**
+ * @brief Преобразование R Кузнечика: сдвиг на байт в сторону младших с результатом l в старшем байте.
+ */
+static void HAL_Crypto_Ref_KuznechikR(uint8_t a[16])
+{
+    uint8_t x = 0;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        x ^= HAL_Crypto_Ref_GfMul(a[i], Kuznechik_L[i], 0xC3);
+    }
+    for (uint32_t i = 15; i > 0; i--)
+    {
+        a[i] = a[i - 1];
+    }
+    a[0] = x;
+}
+
+static void HAL_Crypto_Ref_KuznechikRInv(uint8_t a[16])
+{
+    uint8_t x = a[0];
+
+    for (uint32_t i = 0; i < 15; i++)
+    {
+        a[i] = a[i + 1];
+        x ^= HAL_Crypto_Ref_GfMul(a[i], Kuznechik_L[i], 0xC3);
+    }
+    a[15] = x;
+}
+
+/**
+ * @brief Преобразование LSX[k] Кузнечика.
+ */
+static void HAL_Crypto_Ref_KuznechikLSX(uint8_t a[16], const uint8_t k[16])
+{
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        a[i] = Kuznechik_Pi[a[i] ^ k[i]];
+    }
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        HAL_Crypto_Ref_KuznechikR(a);
+    }
+}
+
+/**
+ * @brief Развертывание ключа Кузнечика: K1, K2 - половины ключа, остальные - 32 итерации сети Фейстеля
+ *        с константами C_i = L(i).
+ */
+static void HAL_Crypto_Ref_KuznechikSetKey(uint8_t round_keys[], const uint8_t Key[])
+{
+    uint8_t a1[16];
+    uint8_t a0[16];
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        a1[i] = Key[i];
+        a0[i] = Key[16 + i];
+        round_keys[i] = a1[i];
+        round_keys[16 + i] = a0[i];
+    }
+
+    for (uint32_t pair = 1; pair < 5; pair++)
+    {
+        for (uint32_t j = 1; j <= 8; j++)
+        {
+            uint8_t c[16] = {0};
+            uint8_t t[16];
+
+            c[15] = (uint8_t)(8 * (pair - 1) + j);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                HAL_Crypto_Ref_KuznechikR(c);
+            }
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                t[i] = a1[i];
+            }
+            HAL_Crypto_Ref_KuznechikLSX(t, c);
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                t[i] ^= a0[i];
+                a0[i] = a1[i];
+                a1[i] = t[i];
+            }
+        }
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            round_keys[32 * pair + i] = a1[i];
+            round_keys[32 * pair + 16 + i] = a0[i];
+        }
+    }
+}
+
+static void HAL_Crypto_Ref_KuznechikEncrypt(const uint8_t round_keys[], uint8_t block[])
+{
+    for (uint32_t round = 0; round < 9; round++)
+    {
+        HAL_Crypto_Ref_KuznechikLSX(block, &round_keys[16 * round]);
+    }
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        block[i] ^= round_keys[16 * 9 + i];
+    }
+}
+
+static void HAL_Crypto_Ref_KuznechikDecrypt(const uint8_t round_keys[], uint8_t block[])
+{
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        block[i] ^= round_keys[16 * 9 + i];
+    }
+    for (int32_t round = 8; round >= 0; round--)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            HAL_Crypto_Ref_KuznechikRInv(block);
+        }
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            block[i] = Kuznechik_PiInv[block[i]] ^ round_keys[16 * round + i];
+        }
+    }
+}
+
+static uint32_t HAL_Crypto_Ref_Load32(const uint8_t bytes[])
+{
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3];
+}
+
+static void HAL_Crypto_Ref_Store32(uint8_t bytes[], uint32_t value)
+{
+    bytes[0] = (uint8_t)(value >> 24);
+    bytes[1] = (uint8_t)(value >> 16);
+    bytes[2] = (uint8_t)(value >> 8);
+    bytes[3] = (uint8_t)value;
+}
+
+/**
+ * @brief Преобразование g[k] Магмы: сложение с ключом, подстановка по 4 бита и циклический сдвиг на 11.
+ */
+static uint32_t HAL_Crypto_Ref_MagmaG(uint32_t a, uint32_t k)
+{
+    uint32_t x = a + k;
+    uint32_t t = 0;
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        t |= (uint32_t)Magma_Pi[i][(x >> (4 * i)) & 0xF] << (4 * i);
+    }
+
+    return (t << 11) | (t >> 21);
+}
+
+/**
+ * @brief 32 итерации Магмы. При шифровании ключи K1..K8 три раза и K8..K1, при расшифровании
+ *        K1..K8 один раз и K8..K1 три раза.
+ */
+static void HAL_Crypto_Ref_MagmaRounds(const uint8_t round_keys[], uint8_t block[], uint32_t forward_rounds)
+{
+    uint32_t a1 = HAL_Crypto_Ref_Load32(&block[0]);
+    uint32_t a0 = HAL_Crypto_Ref_Load32(&block[4]);
+
+    for (uint32_t round = 0; round < 32; round++)
+    {
+        uint32_t index = (round < forward_rounds) ? (round % 8) : (7 - (round % 8));
+        uint32_t t = a1 ^ HAL_Crypto_Ref_MagmaG(a0, HAL_Crypto_Ref_Load32(&round_keys[4 * index]));
+
+        if (round == 31)
+        {
+            a1 = t;
+        }
+        else
+        {
+            a1 = a0;
+            a0 = t;
+        }
+    }
+
+    HAL_Crypto_Ref_Store32(&block[0], a1);
+    HAL_Crypto_Ref_Store32(&block[4], a0);
+}
+
+static uint8_t HAL_Crypto_Ref_AesXtime(uint8_t a)
+{
+    return HAL_Crypto_Ref_GfMul(a, 2, 0x1B);
+}
+
+/**
+ * @brief Развертывание ключа AES-128 в 44 слова.
+ */
+static void HAL_Crypto_Ref_AesSetKey(uint8_t round_keys[], const uint8_t Key[])
+{
+    uint8_t rcon = 1;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        round_keys[i] = Key[i];
+    }
+
+    for (uint32_t i = 4; i < 44; i++)
+    {
+        uint8_t t[4];
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            t[j] = round_keys[4 * (i - 1) + j];
+        }
+
+        if ((i % 4) == 0)
+        {
+            /* RotWord, SubWord, Rcon */
+            uint8_t first = t[0];
+            t[0] = Aes_Sbox[t[1]] ^ rcon;
+            t[1] = Aes_Sbox[t[2]];
+            t[2] = Aes_Sbox[t[3]];
+            t[3] = Aes_Sbox[first];
+            rcon = HAL_Crypto_Ref_AesXtime(rcon);
+        }
+
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            round_keys[4 * i + j] = round_keys[4 * (i - 4) + j] ^ t[j];
+        }
+    }
+}
+
+static void HAL_Crypto_Ref_AesAddRoundKey(uint8_t state[], const uint8_t round_key[])
+{
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        state[i] ^= round_key[i];
+    }
+}
+
+/**
+ * @brief Сдвиг строки r состояния (байты r, r + 4, r + 8, r + 12) на shift столбцов влево.
+ */
+static void HAL_Crypto_Ref_AesShiftRows(uint8_t state[], uint32_t inverse)
+{
+    for (uint32_t r = 1; r < 4; r++)
+    {
+        uint8_t row[4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            row[c] = state[r + 4 * c];
+        }
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            uint32_t source = inverse ? ((c + 4 - r) % 4) : ((c + r) % 4);
+            state[r + 4 * c] = row[source];
+        }
+    }
+}
+
+static void HAL_Crypto_Ref_AesMixColumns(uint8_t state[], uint32_t inverse)
+{
+    /* Коэффициенты первой строки матрицы: {2, 3, 1, 1} и {14, 11, 13, 9} для обратного */
+    const uint8_t forward[4] = {2, 3, 1, 1};
+    const uint8_t backward[4] = {14, 11, 13, 9};
+    const uint8_t *m = inverse ? backward : forward;
+
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        uint8_t column[4];
+        for (uint32_t r = 0; r < 4; r++)
+        {
+            column[r] = state[4 * c + r];
+        }
+        for (uint32_t r = 0; r < 4; r++)
+        {
+            uint8_t x = 0;
+            for (uint32_t k = 0; k < 4; k++)
+            {
+                x ^= HAL_Crypto_Ref_GfMul(column[k], m[(k + 4 - r) % 4], 0x1B);
+            }
+            state[4 * c + r] = x;
+        }
+    }
+}
+
+static void HAL_Crypto_Ref_AesEncrypt(const uint8_t round_keys[], uint8_t state[])
+{
+    HAL_Crypto_Ref_AesAddRoundKey(state, &round_keys[0]);
+    for (uint32_t round = 1; round <= 10; round++)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            state[i] = Aes_Sbox[state[i]];
+        }
+        HAL_Crypto_Ref_AesShiftRows(state, 0);
+        if (round != 10)
+        {
+            HAL_Crypto_Ref_AesMixColumns(state, 0);
+        }
+        HAL_Crypto_Ref_AesAddRoundKey(state, &round_keys[16 * round]);
+    }
+}
+
+static void HAL_Crypto_Ref_AesDecrypt(const uint8_t round_keys[], uint8_t state[])
+{
+    HAL_Crypto_Ref_AesAddRoundKey(state, &round_keys[16 * 10]);
+    for (int32_t round = 9; round >= 0; round--)
+    {
+        HAL_Crypto_Ref_AesShiftRows(state, 1);
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            state[i] = Aes_SboxInv[state[i]];
+        }
+        HAL_Crypto_Ref_AesAddRoundKey(state, &round_keys[16 * round]);
+        if (round != 0)
+        {
+            HAL_Crypto_Ref_AesMixColumns(state, 1);
+        }
+    }
+}
+
+/**
+ * @brief Длина блока алгоритма, байт.
+ * @param Algorithm Алгоритм шифрования.
+ */
+uint32_t HAL_Crypto_Ref_BlockBytes(uint8_t Algorithm)
+{
+    return (Algorithm == CRYPTO_REF_MAGMA) ? 8 : 16;
+}
+
+/**
+ * @brief Длина ключа алгоритма, байт.
+ * @param Algorithm Алгоритм шифрования.
+ */
+uint32_t HAL_Crypto_Ref_KeyBytes(uint8_t Algorithm)
+{
+    return (Algorithm == CRYPTO_REF_AES) ? 16 : 32;
+}
+
+/**
+ * @brief Развернуть ключ.
+ * @param key Развернутый ключ.
+ * @param Algorithm Алгоритм шифрования.
+ * @param Key Ключ длиной @ref HAL_Crypto_Ref_KeyBytes, первый байт - старший.
+ */
+void HAL_Crypto_Ref_SetKey(Crypto_Ref_KeyTypeDef *key, uint8_t Algorithm, const uint8_t Key[])
+{
+    if (!Tables_Ready)
+    {
+        HAL_Crypto_Ref_BuildTables();
+    }
+
+    key->Algorithm = Algorithm;
+
+    switch (Algorithm)
+    {
+    case CRYPTO_REF_KUZNECHIK:
+        HAL_Crypto_Ref_KuznechikSetKey(key->RoundKeys, Key);
+        break;
+    case CRYPTO_REF_MAGMA:
+        /* Итерационные ключи K1..K8 - слова ключа начиная со старшего */
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            key->RoundKeys[i] = Key[i];
+        }
+        break;
+    case CRYPTO_REF_AES:
+        HAL_Crypto_Ref_AesSetKey(key->RoundKeys, Key);
+        break;
+    }
+}
+
+/**
+ * @brief Зашифровать один блок.
+ * @param key Развернутый ключ.
+ * @param block Блок длиной @ref HAL_Crypto_Ref_BlockBytes, первый байт - старший. Результат записывается на место блока.
+ */
+void HAL_Crypto_Ref_EncryptBlock(const Crypto_Ref_KeyTypeDef *key, uint8_t block[])
+{
+    switch (key->Algorithm)
+    {
+    case CRYPTO_REF_KUZNECHIK:
+        HAL_Crypto_Ref_KuznechikEncrypt(key->RoundKeys, block);
+        break;
+    case CRYPTO_REF_MAGMA:
+        HAL_Crypto_Ref_MagmaRounds(key->RoundKeys, block, 24);
+        break;
+    case CRYPTO_REF_AES:
+        HAL_Crypto_Ref_AesEncrypt(key->RoundKeys, block);
+        break;
+    }
+}
+
+/**
+ * @brief Расшифровать один блок.
+ * @param key Развернутый ключ.
+ * @param block Блок длиной @ref HAL_Crypto_Ref_BlockBytes, первый байт - старший. Результат записывается на место блока.
+ */
+void HAL_Crypto_Ref_DecryptBlock(const Crypto_Ref_KeyTypeDef *key, uint8_t block[])
+{
+    switch (key->Algorithm)
+    {
+    case CRYPTO_REF_KUZNECHIK:
+        HAL_Crypto_Ref_KuznechikDecrypt(key->RoundKeys, block);
+        break;
+    case CRYPTO_REF_MAGMA:
+        HAL_Crypto_Ref_MagmaRounds(key->RoundKeys, block, 8);
+        break;
+    case CRYPTO_REF_AES:
+        HAL_Crypto_Ref_AesDecrypt(key->RoundKeys, block);
+        break;
+    }
+}
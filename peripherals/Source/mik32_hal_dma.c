@@ -2,15 +2,68 @@
 
 /** 
  * @brief Данная переменная хранит последнее записанное значение в регистр CHx_CFG. 
+ * 
+ * Изменение элемента массива и запись в регистр выполняются в критической секции,
+ * поэтому функции канала можно вызывать как из основного потока, так и из прерываний.
  * @warning Не следует изменять значение данной переменной. 
  */
-static uint32_t CFGWriteBuffer[4] = {0}; 
+static volatile uint32_t CFGWriteBuffer[4] = {0}; 
 
 /** 
  * @brief Данная переменная используется для хранения значения битовых полей CONFIG_STATUS[8:6]. 
+ * 
+ * Биты очистки флагов прерываний в переменной не хранятся. Чтение значения и запись регистра,
+ * как и изменение значения, выполняются в критической секции.
  * @warning Не следует изменять значение данной переменной. 
  */
-static uint32_t ConfigStatusWriteBuffer = 0;
+static volatile uint32_t ConfigStatusWriteBuffer = 0;
+
+/**
+ * @brief Записать в регистр CONFIG_STATUS сохраненные настройки вместе с битами очистки флагов.
+ * 
+ * Чтение ConfigStatusWriteBuffer и запись регистра выполняются в короткой критической секции: иначе
+ * прерывание между ними может изменить настройки, и запись вернет в регистр устаревшее значение.
+ * @param hdma Указатель на структуру для инициализации DMA.
+ * @param ClearMask Маска битов очистки флагов прерываний.
+ */
+static inline __attribute__((always_inline)) void HAL_DMA_WriteClear(DMA_InitTypeDef *hdma, uint32_t ClearMask)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer | ClearMask;
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Изменить битовые поля ConfigStatusWriteBuffer и записать результат в регистр CONFIG_STATUS.
+ * @param hdma Указатель на структуру для инициализации DMA.
+ * @param Mask Маска изменяемых битовых полей.
+ * @param Value Новое значение битовых полей.
+ */
+static void HAL_DMA_ConfigStatusModify(DMA_InitTypeDef *hdma, uint32_t Mask, uint32_t Value)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    uint32_t config = (ConfigStatusWriteBuffer & ~Mask) | (Value & Mask);
+    ConfigStatusWriteBuffer = config;
+    hdma->Instance->CONFIG_STATUS = config;
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Изменить битовые поля CFGWriteBuffer канала и записать результат в регистр CHx_CFG.
+ * @param hdma_channel Структура для инициализации канала DMA.
+ * @param Mask Маска изменяемых битовых полей.
+ * @param Value Новое значение битовых полей.
+ */
+static void HAL_DMA_ChannelCFGModify(DMA_ChannelHandleTypeDef *hdma_channel, uint32_t Mask, uint32_t Value)
+{
+    uint32_t ChannelIndex = hdma_channel->ChannelInit.Channel;
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    uint32_t cfg = (CFGWriteBuffer[ChannelIndex] & ~Mask) | (Value & Mask);
+    CFGWriteBuffer[ChannelIndex] = cfg;
+    hdma_channel->dma->Instance->CHANNELS[ChannelIndex].CFG = cfg;
+    HAL_IRQ_Restore(mstatus);
+}
 
 
 /**
@@ -40,10 +93,7 @@ void HAL_DMA_SetChannel(DMA_ChannelHandleTypeDef *hdma_channel, HAL_DMA_ChannelI
  */
 void HAL_DMA_ClearLocalIrq(DMA_InitTypeDef *hdma)
 {
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
-    ConfigStatusWriteBuffer |= DMA_CONFIG_CLEAR_LOCAL_IRQ_M;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
+    HAL_DMA_WriteClear(hdma, DMA_CONFIG_CLEAR_LOCAL_IRQ_M);
 }
 
 /**
@@ -52,10 +102,7 @@ void HAL_DMA_ClearLocalIrq(DMA_InitTypeDef *hdma)
  */
 void HAL_DMA_ClearGlobalIrq(DMA_InitTypeDef *hdma)
 {
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
-    ConfigStatusWriteBuffer |= DMA_CONFIG_CLEAR_GLOBAL_IRQ_M;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
+    HAL_DMA_WriteClear(hdma, DMA_CONFIG_CLEAR_GLOBAL_IRQ_M);
 }
 
 /**
@@ -64,10 +111,7 @@ void HAL_DMA_ClearGlobalIrq(DMA_InitTypeDef *hdma)
  */
 void HAL_DMA_ClearErrorIrq(DMA_InitTypeDef *hdma)
 {
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
-    ConfigStatusWriteBuffer |= DMA_CONFIG_CLEAR_ERROR_IRQ_M;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
-    ConfigStatusWriteBuffer &= ~(DMA_CONFIG_CLEAR_LOCAL_IRQ_M | DMA_CONFIG_CLEAR_GLOBAL_IRQ_M | DMA_CONFIG_CLEAR_ERROR_IRQ_M);
+    HAL_DMA_WriteClear(hdma, DMA_CONFIG_CLEAR_ERROR_IRQ_M);
 }
 
 /**
@@ -94,9 +138,7 @@ void HAL_DMA_ClearIrq(DMA_InitTypeDef *hdma)
 void HAL_DMA_SetCurrentValue(DMA_InitTypeDef *hdma, HAL_DMA_CurrentValueTypeDef CurrentValue)
 {
     hdma->CurrentValue = CurrentValue;
-    ConfigStatusWriteBuffer &= ~DMA_CONFIG_CURRENT_VALUE_M;
-    ConfigStatusWriteBuffer |= CurrentValue <<  DMA_CONFIG_CURRENT_VALUE_S;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
+    HAL_DMA_ConfigStatusModify(hdma, DMA_CONFIG_CURRENT_VALUE_M, CurrentValue << DMA_CONFIG_CURRENT_VALUE_S);
 }
 
 /**
@@ -106,9 +148,7 @@ void HAL_DMA_SetCurrentValue(DMA_InitTypeDef *hdma, HAL_DMA_CurrentValueTypeDef
  */
 void HAL_DMA_GlobalIRQEnable(DMA_InitTypeDef *hdma, HAL_DMA_IRQTypeDef Permission)
 {
-    ConfigStatusWriteBuffer &= ~DMA_CONFIG_GLOBAL_IRQ_ENA_M;
-    ConfigStatusWriteBuffer |= Permission << DMA_CONFIG_GLOBAL_IRQ_ENA_S;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
+    HAL_DMA_ConfigStatusModify(hdma, DMA_CONFIG_GLOBAL_IRQ_ENA_M, Permission << DMA_CONFIG_GLOBAL_IRQ_ENA_S);
 }
 
 /**
@@ -118,9 +158,7 @@ void HAL_DMA_GlobalIRQEnable(DMA_InitTypeDef *hdma, HAL_DMA_IRQTypeDef Permissio
  */
 void HAL_DMA_ErrorIRQEnable(DMA_InitTypeDef *hdma, HAL_DMA_IRQTypeDef Permission)
 {
-    ConfigStatusWriteBuffer &= ~DMA_CONFIG_ERROR_IRQ_ENA_M;
-    ConfigStatusWriteBuffer |= Permission << DMA_CONFIG_ERROR_IRQ_ENA_S;
-    hdma->Instance->CONFIG_STATUS = ConfigStatusWriteBuffer;
+    HAL_DMA_ConfigStatusModify(hdma, DMA_CONFIG_ERROR_IRQ_ENA_M, Permission << DMA_CONFIG_ERROR_IRQ_ENA_S);
 }
 
 /**
@@ -132,12 +170,7 @@ void HAL_DMA_ErrorIRQEnable(DMA_InitTypeDef *hdma, HAL_DMA_IRQTypeDef Permission
  */
 void HAL_DMA_LocalIRQEnable(DMA_ChannelHandleTypeDef* hdma_channel, HAL_DMA_IRQTypeDef Permission)
 {
-    uint32_t ChannelIndex = hdma_channel->ChannelInit.Channel;
-
-    CFGWriteBuffer[ChannelIndex] &= ~DMA_CH_CFG_IRQ_EN_M;
-    CFGWriteBuffer[ChannelIndex] |= Permission << DMA_CH_CFG_IRQ_EN_S;
-
-    hdma_channel->dma->Instance->CHANNELS[ChannelIndex].CFG = CFGWriteBuffer[ChannelIndex];
+    HAL_DMA_ChannelCFGModify(hdma_channel, DMA_CH_CFG_IRQ_EN_M, Permission << DMA_CH_CFG_IRQ_EN_S);
 }
 
 /**
@@ -154,7 +187,7 @@ HAL_StatusTypeDef HAL_DMA_Init(DMA_InitTypeDef *hdma)
     
     HAL_DMA_MspInit(hdma);
 
-    ConfigStatusWriteBuffer = 0;
+    HAL_DMA_ConfigStatusModify(hdma, 0xFFFFFFFF, 0);
 
     HAL_DMA_ClearIrq(hdma);
     HAL_DMA_SetCurrentValue(hdma, hdma->CurrentValue);
@@ -231,9 +264,7 @@ int HAL_DMA_GetBusError(DMA_ChannelHandleTypeDef* hdma_channel)
  */
 void HAL_DMA_ChannelDisable(DMA_ChannelHandleTypeDef *hdma_channel)
 {
-    uint32_t ChannelIndex = hdma_channel->ChannelInit.Channel;
-    CFGWriteBuffer[ChannelIndex] &= ~(DMA_CH_CFG_ENABLE_M);
-    hdma_channel->dma->Instance->CHANNELS[ChannelIndex].CFG = CFGWriteBuffer[ChannelIndex];
+    HAL_DMA_ChannelCFGModify(hdma_channel, DMA_CH_CFG_ENABLE_M, 0);
 }
 
 /**
@@ -242,9 +273,7 @@ void HAL_DMA_ChannelDisable(DMA_ChannelHandleTypeDef *hdma_channel)
  */
 void HAL_DMA_ChannelEnable(DMA_ChannelHandleTypeDef *hdma_channel)
 {
-    uint32_t ChannelIndex = hdma_channel->ChannelInit.Channel;
-    CFGWriteBuffer[ChannelIndex] |= DMA_CH_CFG_ENABLE_M;
-    hdma_channel->dma->Instance->CHANNELS[ChannelIndex].CFG = CFGWriteBuffer[ChannelIndex];
+    HAL_DMA_ChannelCFGModify(hdma_channel, DMA_CH_CFG_ENABLE_M, DMA_CH_CFG_ENABLE_M);
 }
 
 /**
@@ -263,9 +292,7 @@ void HAL_DMA_Start(DMA_ChannelHandleTypeDef *hdma_channel, void* SRC, void* DST,
     hdma_channel->dma->Instance->CHANNELS[ChannelIndex].DST = (uint32_t) DST;
     hdma_channel->dma->Instance->CHANNELS[ChannelIndex].LEN = Len;
 
-    CFGWriteBuffer[ChannelIndex] &= DMA_CH_CFG_IRQ_EN_M;
-
-    CFGWriteBuffer[ChannelIndex] |= DMA_CH_CFG_ENABLE_M 
+    HAL_DMA_ChannelCFGModify(hdma_channel, ~DMA_CH_CFG_IRQ_EN_M, DMA_CH_CFG_ENABLE_M 
         | (hdma_channel->ChannelInit.Priority << DMA_CH_CFG_PRIOR_S) 
         | (hdma_channel->ChannelInit.ReadMode << DMA_CH_CFG_READ_MODE_S) 
         | (hdma_channel->ChannelInit.ReadInc << DMA_CH_CFG_READ_INCREMENT_S) 
@@ -278,8 +305,6 @@ void HAL_DMA_Start(DMA_ChannelHandleTypeDef *hdma_channel, void* SRC, void* DST,
         | (hdma_channel->ChannelInit.WriteSize << DMA_CH_CFG_WRITE_SIZE_S) 
         | (hdma_channel->ChannelInit.WriteBurstSize << DMA_CH_CFG_WRITE_BURST_SIZE_S) 
         | (hdma_channel->ChannelInit.WriteRequest << DMA_CH_CFG_WRITE_REQUEST_S) 
-        | (hdma_channel->ChannelInit.WriteAck << DMA_CH_CFG_WRITE_ACK_EN_S);
-
-    hdma_channel->dma->Instance->CHANNELS[ChannelIndex].CFG = CFGWriteBuffer[ChannelIndex];
+        | (hdma_channel->ChannelInit.WriteAck << DMA_CH_CFG_WRITE_ACK_EN_S));
 }
 
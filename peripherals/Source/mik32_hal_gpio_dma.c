@@ -0,0 +1,159 @@
+#include "mik32_hal_gpio_dma.h"
+
+
+/**
+ * @brief Получить линию запроса DMA таймера Timer32.
+ * @param timer Базовый адрес регистров таймера.
+ * @param Request Указатель на линию запроса.
+ * @return Статус HAL. @ref HAL_ERROR, если таймер не формирует запросы DMA.
+ */
+static HAL_StatusTypeDef HAL_GPIO_DMA_GetRequest(TIMER32_TypeDef *timer, HAL_DMA_ChannelRequestTypeDef *Request)
+{
+    switch ((uint32_t)timer)
+    {
+    case (uint32_t)TIMER32_0:
+        *Request = DMA_CHANNEL_TIMER32_0_REQUEST;
+        return HAL_OK;
+    case (uint32_t)TIMER32_1:
+        *Request = DMA_CHANNEL_TIMER32_1_REQUEST;
+        return HAL_OK;
+    case (uint32_t)TIMER32_2:
+        *Request = DMA_CHANNEL_TIMER32_2_REQUEST;
+        return HAL_OK;
+    default:
+        return HAL_ERROR;
+    }
+}
+
+/**
+ * @brief Получить адрес регистра порта, в который записывается шаблон.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ * @return Адрес регистра порта.
+ */
+static volatile uint32_t *HAL_GPIO_DMA_GetTarget(GPIO_DMA_HandleTypeDef *hgpio_dma)
+{
+    switch (hgpio_dma->Target)
+    {
+    case GPIO_DMA_TARGET_SET:
+        return &hgpio_dma->Port->SET;
+    case GPIO_DMA_TARGET_CLEAR:
+        return &hgpio_dma->Port->CLEAR;
+    case GPIO_DMA_TARGET_OUTPUT:
+    default:
+        return &hgpio_dma->Port->OUTPUT;
+    }
+}
+
+/**
+ * @brief Настроить канал DMA для вывода шаблона в порт GPIO.
+ *
+ * Источник - память с инкрементом адреса, назначение - регистр порта без инкремента.
+ * Назначение работает в режиме периферии с линией запроса таймера и логикой с откликом,
+ * поэтому на каждое переполнение таймера пересылается одно слово.
+ * Выводы порта должны быть предварительно настроены как выходы GPIO.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_GPIO_DMA_Init(GPIO_DMA_HandleTypeDef *hgpio_dma)
+{
+    HAL_DMA_ChannelRequestTypeDef request;
+
+    if ((hgpio_dma == NULL) || (hgpio_dma->hdma == NULL) || (hgpio_dma->htimer32 == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hgpio_dma->Port != GPIO_0) && (hgpio_dma->Port != GPIO_1) && (hgpio_dma->Port != GPIO_2))
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_GPIO_DMA_GetRequest(hgpio_dma->htimer32->Instance, &request) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    DMA_ChannelInitHandleTypeDef *init = &hgpio_dma->hdma->ChannelInit;
+
+    init->ReadMode = DMA_CHANNEL_MODE_MEMORY;
+    init->ReadInc = DMA_CHANNEL_INC_ENABLE;
+    init->ReadSize = DMA_CHANNEL_SIZE_WORD;
+    init->ReadBurstSize = 2;
+    init->ReadRequest = request;
+    init->ReadAck = DMA_CHANNEL_ACK_DISABLE;
+
+    init->WriteMode = DMA_CHANNEL_MODE_PERIPHERY;
+    init->WriteInc = DMA_CHANNEL_INC_DISABLE;
+    init->WriteSize = DMA_CHANNEL_SIZE_WORD;
+    init->WriteBurstSize = 2;
+    init->WriteRequest = request;
+    init->WriteAck = DMA_CHANNEL_ACK_ENABLE;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить вывод шаблона в порт GPIO.
+ *
+ * Канал DMA запускается до таймера, поэтому первое слово выводится на первом переполнении таймера.
+ * Для повторения шаблона функцию можно вызвать повторно из локального прерывания DMA.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ * @param pPattern Указатель на шаблон. Массив должен оставаться доступным до завершения вывода.
+ * @param Count Количество слов шаблона.
+ * @return Статус HAL. @ref HAL_BUSY, если предыдущий вывод не завершен.
+ */
+HAL_StatusTypeDef HAL_GPIO_DMA_Start(GPIO_DMA_HandleTypeDef *hgpio_dma, const uint32_t *pPattern, uint32_t Count)
+{
+    if ((pPattern == NULL) || (Count == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_GPIO_DMA_IsBusy(hgpio_dma))
+    {
+        return HAL_BUSY;
+    }
+
+    HAL_DMA_Start(hgpio_dma->hdma, (void *)pPattern, (void *)HAL_GPIO_DMA_GetTarget(hgpio_dma), Count * sizeof(uint32_t) - 1);
+
+    if (hgpio_dma->htimer32->State != TIMER32_STATE_ENABLE)
+    {
+        HAL_Timer32_Value_Clear(hgpio_dma->htimer32);
+        HAL_Timer32_Start(hgpio_dma->htimer32);
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Остановить вывод шаблона.
+ *
+ * Останавливаются канал DMA и таймер. Выводы порта сохраняют последнее выведенное состояние.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ */
+void HAL_GPIO_DMA_Stop(GPIO_DMA_HandleTypeDef *hgpio_dma)
+{
+    HAL_Timer32_Stop(hgpio_dma->htimer32);
+    HAL_DMA_ChannelDisable(hgpio_dma->hdma);
+}
+
+/**
+ * @brief Ожидать завершения вывода шаблона.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ * @param Timeout Количество циклов ожидания.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_GPIO_DMA_Wait(GPIO_DMA_HandleTypeDef *hgpio_dma, uint32_t Timeout)
+{
+    return HAL_DMA_Wait(hgpio_dma->hdma, Timeout);
+}
+
+/**
+ * @brief Получить состояние вывода шаблона.
+ * @param hgpio_dma Указатель на структуру вывода шаблона.
+ * @return 1 - вывод продолжается, 0 - канал DMA свободен.
+ */
+int HAL_GPIO_DMA_IsBusy(GPIO_DMA_HandleTypeDef *hgpio_dma)
+{
+    return !HAL_DMA_GetChannelReadyStatus(hgpio_dma->hdma);
+}
@@ -1,4 +1,5 @@
 #include "mik32_hal_i2c.h"
+#include "mik32_hal_prof.h"
 
 __attribute__((weak)) void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c)
 {
@@ -196,24 +197,127 @@ void HAL_I2C_MasterInit(I2C_HandleTypeDef *hi2c)
 
 }
 
-void HAL_I2C_calcFreqCoef(I2C_HandleTypeDef *hi2c)
-{
-    uint32_t i2cclk_freq;
-    uint32_t i2c_cycles;
-    uint32_t presc_del;
-
-    i2cclk_freq = HAL_PCC_GetSysClockFreq() / (PM->DIV_APB_P+1);
-    i2c_cycles = i2cclk_freq / hi2c->Init.frequency - TSYNC_SIGMA_FACTOR;
-    //so SCLL & SCLH are 7-bit, their summ is 8-bit, d256 max
-    presc_del = i2c_cycles / 256;
-    i2c_cycles = i2c_cycles / (presc_del + 1);
-    hi2c->Clock.PRESC = presc_del;
-    hi2c->Clock.SCLDEL = 0;
-    hi2c->Clock.SDADEL = 0;
-    hi2c->Clock.SCLH = i2c_cycles / hi2c->Init.duty_factor;
-    hi2c->Clock.SCLL = i2c_cycles - hi2c->Clock.SCLH;
-    hi2c->Clock.SCLH -= 1;
-    hi2c->Clock.SCLL -= 1;
+/*
+ * Временные ограничения спецификации I2C для режимов Standard, Fast и Fast-mode Plus, нс
+ */
+static const struct
+{
+    uint32_t Frequency;     /* Максимальная частота SCL режима, Гц */
+    uint16_t LowMin;        /* tLOW min */
+    uint16_t HighMin;       /* tHIGH min */
+    uint16_t DataSetupMin;  /* tSU;DAT min */
+    uint16_t RiseTimeMax;   /* tr max, используется, если Init.RiseTime = 0 */
+} i2c_timing_spec[] =
+{
+    {100000,  4700, 4000, 250, 1000},
+    {400000,  1300, 600,  100, 300},
+    {1000000, 500,  260,  50,  120},
+};
+
+/*
+ * Перевод интервала в нс в количество тактов частоты ClockKHz с округлением вверх
+ */
+static uint32_t HAL_I2C_NsToCycles(uint32_t Ns, uint32_t ClockKHz)
+{
+    return (Ns * ClockKHz + 999999) / 1000000;
+}
+
+/**
+ * @brief Рассчитать настройки TIMINGR для частоты Init.frequency.
+ *
+ * Перебираются все значения PRESC. Для каждого SCLL и SCLH выбираются так, чтобы период SCL с учетом
+ * времени нарастания Init.RiseTime и задержки цифрового фильтра был не меньше заданного,
+ * а tLOW, tHIGH и tSU;DAT удовлетворяли спецификации режима. Выбирается вариант с частотой, ближайшей к заданной снизу.
+ * Отношение SCLH к периоду задается Init.duty_factor, как и прежде.
+ * Результат записывается в hi2c->Clock. Функция не вызывается из @ref HAL_I2C_Init и @ref HAL_I2C_SetClockSpeed:
+ * ее нужно вызвать до них, иначе в TIMINGR будут записаны значения Clock, заданные пользователем.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @return Расчетная частота SCL, Гц. 0, если частоту нельзя получить при текущей частоте I2CCLK.
+ */
+uint32_t HAL_I2C_calcFreqCoef(I2C_HandleTypeDef *hi2c)
+{
+    uint32_t i2cclk_freq = HAL_PCC_GetSysClockFreq() / (PM->DIV_APB_P+1);
+    uint32_t clock_khz = i2cclk_freq / 1000;
+    uint32_t spec = 0;
+    uint32_t best_total = 0;
+
+    if (hi2c->Init.frequency == 0)
+    {
+        return 0;
+    }
+
+    while ((spec < (sizeof(i2c_timing_spec) / sizeof(i2c_timing_spec[0]) - 1)) && (hi2c->Init.frequency > i2c_timing_spec[spec].Frequency))
+    {
+        spec++;
+    }
+
+    uint32_t rise_time = (hi2c->Init.RiseTime != 0) ? hi2c->Init.RiseTime : i2c_timing_spec[spec].RiseTimeMax;
+    uint32_t duty_factor = (hi2c->Init.duty_factor != 0) ? hi2c->Init.duty_factor : 2;
+
+    /* Синхронизация SCL: нарастание фронта и цифровой фильтр на каждом фронте.
+     * Задержка аналогового фильтра не учитывается, поэтому реальная частота не превышает расчетную */
+    uint32_t sync = HAL_I2C_NsToCycles(rise_time, clock_khz) + 2 * (hi2c->Init.DigitalFilter + 2);
+    /* Период SCL с округлением вверх, чтобы не превысить заданную частоту */
+    uint32_t period = (i2cclk_freq + hi2c->Init.frequency - 1) / hi2c->Init.frequency;
+
+    uint32_t low_min_cycles = HAL_I2C_NsToCycles(i2c_timing_spec[spec].LowMin, clock_khz);
+    uint32_t high_min_cycles = HAL_I2C_NsToCycles(i2c_timing_spec[spec].HighMin, clock_khz);
+    uint32_t setup_cycles = HAL_I2C_NsToCycles(rise_time + i2c_timing_spec[spec].DataSetupMin, clock_khz);
+
+    for (uint32_t presc = 0; presc < 16; presc++)
+    {
+        uint32_t div = presc + 1;
+        uint32_t n = (period > sync) ? (period - sync + div - 1) / div : 0;
+        uint32_t high = n / duty_factor;
+        uint32_t low = n - high;
+        uint32_t low_min = (low_min_cycles + div - 1) / div;
+        uint32_t high_min = (high_min_cycles + div - 1) / div;
+        uint32_t scldel = (setup_cycles + div - 1) / div;
+
+        /* Недостающие такты уровня забираются у другого уровня, пока он не достигнет своего минимума */
+        if (low < low_min)
+        {
+            low = low_min;
+            high = (n > low) ? (n - low) : 0;
+        }
+        if (high < high_min)
+        {
+            high = high_min;
+            low = (n > high) ? (n - high) : 0;
+            if (low < low_min)
+            {
+                low = low_min;
+            }
+        }
+        if (scldel == 0)
+        {
+            scldel = 1;
+        }
+
+        if ((low > 256) || (high > 256) || (scldel > 16))
+        {
+            continue;
+        }
+
+        uint32_t total = (low + high) * div + sync;
+        if ((best_total == 0) || (total < best_total))
+        {
+            best_total = total;
+            hi2c->Clock.PRESC = presc;
+            hi2c->Clock.SCLDEL = scldel - 1;
+            /* tHD;DAT min = 0 во всех режимах */
+            hi2c->Clock.SDADEL = 0;
+            hi2c->Clock.SCLH = high - 1;
+            hi2c->Clock.SCLL = low - 1;
+        }
+    }
+
+    if (best_total == 0)
+    {
+        return 0;
+    }
+
+    return i2cclk_freq / best_total;
 }
 
 HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
@@ -261,6 +365,7 @@ HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
     }
     
     hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->MemMode = HAL_I2C_MEM_NONE;
     return HAL_OK;
 }
 
@@ -430,6 +535,8 @@ void HAL_I2C_Master_NBYTES(I2C_HandleTypeDef *hi2c)
 
 HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize, uint32_t Timeout)
 {
+    HAL_PROF_BEGIN(i2c_master_transmit);
+
     HAL_StatusTypeDef error_code = HAL_OK;
     uint32_t nbytes = 0;
 
@@ -470,6 +577,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t Slav
         {
             if ((error_code = HAL_I2C_Master_WaitTXIS(hi2c, Timeout)) != HAL_OK)
             {
+                HAL_PROF_END(i2c_master_transmit);
                 return error_code;
             }
             hi2c->Instance->TXDR = *pData;
@@ -495,6 +603,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t Slav
 
         if ((error_code = HAL_I2C_Master_WaitTCR(hi2c, Timeout)) != HAL_OK)
         {
+            HAL_PROF_END(i2c_master_transmit);
             return error_code;
         }
 
@@ -520,6 +629,8 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t Slav
     }
     
     
+    HAL_PROF_END(i2c_master_transmit);
+
     return error_code;
 }
 
@@ -621,6 +732,201 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t Slave
     return error_code;
 }
 
+/*
+ * Задать NBYTES очередной части транзакции ведущего.
+ *
+ * Remaining - количество байт до конца транзакции. Если Remaining > I2C_NBYTE_MAX, устанавливается RELOAD,
+ * иначе окончание транзакции задается полем Init.AutoEnd.
+ * Возвращает количество байт в части.
+ */
+static uint32_t HAL_I2C_Master_Chunk(I2C_HandleTypeDef *hi2c, uint32_t Remaining)
+{
+    uint32_t nbytes = (Remaining > I2C_NBYTE_MAX) ? I2C_NBYTE_MAX : Remaining;
+
+    hi2c->Instance->CR2 &= ~I2C_CR2_NBYTES_M;
+    hi2c->Instance->CR2 |= I2C_CR2_NBYTES(nbytes);
+
+    if (Remaining > I2C_NBYTE_MAX)
+    {
+        /* При RELOAD = 1 AUTOEND игнорируется */
+        hi2c->Instance->CR2 |= I2C_CR2_RELOAD_M;
+    }
+    else
+    {
+        hi2c->Instance->CR2 &= ~I2C_CR2_RELOAD_M;
+        HAL_I2C_AutoEnd(hi2c, hi2c->Init.AutoEnd);
+    }
+
+    return nbytes;
+}
+
+/*
+ * Задать передачу адреса регистра отдельной посылкой без STOP.
+ *
+ * После передачи MemAddSize байт устанавливается флаг TC, и START формирует повторный START.
+ */
+static void HAL_I2C_Mem_AddressPhase(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize)
+{
+    hi2c->Instance->CR2 &= ~(I2C_CR2_NBYTES_M | I2C_CR2_RELOAD_M | I2C_CR2_AUTOEND_M);
+    hi2c->Instance->CR2 |= I2C_CR2_NBYTES(MemAddSize);
+
+    /* Задать адрес и режим адресации */
+    HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
+    /* Задать направление передачи - запись */
+    hi2c->Instance->CR2 &= ~I2C_CR2_RD_WRN_M;
+}
+
+/*
+ * Завершение транзакции ведущего после пересылки последнего байта.
+ */
+static HAL_StatusTypeDef HAL_I2C_Master_WaitEnd(I2C_HandleTypeDef *hi2c, uint32_t Timeout)
+{
+    if (hi2c->Instance->CR2 & I2C_CR2_AUTOEND_M)
+    {
+        return HAL_I2C_WaitBusy(hi2c, Timeout); /* Ожидание сигнала STOP */
+    }
+    else
+    {
+        return HAL_I2C_Master_WaitTC(hi2c, Timeout); /* Ожидание сигнала конца передачи. STOP не отправляется */
+    }
+}
+
+/**
+ * @brief Запись в регистры ведомого.
+ *
+ * Адрес регистра и данные передаются одной транзакцией записи.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Данные для записи.
+ * @param DataSize Количество байт данных.
+ * @param Timeout Количество циклов ожидания флагов.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize, uint32_t Timeout)
+{
+    HAL_StatusTypeDef error_code = HAL_OK;
+    uint32_t remaining = MemAddSize + DataSize;
+    uint32_t address_count = MemAddSize;
+    uint32_t nbytes = HAL_I2C_Master_Chunk(hi2c, remaining);
+
+    /* Задать адрес и режим адресации */
+    HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
+    /* Задать направление передачи - запись */
+    hi2c->Instance->CR2 &= ~I2C_CR2_RD_WRN_M;
+    /* Старт */
+    hi2c->Instance->CR2 |= I2C_CR2_START_M;
+
+    while (remaining > 0)
+    {
+        if (nbytes == 0)
+        {
+            if ((error_code = HAL_I2C_Master_WaitTCR(hi2c, Timeout)) != HAL_OK)
+            {
+                return error_code;
+            }
+            nbytes = HAL_I2C_Master_Chunk(hi2c, remaining);
+        }
+
+        if ((error_code = HAL_I2C_Master_WaitTXIS(hi2c, Timeout)) != HAL_OK)
+        {
+            return error_code;
+        }
+
+        if (address_count > 0)
+        {
+            /* Адрес регистра передается старшим байтом вперед */
+            address_count--;
+            hi2c->Instance->TXDR = (uint8_t)(MemAddress >> (8 * address_count));
+        }
+        else
+        {
+            hi2c->Instance->TXDR = *pData;
+            pData++;
+        }
+
+        nbytes--;
+        remaining--;
+    }
+
+    return HAL_I2C_Master_WaitEnd(hi2c, Timeout);
+}
+
+/**
+ * @brief Чтение регистров ведомого.
+ *
+ * Адрес регистра передается без STOP, затем повторным START начинается чтение.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Буфер для принятых данных.
+ * @param DataSize Количество байт данных.
+ * @param Timeout Количество циклов ожидания флагов.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize, uint32_t Timeout)
+{
+    HAL_StatusTypeDef error_code = HAL_OK;
+    uint32_t remaining = DataSize;
+    uint32_t nbytes = 0;
+
+    if (DataSize == 0)
+    {
+        return HAL_ERROR;
+    }
+
+    HAL_I2C_Mem_AddressPhase(hi2c, SlaveAddress, MemAddSize);
+    /* Старт */
+    hi2c->Instance->CR2 |= I2C_CR2_START_M;
+
+    for (uint32_t i = MemAddSize; i > 0; i--)
+    {
+        if ((error_code = HAL_I2C_Master_WaitTXIS(hi2c, Timeout)) != HAL_OK)
+        {
+            return error_code;
+        }
+        hi2c->Instance->TXDR = (uint8_t)(MemAddress >> (8 * (i - 1)));
+    }
+
+    if ((error_code = HAL_I2C_Master_WaitTC(hi2c, Timeout)) != HAL_OK)
+    {
+        return error_code;
+    }
+
+    nbytes = HAL_I2C_Master_Chunk(hi2c, remaining);
+    /* Задать направление передачи - чтение */
+    hi2c->Instance->CR2 |= I2C_CR2_RD_WRN_M;
+    /* Повторный старт */
+    hi2c->Instance->CR2 |= I2C_CR2_START_M;
+
+    while (remaining > 0)
+    {
+        if (nbytes == 0)
+        {
+            if ((error_code = HAL_I2C_Master_WaitTCR(hi2c, Timeout)) != HAL_OK)
+            {
+                return error_code;
+            }
+            nbytes = HAL_I2C_Master_Chunk(hi2c, remaining);
+        }
+
+        if ((error_code = HAL_I2C_Master_WaitRXNE(hi2c, Timeout)) != HAL_OK)
+        {
+            return error_code;
+        }
+
+        *pData = hi2c->Instance->RXDR;
+        pData++;
+
+        nbytes--;
+        remaining--;
+    }
+
+    return HAL_I2C_Master_WaitEnd(hi2c, Timeout);
+}
+
 HAL_StatusTypeDef HAL_I2C_Slave_WaitADDR(I2C_HandleTypeDef *hi2c, uint32_t Timeout)
 {
     /* Ожидание совпадения адреса */
@@ -1000,22 +1306,49 @@ HAL_StatusTypeDef HAL_I2C_Slave_ReceiveSBC(I2C_HandleTypeDef *hi2c, uint8_t *pDa
     return error_code;
 }
 
-HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize)
+/*
+ * Подготовка NBYTES для передачи ведущего через DMA.
+ *
+ * Канал DMA пересылает все DataSize байт одной задачей. Если DataSize > I2C_NBYTE_MAX,
+ * транзакция делится на части по I2C_NBYTE_MAX байт с RELOAD = 1. NBYTES перезаписывается
+ * в прерывании TCR (HAL_I2C_TCR_IRQ), поэтому на шине не формируются STOP и повторный START между частями.
+ * В этом случае HAL_I2C_IRQHandler должен вызываться из обработчика прерывания I2C.
+ */
+static void HAL_I2C_Master_DMA_NBYTES(I2C_HandleTypeDef *hi2c, uint16_t DataSize)
 {
-    HAL_StatusTypeDef error_code = HAL_OK;
+    hi2c->pBuffPtr = NULL;
+    hi2c->TransferSize = DataSize;
+    hi2c->TransferCount = 0;
 
-    /* Подготовка перед отправкой */
-    if (DataSize <= I2C_NBYTE_MAX)
-    {
-        hi2c->Instance->CR2 &= ~I2C_CR2_NBYTES_M;
-        hi2c->Instance->CR2 |= I2C_CR2_NBYTES(DataSize);
+    HAL_I2C_Master_NBYTES(hi2c);
 
-        HAL_I2C_AutoEnd(hi2c, hi2c->Init.AutoEnd);
+    /* Направление DMA разрешается вызывающей функцией */
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
+
+    HAL_I2C_InterruptDisable(hi2c, I2C_INTMASK);
+    if (DataSize > I2C_NBYTE_MAX)
+    {
+        hi2c->State = HAL_I2C_STATE_BUSY;
+        HAL_I2C_InterruptEnable(hi2c,     I2C_CR1_ERRIE_M
+                                        | I2C_CR1_NACKIE_M
+                                        | I2C_CR1_TCIE_M
+                                        | I2C_CR1_STOPIE_M
+                                        );
     }
-    else /* DataSize > 255 */
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint8_t *pData, uint16_t DataSize)
+{
+    HAL_StatusTypeDef error_code = HAL_OK;
+
+    if (DataSize == 0)
     {
         return HAL_ERROR;
     }
+
+    /* Подготовка перед отправкой */
+    HAL_I2C_Master_DMA_NBYTES(hi2c, DataSize);
+
     /* Задать адрес и режим адресации */
     HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
     /* Задать направление передачи - запись */
@@ -1037,18 +1370,14 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t S
 {
     HAL_StatusTypeDef error_code = HAL_OK;
 
-    /* Подготовка перед приемом */
-    if (DataSize <= I2C_NBYTE_MAX)
-    {
-        hi2c->Instance->CR2 &= ~I2C_CR2_NBYTES_M;
-        hi2c->Instance->CR2 |= I2C_CR2_NBYTES(DataSize);
-
-        HAL_I2C_AutoEnd(hi2c, hi2c->Init.AutoEnd);
-    }
-    else /* DataSize > 255 */
+    if (DataSize == 0)
     {
         return HAL_ERROR;
     }
+
+    /* Подготовка перед приемом */
+    HAL_I2C_Master_DMA_NBYTES(hi2c, DataSize);
+
     /* Задать адрес и режим адресации */
     HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
     /* Задать направление передачи - чтение */
@@ -1165,6 +1494,8 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t S
     hi2c->TransferCount = 0;
 
     HAL_I2C_Master_NBYTES(hi2c);
+    /* Данные пересылаются в прерываниях, запросы DMA не нужны */
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
 
     /* Задать адрес и режим адресации */
     HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
@@ -1196,6 +1527,8 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t Sl
     hi2c->TransferCount = 0;
 
     HAL_I2C_Master_NBYTES(hi2c);
+    /* Данные пересылаются в прерываниях, запросы DMA не нужны */
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
 
     /* Задать адрес и режим адресации */
     HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
@@ -1213,6 +1546,180 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t Sl
     return error_code;
 }
 
+/**
+ * @brief Переход к пересылке данных после передачи адреса регистра.
+ *
+ * Вызывается из HAL_I2C_TXIS_IRQ и HAL_I2C_TC_IRQ. При записи через DMA запускает канал DMA,
+ * при чтении задает NBYTES для данных и формирует повторный START.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ */
+void HAL_I2C_Mem_AddressComplete(I2C_HandleTypeDef *hi2c)
+{
+    HAL_I2C_MemModeTypeDef mem_mode = hi2c->MemMode;
+    hi2c->MemMode = HAL_I2C_MEM_NONE;
+
+    if (mem_mode == HAL_I2C_MEM_WRITE_DMA)
+    {
+        uint32_t data_size = hi2c->TransferSize - hi2c->TransferCount;
+
+        /* При перезаписи NBYTES в HAL_I2C_TCR_IRQ отсчет ведется от начала транзакции */
+        hi2c->TransferCount = 0;
+
+        HAL_I2C_InterruptDisable(hi2c, I2C_CR1_TXIE_M);
+        hi2c->Instance->CR1 |= I2C_CR1_TXDMAEN_M;
+        HAL_DMA_Start(hi2c->hdmatx, hi2c->pBuffPtr, (void*)&hi2c->Instance->TXDR, data_size - 1);
+        return;
+    }
+
+    /* Чтение данных */
+    hi2c->TransferCount = 0;
+    HAL_I2C_Master_NBYTES(hi2c);
+    /* Задать направление передачи - чтение */
+    hi2c->Instance->CR2 |= I2C_CR2_RD_WRN_M;
+
+    if (mem_mode == HAL_I2C_MEM_READ_DMA)
+    {
+        hi2c->Instance->CR1 |= I2C_CR1_RXDMAEN_M;
+        HAL_DMA_Start(hi2c->hdmarx, (void*)&hi2c->Instance->RXDR, hi2c->pBuffPtr, hi2c->TransferSize - 1);
+    }
+    else
+    {
+        HAL_I2C_InterruptEnable(hi2c, I2C_CR1_RXIE_M);
+    }
+
+    /* Повторный старт */
+    hi2c->Instance->CR2 |= I2C_CR2_START_M;
+}
+
+/*
+ * Подготовка транзакции HAL_I2C_Mem_*_IT и HAL_I2C_Mem_*_DMA.
+ *
+ * Адрес регистра передается в HAL_I2C_TXIS_IRQ. При записи адрес и данные образуют одну посылку,
+ * при чтении адрес передается отдельной посылкой без STOP.
+ */
+static HAL_StatusTypeDef HAL_I2C_Mem_Start(I2C_HandleTypeDef *hi2c, HAL_I2C_MemModeTypeDef MemMode, uint16_t SlaveAddress,
+    uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize)
+{
+    uint32_t int_mask = I2C_CR1_ERRIE_M | I2C_CR1_NACKIE_M | I2C_CR1_TCIE_M | I2C_CR1_TXIE_M;
+
+    if ((MemMode != HAL_I2C_MEM_WRITE_IT) && (DataSize == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    hi2c->State = HAL_I2C_STATE_BUSY;
+    hi2c->MemMode = MemMode;
+    hi2c->MemAddress = MemAddress;
+    hi2c->MemAddressCount = MemAddSize;
+    hi2c->pBuffPtr = pData;
+    hi2c->TransferCount = 0;
+
+    /* Данные пересылаются после передачи адреса регистра */
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
+
+    if ((MemMode == HAL_I2C_MEM_WRITE_IT) || (MemMode == HAL_I2C_MEM_WRITE_DMA))
+    {
+        hi2c->TransferSize = MemAddSize + DataSize;
+        HAL_I2C_Master_NBYTES(hi2c);
+
+        /* Задать адрес и режим адресации */
+        HAL_I2C_Master_SlaveAddress(hi2c, SlaveAddress);
+        /* Задать направление передачи - запись */
+        hi2c->Instance->CR2 &= ~I2C_CR2_RD_WRN_M;
+    }
+    else
+    {
+        hi2c->TransferSize = DataSize;
+        HAL_I2C_Mem_AddressPhase(hi2c, SlaveAddress, MemAddSize);
+    }
+
+    if ((MemMode == HAL_I2C_MEM_WRITE_DMA) || (MemMode == HAL_I2C_MEM_READ_DMA))
+    {
+        /* Окончание пересылки через DMA определяется по STOP или TC */
+        int_mask |= I2C_CR1_STOPIE_M;
+    }
+
+    /* Выключить все прерывания I2C */
+    HAL_I2C_InterruptDisable(hi2c, I2C_INTMASK);
+    /* Включение прерываний */
+    HAL_I2C_InterruptEnable(hi2c, int_mask);
+
+    /* Старт */
+    hi2c->Instance->CR2 |= I2C_CR2_START_M;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запись в регистры ведомого в прерываниях.
+ *
+ * Окончание передачи отражается в поле State.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Данные для записи.
+ * @param DataSize Количество байт данных.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize)
+{
+    return HAL_I2C_Mem_Start(hi2c, HAL_I2C_MEM_WRITE_IT, SlaveAddress, MemAddress, MemAddSize, pData, DataSize);
+}
+
+/**
+ * @brief Чтение регистров ведомого в прерываниях.
+ *
+ * Повторный START формируется в HAL_I2C_TC_IRQ. Окончание приема отражается в поле State.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Буфер для принятых данных.
+ * @param DataSize Количество байт данных.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize)
+{
+    return HAL_I2C_Mem_Start(hi2c, HAL_I2C_MEM_READ_IT, SlaveAddress, MemAddress, MemAddSize, pData, DataSize);
+}
+
+/**
+ * @brief Запись в регистры ведомого через DMA.
+ *
+ * Адрес регистра передается в прерывании, данные - каналом hdmatx.
+ * Окончание передачи отражается в поле State.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Данные для записи.
+ * @param DataSize Количество байт данных.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize)
+{
+    return HAL_I2C_Mem_Start(hi2c, HAL_I2C_MEM_WRITE_DMA, SlaveAddress, MemAddress, MemAddSize, pData, DataSize);
+}
+
+/**
+ * @brief Чтение регистров ведомого через DMA.
+ *
+ * Адрес регистра передается в прерывании, после повторного START данные принимает канал hdmarx.
+ * Окончание приема отражается в поле State.
+ * @param hi2c Указатель на структуру с настройками I2C.
+ * @param SlaveAddress Адрес ведомого.
+ * @param MemAddress Адрес регистра.
+ * @param MemAddSize Размер адреса регистра.
+ * @param pData Буфер для принятых данных.
+ * @param DataSize Количество байт данных.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t SlaveAddress, uint16_t MemAddress, HAL_I2C_MemAddSizeTypeDef MemAddSize, uint8_t *pData, uint16_t DataSize)
+{
+    return HAL_I2C_Mem_Start(hi2c, HAL_I2C_MEM_READ_DMA, SlaveAddress, MemAddress, MemAddSize, pData, DataSize);
+}
+
 HAL_StatusTypeDef HAL_I2C_Slave_Transmit_IT(I2C_HandleTypeDef *hi2c, uint8_t *pData, uint16_t DataSize)
 {
     HAL_StatusTypeDef error_code = HAL_OK;
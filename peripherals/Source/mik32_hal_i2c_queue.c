@@ -0,0 +1,288 @@
+#include "mik32_hal_i2c_queue.h"
+
+
+#define I2C_QUEUE_INTMASK	(I2C_CR1_ERRIE_M | I2C_CR1_NACKIE_M | I2C_CR1_STOPIE_M | I2C_CR1_TCIE_M | I2C_CR1_TXIE_M | I2C_CR1_RXIE_M)
+
+
+/**
+ * @brief Количество байт текущего сегмента.
+ * @param hqueue Указатель на структуру очереди.
+ * @return Размер сегмента записи или чтения.
+ */
+static uint32_t HAL_I2C_Queue_SegmentSize(I2C_Queue_HandleTypeDef *hqueue)
+{
+    I2C_Queue_TransactionTypeDef *transaction = hqueue->Head;
+
+    return (hqueue->Phase == I2C_QUEUE_PHASE_WRITE) ? transaction->WriteSize : transaction->ReadSize;
+}
+
+/**
+ * @brief Задать NBYTES для оставшейся части сегмента.
+ *
+ * Если после сегмента записи следует чтение, окончание программное и по флагу TC формируется повторный START.
+ * Иначе STOP формируется аппаратно после последнего байта.
+ * @param hqueue Указатель на структуру очереди.
+ */
+static void HAL_I2C_Queue_NBYTES(I2C_Queue_HandleTypeDef *hqueue)
+{
+    I2C_TypeDef *i2c = hqueue->hi2c->Instance;
+    uint32_t remaining = HAL_I2C_Queue_SegmentSize(hqueue) - hqueue->TransferCount;
+    uint32_t cr2 = i2c->CR2 & ~(I2C_CR2_NBYTES_M | I2C_CR2_RELOAD_M | I2C_CR2_AUTOEND_M);
+
+    if (remaining > I2C_NBYTE_MAX)
+    {
+        /* При RELOAD = 1 AUTOEND игнорируется */
+        cr2 |= I2C_CR2_NBYTES(I2C_NBYTE_MAX) | I2C_CR2_RELOAD_M;
+    }
+    else
+    {
+        cr2 |= I2C_CR2_NBYTES(remaining);
+        if ((hqueue->Phase == I2C_QUEUE_PHASE_READ) || (hqueue->Head->ReadSize == 0))
+        {
+            cr2 |= I2C_CR2_AUTOEND_M;
+        }
+    }
+
+    i2c->CR2 = cr2;
+}
+
+/**
+ * @brief Начать сегмент текущей транзакции.
+ *
+ * Для сегмента чтения после записи START формирует повторный START.
+ * @param hqueue Указатель на структуру очереди.
+ * @param Phase Этап транзакции.
+ */
+static void HAL_I2C_Queue_StartSegment(I2C_Queue_HandleTypeDef *hqueue, HAL_I2C_Queue_PhaseTypeDef Phase)
+{
+    I2C_TypeDef *i2c = hqueue->hi2c->Instance;
+
+    hqueue->Phase = Phase;
+    hqueue->TransferCount = 0;
+
+    HAL_I2C_Queue_NBYTES(hqueue);
+
+    if (Phase == I2C_QUEUE_PHASE_READ)
+    {
+        i2c->CR2 |= I2C_CR2_RD_WRN_M;
+    }
+    else
+    {
+        i2c->CR2 &= ~I2C_CR2_RD_WRN_M;
+    }
+
+    /* Старт */
+    i2c->CR2 |= I2C_CR2_START_M;
+}
+
+/**
+ * @brief Запустить транзакцию в начале очереди.
+ * @param hqueue Указатель на структуру очереди.
+ */
+static void HAL_I2C_Queue_StartTransaction(I2C_Queue_HandleTypeDef *hqueue)
+{
+    I2C_Queue_TransactionTypeDef *transaction = hqueue->Head;
+
+    HAL_I2C_Master_SlaveAddress(hqueue->hi2c, transaction->SlaveAddress);
+
+    if ((transaction->WriteSize == 0) && (transaction->ReadSize != 0))
+    {
+        HAL_I2C_Queue_StartSegment(hqueue, I2C_QUEUE_PHASE_READ);
+    }
+    else
+    {
+        HAL_I2C_Queue_StartSegment(hqueue, I2C_QUEUE_PHASE_WRITE);
+    }
+}
+
+/**
+ * @brief Завершить текущую транзакцию и запустить следующую.
+ * @param hqueue Указатель на структуру очереди.
+ */
+static void HAL_I2C_Queue_Complete(I2C_Queue_HandleTypeDef *hqueue)
+{
+    I2C_Queue_TransactionTypeDef *transaction = hqueue->Head;
+
+    hqueue->Head = transaction->Next;
+    if (hqueue->Head == NULL)
+    {
+        hqueue->Tail = NULL;
+    }
+
+    transaction->State = (transaction->ErrorCode == I2C_ERROR_NONE) ? HAL_I2C_STATE_END : HAL_I2C_STATE_ERROR;
+    if (transaction->Callback != NULL)
+    {
+        transaction->Callback(transaction);
+    }
+
+    /* Callback мог поставить в очередь новую транзакцию */
+    if (hqueue->Head != NULL)
+    {
+        HAL_I2C_Queue_StartTransaction(hqueue);
+    }
+    else
+    {
+        HAL_I2C_InterruptDisable(hqueue->hi2c, I2C_QUEUE_INTMASK);
+        hqueue->hi2c->State = HAL_I2C_STATE_READY;
+    }
+}
+
+/**
+ * @brief Инициализировать очередь транзакций.
+ *
+ * Прерывание модуля I2C должно быть разрешено в EPIC, а из обработчика прерываний
+ * вместо @ref HAL_I2C_IRQHandler должен вызываться @ref HAL_I2C_Queue_IRQHandler.
+ * @param hqueue Указатель на структуру очереди.
+ * @param hi2c Указатель на структуру I2C в режиме ведущего.
+ */
+void HAL_I2C_Queue_Init(I2C_Queue_HandleTypeDef *hqueue, I2C_HandleTypeDef *hi2c)
+{
+    hqueue->hi2c = hi2c;
+    hqueue->Head = NULL;
+    hqueue->Tail = NULL;
+    hqueue->Phase = I2C_QUEUE_PHASE_WRITE;
+    hqueue->TransferCount = 0;
+
+    HAL_I2C_InterruptDisable(hi2c, I2C_INTMASK);
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
+}
+
+/**
+ * @brief Поставить транзакцию в очередь.
+ *
+ * Если очередь пуста, транзакция запускается сразу. Функцию можно вызывать из прерываний.
+ * @param hqueue Указатель на структуру очереди.
+ * @param transaction Указатель на описатель транзакции.
+ * @return Статус HAL. @ref HAL_BUSY, если описатель уже находится в очереди.
+ */
+HAL_StatusTypeDef HAL_I2C_Queue_Submit(I2C_Queue_HandleTypeDef *hqueue, I2C_Queue_TransactionTypeDef *transaction)
+{
+    if ((transaction == NULL)
+        || ((transaction->WriteSize != 0) && (transaction->pWriteData == NULL))
+        || ((transaction->ReadSize != 0) && (transaction->pReadData == NULL)))
+    {
+        return HAL_ERROR;
+    }
+
+    if (transaction->State == HAL_I2C_STATE_BUSY)
+    {
+        return HAL_BUSY;
+    }
+
+    transaction->State = HAL_I2C_STATE_BUSY;
+    transaction->ErrorCode = I2C_ERROR_NONE;
+    transaction->Next = NULL;
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (hqueue->Head == NULL)
+    {
+        hqueue->Head = transaction;
+        hqueue->Tail = transaction;
+
+        hqueue->hi2c->State = HAL_I2C_STATE_BUSY;
+        HAL_I2C_InterruptEnable(hqueue->hi2c, I2C_QUEUE_INTMASK);
+        HAL_I2C_Queue_StartTransaction(hqueue);
+    }
+    else
+    {
+        hqueue->Tail->Next = transaction;
+        hqueue->Tail = transaction;
+    }
+
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Проверить, что очередь пуста и шина не занята очередью.
+ * @param hqueue Указатель на структуру очереди.
+ * @return 1 - очередь пуста, 0 - транзакции выполняются.
+ */
+int HAL_I2C_Queue_IsIdle(I2C_Queue_HandleTypeDef *hqueue)
+{
+    return hqueue->Head == NULL;
+}
+
+/**
+ * @brief Обработчик прерывания I2C для очереди транзакций.
+ *
+ * Пересылает байты текущего сегмента, перезаписывает NBYTES при RELOAD, формирует повторный START
+ * между сегментами и по STOP запускает следующую транзакцию.
+ * @param hqueue Указатель на структуру очереди.
+ */
+void HAL_I2C_Queue_IRQHandler(I2C_Queue_HandleTypeDef *hqueue)
+{
+    I2C_TypeDef *i2c = hqueue->hi2c->Instance;
+    I2C_Queue_TransactionTypeDef *transaction = hqueue->Head;
+    uint32_t interrupt_status = i2c->ISR;
+
+    if (transaction == NULL)
+    {
+        HAL_I2C_InterruptDisable(hqueue->hi2c, I2C_QUEUE_INTMASK);
+        return;
+    }
+
+    if (interrupt_status & (I2C_ISR_BERR_M | I2C_ISR_ARLO_M | I2C_ISR_OVR_M))
+    {
+        if (interrupt_status & I2C_ISR_BERR_M)
+        {
+            transaction->ErrorCode = I2C_ERROR_BERR;
+        }
+        else if (interrupt_status & I2C_ISR_ARLO_M)
+        {
+            transaction->ErrorCode = I2C_ERROR_ARLO;
+        }
+        else
+        {
+            transaction->ErrorCode = I2C_ERROR_OVR;
+        }
+
+        /* Сброс I2C, STOP не ожидается */
+        i2c->CR1 &= ~I2C_CR1_PE_M;
+        i2c->CR1 |= I2C_CR1_PE_M;
+        HAL_I2C_Queue_Complete(hqueue);
+        return;
+    }
+
+    if (interrupt_status & I2C_ISR_NACKF_M)
+    {
+        /* STOP после NACK формируется аппаратно, транзакция завершается по STOPF */
+        transaction->ErrorCode = I2C_ERROR_NACK;
+        i2c->ICR |= I2C_ICR_NACKCF_M;
+    }
+
+    if ((interrupt_status & I2C_ISR_TXIS_M) && (hqueue->Phase == I2C_QUEUE_PHASE_WRITE))
+    {
+        i2c->TXDR = transaction->pWriteData[hqueue->TransferCount];
+        hqueue->TransferCount++;
+    }
+
+    if ((interrupt_status & I2C_ISR_RXNE_M) && (hqueue->Phase == I2C_QUEUE_PHASE_READ))
+    {
+        transaction->pReadData[hqueue->TransferCount] = (uint8_t)i2c->RXDR;
+        hqueue->TransferCount++;
+    }
+
+    if (interrupt_status & I2C_ISR_TCR_M)
+    {
+        HAL_I2C_Queue_NBYTES(hqueue);
+    }
+
+    if ((interrupt_status & I2C_ISR_TC_M) && (transaction->ErrorCode == I2C_ERROR_NONE))
+    {
+        /* Программное окончание задается только перед сегментом чтения */
+        HAL_I2C_Queue_StartSegment(hqueue, I2C_QUEUE_PHASE_READ);
+    }
+
+    if (interrupt_status & I2C_ISR_STOPF_M)
+    {
+        /* Сброс флага детектирования STOP на шине */
+        i2c->ICR |= I2C_ICR_STOPCF_M;
+        /* Сброс содержимого TXDR */
+        i2c->ISR |= I2C_ISR_TXE_M;
+
+        HAL_I2C_Queue_Complete(hqueue);
+    }
+}
@@ -0,0 +1,286 @@
+#include "mik32_hal_i2c_regmap.h"
+
+
+#define I2C_REGMAP_INTMASK	(I2C_CR1_ERRIE_M | I2C_CR1_ADDRIE_M | I2C_CR1_STOPIE_M | I2C_CR1_RXIE_M)
+
+
+/**
+ * @brief Следующий регистр с переходом через конец карты.
+ * @param hregmap Указатель на структуру карты регистров.
+ * @param Pointer Текущий регистр.
+ * @return Номер следующего регистра.
+ */
+static inline uint16_t HAL_I2C_RegMap_Next(I2C_RegMap_HandleTypeDef *hregmap, uint16_t Pointer)
+{
+    Pointer++;
+    return (Pointer < hregmap->Size) ? Pointer : 0;
+}
+
+/**
+ * @brief Начало чтения ведущим.
+ *
+ * Вызывается при совпадении адреса до сброса флага ADDR, поэтому SCL удерживается до загрузки первого байта.
+ * @param hregmap Указатель на структуру карты регистров.
+ */
+static void HAL_I2C_RegMap_ReadBegin(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+    uint16_t pointer = hregmap->Pointer;
+
+    if (hregmap->ReadCallback != NULL)
+    {
+        hregmap->ReadCallback(hregmap, pointer);
+    }
+
+    /* Сброс содержимого TXDR */
+    hi2c->Instance->ISR |= I2C_ISR_TXE_M;
+
+    if (hi2c->hdmatx != NULL)
+    {
+        /* Байты до конца карты загружаются в TXDR по запросу TXIS без участия процессора, дальше - в прерывании
+         * после HAL_I2C_RegMap_DMA_IRQHandler */
+        hi2c->Instance->CR1 |= I2C_CR1_TXDMAEN_M;
+        HAL_DMA_Start(hi2c->hdmatx, &hregmap->pRegisters[pointer], (void*)&hi2c->Instance->TXDR, hregmap->Size - pointer - 1);
+    }
+    else
+    {
+        /* Первая запись делается заранее */
+        hi2c->Instance->TXDR = hregmap->pRegisters[pointer];
+        hregmap->Pointer = HAL_I2C_RegMap_Next(hregmap, pointer);
+        HAL_I2C_InterruptEnable(hi2c, I2C_CR1_TXIE_M);
+    }
+}
+
+/**
+ * @brief Прием байта от ведущего.
+ *
+ * Первые AddressSize байт транзакции задают указатель, остальные записываются в регистры.
+ * @param hregmap Указатель на структуру карты регистров.
+ * @param Data Принятый байт.
+ */
+static void HAL_I2C_RegMap_Receive(I2C_RegMap_HandleTypeDef *hregmap, uint8_t Data)
+{
+    uint16_t pointer = hregmap->Pointer;
+
+    if (hregmap->AddressCount < hregmap->AddressSize)
+    {
+        if (hregmap->AddressCount == 0)
+        {
+            pointer = 0;
+        }
+        pointer = (pointer << 8) | Data;
+        hregmap->AddressCount++;
+
+        if ((hregmap->AddressCount == hregmap->AddressSize) && (pointer >= hregmap->Size))
+        {
+            pointer = 0;
+        }
+        hregmap->Pointer = pointer;
+        return;
+    }
+
+    uint8_t access = (hregmap->pAccess != NULL) ? hregmap->pAccess[pointer] : I2C_REGMAP_ACCESS_WRITE;
+
+    if (access & I2C_REGMAP_ACCESS_WRITE)
+    {
+        hregmap->pRegisters[pointer] = Data;
+
+        if (hregmap->WriteCount == 0)
+        {
+            hregmap->WriteStart = pointer;
+        }
+        hregmap->WriteCount++;
+
+        if (access & I2C_REGMAP_ACCESS_NOTIFY)
+        {
+            hregmap->WriteNotify = 1;
+        }
+    }
+
+    hregmap->Pointer = HAL_I2C_RegMap_Next(hregmap, pointer);
+}
+
+/**
+ * @brief Окончание транзакции по STOP.
+ * @param hregmap Указатель на структуру карты регистров.
+ */
+static void HAL_I2C_RegMap_End(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+
+    if (hi2c->Instance->CR1 & I2C_CR1_TXDMAEN_M)
+    {
+        /* Ведущий мог прочитать меньше, чем осталось до конца карты */
+        HAL_DMA_ChannelDisable(hi2c->hdmatx);
+        hi2c->Instance->CR1 &= ~I2C_CR1_TXDMAEN_M;
+    }
+
+    if ((hi2c->Instance->CR1 & I2C_CR1_TXIE_M) && !(hi2c->Instance->ISR & I2C_ISR_TXE_M))
+    {
+        /* Байт, загруженный по TXIS после NACK ведущего, не передан и сбрасывается: указатель возвращается на него */
+        hregmap->Pointer = (hregmap->Pointer != 0) ? (hregmap->Pointer - 1) : (hregmap->Size - 1);
+    }
+
+    HAL_I2C_InterruptDisable(hi2c, I2C_CR1_TXIE_M);
+
+    /* Сброс содержимого TXDR */
+    hi2c->Instance->ISR |= I2C_ISR_TXE_M;
+    /* Сброс флагов NACK и детектирования STOP на шине */
+    hi2c->Instance->ICR |= I2C_ICR_NACKCF_M | I2C_ICR_STOPCF_M;
+
+    if (hregmap->WriteNotify && (hregmap->WriteCallback != NULL))
+    {
+        hregmap->WriteCallback(hregmap, hregmap->WriteStart, hregmap->WriteCount);
+    }
+
+    hregmap->AddressCount = 0;
+    hregmap->WriteNotify = 0;
+    hregmap->WriteCount = 0;
+    hi2c->State = HAL_I2C_STATE_READY;
+}
+
+/**
+ * @brief Запустить обслуживание карты регистров.
+ *
+ * После запуска ведомый отвечает на свой адрес без повторного вызова функций приема и передачи.
+ * Из обработчика прерываний вместо @ref HAL_I2C_IRQHandler должен вызываться @ref HAL_I2C_RegMap_IRQHandler.
+ * @param hregmap Указатель на структуру карты регистров.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_I2C_RegMap_Start(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+
+    if ((hregmap->pRegisters == NULL) || (hregmap->Size == 0) || (hi2c->Init.Mode != HAL_I2C_MODE_SLAVE))
+    {
+        return HAL_ERROR;
+    }
+
+    if (hi2c->Instance->CR1 & (I2C_CR1_SBC_M | I2C_CR1_NOSTRETCH_M)) /* Указатель и ответ формируются с удержанием SCL */
+    {
+        return HAL_ERROR;
+    }
+
+    hregmap->Pointer = 0;
+    hregmap->AddressCount = 0;
+    hregmap->WriteNotify = 0;
+    hregmap->WriteCount = 0;
+
+    hi2c->Instance->CR2 &= ~I2C_CR2_RELOAD_M;
+    hi2c->Instance->CR1 &= ~(I2C_CR1_TXDMAEN_M | I2C_CR1_RXDMAEN_M);
+
+    if (hi2c->hdmatx != NULL)
+    {
+        /* Окончание пересылки до конца карты переводит чтение на прерывание TXIS */
+        HAL_DMA_LocalIRQEnable(hi2c->hdmatx, DMA_IRQ_ENABLE);
+    }
+
+    HAL_I2C_InterruptDisable(hi2c, I2C_INTMASK);
+    HAL_I2C_InterruptEnable(hi2c, I2C_REGMAP_INTMASK);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Остановить обслуживание карты регистров.
+ * @param hregmap Указатель на структуру карты регистров.
+ */
+void HAL_I2C_RegMap_Stop(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+
+    HAL_I2C_InterruptDisable(hi2c, I2C_INTMASK);
+    if (hi2c->Instance->CR1 & I2C_CR1_TXDMAEN_M)
+    {
+        HAL_DMA_ChannelDisable(hi2c->hdmatx);
+        hi2c->Instance->CR1 &= ~I2C_CR1_TXDMAEN_M;
+    }
+    hi2c->State = HAL_I2C_STATE_READY;
+}
+
+/**
+ * @brief Обработчик прерывания DMA карты регистров.
+ *
+ * Вызывается из обработчика прерывания DMA, если задан hi2c->hdmatx. Когда DMA загрузил регистры до конца карты,
+ * следующие байты чтения передаются в прерывании TXIS с регистра 0, как без DMA. Функция сбрасывает флаги
+ * локальных прерываний DMA (@ref HAL_DMA_ClearLocalIrq), поэтому флаги других каналов проверяются до вызова.
+ * @param hregmap Указатель на структуру карты регистров.
+ */
+void HAL_I2C_RegMap_DMA_IRQHandler(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+
+    if (HAL_DMA_GetChannelIrq(hi2c->hdmatx) && HAL_DMA_GetChannelReadyStatus(hi2c->hdmatx)
+        && (hi2c->Instance->CR1 & I2C_CR1_TXDMAEN_M))
+    {
+        hi2c->Instance->CR1 &= ~I2C_CR1_TXDMAEN_M;
+        hregmap->Pointer = 0;
+        HAL_I2C_InterruptEnable(hi2c, I2C_CR1_TXIE_M);
+    }
+
+    HAL_DMA_ClearLocalIrq(hi2c->hdmatx->dma);
+}
+
+/**
+ * @brief Обработчик прерывания I2C для карты регистров.
+ * @param hregmap Указатель на структуру карты регистров.
+ */
+void HAL_I2C_RegMap_IRQHandler(I2C_RegMap_HandleTypeDef *hregmap)
+{
+    I2C_HandleTypeDef *hi2c = hregmap->hi2c;
+    uint32_t int_mask = hi2c->Instance->CR1 & I2C_INTMASK; /* разрешенные прерывания  */
+    uint32_t interrupt_status = hi2c->Instance->ISR; /* Флаги */
+
+    if (interrupt_status & (I2C_ISR_BERR_M | I2C_ISR_ARLO_M | I2C_ISR_OVR_M))
+    {
+        hregmap->AddressCount = 0;
+        hregmap->WriteNotify = 0;
+        hregmap->WriteCount = 0;
+        if (hi2c->Instance->CR1 & I2C_CR1_TXDMAEN_M)
+        {
+            HAL_DMA_ChannelDisable(hi2c->hdmatx);
+            hi2c->Instance->CR1 &= ~I2C_CR1_TXDMAEN_M;
+        }
+        HAL_I2C_InterruptDisable(hi2c, I2C_CR1_TXIE_M);
+
+        /* Сброс I2C, собственный адрес и разрешения прерываний сохраняются */
+        hi2c->State = HAL_I2C_STATE_ERROR;
+        hi2c->Instance->CR1 &= ~I2C_CR1_PE_M;
+        hi2c->Instance->CR1 |= I2C_CR1_PE_M;
+        return;
+    }
+
+    if (interrupt_status & I2C_ISR_RXNE_M)
+    {
+        HAL_I2C_RegMap_Receive(hregmap, (uint8_t)hi2c->Instance->RXDR);
+    }
+
+    if ((interrupt_status & I2C_ISR_TXIS_M) && (int_mask & I2C_CR1_TXIE_M))
+    {
+        uint16_t pointer = hregmap->Pointer;
+        hi2c->Instance->TXDR = hregmap->pRegisters[pointer];
+        hregmap->Pointer = HAL_I2C_RegMap_Next(hregmap, pointer);
+    }
+
+    if (interrupt_status & I2C_ISR_ADDR_M)
+    {
+        hi2c->State = HAL_I2C_STATE_BUSY;
+        if (interrupt_status & I2C_ISR_DIR_M)
+        {
+            HAL_I2C_RegMap_ReadBegin(hregmap);
+        }
+        else
+        {
+            /* Запись или повторный START: новый указатель */
+            hregmap->AddressCount = 0;
+        }
+
+        /* Сброс флага ADDR */
+        hi2c->Instance->ICR |= I2C_ICR_ADDRCF_M;
+    }
+
+    if (interrupt_status & I2C_ISR_STOPF_M)
+    {
+        HAL_I2C_RegMap_End(hregmap);
+    }
+}
@@ -303,6 +303,7 @@ void HAL_PCC_DividerAPB_P(uint32_t DividerAPB_P)
  * @brief Настроить тактирование и монитор частоты.
  * 
  * Функция для настройки тактирования и монитора частоты в соответствии с заданными настройками в PCC_Init.
+ * После настройки выполняется калибровка программной задержки @ref HAL_ProgramDelay_Calibrate.
  * 
  * @param PCC_Init Структура с настройками.
  * @return Структура с состояниями об ошибках.
@@ -369,6 +370,9 @@ PCC_ConfigErrorsTypeDef HAL_PCC_Config(PCC_InitTypeDef *PCC_Init)
         WU->CLOCKS_BU |= (1 << WU_CLOCKS_BU_OSC32K_EN_S); // Выключить OSC32K
     }
 
+    /* Калибровка программной задержки для новой частоты ядра */
+    HAL_ProgramDelay_Calibrate();
+
     return errors;
 }
 
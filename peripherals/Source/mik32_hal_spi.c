@@ -1,4 +1,5 @@
 #include "mik32_hal_spi.h"
+#include "mik32_hal_prof.h"
 
 /**
   * @brief  Инициализация SPI MSP.
@@ -450,6 +451,8 @@ error:
  */
 HAL_StatusTypeDef HAL_SPI_Exchange(SPI_HandleTypeDef *hspi, uint8_t TransmitBytes[], uint8_t ReceiveBytes[], uint32_t DataSize, uint32_t Timeout)
 {
+    HAL_PROF_BEGIN(spi_exchange);
+
     uint32_t txallowed = 1;
     HAL_StatusTypeDef error_code = HAL_OK;
     uint32_t timeout_counter = 0;
@@ -507,6 +510,7 @@ error:
     volatile uint32_t unused = hspi->Instance->INT_STATUS; /* Очистка флагов ошибок чтением */
     (void) unused;
 
+    HAL_PROF_END(spi_exchange);
 
     return error_code;
 }
@@ -0,0 +1,450 @@
+#include "mik32_hal_stepper.h"
+#include "mik32_hal.h"
+
+
+/**
+ * @brief Приращение величины за время шага.
+ *
+ * Используется для приращения скорости по ускорению и ускорения по рывку.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param rate Скорость изменения величины в формате Q8.
+ * @param interval Период шага в тактах таймера в формате Q8.
+ * @return Приращение rate * interval / TickFreq в формате Q8.
+ */
+static inline uint32_t HAL_Stepper_Delta(Stepper_HandleTypeDef *hstepper, uint32_t rate, uint32_t interval)
+{
+    return (uint32_t)(((((uint64_t)rate * interval) >> 24) * hstepper->InvFreq) >> 32);
+}
+
+/**
+ * @brief Период шага для новой скорости.
+ *
+ * Одна итерация Ньютона для 1 / v от периода предыдущего шага: c' = c + c * (1 - v * c / F).
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param interval Период предыдущего шага в тактах таймера в формате Q8.
+ * @param speed Новая скорость в формате Q8.
+ * @return Период шага в тактах таймера в формате Q8.
+ */
+static inline uint32_t HAL_Stepper_Interval(Stepper_HandleTypeDef *hstepper, uint32_t interval, uint32_t speed)
+{
+    /* v * c / F в формате Q48 */
+    int64_t product = (int64_t)((((uint64_t)speed * interval) >> 16) * hstepper->InvFreq);
+    int64_t error = ((int64_t)1 << 48) - product;
+
+    return interval + (int32_t)(((int64_t)interval * (error >> 16)) >> 32);
+}
+
+/**
+ * @brief Тормозной путь оси с текущей скорости до начальной.
+ * @param axis Указатель на ось.
+ * @return Количество шагов.
+ */
+static uint32_t HAL_Stepper_StopDistance(Stepper_AxisTypeDef *axis)
+{
+    uint32_t speed = axis->Speed >> 8;
+    uint32_t speed_min = axis->SpeedMin >> 8;
+
+    if (speed <= speed_min)
+    {
+        return 0;
+    }
+
+    if (axis->Profile == STEPPER_PROFILE_TRAPEZOID)
+    {
+        /* (v^2 - v0^2) / (2 * A) */
+        uint64_t square = (uint64_t)speed * speed - (uint64_t)speed_min * speed_min;
+        return (uint32_t)(((square >> 8) * axis->InvTwoAccel) >> 24) + 1;
+    }
+
+    /* Средняя скорость (v + v0) / 2 на время торможения (v - v0) / A + A / J. Если ускорение не достигает
+     * Accel, время торможения 2 * sqrt((v - v0) / J) меньше этой оценки */
+    uint64_t time = (uint64_t)(speed - speed_min) * axis->InvAccel + (uint64_t)axis->Accel * axis->InvJerk;
+    return (uint32_t)((((uint64_t)(speed + speed_min) >> 1) * time) >> 32) + 1;
+}
+
+/**
+ * @brief Ускорение S-кривой на следующем шаге.
+ *
+ * Ускорение спадает, если до целевой скорости осталось не больше a^2 / (2 * J), иначе нарастает до Accel.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param axis Указатель на ось.
+ * @param remaining Разность целевой и текущей скорости в формате Q8.
+ */
+static inline void HAL_Stepper_Jerk(Stepper_HandleTypeDef *hstepper, Stepper_AxisTypeDef *axis, uint32_t remaining)
+{
+    uint32_t accel = axis->CurAccel;
+    uint32_t delta = HAL_Stepper_Delta(hstepper, axis->Jerk << 8, axis->Interval);
+    uint64_t accel_int = accel >> 8;
+    uint32_t ramp = (uint32_t)((accel_int * accel_int * axis->InvJerk) >> 25);
+
+    if (remaining <= ramp)
+    {
+        accel = (accel > delta) ? (accel - delta) : 0;
+    }
+    else
+    {
+        accel = (axis->AccelMax - accel > delta) ? (accel + delta) : axis->AccelMax;
+    }
+
+    axis->CurAccel = accel;
+}
+
+/**
+ * @brief Выполнить шаг оси.
+ *
+ * Выдает импульс STEP, обновляет скорость по этапу движения и записывает в OCR время следующего шага.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param index Номер оси.
+ */
+static void HAL_Stepper_Step(Stepper_HandleTypeDef *hstepper, uint32_t index)
+{
+    Stepper_AxisTypeDef *axis = hstepper->Axis[index];
+    TIMER32_TypeDef *timer = hstepper->htimer32->Instance;
+    uint32_t pulse_start = timer->VALUE;
+
+    axis->StepPort->SET = axis->StepPin;
+    axis->Position += axis->Direction;
+
+    if (--axis->Remaining == 0)
+    {
+        axis->State = STEPPER_STATE_IDLE;
+        HAL_Timer32_InterruptMask_Clear(hstepper->htimer32, TIMER32_INT_OC_M(index));
+    }
+    else
+    {
+        if ((axis->State != STEPPER_STATE_DECEL) && (axis->Remaining <= HAL_Stepper_StopDistance(axis)))
+        {
+            axis->State = STEPPER_STATE_DECEL;
+            if (axis->Profile == STEPPER_PROFILE_SCURVE)
+            {
+                axis->CurAccel = 0;
+            }
+        }
+
+        uint32_t speed = axis->Speed;
+
+        switch (axis->State)
+        {
+        case STEPPER_STATE_ACCEL:
+            if (axis->Profile == STEPPER_PROFILE_SCURVE)
+            {
+                HAL_Stepper_Jerk(hstepper, axis, axis->SpeedMax - speed);
+            }
+            speed += HAL_Stepper_Delta(hstepper, axis->CurAccel, axis->Interval);
+            if (speed >= axis->SpeedMax)
+            {
+                speed = axis->SpeedMax;
+                axis->State = STEPPER_STATE_CRUISE;
+                if (axis->Profile == STEPPER_PROFILE_SCURVE)
+                {
+                    axis->CurAccel = 0;
+                }
+            }
+            break;
+
+        case STEPPER_STATE_DECEL:
+            if (axis->Profile == STEPPER_PROFILE_SCURVE)
+            {
+                HAL_Stepper_Jerk(hstepper, axis, speed - axis->SpeedMin);
+            }
+            uint32_t delta = HAL_Stepper_Delta(hstepper, axis->CurAccel, axis->Interval);
+            speed = (speed - axis->SpeedMin > delta) ? (speed - delta) : axis->SpeedMin;
+            break;
+
+        default:
+            break;
+        }
+
+        if (speed != axis->Speed)
+        {
+            axis->Speed = speed;
+            axis->Interval = HAL_Stepper_Interval(hstepper, axis->Interval, speed);
+        }
+
+        uint32_t frac = axis->Frac + (axis->Interval & 0xFF);
+        uint32_t compare = axis->Compare + (axis->Interval >> 8) + (frac >> 8);
+        axis->Frac = frac & 0xFF;
+
+        /* Если расчет занял больше периода шага, шаг выполняется с опозданием, а не через полный оборот таймера */
+        uint32_t earliest = timer->VALUE + STEPPER_MIN_DELTA;
+        if ((int32_t)(compare - earliest) < 0)
+        {
+            compare = earliest;
+        }
+        axis->Compare = compare;
+        timer->CHANNELS[index].OCR = compare;
+    }
+
+    while ((timer->VALUE - pulse_start) < axis->PulseWidth)
+        ;
+    axis->StepPort->CLEAR = axis->StepPin;
+}
+
+/**
+ * @brief Рассчитать параметры профиля оси.
+ *
+ * Выполняет все деления профиля. Начальная скорость повышается так, чтобы скорость за первый шаг изменилась
+ * не больше чем на 1/8 и период шага помещался в 23 бита.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param axis Указатель на ось.
+ * @return Статус HAL.
+ */
+static HAL_StatusTypeDef HAL_Stepper_Plan(Stepper_HandleTypeDef *hstepper, Stepper_AxisTypeDef *axis)
+{
+    if ((axis->Accel == 0) || (axis->Accel > 0xFFFFFF) || (axis->MaxSpeed == 0) ||
+        ((hstepper->TickFreq / axis->MaxSpeed) < STEPPER_MIN_INTERVAL))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((axis->Profile == STEPPER_PROFILE_SCURVE) && ((axis->Jerk < axis->Accel) || (axis->Jerk > 0xFFFFFF)))
+    {
+        return HAL_ERROR;
+    }
+
+    uint32_t speed_min = axis->StartSpeed;
+    uint32_t limit = HAL_Sqrt(axis->Accel * 8);
+    if (speed_min < limit)
+    {
+        speed_min = limit;
+    }
+    limit = (hstepper->TickFreq >> 23) + 1;
+    if (speed_min < limit)
+    {
+        speed_min = limit;
+    }
+    if (speed_min > axis->MaxSpeed)
+    {
+        speed_min = axis->MaxSpeed;
+    }
+
+    axis->SpeedMin = speed_min << 8;
+    axis->SpeedMax = axis->MaxSpeed << 8;
+    axis->AccelMax = axis->Accel << 8;
+    axis->InvTwoAccel = 0x80000000UL / axis->Accel;
+    axis->InvAccel = 0xFFFFFFFFUL / axis->Accel;
+    axis->InvJerk = (axis->Profile == STEPPER_PROFILE_SCURVE) ? (0xFFFFFFFFUL / axis->Jerk) : 0;
+
+    axis->Speed = axis->SpeedMin;
+    axis->CurAccel = (axis->Profile == STEPPER_PROFILE_SCURVE) ? 0 : axis->AccelMax;
+    axis->Interval = (uint32_t)(((uint64_t)hstepper->TickFreq << 8) / speed_min);
+    axis->Frac = 0;
+
+    return HAL_OK;
+}
+
+
+/**
+ * @brief Инициализировать генератор шагов.
+ *
+ * Настраивает таймер на счет вперед с Top = 0xFFFFFFFF, каналы заданных осей - в режим сравнения, и запускает таймер.
+ * Выводы STEP переводятся в 0.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Stepper_Init(Stepper_HandleTypeDef *hstepper)
+{
+    TIMER32_HandleTypeDef *htimer32 = hstepper->htimer32;
+
+    if ((htimer32 == NULL) || ((htimer32->Instance != TIMER32_1) && (htimer32->Instance != TIMER32_2)) ||
+        (hstepper->TickFreq < STEPPER_MIN_TICK_FREQ))
+    {
+        return HAL_ERROR;
+    }
+
+    htimer32->Top = 0xFFFFFFFF;
+    htimer32->CountMode = TIMER32_COUNTMODE_FORWARD;
+    htimer32->State = TIMER32_STATE_DISABLE;
+    htimer32->InterruptMask = 0;
+    if (HAL_Timer32_Init(htimer32) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    hstepper->InvFreq = (uint32_t)((1ULL << 48) / hstepper->TickFreq);
+
+    for (uint32_t index = 0; index < STEPPER_AXES; index++)
+    {
+        Stepper_AxisTypeDef *axis = hstepper->Axis[index];
+
+        if (axis == NULL)
+        {
+            continue;
+        }
+
+        hstepper->Channel[index].TimerInstance = htimer32->Instance;
+        hstepper->Channel[index].ChannelIndex = index;
+        hstepper->Channel[index].PWM_Invert = TIMER32_CHANNEL_NON_INVERTED_PWM;
+        hstepper->Channel[index].Mode = TIMER32_CHANNEL_MODE_COMPARE;
+        hstepper->Channel[index].CaptureEdge = TIMER32_CHANNEL_CAPTUREEDGE_RISING;
+        hstepper->Channel[index].OCR = 0;
+        hstepper->Channel[index].Noise = TIMER32_CHANNEL_FILTER_OFF;
+        if (HAL_Timer32_Channel_Init(&hstepper->Channel[index]) != HAL_OK)
+        {
+            return HAL_ERROR;
+        }
+
+        axis->StepPort->CLEAR = axis->StepPin;
+        axis->State = STEPPER_STATE_IDLE;
+        axis->Remaining = 0;
+        HAL_Timer32_Channel_Enable(&hstepper->Channel[index]);
+    }
+
+    HAL_Timer32_Value_Clear(htimer32);
+    HAL_Timer32_InterruptFlags_Clear(htimer32);
+    HAL_Timer32_Start(htimer32);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить перемещение оси на заданное количество шагов.
+ *
+ * Первый шаг выполняется через период начальной скорости.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param index Номер оси.
+ * @param Steps Количество шагов со знаком направления.
+ * @return Статус HAL. HAL_BUSY, если ось движется.
+ */
+HAL_StatusTypeDef HAL_Stepper_Move(Stepper_HandleTypeDef *hstepper, uint32_t index, int32_t Steps)
+{
+    if ((index >= STEPPER_AXES) || (hstepper->Axis[index] == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    Stepper_AxisTypeDef *axis = hstepper->Axis[index];
+
+    if (axis->State != STEPPER_STATE_IDLE)
+    {
+        return HAL_BUSY;
+    }
+
+    if (Steps == 0)
+    {
+        return HAL_OK;
+    }
+
+    if (HAL_Stepper_Plan(hstepper, axis) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    axis->Direction = (Steps > 0) ? 1 : -1;
+    axis->Remaining = (Steps > 0) ? (uint32_t)Steps : (uint32_t)(-(int64_t)Steps);
+    if (axis->DirPort != NULL)
+    {
+        HAL_GPIO_WritePin(axis->DirPort, axis->DirPin, (Steps > 0) ? GPIO_PIN_HIGH : GPIO_PIN_LOW);
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    axis->State = (axis->SpeedMin < axis->SpeedMax) ? STEPPER_STATE_ACCEL : STEPPER_STATE_CRUISE;
+    axis->Compare = hstepper->htimer32->Instance->VALUE + (axis->Interval >> 8);
+    HAL_Timer32_Channel_OCR_Set(&hstepper->Channel[index], axis->Compare);
+    HAL_Timer32_InterruptFlags_ClearMask(hstepper->htimer32, TIMER32_INT_OC_M(index));
+    HAL_Timer32_InterruptMask_Set(hstepper->htimer32, TIMER32_INT_OC_M(index));
+
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить перемещение оси в заданное положение.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param index Номер оси.
+ * @param Position Положение в шагах.
+ * @return Статус HAL. HAL_BUSY, если ось движется.
+ */
+HAL_StatusTypeDef HAL_Stepper_MoveTo(Stepper_HandleTypeDef *hstepper, uint32_t index, int32_t Position)
+{
+    if ((index >= STEPPER_AXES) || (hstepper->Axis[index] == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    return HAL_Stepper_Move(hstepper, index, Position - hstepper->Axis[index]->Position);
+}
+
+/**
+ * @brief Остановить ось с торможением.
+ *
+ * Количество оставшихся шагов сокращается до тормозного пути с текущей скорости, но не меньше одного
+ * уже назначенного шага.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param index Номер оси.
+ */
+void HAL_Stepper_Stop(Stepper_HandleTypeDef *hstepper, uint32_t index)
+{
+    if ((index >= STEPPER_AXES) || (hstepper->Axis[index] == NULL))
+    {
+        return;
+    }
+
+    Stepper_AxisTypeDef *axis = hstepper->Axis[index];
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (axis->State != STEPPER_STATE_IDLE)
+    {
+        /* Следующий шаг уже назначен в OCR: на начальной скорости тормозной путь равен 0, и ось
+         * останавливается после него */
+        uint32_t distance = HAL_Stepper_StopDistance(axis);
+        if (distance == 0)
+        {
+            distance = 1;
+        }
+        if (distance < axis->Remaining)
+        {
+            axis->Remaining = distance;
+        }
+    }
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Остановить ось без торможения.
+ * @param hstepper Указатель на структуру генератора шагов.
+ * @param index Номер оси.
+ */
+void HAL_Stepper_Abort(Stepper_HandleTypeDef *hstepper, uint32_t index)
+{
+    if ((index >= STEPPER_AXES) || (hstepper->Axis[index] == NULL))
+    {
+        return;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    HAL_Timer32_InterruptMask_Clear(hstepper->htimer32, TIMER32_INT_OC_M(index));
+    HAL_Timer32_InterruptFlags_ClearMask(hstepper->htimer32, TIMER32_INT_OC_M(index));
+    hstepper->Axis[index]->Remaining = 0;
+    hstepper->Axis[index]->State = STEPPER_STATE_IDLE;
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Обработчик прерывания генератора шагов.
+ *
+ * Выполняет шаги осей, для которых наступило сравнение.
+ * @param hstepper Указатель на структуру генератора шагов.
+ */
+void HAL_Stepper_IRQHandler(Stepper_HandleTypeDef *hstepper)
+{
+    TIMER32_HandleTypeDef *htimer32 = hstepper->htimer32;
+    uint32_t interrupt_status = htimer32->Instance->INT_FLAGS & htimer32->InterruptMask;
+
+    for (uint32_t index = 0; index < STEPPER_AXES; index++)
+    {
+        if (interrupt_status & TIMER32_INT_OC_M(index))
+        {
+            HAL_Timer32_InterruptFlags_ClearMask(htimer32, TIMER32_INT_OC_M(index));
+            if (hstepper->Axis[index]->State != STEPPER_STATE_IDLE)
+            {
+                HAL_Stepper_Step(hstepper, index);
+            }
+        }
+    }
+}
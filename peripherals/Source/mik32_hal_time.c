@@ -0,0 +1,107 @@
+#include "mik32_hal_time.h"
+
+
+/* Источник системного времени, задается функциями HAL_Time_*_Init */
+static struct
+{
+    HAL_Time_Ticks64TypeDef ticks64;
+    uint32_t tick_freq;
+    HAL_Time_ScaleTypeDef micros;
+} HAL_Time_Source;
+
+
+/**
+ * @brief Рассчитать коэффициент перевода тактов частоты FromFreq в такты частоты ToFreq.
+ *
+ * Выбирается наибольшее количество дробных бит, при котором множитель помещается в 32 бита.
+ * Функция выполняет 64-р деление и вызывается только при инициализации.
+ * @param scale Указатель на коэффициент.
+ * @param FromFreq Частота исходного счетчика, Гц.
+ * @param ToFreq Частота результата, Гц. Например, 1000000 для микросекунд.
+ */
+void HAL_Time_ScaleInit(HAL_Time_ScaleTypeDef *scale, uint32_t FromFreq, uint32_t ToFreq)
+{
+    uint32_t shift = 0;
+
+    if (FromFreq == 0)
+    {
+        scale->Mult = 0;
+        scale->Shift = 0;
+        return;
+    }
+
+    while (shift < 63)
+    {
+        uint64_t next = (uint64_t)ToFreq << (shift + 1);
+
+        /* Сдвиг не должен терять старшие биты, множитель должен помещаться в 32 бита */
+        if (((next >> (shift + 1)) != ToFreq) || ((next / FromFreq) > 0xFFFFFFFFULL))
+        {
+            break;
+        }
+        shift++;
+    }
+
+    scale->Mult = (uint32_t)(((uint64_t)ToFreq << shift) / FromFreq);
+    scale->Shift = shift;
+}
+
+/**
+ * @brief Задать источник системного времени.
+ *
+ * Вызывается из функций инициализации системных часов HAL_Time_SCR1TIM_Init, HAL_Time_TIM16_Init и HAL_Time_TIM32_Init.
+ * Источником становится последний проинициализированный таймер.
+ * @param Ticks64 Функция чтения 64-р счетчика тактов.
+ * @param TickFreq Частота счетчика, Гц.
+ */
+void HAL_Time_SetSource(HAL_Time_Ticks64TypeDef Ticks64, uint32_t TickFreq)
+{
+    HAL_Time_ScaleTypeDef micros;
+    HAL_Time_ScaleInit(&micros, TickFreq, 1000000UL);
+
+    HAL_Time_Source.ticks64 = NULL;
+    HAL_Time_Source.tick_freq = TickFreq;
+    HAL_Time_Source.micros = micros;
+    HAL_Time_Source.ticks64 = Ticks64;
+}
+
+/**
+ * @brief Частота счетчика системного времени.
+ * @return Частота, Гц. 0, если источник не задан.
+ */
+uint32_t HAL_Time_GetTickFreq()
+{
+    return HAL_Time_Source.tick_freq;
+}
+
+/**
+ * @brief 64-р счетчик тактов системного времени.
+ * @return Количество тактов с момента инициализации источника. 0, если источник не задан.
+ */
+uint64_t HAL_Time_Ticks64()
+{
+    HAL_Time_Ticks64TypeDef ticks64 = HAL_Time_Source.ticks64;
+
+    return (ticks64 != NULL) ? ticks64() : 0;
+}
+
+/**
+ * @brief Перевести такты системного времени в микросекунды.
+ * @param ticks Количество тактов, например разность двух значений @ref HAL_Time_Ticks64.
+ * @return Время в микросекундах.
+ */
+uint64_t HAL_Time_TicksToUs(uint64_t ticks)
+{
+    return HAL_Time_Scale(&HAL_Time_Source.micros, ticks);
+}
+
+/**
+ * @brief Монотонное системное время в микросекундах.
+ *
+ * Значение не переполняется за время работы устройства. Функцию можно вызывать из прерываний.
+ * @return Время в микросекундах с момента инициализации источника.
+ */
+uint64_t HAL_Time_Now64()
+{
+    return HAL_Time_Scale(&HAL_Time_Source.micros, HAL_Time_Ticks64());
+}
@@ -1035,9 +1035,12 @@ struct {
     /* Timer prescaler */
     uint32_t pt;
     /* Time in ticks, updated by interrupts */
-    volatile uint32_t ticks;
+    volatile uint64_t ticks;
     /* Clock frequency */
     uint32_t clock_freq;
+    /* Ticks to microseconds and milliseconds */
+    HAL_Time_ScaleTypeDef micros;
+    HAL_Time_ScaleTypeDef millis;
 } HAL_Time_TIM16_Handler;
 
 
@@ -1115,6 +1118,10 @@ void HAL_Time_TIM16_Init(TIMER16_TypeDef* timer)
     /* Reset the timer */
     HAL_Time_TIM16_Handler.tim16.Instance->CNT = 0;
     HAL_Time_TIM16_Handler.ticks = 0;
+    /* Conversion coefficients */
+    uint32_t tick_freq = HAL_Time_TIM16_Handler.clock_freq / HAL_Time_TIM16_Handler.pt;
+    HAL_Time_ScaleInit(&HAL_Time_TIM16_Handler.micros, tick_freq, 1000000UL);
+    HAL_Time_ScaleInit(&HAL_Time_TIM16_Handler.millis, tick_freq, 1000UL);
     /* Set interrupt mask */
     switch ((uint32_t)timer)
     {
@@ -1124,6 +1131,32 @@ void HAL_Time_TIM16_Init(TIMER16_TypeDef* timer)
     }
     HAL_IRQ_EnableInterrupts();
     HAL_Timer16_Counter_Start_IT(&(HAL_Time_TIM16_Handler.tim16), 0xFFFF);
+
+    HAL_Time_SetSource(HAL_Time_TIM16_Ticks64, tick_freq);
+}
+
+/**
+ * @brief 64-р значение счетчика 16-р таймера системных часов.
+ * 
+ * Учитывает переполнение, прерывание по которому еще не обработано, поэтому функцию можно
+ * вызывать из прерываний и при запрещенных прерываниях.
+*/
+uint64_t HAL_Time_TIM16_Ticks64()
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    uint64_t ticks = HAL_Time_TIM16_Handler.ticks;
+    uint32_t cnt = HAL_Time_TIM16_Handler.tim16.Instance->CNT;
+    if (__HAL_TIMER16_GET_FLAG_IT(&(HAL_Time_TIM16_Handler.tim16), TIMER16_FLAG_ARRM))
+    {
+        /* Переполнение еще не учтено в ticks, значение CNT перечитывается после переполнения */
+        cnt = HAL_Time_TIM16_Handler.tim16.Instance->CNT;
+        ticks += 0x00010000UL;
+    }
+
+    HAL_IRQ_Restore(mstatus);
+
+    return ticks + cnt;
 }
 
 // uint32_t HAL_Time_TIM16_GetTick()
@@ -1136,10 +1169,7 @@ void HAL_Time_TIM16_Init(TIMER16_TypeDef* timer)
 */
 uint32_t HAL_Time_TIM16_Micros()
 {
-    //HAL_IRQ_DisableInterrupts();
-    uint64_t time_raw = HAL_Time_TIM16_Handler.ticks + HAL_Time_TIM16_Handler.tim16.Instance->CNT;
-    return (uint32_t)(time_raw * (1000000UL * HAL_Time_TIM16_Handler.pt) /
-        HAL_Time_TIM16_Handler.clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_TIM16_Handler.micros, HAL_Time_TIM16_Ticks64());
 }
 
 /**
@@ -1147,9 +1177,7 @@ uint32_t HAL_Time_TIM16_Micros()
 */
 uint32_t HAL_Time_TIM16_Millis()
 {
-    uint64_t time_raw = HAL_Time_TIM16_Handler.ticks + HAL_Time_TIM16_Handler.tim16.Instance->CNT;
-    return (uint32_t)(time_raw * (1000UL * HAL_Time_TIM16_Handler.pt) /
-        HAL_Time_TIM16_Handler.clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_TIM16_Handler.millis, HAL_Time_TIM16_Ticks64());
 }
 
 /**
@@ -0,0 +1,192 @@
+#include "mik32_hal_timer16_encoder.h"
+
+
+/**
+ * @brief Прочитать счетчик Timer16.
+ *
+ * Счетчик тактируется сигналами энкодера асинхронно шине, значение читается до совпадения двух чтений подряд.
+ * @param hencoder Указатель на структуру энкодера.
+ * @return Значение счетчика.
+ */
+static inline uint16_t HAL_Timer16_Encoder_ReadCount(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    uint16_t count;
+
+    do
+    {
+        count = hencoder->htimer16->Instance->CNT;
+    } while (count != (uint16_t)hencoder->htimer16->Instance->CNT);
+
+    return count;
+}
+
+/**
+ * @brief Ограничить скорость диапазоном int32_t.
+ * @param velocity Скорость.
+ * @return Ограниченная скорость.
+ */
+static inline int32_t HAL_Timer16_Encoder_Saturate(int64_t velocity)
+{
+    if (velocity > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if (velocity < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)velocity;
+}
+
+
+/**
+ * @brief Запустить энкодер и таймер меток времени.
+ *
+ * Timer16 запускается в режиме энкодера с ARR = 0xFFFF, положение и скорость сбрасываются.
+ * Канал захвата, если задан, включается без прерываний. Timer32 запускается, если он остановлен.
+ * @param hencoder Указатель на структуру энкодера.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer16_Encoder_Init(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    if ((hencoder == NULL) || (hencoder->htimer16 == NULL) || (hencoder->htimer32 == NULL) || (hencoder->TickFreq == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if ((hencoder->hchannel != NULL) && (hencoder->hchannel->Mode != TIMER32_CHANNEL_MODE_CAPTURE))
+    {
+        return HAL_ERROR;
+    }
+
+    HAL_Timer16_Encoder_Start(hencoder->htimer16, 0xFFFF);
+
+    if (hencoder->hchannel != NULL)
+    {
+        HAL_Timer32_Channel_Enable(hencoder->hchannel);
+    }
+
+    if (hencoder->htimer32->State != TIMER32_STATE_ENABLE)
+    {
+        HAL_Timer32_Start(hencoder->htimer32);
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    hencoder->Position = 0;
+    hencoder->LastCount = HAL_Timer16_Encoder_ReadCount(hencoder);
+    hencoder->EdgePosition = 0;
+    hencoder->EdgeTime = (hencoder->hchannel != NULL) ? hencoder->hchannel->Instance->ICR : hencoder->htimer32->Instance->VALUE;
+    hencoder->EdgePeriod = 0;
+    hencoder->Velocity = 0;
+
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Выполнить выборку: обновить положение и рассчитать скорость.
+ *
+ * Вызывается периодически, например из прерывания таймера. Если с предыдущего расчета был захвачен новый фронт,
+ * скорость равна M / T, где M - изменение положения, округленное до кратного EdgeCounts, T - время между
+ * фронтами. Если фронтов нет, модуль скорости ограничивается значением, соответствующим появлению фронта
+ * в текущий момент, а после Timeout тактов без фронтов скорость равна 0.
+ * @param hencoder Указатель на структуру энкодера.
+ */
+void HAL_Timer16_Encoder_Sample(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    uint16_t count = HAL_Timer16_Encoder_ReadCount(hencoder);
+    uint32_t now = hencoder->htimer32->Instance->VALUE;
+    uint32_t edge = (hencoder->hchannel != NULL) ? hencoder->hchannel->Instance->ICR : now;
+
+    hencoder->Position += (int16_t)(uint16_t)(count - hencoder->LastCount);
+    hencoder->LastCount = count;
+
+    uint32_t edge_counts = (hencoder->EdgeCounts > 1) ? hencoder->EdgeCounts : 1;
+
+    if (edge != hencoder->EdgeTime)
+    {
+        uint32_t period = edge - hencoder->EdgeTime;
+        int32_t m = (int32_t)(hencoder->Position - hencoder->EdgePosition);
+
+        if (edge_counts > 1)
+        {
+            /* Отсчеты после захваченного фронта не относятся к интервалу T */
+            int32_t half = edge_counts / 2;
+            m = ((m >= 0) ? (m + half) : (m - half)) / (int32_t)edge_counts * (int32_t)edge_counts;
+        }
+
+        hencoder->Velocity = HAL_Timer16_Encoder_Saturate(
+            ((int64_t)m * hencoder->TickFreq << TIMER16_ENCODER_VELOCITY_SHIFT) / period);
+        hencoder->EdgeTime = edge;
+        hencoder->EdgePosition = hencoder->Position;
+        hencoder->EdgePeriod = period;
+    }
+    else if (hencoder->Velocity != 0)
+    {
+        uint32_t elapsed = now - hencoder->EdgeTime;
+
+        if ((hencoder->Timeout != 0) && (elapsed >= hencoder->Timeout))
+        {
+            hencoder->Velocity = 0;
+        }
+        else if (elapsed > hencoder->EdgePeriod)
+        {
+            /* Следующий фронт еще не пришел: скорость не больше edge_counts / elapsed */
+            int32_t bound = HAL_Timer16_Encoder_Saturate(((int64_t)edge_counts * hencoder->TickFreq << TIMER16_ENCODER_VELOCITY_SHIFT) / elapsed);
+            if (hencoder->Velocity > bound)
+            {
+                hencoder->Velocity = bound;
+            }
+            else if (hencoder->Velocity < -bound)
+            {
+                hencoder->Velocity = -bound;
+            }
+        }
+    }
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Получить текущее положение.
+ *
+ * Положение последней выборки дополняется изменением счетчика после нее. Функция выполняется за постоянное
+ * время и может вызываться из прерываний.
+ * @param hencoder Указатель на структуру энкодера.
+ * @return Положение, отсчеты.
+ */
+int64_t HAL_Timer16_Encoder_GetPosition(Timer16_Encoder_HandleTypeDef *hencoder)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    int64_t position = hencoder->Position + (int16_t)(uint16_t)(HAL_Timer16_Encoder_ReadCount(hencoder) - hencoder->LastCount);
+
+    HAL_IRQ_Restore(mstatus);
+
+    return position;
+}
+
+/**
+ * @brief Задать текущее положение.
+ *
+ * Оценка скорости не сбрасывается.
+ * @param hencoder Указатель на структуру энкодера.
+ * @param Position Новое положение, отсчеты.
+ */
+void HAL_Timer16_Encoder_SetPosition(Timer16_Encoder_HandleTypeDef *hencoder, int64_t Position)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    uint16_t count = HAL_Timer16_Encoder_ReadCount(hencoder);
+    int64_t offset = Position - (hencoder->Position + (int16_t)(uint16_t)(count - hencoder->LastCount));
+
+    hencoder->Position = Position;
+    hencoder->LastCount = count;
+    hencoder->EdgePosition += offset;
+
+    HAL_IRQ_Restore(mstatus);
+}
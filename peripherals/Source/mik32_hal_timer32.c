@@ -510,15 +510,49 @@ struct
     uint32_t presc;
     /* Timer prescaler */
     uint32_t pt;
+    /* Number of counter overflows, extends the counter to 64 bits */
+    volatile uint32_t high;
+    /* Ticks to microseconds and milliseconds */
+    HAL_Time_ScaleTypeDef micros;
+    HAL_Time_ScaleTypeDef millis;
 } HAL_Time_TIM32_Handler;
 
+
+/**
+ * @brief Обработчик прерывания переполнения 32-р таймера системных часов.
+ *
+ * Вызывается из обработчика прерываний, пока таймер используется в качестве системных часов.
+ */
+void HAL_Time_TIM32_InterruptHandler()
+{
+    uint32_t condition;
+    switch ((uint32_t)HAL_Time_TIM32_Handler.tim32.Instance)
+    {
+        case (uint32_t)TIMER32_0: condition = EPIC_CHECK_TIMER32_0(); break;
+        case (uint32_t)TIMER32_1: condition = EPIC_CHECK_TIMER32_1(); break;
+        case (uint32_t)TIMER32_2: condition = EPIC_CHECK_TIMER32_2(); break;
+        default: condition = 0;
+    }
+    if (!condition) return;
+    if (HAL_Time_TIM32_Handler.tim32.Instance->INT_FLAGS & TIMER32_INT_OVERFLOW_M)
+    {
+        HAL_Time_TIM32_Handler.high++;
+        HAL_Timer32_InterruptFlags_ClearMask(&HAL_Time_TIM32_Handler.tim32, TIMER32_INT_OVERFLOW_M);
+    }
+}
+
 /**
  * @brief Инициализация 32-р таймера для работы в качестве системных часов.
  * После инициализации системного таймера не рекомендуется изменять делители тактовой частоты AHB, APB_P и APB_M
  * Если делители такта были изменены или микроконтроллер переключился на другой источник тактирования, необходимо
  * переинициализаровать таймер. При этом прежнее значение системного времени потеряется
  * 
- * Время переполнения системных часов зависит от частоты тактирования. Минимальное время переполнения - 4295с
+ * Переполнения счетчика учитываются в прерывании @ref HAL_Time_TIM32_InterruptHandler. Период счетчика зависит
+ * от частоты тактирования: 2^32 тактов таймера, 4295с при частоте таймера 1 МГц и около 134с, если частота
+ * не кратна 1 МГц и таймер тактируется без предделителя (32 МГц).
+ * 
+ * @warning Прерывание переполнения должно обрабатываться хотя бы раз за период счетчика. Не рекомендуется
+ * запрещать глобальные прерывания на большее время.
  * 
  * @param timer  TIMER32_0, TIMER32_1 или TIMER32_2
 */
@@ -543,9 +577,52 @@ void HAL_Time_TIM32_Init(TIMER32_TypeDef* timer)
     HAL_Time_TIM32_Handler.tim32.Clock.Prescaler = HAL_Time_TIM32_Handler.pt-1;
 
     HAL_Time_TIM32_Handler.tim32.CountMode = TIMER32_COUNTMODE_FORWARD;
+    HAL_Time_TIM32_Handler.tim32.InterruptMask = 0;
     HAL_Timer32_Init(&HAL_Time_TIM32_Handler.tim32);
     HAL_Timer32_Value_Clear(&HAL_Time_TIM32_Handler.tim32);
+
+    uint32_t tick_freq = clock_freq / (HAL_Time_TIM32_Handler.presc * HAL_Time_TIM32_Handler.pt);
+    HAL_Time_ScaleInit(&HAL_Time_TIM32_Handler.micros, tick_freq, 1000000UL);
+    HAL_Time_ScaleInit(&HAL_Time_TIM32_Handler.millis, tick_freq, 1000UL);
+    HAL_Time_TIM32_Handler.high = 0;
+
+    /* Set interrupt mask */
+    HAL_Timer32_InterruptMask_Set(&HAL_Time_TIM32_Handler.tim32, TIMER32_INT_OVERFLOW_M);
+    switch ((uint32_t)timer)
+    {
+        case (uint32_t)TIMER32_0: HAL_EPIC_MaskLevelSet(HAL_EPIC_TIMER32_0_MASK); break;
+        case (uint32_t)TIMER32_1: HAL_EPIC_MaskLevelSet(HAL_EPIC_TIMER32_1_MASK); break;
+        case (uint32_t)TIMER32_2: HAL_EPIC_MaskLevelSet(HAL_EPIC_TIMER32_2_MASK); break;
+    }
+    HAL_IRQ_EnableInterrupts();
     HAL_Timer32_Start(&HAL_Time_TIM32_Handler.tim32);
+
+    HAL_Time_SetSource(HAL_Time_TIM32_Ticks64, tick_freq);
+}
+
+/**
+ * @brief 64-р значение счетчика 32-р таймера системных часов.
+ * 
+ * Учитывает переполнение, прерывание по которому еще не обработано, поэтому функцию можно
+ * вызывать из прерываний и при запрещенных прерываниях.
+*/
+uint64_t HAL_Time_TIM32_Ticks64()
+{
+    TIMER32_TypeDef *timer = HAL_Time_TIM32_Handler.tim32.Instance;
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    uint32_t high = HAL_Time_TIM32_Handler.high;
+    uint32_t value = timer->VALUE;
+    if (timer->INT_FLAGS & TIMER32_INT_OVERFLOW_M)
+    {
+        /* Переполнение еще не учтено в high, значение VALUE перечитывается после переполнения */
+        value = timer->VALUE;
+        high++;
+    }
+
+    HAL_IRQ_Restore(mstatus);
+
+    return ((uint64_t)high << 32) | value;
 }
 
 /**
@@ -553,9 +630,7 @@ void HAL_Time_TIM32_Init(TIMER32_TypeDef* timer)
 */
 uint32_t HAL_Time_TIM32_Micros()
 {
-    uint32_t clock_freq = HAL_PCC_GetSysClockFreq();
-    return (uint32_t)((uint64_t)HAL_Time_TIM32_Handler.tim32.Instance->VALUE * (1000000UL *
-        HAL_Time_TIM32_Handler.presc * HAL_Time_TIM32_Handler.pt) / clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_TIM32_Handler.micros, HAL_Time_TIM32_Ticks64());
 }
 
 /**
@@ -563,9 +638,7 @@ uint32_t HAL_Time_TIM32_Micros()
 */
 uint32_t HAL_Time_TIM32_Millis()
 {
-    uint32_t clock_freq = HAL_PCC_GetSysClockFreq();
-    return (uint32_t)((uint64_t)HAL_Time_TIM32_Handler.tim32.Instance->VALUE * (1000UL *
-        HAL_Time_TIM32_Handler.presc * HAL_Time_TIM32_Handler.pt) / clock_freq);
+    return (uint32_t)HAL_Time_Scale(&HAL_Time_TIM32_Handler.millis, HAL_Time_TIM32_Ticks64());
 }
 
 /**
@@ -0,0 +1,531 @@
+#include "mik32_hal_timer32_capture_dma.h"
+
+
+/**
+ * @brief Получить линию запроса DMA таймера Timer32.
+ * @param timer Базовый адрес регистров таймера.
+ * @param Request Указатель на линию запроса.
+ * @return Статус HAL. @ref HAL_ERROR, если таймер не имеет каналов захвата.
+ */
+static HAL_StatusTypeDef HAL_Timer32_CaptureDMA_GetRequest(TIMER32_TypeDef *timer, HAL_DMA_ChannelRequestTypeDef *Request)
+{
+    switch ((uint32_t)timer)
+    {
+    case (uint32_t)TIMER32_1:
+        *Request = DMA_CHANNEL_TIMER32_1_REQUEST;
+        return HAL_OK;
+    case (uint32_t)TIMER32_2:
+        *Request = DMA_CHANNEL_TIMER32_2_REQUEST;
+        return HAL_OK;
+    default:
+        return HAL_ERROR;
+    }
+}
+
+/**
+ * @brief Получить интервал между двумя захватами с учетом переполнения таймера.
+ *
+ * Интервал должен быть меньше периода таймера (Top + 1).
+ * @param hcapture Указатель на структуру захвата.
+ * @param Prev Предыдущее значение ICR.
+ * @param Raw Текущее значение ICR.
+ * @return Интервал, такты таймера.
+ */
+static inline uint32_t HAL_Timer32_CaptureDMA_Delta(Timer32_CaptureDMA_HandleTypeDef *hcapture, uint32_t Prev, uint32_t Raw)
+{
+    uint32_t delta = Raw - Prev;
+
+    /* При Top = 0xFFFFFFFF слагаемое равно 0, перенос учитывается беззнаковым вычитанием */
+    if (Raw < Prev)
+    {
+        delta += hcapture->htimer32->Top + 1;
+    }
+
+    return delta;
+}
+
+/**
+ * @brief Получить время следующего захвата в буфере без извлечения.
+ * @param hcapture Указатель на структуру захвата. В буфере должен быть хотя бы один захват.
+ * @param Raw Указатель на значение ICR.
+ * @return Время захвата в тактах таймера с учетом переполнений.
+ */
+static uint64_t HAL_Timer32_CaptureDMA_Peek(Timer32_CaptureDMA_HandleTypeDef *hcapture, uint32_t *Raw)
+{
+    *Raw = hcapture->Buffer[hcapture->ReadIndex];
+
+    if (!hcapture->HasLast)
+    {
+        return *Raw;
+    }
+
+    return hcapture->Last + HAL_Timer32_CaptureDMA_Delta(hcapture, hcapture->LastRaw, *Raw);
+}
+
+/**
+ * @brief Извлечь захват, полученный @ref HAL_Timer32_CaptureDMA_Peek.
+ * @param hcapture Указатель на структуру захвата.
+ * @param Raw Значение ICR.
+ * @param Time Время захвата.
+ */
+static void HAL_Timer32_CaptureDMA_Pop(Timer32_CaptureDMA_HandleTypeDef *hcapture, uint32_t Raw, uint64_t Time)
+{
+    hcapture->Last = Time;
+    hcapture->LastRaw = Raw;
+    hcapture->HasLast = 1;
+
+    hcapture->ReadCount++;
+    if (++hcapture->ReadIndex == hcapture->Size)
+    {
+        hcapture->ReadIndex = 0;
+    }
+}
+
+/**
+ * @brief Рассчитать средние значения статистики.
+ * @param hcapture Указатель на структуру захвата с частотой счета.
+ * @param stats Статистика.
+ * @param PeriodSum Сумма периодов.
+ * @param HighSum Сумма длительностей высокого уровня.
+ * @param DutyPeriodSum Сумма периодов, для которых найдена длительность высокого уровня.
+ * @param HighCount Количество найденных длительностей высокого уровня.
+ */
+static void HAL_Timer32_CaptureDMA_Finish(Timer32_CaptureDMA_HandleTypeDef *hcapture, Timer32_CaptureDMA_StatsTypeDef *stats,
+    uint64_t PeriodSum, uint64_t HighSum, uint64_t DutyPeriodSum, uint32_t HighCount)
+{
+    if (stats->Count != 0)
+    {
+        stats->PeriodMean = (uint32_t)(PeriodSum / stats->Count);
+        /* Count не превышает размера буфера, произведение не переполняется */
+        if ((hcapture->TickFreq != 0) && (PeriodSum != 0))
+        {
+            stats->Frequency = (uint32_t)((uint64_t)hcapture->TickFreq * 1000 * stats->Count / PeriodSum);
+        }
+    }
+
+    if ((HighCount != 0) && (DutyPeriodSum != 0))
+    {
+        stats->HighMean = (uint32_t)(HighSum / HighCount);
+        stats->Duty = (uint32_t)((HighSum << 16) / DutyPeriodSum);
+    }
+}
+
+/**
+ * @brief Подготовить захват к запуску: сбросить состояние, включить канал и запустить канал DMA.
+ * @param hcapture Указатель на структуру захвата.
+ * @return Статус HAL.
+ */
+static HAL_StatusTypeDef HAL_Timer32_CaptureDMA_Prepare(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    if ((hcapture->Buffer == NULL) || (hcapture->Size == 0) || (hcapture->Size > TIMER32_CAPTURE_DMA_MAX_SIZE))
+    {
+        return HAL_ERROR;
+    }
+
+    if (!HAL_DMA_GetChannelReadyStatus(hcapture->hdma))
+    {
+        return HAL_BUSY;
+    }
+
+    hcapture->Laps = 0;
+    hcapture->ReadCount = 0;
+    hcapture->ReadIndex = 0;
+    hcapture->Overruns = 0;
+    hcapture->HasLast = 0;
+
+    HAL_Timer32_Stop(hcapture->htimer32);
+    HAL_Timer32_Channel_ICR_Clear(hcapture->hchannel);
+    HAL_Timer32_InterruptFlags_ClearMask(hcapture->htimer32, TIMER32_INT_IC_M(hcapture->hchannel->ChannelIndex));
+    /* Событие захвата формирует запрос DMA */
+    HAL_Timer32_InterruptMask_Set(hcapture->htimer32, TIMER32_INT_IC_M(hcapture->hchannel->ChannelIndex));
+
+    HAL_DMA_LocalIRQEnable(hcapture->hdma, DMA_IRQ_ENABLE);
+    HAL_DMA_Start(hcapture->hdma, (void *)&hcapture->hchannel->Instance->ICR, hcapture->Buffer, hcapture->Size * sizeof(uint32_t) - 1);
+    HAL_Timer32_Channel_Enable(hcapture->hchannel);
+
+    return HAL_OK;
+}
+
+
+/**
+ * @brief Настроить канал DMA для захвата фронтов.
+ *
+ * Источник - регистр ICR канала таймера в режиме периферии с линией запроса таймера и логикой с откликом,
+ * назначение - буфер с инкрементом адреса. На каждый захват пересылается одно слово.
+ * @param hcapture Указатель на структуру захвата.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_Init(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    HAL_DMA_ChannelRequestTypeDef request;
+
+    if ((hcapture == NULL) || (hcapture->htimer32 == NULL) || (hcapture->hchannel == NULL) || (hcapture->hdma == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if (hcapture->hchannel->Mode != TIMER32_CHANNEL_MODE_CAPTURE)
+    {
+        return HAL_ERROR;
+    }
+
+    /* Количество захватов определяется по текущему адресу назначения канала DMA */
+    if (hcapture->hdma->dma->CurrentValue != DMA_CURRENT_VALUE_ENABLE)
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_Timer32_CaptureDMA_GetRequest(hcapture->htimer32->Instance, &request) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    DMA_ChannelInitHandleTypeDef *init = &hcapture->hdma->ChannelInit;
+
+    init->ReadMode = DMA_CHANNEL_MODE_PERIPHERY;
+    init->ReadInc = DMA_CHANNEL_INC_DISABLE;
+    init->ReadSize = DMA_CHANNEL_SIZE_WORD;
+    init->ReadBurstSize = 2;
+    init->ReadRequest = request;
+    init->ReadAck = DMA_CHANNEL_ACK_ENABLE;
+
+    init->WriteMode = DMA_CHANNEL_MODE_MEMORY;
+    init->WriteInc = DMA_CHANNEL_INC_ENABLE;
+    init->WriteSize = DMA_CHANNEL_SIZE_WORD;
+    init->WriteBurstSize = 2;
+    init->WriteRequest = request;
+    init->WriteAck = DMA_CHANNEL_ACK_DISABLE;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить захват фронтов в буфер.
+ *
+ * Счетчик таймера сбрасывается. Буфер, размер и частота счета задаются в полях структуры до вызова.
+ * @param hcapture Указатель на структуру захвата.
+ * @return Статус HAL. @ref HAL_BUSY, если канал DMA занят.
+ */
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_Start(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    HAL_StatusTypeDef status = HAL_Timer32_CaptureDMA_Prepare(hcapture);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+
+    HAL_Timer32_Value_Clear(hcapture->htimer32);
+    HAL_Timer32_Start(hcapture->htimer32);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить два захвата одного сигнала для измерения коэффициента заполнения.
+ *
+ * Сигнал подается на каналы двух таймеров: hrise захватывает нарастающие фронты, hfall - спадающие.
+ * Таймеры должны иметь одинаковые источник тактирования, делитель и Top. Счетчики сбрасываются и
+ * запускаются при запрещенных прерываниях, расхождение отсчетов не превышает нескольких тактов таймера.
+ * @param hrise Захват нарастающих фронтов.
+ * @param hfall Захват спадающих фронтов.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_StartSync(Timer32_CaptureDMA_HandleTypeDef *hrise, Timer32_CaptureDMA_HandleTypeDef *hfall)
+{
+    HAL_StatusTypeDef status;
+
+    if (hrise->htimer32->Instance == hfall->htimer32->Instance)
+    {
+        return HAL_ERROR;
+    }
+
+    status = HAL_Timer32_CaptureDMA_Prepare(hrise);
+    if (status != HAL_OK)
+    {
+        return status;
+    }
+
+    status = HAL_Timer32_CaptureDMA_Prepare(hfall);
+    if (status != HAL_OK)
+    {
+        HAL_Timer32_CaptureDMA_Stop(hrise);
+        return status;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    HAL_Timer32_Value_Clear(hrise->htimer32);
+    HAL_Timer32_Value_Clear(hfall->htimer32);
+    HAL_Timer32_Start(hrise->htimer32);
+    HAL_Timer32_Start(hfall->htimer32);
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Остановить захват.
+ *
+ * Захваты, находящиеся в буфере, можно прочитать после остановки.
+ * @param hcapture Указатель на структуру захвата.
+ */
+void HAL_Timer32_CaptureDMA_Stop(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    HAL_Timer32_Stop(hcapture->htimer32);
+    HAL_Timer32_Channel_Disable(hcapture->hchannel);
+    HAL_Timer32_InterruptMask_Clear(hcapture->htimer32, TIMER32_INT_IC_M(hcapture->hchannel->ChannelIndex));
+    HAL_DMA_LocalIRQEnable(hcapture->hdma, DMA_IRQ_DISABLE);
+    HAL_DMA_ChannelDisable(hcapture->hdma);
+}
+
+/**
+ * @brief Обработчик прерывания DMA захвата.
+ *
+ * Вызывается из обработчика прерывания DMA. Если канал заполнил буфер, канал перезапускается с начала буфера.
+ * Функция сбрасывает флаги локальных прерываний DMA (@ref HAL_DMA_ClearLocalIrq), поэтому флаги других
+ * каналов проверяются до вызова.
+ * @param hcapture Указатель на структуру захвата.
+ */
+void HAL_Timer32_CaptureDMA_IRQHandler(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    if ((hcapture->htimer32->State == TIMER32_STATE_ENABLE) && HAL_DMA_GetChannelReadyStatus(hcapture->hdma))
+    {
+        /* Перезапуск до увеличения Laps: GetCount не уменьшается на границе круга */
+        HAL_DMA_Start(hcapture->hdma, (void *)&hcapture->hchannel->Instance->ICR, hcapture->Buffer, hcapture->Size * sizeof(uint32_t) - 1);
+        hcapture->Laps++;
+    }
+
+    HAL_DMA_ClearLocalIrq(hcapture->hdma->dma);
+}
+
+/**
+ * @brief Получить общее количество захватов с момента запуска.
+ *
+ * Функция не должна вызываться из прерываний с приоритетом выше прерывания DMA.
+ * @param hcapture Указатель на структуру захвата.
+ * @return Количество захватов по модулю 2^32.
+ */
+uint32_t HAL_Timer32_CaptureDMA_GetCount(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    uint32_t ChannelIndex = hcapture->hdma->ChannelInit.Channel;
+    uint32_t laps;
+    uint32_t dst;
+
+    do
+    {
+        laps = hcapture->Laps;
+        dst = hcapture->hdma->dma->Instance->CHANNELS[ChannelIndex].DST;
+    } while (laps != hcapture->Laps);
+
+    uint32_t position = (dst - (uint32_t)hcapture->Buffer) / sizeof(uint32_t);
+    if (position > hcapture->Size)
+    {
+        position = hcapture->Size;
+    }
+
+    return laps * hcapture->Size + position;
+}
+
+/**
+ * @brief Получить количество непрочитанных захватов.
+ *
+ * Если канал DMA перезаписал непрочитанные захваты, они пропускаются и учитываются в поле Overruns,
+ * время последнего захвата становится недействительным.
+ * @param hcapture Указатель на структуру захвата.
+ * @return Количество непрочитанных захватов, не больше Size.
+ */
+uint32_t HAL_Timer32_CaptureDMA_Available(Timer32_CaptureDMA_HandleTypeDef *hcapture)
+{
+    uint32_t available = HAL_Timer32_CaptureDMA_GetCount(hcapture) - hcapture->ReadCount;
+
+    if (available > hcapture->Size)
+    {
+        uint32_t lost = available - hcapture->Size;
+
+        hcapture->Overruns += lost;
+        hcapture->ReadCount += lost;
+        hcapture->ReadIndex = (hcapture->ReadIndex + lost) % hcapture->Size;
+        hcapture->HasLast = 0;
+        available = hcapture->Size;
+    }
+
+    return available;
+}
+
+/**
+ * @brief Прочитать захваченные значения ICR.
+ * @param hcapture Указатель на структуру захвата.
+ * @param pData Массив для значений.
+ * @param MaxCount Размер массива.
+ * @return Количество прочитанных значений.
+ */
+uint32_t HAL_Timer32_CaptureDMA_Read(Timer32_CaptureDMA_HandleTypeDef *hcapture, uint32_t *pData, uint32_t MaxCount)
+{
+    uint32_t count = HAL_Timer32_CaptureDMA_Available(hcapture);
+    if (count > MaxCount)
+    {
+        count = MaxCount;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t raw;
+        uint64_t time = HAL_Timer32_CaptureDMA_Peek(hcapture, &raw);
+        HAL_Timer32_CaptureDMA_Pop(hcapture, raw, time);
+        pData[i] = raw;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Прочитать пачку захватов и рассчитать статистику периода и частоты.
+ *
+ * Период считается между соседними захватами, в том числе между последним захватом предыдущей пачки
+ * и первым захватом текущей. Период не может превышать период таймера (Top + 1).
+ * @param hcapture Указатель на структуру захвата.
+ * @param stats Статистика.
+ * @param MaxCount Наибольшее количество читаемых захватов. 0 - все доступные.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_GetStats(Timer32_CaptureDMA_HandleTypeDef *hcapture, Timer32_CaptureDMA_StatsTypeDef *stats, uint32_t MaxCount)
+{
+    uint64_t sum = 0;
+    uint32_t count = HAL_Timer32_CaptureDMA_Available(hcapture);
+
+    if ((MaxCount != 0) && (count > MaxCount))
+    {
+        count = MaxCount;
+    }
+
+    *stats = (Timer32_CaptureDMA_StatsTypeDef){0};
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t raw;
+        uint8_t has_last = hcapture->HasLast;
+        uint64_t time = HAL_Timer32_CaptureDMA_Peek(hcapture, &raw);
+
+        if (has_last)
+        {
+            uint32_t period = (uint32_t)(time - hcapture->Last);
+
+            if ((stats->Count == 0) || (period < stats->PeriodMin))
+            {
+                stats->PeriodMin = period;
+            }
+            if (period > stats->PeriodMax)
+            {
+                stats->PeriodMax = period;
+            }
+            sum += period;
+            stats->Count++;
+        }
+
+        HAL_Timer32_CaptureDMA_Pop(hcapture, raw, time);
+    }
+
+    HAL_Timer32_CaptureDMA_Finish(hcapture, stats, sum, 0, 0, 0);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Прочитать пачку захватов двух фронтов и рассчитать статистику периода, частоты и коэффициента заполнения.
+ *
+ * Захваты запускаются функцией @ref HAL_Timer32_CaptureDMA_StartSync. Период считается по нарастающим фронтам,
+ * длительность высокого уровня - от нарастающего фронта до первого спадающего фронта в том же периоде.
+ * Спадающие фронты после последнего нарастающего фронта пачки остаются в буфере до следующего вызова.
+ * Первые захваты обоих потоков должны произойти до первого переполнения таймеров.
+ * @param hrise Захват нарастающих фронтов.
+ * @param hfall Захват спадающих фронтов.
+ * @param stats Статистика.
+ * @param MaxCount Наибольшее количество читаемых нарастающих фронтов. 0 - все доступные.
+ * @return Статус HAL. @ref HAL_ERROR, если в одном из потоков были потеряны захваты; захват нужно перезапустить.
+ */
+HAL_StatusTypeDef HAL_Timer32_CaptureDMA_GetDutyStats(Timer32_CaptureDMA_HandleTypeDef *hrise, Timer32_CaptureDMA_HandleTypeDef *hfall,
+    Timer32_CaptureDMA_StatsTypeDef *stats, uint32_t MaxCount)
+{
+    uint64_t period_sum = 0;
+    uint64_t high_sum = 0;
+    uint64_t duty_period_sum = 0;
+    uint32_t high_count = 0;
+    uint32_t overruns = hrise->Overruns + hfall->Overruns;
+
+    /* Спадающие фронты читаются после нарастающих, чтобы в буфере были все фронты до последнего нарастающего */
+    uint32_t rise_count = HAL_Timer32_CaptureDMA_Available(hrise);
+    uint32_t fall_count = HAL_Timer32_CaptureDMA_Available(hfall);
+
+    *stats = (Timer32_CaptureDMA_StatsTypeDef){0};
+
+    if (hrise->Overruns + hfall->Overruns != overruns)
+    {
+        return HAL_ERROR;
+    }
+
+    if ((MaxCount != 0) && (rise_count > MaxCount))
+    {
+        rise_count = MaxCount;
+    }
+
+    for (uint32_t i = 0; i < rise_count; i++)
+    {
+        uint32_t raw;
+        uint8_t has_last = hrise->HasLast;
+        uint64_t previous = hrise->Last;
+        uint64_t rise = HAL_Timer32_CaptureDMA_Peek(hrise, &raw);
+        uint8_t high_found = 0;
+        uint32_t high = 0;
+
+        HAL_Timer32_CaptureDMA_Pop(hrise, raw, rise);
+
+        /* Спадающие фронты до текущего нарастающего */
+        while (fall_count != 0)
+        {
+            uint32_t fall_raw;
+            uint64_t fall = HAL_Timer32_CaptureDMA_Peek(hfall, &fall_raw);
+
+            if (fall > rise)
+            {
+                break;
+            }
+
+            HAL_Timer32_CaptureDMA_Pop(hfall, fall_raw, fall);
+            fall_count--;
+
+            if (has_last && !high_found && (fall > previous))
+            {
+                high = (uint32_t)(fall - previous);
+                high_found = 1;
+            }
+        }
+
+        if (!has_last)
+        {
+            continue;
+        }
+
+        uint32_t period = (uint32_t)(rise - previous);
+
+        if ((stats->Count == 0) || (period < stats->PeriodMin))
+        {
+            stats->PeriodMin = period;
+        }
+        if (period > stats->PeriodMax)
+        {
+            stats->PeriodMax = period;
+        }
+        period_sum += period;
+        stats->Count++;
+
+        if (high_found)
+        {
+            high_sum += high;
+            duty_period_sum += period;
+            high_count++;
+        }
+    }
+
+    HAL_Timer32_CaptureDMA_Finish(hrise, stats, period_sum, high_sum, duty_period_sum, high_count);
+
+    return HAL_OK;
+}
@@ -0,0 +1,222 @@
+#include "mik32_hal_timer32_pwm_dma.h"
+
+
+/**
+ * @brief Получить линию запроса DMA таймера Timer32.
+ * @param timer Базовый адрес регистров таймера.
+ * @param Request Указатель на линию запроса.
+ * @return Статус HAL. @ref HAL_ERROR, если таймер не имеет каналов ШИМ.
+ */
+static HAL_StatusTypeDef HAL_Timer32_PWM_DMA_GetRequest(TIMER32_TypeDef *timer, HAL_DMA_ChannelRequestTypeDef *Request)
+{
+    switch ((uint32_t)timer)
+    {
+    case (uint32_t)TIMER32_1:
+        *Request = DMA_CHANNEL_TIMER32_1_REQUEST;
+        return HAL_OK;
+    case (uint32_t)TIMER32_2:
+        *Request = DMA_CHANNEL_TIMER32_2_REQUEST;
+        return HAL_OK;
+    default:
+        return HAL_ERROR;
+    }
+}
+
+/**
+ * @brief Запустить канал DMA на пересылку части буфера в регистр OCR.
+ * @param hpwm_dma Указатель на структуру вывода.
+ * @param pData Первое пересылаемое слово.
+ * @param Count Количество слов.
+ */
+static inline void HAL_Timer32_PWM_DMA_Transfer(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma, const uint32_t *pData, uint32_t Count)
+{
+    HAL_DMA_Start(hpwm_dma->hdma, (void *)pData, (void *)&hpwm_dma->hchannel->Instance->OCR, Count * sizeof(uint32_t) - 1);
+}
+
+/**
+ * @brief Завершить проход буфера.
+ *
+ * В режиме повтора запускает канал DMA с начала буфера, иначе снимает маску переполнения таймера,
+ * которая формирует запросы DMA. Затем увеличивает Passes и вызывает CpltCallback.
+ * @param hpwm_dma Указатель на структуру вывода.
+ */
+static void HAL_Timer32_PWM_DMA_Complete(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma)
+{
+    if (hpwm_dma->Loop)
+    {
+        HAL_Timer32_PWM_DMA_Transfer(hpwm_dma, hpwm_dma->pData, hpwm_dma->Count);
+    }
+    else
+    {
+        HAL_Timer32_InterruptMask_Clear(hpwm_dma->htimer32, TIMER32_INT_OVERFLOW_M);
+    }
+
+    hpwm_dma->Passes++;
+
+    if (hpwm_dma->CpltCallback != NULL)
+    {
+        hpwm_dma->CpltCallback(hpwm_dma);
+    }
+}
+
+
+/**
+ * @brief Настроить канал DMA для вывода значений сравнения.
+ *
+ * Источник - память с инкрементом адреса, назначение - регистр OCR канала без инкремента в режиме периферии
+ * с линией запроса таймера и логикой с откликом, поэтому на каждое переполнение таймера пересылается одно слово.
+ * @param hpwm_dma Указатель на структуру вывода.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Init(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma)
+{
+    HAL_DMA_ChannelRequestTypeDef request;
+
+    if ((hpwm_dma == NULL) || (hpwm_dma->htimer32 == NULL) || (hpwm_dma->hchannel == NULL) || (hpwm_dma->hdma == NULL))
+    {
+        return HAL_ERROR;
+    }
+
+    if (hpwm_dma->hchannel->Mode != TIMER32_CHANNEL_MODE_PWM)
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_Timer32_PWM_DMA_GetRequest(hpwm_dma->htimer32->Instance, &request) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    DMA_ChannelInitHandleTypeDef *init = &hpwm_dma->hdma->ChannelInit;
+
+    init->ReadMode = DMA_CHANNEL_MODE_MEMORY;
+    init->ReadInc = DMA_CHANNEL_INC_ENABLE;
+    init->ReadSize = DMA_CHANNEL_SIZE_WORD;
+    init->ReadBurstSize = 2;
+    init->ReadRequest = request;
+    init->ReadAck = DMA_CHANNEL_ACK_DISABLE;
+
+    init->WriteMode = DMA_CHANNEL_MODE_PERIPHERY;
+    init->WriteInc = DMA_CHANNEL_INC_DISABLE;
+    init->WriteSize = DMA_CHANNEL_SIZE_WORD;
+    init->WriteBurstSize = 2;
+    init->WriteRequest = request;
+    init->WriteAck = DMA_CHANNEL_ACK_ENABLE;
+
+    hpwm_dma->Passes = 0;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Запустить вывод последовательности значений сравнения.
+ *
+ * Первое слово записывается в OCR сразу и действует в первом периоде, остальные слова пересылаются DMA
+ * на переполнениях таймера. Если таймер остановлен, счетчик сбрасывается и таймер запускается.
+ * В режиме повтора и для получения CpltCallback требуется разрешенное прерывание DMA с вызовом
+ * @ref HAL_Timer32_PWM_DMA_IRQHandler. Буфер из одного слова выводится без DMA: первый проход
+ * завершается сразу, и CpltCallback вызывается из этой функции.
+ * @param hpwm_dma Указатель на структуру вывода.
+ * @param pData Буфер значений OCR. Массив должен оставаться доступным до завершения вывода.
+ * @param Count Количество слов буфера.
+ * @param Loop 1 - выводить буфер повторно.
+ * @return Статус HAL. @ref HAL_BUSY, если предыдущий вывод не завершен.
+ */
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Start(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma, const uint32_t *pData, uint32_t Count, uint8_t Loop)
+{
+    if ((pData == NULL) || (Count == 0))
+    {
+        return HAL_ERROR;
+    }
+
+    if (HAL_Timer32_PWM_DMA_IsBusy(hpwm_dma))
+    {
+        return HAL_BUSY;
+    }
+
+    hpwm_dma->pData = pData;
+    hpwm_dma->Count = Count;
+    hpwm_dma->Loop = Loop;
+    hpwm_dma->Passes = 0;
+
+    HAL_Timer32_Channel_OCR_Set(hpwm_dma->hchannel, pData[0]);
+
+    /* Событие переполнения формирует запрос DMA */
+    HAL_Timer32_InterruptFlags_ClearMask(hpwm_dma->htimer32, TIMER32_INT_OVERFLOW_M);
+    HAL_Timer32_InterruptMask_Set(hpwm_dma->htimer32, TIMER32_INT_OVERFLOW_M);
+
+    if (Count > 1)
+    {
+        HAL_Timer32_PWM_DMA_Transfer(hpwm_dma, &pData[1], Count - 1);
+    }
+    else
+    {
+        /* Первый проход не требует пересылок */
+        HAL_Timer32_PWM_DMA_Complete(hpwm_dma);
+    }
+
+    HAL_Timer32_Channel_Enable(hpwm_dma->hchannel);
+
+    if (hpwm_dma->htimer32->State != TIMER32_STATE_ENABLE)
+    {
+        HAL_Timer32_Value_Clear(hpwm_dma->htimer32);
+        HAL_Timer32_Start(hpwm_dma->htimer32);
+    }
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Остановить вывод последовательности.
+ *
+ * Канал DMA останавливается, канал таймера продолжает ШИМ с последним записанным значением OCR.
+ * @param hpwm_dma Указатель на структуру вывода.
+ */
+void HAL_Timer32_PWM_DMA_Stop(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma)
+{
+    hpwm_dma->Loop = 0;
+    HAL_DMA_ChannelDisable(hpwm_dma->hdma);
+    HAL_Timer32_InterruptMask_Clear(hpwm_dma->htimer32, TIMER32_INT_OVERFLOW_M);
+}
+
+/**
+ * @brief Обработчик прерывания DMA вывода.
+ *
+ * Вызывается из обработчика прерывания DMA. Если буфер выведен, в режиме повтора перезапускает канал DMA
+ * с начала буфера, иначе снимает маску переполнения таймера. Затем увеличивает Passes и вызывает
+ * CpltCallback. Функция сбрасывает флаги локальных прерываний
+ * DMA (@ref HAL_DMA_ClearLocalIrq), поэтому флаги других каналов проверяются до вызова.
+ * @param hpwm_dma Указатель на структуру вывода.
+ */
+void HAL_Timer32_PWM_DMA_IRQHandler(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma)
+{
+    if (HAL_DMA_GetChannelIrq(hpwm_dma->hdma) && HAL_DMA_GetChannelReadyStatus(hpwm_dma->hdma))
+    {
+        HAL_Timer32_PWM_DMA_Complete(hpwm_dma);
+    }
+
+    HAL_DMA_ClearLocalIrq(hpwm_dma->hdma->dma);
+}
+
+/**
+ * @brief Ожидать завершения вывода буфера.
+ *
+ * В режиме повтора функция ожидает окончания текущего прохода.
+ * @param hpwm_dma Указатель на структуру вывода.
+ * @param Timeout Количество циклов ожидания.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_PWM_DMA_Wait(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma, uint32_t Timeout)
+{
+    return HAL_DMA_Wait(hpwm_dma->hdma, Timeout);
+}
+
+/**
+ * @brief Получить состояние вывода.
+ * @param hpwm_dma Указатель на структуру вывода.
+ * @return 1 - вывод продолжается, 0 - канал DMA свободен.
+ */
+int HAL_Timer32_PWM_DMA_IsBusy(Timer32_PWM_DMA_HandleTypeDef *hpwm_dma)
+{
+    return !HAL_DMA_GetChannelReadyStatus(hpwm_dma->hdma);
+}
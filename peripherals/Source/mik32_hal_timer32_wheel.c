@@ -0,0 +1,413 @@
+#include "mik32_hal_timer32_wheel.h"
+
+
+/**
+ * @brief Текущее 64-р время таймера.
+ *
+ * Вызывается при запрещенных прерываниях. Учитывает переполнение, прерывание по которому еще не обработано.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @return Время в тактах таймера.
+ */
+static uint64_t HAL_Timer32_Wheel_HwTime(Timer32_Wheel_HandleTypeDef *hwheel)
+{
+    TIMER32_TypeDef *timer32 = hwheel->htimer32->Instance;
+    uint32_t high = hwheel->High;
+    uint32_t value = timer32->VALUE;
+
+    if (timer32->INT_FLAGS & TIMER32_INT_OVERFLOW_M)
+    {
+        /* Переполнение еще не учтено в High, значение перечитывается после переполнения */
+        value = timer32->VALUE;
+        high++;
+    }
+
+    return ((uint64_t)high << 32) | value;
+}
+
+/**
+ * @brief Поместить таймер в колесо относительно текущего времени колеса.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param timer Указатель на программный таймер с заданным временем срабатывания.
+ */
+static void HAL_Timer32_Wheel_Insert(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer)
+{
+    uint64_t diff = timer->Expires ^ hwheel->Now;
+    Timer32_Wheel_TimerTypeDef **head;
+    uint32_t level = 0;
+    uint32_t slot = 0;
+
+    if ((diff >> TIMER32_WHEEL_RANGE_BITS) != 0)
+    {
+        /* Время срабатывания за границей текущего интервала 2^35 тактов */
+        level = TIMER32_WHEEL_LEVELS;
+        head = &hwheel->Far;
+    }
+    else
+    {
+        /* Уровень определяется старшей группой бит, в которой время срабатывания отличается от текущего */
+        diff >>= TIMER32_WHEEL_LEVEL_BITS;
+        while (diff != 0)
+        {
+            diff >>= TIMER32_WHEEL_LEVEL_BITS;
+            level++;
+        }
+
+        slot = (uint32_t)(timer->Expires >> (level * TIMER32_WHEEL_LEVEL_BITS)) & (TIMER32_WHEEL_SLOTS - 1);
+        head = &hwheel->Slots[level][slot];
+        hwheel->Bitmap[level] |= 1UL << slot;
+    }
+
+    timer->Next = *head;
+    if (*head != NULL)
+    {
+        (*head)->PPrev = &timer->Next;
+    }
+    *head = timer;
+    timer->PPrev = head;
+    timer->Level = level;
+    timer->Slot = slot;
+}
+
+/**
+ * @brief Убрать таймер из колеса.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param timer Указатель на запущенный программный таймер.
+ */
+static void HAL_Timer32_Wheel_Unlink(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer)
+{
+    *timer->PPrev = timer->Next;
+    if (timer->Next != NULL)
+    {
+        timer->Next->PPrev = timer->PPrev;
+    }
+
+    if ((timer->Level < TIMER32_WHEEL_LEVELS) && (hwheel->Slots[timer->Level][timer->Slot] == NULL))
+    {
+        hwheel->Bitmap[timer->Level] &= ~(1UL << timer->Slot);
+    }
+
+    timer->Next = NULL;
+    timer->PPrev = NULL;
+}
+
+/**
+ * @brief Ближайшее событие колеса.
+ *
+ * Все занятые ячейки нижнего уровня наступают раньше ячеек верхних уровней, поэтому событием
+ * является первая занятая ячейка самого нижнего непустого уровня. Если колесо пусто, а список Far нет,
+ * событием является граница следующего интервала 2^35 тактов. Время события не меньше Now.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param time Время события.
+ * @return Уровень события, #TIMER32_WHEEL_LEVELS для списка Far, -1 если запущенных таймеров нет.
+ */
+static int HAL_Timer32_Wheel_NextEvent(Timer32_Wheel_HandleTypeDef *hwheel, uint64_t *time)
+{
+    for (uint32_t level = 0; level < TIMER32_WHEEL_LEVELS; level++)
+    {
+        uint32_t bitmap = hwheel->Bitmap[level];
+        if (bitmap != 0)
+        {
+            uint32_t shift = level * TIMER32_WHEEL_LEVEL_BITS;
+            uint64_t mask = (1ULL << (shift + TIMER32_WHEEL_LEVEL_BITS)) - 1;
+
+            *time = (hwheel->Now & ~mask) | ((uint64_t)__builtin_ctz(bitmap) << shift);
+            return (int)level;
+        }
+    }
+
+    if (hwheel->Far != NULL)
+    {
+        *time = ((hwheel->Now >> TIMER32_WHEEL_RANGE_BITS) + 1) << TIMER32_WHEEL_RANGE_BITS;
+        return TIMER32_WHEEL_LEVELS;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Обработать события колеса до заданного времени.
+ *
+ * Время колеса переходит от события к событию без перебора пустых ячеек. Таймеры нулевого уровня
+ * срабатывают, ячейки верхних уровней и список Far переносятся на нижние уровни.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param target Текущее время таймера.
+ */
+static void HAL_Timer32_Wheel_Advance(Timer32_Wheel_HandleTypeDef *hwheel, uint64_t target)
+{
+    uint64_t time;
+    int level;
+
+    while (((level = HAL_Timer32_Wheel_NextEvent(hwheel, &time)) >= 0) && (time <= target))
+    {
+        uint32_t slot = (uint32_t)(time >> (level * TIMER32_WHEEL_LEVEL_BITS)) & (TIMER32_WHEEL_SLOTS - 1);
+        Timer32_Wheel_TimerTypeDef *timer;
+
+        hwheel->Now = time;
+
+        if (level == TIMER32_WHEEL_LEVELS)
+        {
+            timer = hwheel->Far;
+            hwheel->Far = NULL;
+
+            while (timer != NULL)
+            {
+                Timer32_Wheel_TimerTypeDef *next = timer->Next;
+                HAL_Timer32_Wheel_Insert(hwheel, timer);
+                timer = next;
+            }
+        }
+        else if (level == 0)
+        {
+            /* Таймеры извлекаются по одному: функция обратного вызова может остановить любой таймер ячейки */
+            while ((timer = hwheel->Slots[0][slot]) != NULL)
+            {
+                HAL_Timer32_Wheel_Unlink(hwheel, timer);
+                if (timer->Period != 0)
+                {
+                    timer->Expires += timer->Period;
+                    HAL_Timer32_Wheel_Insert(hwheel, timer);
+                }
+                timer->Callback(timer);
+            }
+        }
+        else
+        {
+            timer = hwheel->Slots[level][slot];
+            hwheel->Slots[level][slot] = NULL;
+            hwheel->Bitmap[level] &= ~(1UL << slot);
+
+            while (timer != NULL)
+            {
+                Timer32_Wheel_TimerTypeDef *next = timer->Next;
+                HAL_Timer32_Wheel_Insert(hwheel, timer);
+                timer = next;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Записать время события в OCR.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param time Время события, не меньше now.
+ * @param now Текущее время таймера.
+ * @return 1, если сравнение произойдет после записи. 0, если счетчик уже прошел записанное значение.
+ */
+static int HAL_Timer32_Wheel_Program(Timer32_Wheel_HandleTypeDef *hwheel, uint64_t time, uint64_t now)
+{
+    HAL_Timer32_Channel_OCR_Set(&hwheel->Channel, (uint32_t)time);
+
+    if ((time - now) > 0x7FFFFFFFULL)
+    {
+        /* Событие дальше половины периода счетчика: OCR переписывается после ближайших срабатываний */
+        return 1;
+    }
+
+    return (int32_t)((uint32_t)time - hwheel->htimer32->Instance->VALUE) > 0;
+}
+
+/**
+ * @brief Записать в OCR время ближайшего события вне прерывания таймера.
+ *
+ * Вызывается при запрещенных прерываниях. Если событие уже наступило, сравнение назначается с запасом
+ * @ref TIMER32_WHEEL_MIN_DELTA, и таймеры срабатывают в прерывании.
+ * @param hwheel Указатель на структуру службы таймеров.
+ */
+static void HAL_Timer32_Wheel_Reschedule(Timer32_Wheel_HandleTypeDef *hwheel)
+{
+    uint64_t time;
+
+    if (HAL_Timer32_Wheel_NextEvent(hwheel, &time) < 0)
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        uint64_t now = HAL_Timer32_Wheel_HwTime(hwheel);
+        uint64_t earliest = now + TIMER32_WHEEL_MIN_DELTA;
+
+        if (HAL_Timer32_Wheel_Program(hwheel, (time > earliest) ? time : earliest, now))
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Инициализировать службу программных таймеров.
+ *
+ * Таймер перезапускается с нулевого значения, все программные таймеры считаются остановленными.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_Wheel_Init(Timer32_Wheel_HandleTypeDef *hwheel)
+{
+    TIMER32_HandleTypeDef *htimer32 = hwheel->htimer32;
+
+    if ((htimer32->Instance != TIMER32_1) && (htimer32->Instance != TIMER32_2))
+    {
+        return HAL_ERROR;
+    }
+
+    htimer32->Top = 0xFFFFFFFF;
+    htimer32->CountMode = TIMER32_COUNTMODE_FORWARD;
+    htimer32->State = TIMER32_STATE_DISABLE;
+    htimer32->InterruptMask = 0;
+    if (HAL_Timer32_Init(htimer32) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    hwheel->Channel.TimerInstance = htimer32->Instance;
+    hwheel->Channel.ChannelIndex = hwheel->ChannelIndex;
+    hwheel->Channel.PWM_Invert = TIMER32_CHANNEL_NON_INVERTED_PWM;
+    hwheel->Channel.Mode = TIMER32_CHANNEL_MODE_COMPARE;
+    hwheel->Channel.CaptureEdge = TIMER32_CHANNEL_CAPTUREEDGE_RISING;
+    hwheel->Channel.OCR = 0;
+    hwheel->Channel.Noise = TIMER32_CHANNEL_FILTER_OFF;
+    if (HAL_Timer32_Channel_Init(&hwheel->Channel) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    hwheel->Now = 0;
+    hwheel->High = 0;
+    hwheel->Far = NULL;
+    for (uint32_t level = 0; level < TIMER32_WHEEL_LEVELS; level++)
+    {
+        hwheel->Bitmap[level] = 0;
+        for (uint32_t slot = 0; slot < TIMER32_WHEEL_SLOTS; slot++)
+        {
+            hwheel->Slots[level][slot] = NULL;
+        }
+    }
+
+    HAL_Timer32_Value_Clear(htimer32);
+    HAL_Timer32_InterruptFlags_Clear(htimer32);
+    HAL_Timer32_InterruptMask_Set(htimer32, TIMER32_INT_OVERFLOW_M | TIMER32_INT_OC_M(hwheel->ChannelIndex));
+    HAL_Timer32_Channel_Enable(&hwheel->Channel);
+    HAL_Timer32_Start(htimer32);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Текущее время службы таймеров.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @return Время в тактах таймера с момента инициализации.
+ */
+uint64_t HAL_Timer32_Wheel_GetTime(Timer32_Wheel_HandleTypeDef *hwheel)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+    uint64_t now = HAL_Timer32_Wheel_HwTime(hwheel);
+    HAL_IRQ_Restore(mstatus);
+
+    return now;
+}
+
+/**
+ * @brief Запустить программный таймер.
+ *
+ * Запущенный таймер перезапускается с новыми параметрами. Функцию можно вызывать из прерываний
+ * и из функций обратного вызова таймеров.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param timer Указатель на программный таймер с заданным полем Callback.
+ * @param Delay Задержка до первого срабатывания в тактах таймера.
+ * @param Period Период повторных срабатываний в тактах таймера. 0 - однократный таймер.
+ * @return Статус HAL.
+ */
+HAL_StatusTypeDef HAL_Timer32_Wheel_Start(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer, uint32_t Delay, uint32_t Period)
+{
+    if (timer->Callback == NULL)
+    {
+        return HAL_ERROR;
+    }
+
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (timer->PPrev != NULL)
+    {
+        HAL_Timer32_Wheel_Unlink(hwheel, timer);
+    }
+
+    uint64_t now = HAL_Timer32_Wheel_HwTime(hwheel);
+    uint64_t time;
+    if (HAL_Timer32_Wheel_NextEvent(hwheel, &time) < 0)
+    {
+        /* Пустое колесо не продвигает время: после простоя дольше 2^35 тактов уровень таймера
+         * не определяется отличием от устаревшего Now */
+        hwheel->Now = now;
+    }
+
+    timer->Period = Period;
+    timer->Expires = now + Delay;
+    HAL_Timer32_Wheel_Insert(hwheel, timer);
+    HAL_Timer32_Wheel_Reschedule(hwheel);
+
+    HAL_IRQ_Restore(mstatus);
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Остановить программный таймер.
+ *
+ * Остановка незапущенного таймера допускается. OCR не перезаписывается: лишнее срабатывание
+ * сравнения обрабатывается как пустое.
+ * @param hwheel Указатель на структуру службы таймеров.
+ * @param timer Указатель на программный таймер.
+ */
+void HAL_Timer32_Wheel_Stop(Timer32_Wheel_HandleTypeDef *hwheel, Timer32_Wheel_TimerTypeDef *timer)
+{
+    uint32_t mstatus = HAL_IRQ_SaveAndDisable();
+
+    if (timer->PPrev != NULL)
+    {
+        HAL_Timer32_Wheel_Unlink(hwheel, timer);
+    }
+
+    HAL_IRQ_Restore(mstatus);
+}
+
+/**
+ * @brief Обработчик прерывания таймера службы программных таймеров.
+ *
+ * Вызывает функции обратного вызова наступивших таймеров и записывает в OCR время следующего события.
+ * @param hwheel Указатель на структуру службы таймеров.
+ */
+void HAL_Timer32_Wheel_IRQHandler(Timer32_Wheel_HandleTypeDef *hwheel)
+{
+    TIMER32_HandleTypeDef *htimer32 = hwheel->htimer32;
+    uint32_t interrupt_status = htimer32->Instance->INT_FLAGS;
+
+    if (interrupt_status & TIMER32_INT_OVERFLOW_M)
+    {
+        hwheel->High++;
+        HAL_Timer32_InterruptFlags_ClearMask(htimer32, TIMER32_INT_OVERFLOW_M);
+    }
+
+    if (interrupt_status & TIMER32_INT_OC_M(hwheel->ChannelIndex))
+    {
+        HAL_Timer32_InterruptFlags_ClearMask(htimer32, TIMER32_INT_OC_M(hwheel->ChannelIndex));
+    }
+
+    for (;;)
+    {
+        uint64_t now = HAL_Timer32_Wheel_HwTime(hwheel);
+        uint64_t time;
+
+        HAL_Timer32_Wheel_Advance(hwheel, now);
+
+        if (HAL_Timer32_Wheel_NextEvent(hwheel, &time) < 0)
+        {
+            break;
+        }
+
+        /* Если счетчик успел пройти записанное значение, события обрабатываются повторно */
+        if (HAL_Timer32_Wheel_Program(hwheel, time, now))
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef CRC_H_INCLUDED
+#define CRC_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/*
+ * Регистры блока CRC32 для модели на рабочей машине. В блоке микроконтроллера DATA8, DATA16 и DATA32
+ * расположены по одному адресу; здесь они разнесены, чтобы модель различала разрядность записи.
+ * Драйвер обращается к полям по именам, поэтому расположение на его работу не влияет.
+ */
+
+typedef struct
+{
+    volatile uint32_t POLY;
+    volatile uint32_t DATA32;
+    volatile uint16_t DATA16;
+    volatile uint16_t _reserved0;
+    volatile uint8_t DATA8;
+    volatile uint8_t _reserved1[3];
+    volatile uint32_t CTRL;
+} CRC_TypeDef;
+
+#define CRC                 ((CRC_TypeDef *)CRC_BASE_ADDRESS)
+
+#define CRC_CTRL_TOT_S      30
+#define CRC_CTRL_TOT_M      (0x3 << CRC_CTRL_TOT_S)
+#define CRC_CTRL_TOTR_S     28
+#define CRC_CTRL_TOTR_M     (0x3 << CRC_CTRL_TOTR_S)
+#define CRC_CTRL_FXOR_S     26
+#define CRC_CTRL_FXOR_M     (1 << CRC_CTRL_FXOR_S)
+#define CRC_CTRL_WAS_S      25
+#define CRC_CTRL_WAS_M      (1 << CRC_CTRL_WAS_S)
+#define CRC_CTRL_BUSY_S     0
+#define CRC_CTRL_BUSY_M     (1 << CRC_CTRL_BUSY_S)
+
+#endif // CRC_H_INCLUDED
@@ -0,0 +1,34 @@
+#ifndef CRYPTO_H_INCLUDED
+#define CRYPTO_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры крипто-блока для модели на рабочей машине */
+
+typedef struct
+{
+    volatile uint32_t BLOCK;
+    volatile uint32_t KEY;
+    volatile uint32_t INIT;
+    volatile uint32_t CONFIG;
+} CRYPTO_TypeDef;
+
+#define CRYPTO                          ((CRYPTO_TypeDef *)CRYPTO_BASE_ADDRESS)
+
+#define CRYPTO_CONFIG_DECODE_S          0
+#define CRYPTO_CONFIG_DECODE_M          (1 << CRYPTO_CONFIG_DECODE_S)
+#define CRYPTO_CONFIG_CORE_SEL_S        1
+#define CRYPTO_CONFIG_CORE_SEL_M        (0x3 << CRYPTO_CONFIG_CORE_SEL_S)
+#define CRYPTO_CONFIG_MODE_SEL_S        3
+#define CRYPTO_CONFIG_MODE_SEL_M        (0x3 << CRYPTO_CONFIG_MODE_SEL_S)
+#define CRYPTO_CONFIG_SWAP_MODE_S       5
+#define CRYPTO_CONFIG_SWAP_MODE_M       (0x3 << CRYPTO_CONFIG_SWAP_MODE_S)
+#define CRYPTO_CONFIG_ORDER_MODE_S      7
+#define CRYPTO_CONFIG_ORDER_MODE_M      (1 << CRYPTO_CONFIG_ORDER_MODE_S)
+#define CRYPTO_CONFIG_C_RESET_S         8
+#define CRYPTO_CONFIG_C_RESET_M         (1 << CRYPTO_CONFIG_C_RESET_S)
+#define CRYPTO_CONFIG_READY_S           9
+#define CRYPTO_CONFIG_READY_M           (1 << CRYPTO_CONFIG_READY_S)
+
+#endif // CRYPTO_H_INCLUDED
@@ -0,0 +1,22 @@
+#ifndef CSR_H_INCLUDED
+#define CSR_H_INCLUDED
+
+#include <stdint.h>
+
+/*
+ * Регистры CSR модели прерываний - переменные. Поддерживаются mstatus и mie, драйверы с другими CSR
+ * на рабочей машине не собираются.
+ */
+
+extern volatile uint32_t HAL_Host_MStatus;
+extern volatile uint32_t HAL_Host_Mie;
+
+#define HAL_HOST_CSR_mstatus        HAL_Host_MStatus
+#define HAL_HOST_CSR_mie            HAL_Host_Mie
+
+#define read_csr(reg)               (HAL_HOST_CSR_##reg)
+#define write_csr(reg, val)         (HAL_HOST_CSR_##reg = (val))
+#define set_csr(reg, bit)           (HAL_HOST_CSR_##reg |= (bit))
+#define clear_csr(reg, bit)         (HAL_HOST_CSR_##reg &= ~(bit))
+
+#endif // CSR_H_INCLUDED
@@ -0,0 +1,84 @@
+#ifndef DMA_CONFIG_H_INCLUDED
+#define DMA_CONFIG_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры контроллера DMA для модели на рабочей машине */
+
+typedef struct
+{
+    volatile uint32_t DST;
+    volatile uint32_t SRC;
+    volatile uint32_t LEN;
+    volatile uint32_t CFG;
+} DMA_CHANNEL_TypeDef;
+
+typedef struct
+{
+    DMA_CHANNEL_TypeDef CHANNELS[4];
+    volatile uint32_t CONFIG_STATUS;
+} DMA_CONFIG_TypeDef;
+
+#define DMA_CONFIG                          ((DMA_CONFIG_TypeDef *)DMA_CONFIG_BASE_ADDRESS)
+
+#define DMA_CHANNEL_COUNT                   4
+
+#define DMA_CH_CFG_ENABLE_S                 0
+#define DMA_CH_CFG_ENABLE_M                 (1 << DMA_CH_CFG_ENABLE_S)
+#define DMA_CH_CFG_PRIOR_S                  1
+#define DMA_CH_CFG_PRIOR_M                  (0x3 << DMA_CH_CFG_PRIOR_S)
+#define DMA_CH_CFG_READ_MODE_S              3
+#define DMA_CH_CFG_READ_MODE_M              (1 << DMA_CH_CFG_READ_MODE_S)
+#define DMA_CH_CFG_WRITE_MODE_S             4
+#define DMA_CH_CFG_WRITE_MODE_M             (1 << DMA_CH_CFG_WRITE_MODE_S)
+#define DMA_CH_CFG_READ_INCREMENT_S         5
+#define DMA_CH_CFG_READ_INCREMENT_M         (1 << DMA_CH_CFG_READ_INCREMENT_S)
+#define DMA_CH_CFG_WRITE_INCREMENT_S        6
+#define DMA_CH_CFG_WRITE_INCREMENT_M        (1 << DMA_CH_CFG_WRITE_INCREMENT_S)
+#define DMA_CH_CFG_READ_SIZE_S              7
+#define DMA_CH_CFG_READ_SIZE_M              (0x3 << DMA_CH_CFG_READ_SIZE_S)
+#define DMA_CH_CFG_WRITE_SIZE_S             9
+#define DMA_CH_CFG_WRITE_SIZE_M             (0x3 << DMA_CH_CFG_WRITE_SIZE_S)
+#define DMA_CH_CFG_READ_BURST_SIZE_S        11
+#define DMA_CH_CFG_READ_BURST_SIZE_M        (0x7 << DMA_CH_CFG_READ_BURST_SIZE_S)
+#define DMA_CH_CFG_WRITE_BURST_SIZE_S       14
+#define DMA_CH_CFG_WRITE_BURST_SIZE_M       (0x7 << DMA_CH_CFG_WRITE_BURST_SIZE_S)
+#define DMA_CH_CFG_READ_REQUEST_S           17
+#define DMA_CH_CFG_READ_REQUEST_M           (0xF << DMA_CH_CFG_READ_REQUEST_S)
+#define DMA_CH_CFG_WRITE_REQUEST_S          21
+#define DMA_CH_CFG_WRITE_REQUEST_M          (0xF << DMA_CH_CFG_WRITE_REQUEST_S)
+#define DMA_CH_CFG_READ_ACK_EN_S            25
+#define DMA_CH_CFG_READ_ACK_EN_M            (1 << DMA_CH_CFG_READ_ACK_EN_S)
+#define DMA_CH_CFG_WRITE_ACK_EN_S           26
+#define DMA_CH_CFG_WRITE_ACK_EN_M           (1 << DMA_CH_CFG_WRITE_ACK_EN_S)
+#define DMA_CH_CFG_IRQ_EN_S                 27
+#define DMA_CH_CFG_IRQ_EN_M                 (1 << DMA_CH_CFG_IRQ_EN_S)
+
+/* Запись CONFIG_STATUS */
+#define DMA_CONFIG_CLEAR_LOCAL_IRQ_S        0
+#define DMA_CONFIG_CLEAR_LOCAL_IRQ_M        (0xF << DMA_CONFIG_CLEAR_LOCAL_IRQ_S)
+#define DMA_CONFIG_CLEAR_GLOBAL_IRQ_S       4
+#define DMA_CONFIG_CLEAR_GLOBAL_IRQ_M       (1 << DMA_CONFIG_CLEAR_GLOBAL_IRQ_S)
+#define DMA_CONFIG_CLEAR_ERROR_IRQ_S        5
+#define DMA_CONFIG_CLEAR_ERROR_IRQ_M        (1 << DMA_CONFIG_CLEAR_ERROR_IRQ_S)
+#define DMA_CONFIG_GLOBAL_IRQ_ENA_S         6
+#define DMA_CONFIG_GLOBAL_IRQ_ENA_M         (1 << DMA_CONFIG_GLOBAL_IRQ_ENA_S)
+#define DMA_CONFIG_ERROR_IRQ_ENA_S          7
+#define DMA_CONFIG_ERROR_IRQ_ENA_M          (1 << DMA_CONFIG_ERROR_IRQ_ENA_S)
+#define DMA_CONFIG_CURRENT_VALUE_S          8
+#define DMA_CONFIG_CURRENT_VALUE_M          (1 << DMA_CONFIG_CURRENT_VALUE_S)
+
+/* Чтение CONFIG_STATUS */
+#define DMA_STATUS_READY_S                  0
+#define DMA_STATUS_READY_M                  (0xF << DMA_STATUS_READY_S)
+#define DMA_STATUS_CHANNEL_IRQ_S            4
+#define DMA_STATUS_CHANNEL_IRQ_M            (0xF << DMA_STATUS_CHANNEL_IRQ_S)
+#define DMA_STATUS_GLOBAL_IRQ_S             8
+#define DMA_STATUS_GLOBAL_IRQ_M             (1 << DMA_STATUS_GLOBAL_IRQ_S)
+#define DMA_STATUS_ERROR_IRQ_S              9
+#define DMA_STATUS_ERROR_IRQ_M              (1 << DMA_STATUS_ERROR_IRQ_S)
+#define DMA_STATUS_CHANNEL_BUS_ERROR_S      10
+#define DMA_STATUS_CHANNEL_BUS_ERROR_M      (0xF << DMA_STATUS_CHANNEL_BUS_ERROR_S)
+
+#endif // DMA_CONFIG_H_INCLUDED
@@ -0,0 +1,57 @@
+#ifndef EPIC_H_INCLUDED
+#define EPIC_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры EPIC без поведения */
+
+typedef struct
+{
+    volatile uint32_t MASK_EDGE_SET;
+    volatile uint32_t MASK_EDGE_CLEAR;
+    volatile uint32_t MASK_LEVEL_SET;
+    volatile uint32_t MASK_LEVEL_CLEAR;
+    volatile uint32_t CLEAR;
+    volatile uint32_t STATUS;
+    volatile uint32_t RAW_STATUS;
+    volatile uint32_t MASK_EDGE;
+    volatile uint32_t MASK_LEVEL;
+} EPIC_TypeDef;
+
+#define EPIC                        ((EPIC_TypeDef *)EPIC_BASE_ADDRESS)
+
+#define EPIC_TIMER32_0_INDEX        0
+#define EPIC_UART_0_INDEX           1
+#define EPIC_UART_1_INDEX           2
+#define EPIC_SPI_0_INDEX            3
+#define EPIC_SPI_1_INDEX            4
+#define EPIC_GPIO_IRQ_INDEX         5
+#define EPIC_I2C_0_INDEX            6
+#define EPIC_I2C_1_INDEX            7
+#define EPIC_WDT_INDEX              8
+#define EPIC_TIMER16_0_INDEX        9
+#define EPIC_TIMER16_1_INDEX        10
+#define EPIC_TIMER16_2_INDEX        11
+#define EPIC_TIMER32_1_INDEX        12
+#define EPIC_TIMER32_2_INDEX        13
+#define EPIC_SPIFI_INDEX            14
+#define EPIC_RTC_INDEX              15
+#define EPIC_EEPROM_INDEX           16
+#define EPIC_WDT_DOM3_INDEX         17
+#define EPIC_WDT_SPIFI_INDEX        18
+#define EPIC_WDT_EEPROM_INDEX       19
+#define EPIC_DMA_INDEX              20
+#define EPIC_FREQ_MON_INDEX         21
+#define EPIC_PVD_AVCC_UNDER         22
+#define EPIC_PVD_AVCC_OVER          23
+#define EPIC_PVD_VCC_UNDER          24
+#define EPIC_PVD_VCC_OVER           25
+#define EPIC_BATTERY_NON_GOOD       26
+#define EPIC_BOR_INDEX              27
+#define EPIC_TSENS_INDEX            28
+#define EPIC_ADC_INDEX              29
+#define EPIC_DAC0_INDEX             30
+#define EPIC_DAC1_INDEX             31
+
+#endif // EPIC_H_INCLUDED
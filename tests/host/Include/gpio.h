@@ -0,0 +1,23 @@
+#ifndef GPIO_H_INCLUDED
+#define GPIO_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры портов GPIO без поведения */
+
+typedef struct
+{
+    volatile uint32_t SET;
+    volatile uint32_t CLEAR;
+    volatile uint32_t DIRECTION_OUT;
+    volatile uint32_t DIRECTION_IN;
+    volatile uint32_t OUTPUT;
+    volatile uint32_t STATE;
+} GPIO_TypeDef;
+
+#define GPIO_0      ((GPIO_TypeDef *)GPIO_0_BASE_ADDRESS)
+#define GPIO_1      ((GPIO_TypeDef *)GPIO_1_BASE_ADDRESS)
+#define GPIO_2      ((GPIO_TypeDef *)GPIO_2_BASE_ADDRESS)
+
+#endif // GPIO_H_INCLUDED
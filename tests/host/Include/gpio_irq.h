@@ -0,0 +1,27 @@
+#ifndef GPIO_IRQ_H_INCLUDED
+#define GPIO_IRQ_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры прерываний GPIO без поведения */
+
+typedef struct
+{
+    volatile uint32_t LINE_MUX;
+    volatile uint32_t INTERRUPT;
+    volatile uint32_t ENABLE_SET;
+    volatile uint32_t ENABLE_CLEAR;
+    volatile uint32_t EDGE;
+    volatile uint32_t LEVEL;
+    volatile uint32_t LEVEL_SET;
+    volatile uint32_t LEVEL_CLEAR;
+    volatile uint32_t ANYEDGE_SET;
+    volatile uint32_t ANYEDGE_CLEAR;
+    volatile uint32_t CLEAR;
+    volatile uint32_t STATE;
+} GPIO_IRQ_TypeDef;
+
+#define GPIO_IRQ    ((GPIO_IRQ_TypeDef *)GPIO_IRQ_BASE_ADDRESS)
+
+#endif // GPIO_IRQ_H_INCLUDED
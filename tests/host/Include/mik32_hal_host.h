@@ -0,0 +1,101 @@
+#ifndef MIK32_HAL_HOST_MODEL
+#define MIK32_HAL_HOST_MODEL
+
+#include <stdint.h>
+#include <stdio.h>
+#include "mik32_hal_def.h"
+#include "mik32_memory_map.h"
+#include "scr1_csr_encoding.h"
+#include "timer32.h"
+#include "spi.h"
+#include "uart.h"
+
+
+#define HAL_HOST_SKIP_CODE      77      /**< Код завершения теста, если модель недоступна на рабочей машине (SKIP_RETURN_CODE ctest). */
+
+/**
+ * Проверка условия в тесте: при невыполнении выводится место проверки и увеличивается HAL_Host_Failures.
+ */
+#define HAL_HOST_CHECK(__COND__)    do { if (!(__COND__)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #__COND__); HAL_Host_Failures++; } } while (0)
+
+struct __HAL_Host_ModelTypeDef;
+
+/**
+ * @brief Обработчик обращения к регистру модели.
+ * @param model Указатель на модель блока.
+ * @param Offset Смещение регистра от базового адреса блока, байт.
+ */
+typedef void (*HAL_Host_AccessTypeDef)(struct __HAL_Host_ModelTypeDef *model, uint32_t Offset);
+
+/**
+ * @brief Модель периферийного блока.
+ *
+ * Регистры блока находятся в области периферии по тем же адресам, что и на микроконтроллере. Область
+ * защищена от обращений: перед чтением регистра вызывается Read, который записывает в память значения,
+ * видимые при чтении (статус, счетчик, результат). После записи регистра вызывается Write, который выполняет
+ * действие блока. Обработчики вызываются с открытой областью и обращаются к регистрам напрямую.
+ */
+typedef struct __HAL_Host_ModelTypeDef
+{
+    const char *Name;                   /**< Имя блока для сообщений. */
+    uintptr_t Base;                     /**< Базовый адрес регистров. */
+    uint32_t Size;                      /**< Размер области регистров, байт. */
+    HAL_Host_AccessTypeDef Read;        /**< Обработчик чтения. NULL - регистры читаются как записаны. */
+    HAL_Host_AccessTypeDef Write;       /**< Обработчик записи. NULL - запись только сохраняется. */
+    void (*Reset)(struct __HAL_Host_ModelTypeDef *model);  /**< Сброс состояния блока, вызывается из @ref HAL_Host_Init. */
+} HAL_Host_ModelTypeDef;
+
+/**
+ * @brief Модель регистра mstatus. Бит MSTATUS_MIE изменяется @ref HAL_IRQ_SaveAndDisable и @ref HAL_IRQ_Restore.
+ */
+extern volatile uint32_t HAL_Host_MStatus;
+
+/**
+ * @brief Модель регистра mie, изменяется @ref HAL_IRQ_EnableInterrupts и @ref HAL_IRQ_DisableInterrupts.
+ */
+extern volatile uint32_t HAL_Host_Mie;
+
+/**
+ * @brief Количество невыполненных проверок @ref HAL_HOST_CHECK.
+ */
+extern uint32_t HAL_Host_Failures;
+
+/**
+ * @brief Модель ведомого устройства SPI: возвращает байт, передаваемый в ответ на принятый.
+ */
+typedef uint8_t (*HAL_Host_SPI_SlaveTypeDef)(uint8_t Data);
+
+/**
+ * @brief Модель линии TX USART: вызывается для каждого переданного байта.
+ */
+typedef void (*HAL_Host_USART_LineTypeDef)(uint32_t Data);
+
+extern HAL_Host_ModelTypeDef HAL_Host_CRC_Model;
+extern HAL_Host_ModelTypeDef HAL_Host_Crypto_Model;
+extern HAL_Host_ModelTypeDef HAL_Host_DMA_Model;
+extern HAL_Host_ModelTypeDef HAL_Host_SPI_Model[2];
+extern HAL_Host_ModelTypeDef HAL_Host_Timer32_Model[3];
+extern HAL_Host_ModelTypeDef HAL_Host_USART_Model[2];
+
+
+HAL_StatusTypeDef HAL_Host_Init(void);
+void HAL_Host_Unlock(void);
+void HAL_Host_Lock(void);
+uint32_t HAL_Host_GetAccessCount(void);
+
+void HAL_Host_DMA_Request(uint32_t Request);
+uint32_t HAL_Host_DMA_GetBusyMask(void);
+
+uint32_t HAL_Host_Timer32_Run(TIMER32_TypeDef *timer, uint32_t Ticks);
+int HAL_Host_Timer32_IsPending(TIMER32_TypeDef *timer);
+
+void HAL_Host_SPI_SetSlave(SPI_TypeDef *spi, HAL_Host_SPI_SlaveTypeDef Slave);
+uint32_t HAL_Host_SPI_GetShifted(SPI_TypeDef *spi);
+
+void HAL_Host_USART_SetLine(UART_TypeDef *uart, HAL_Host_USART_LineTypeDef Line);
+void HAL_Host_USART_Receive(UART_TypeDef *uart, uint32_t Data);
+uint32_t HAL_Host_USART_GetTransmitted(UART_TypeDef *uart);
+
+uint32_t HAL_Host_Crypto_GetBlocks(void);
+
+#endif // MIK32_HAL_HOST_MODEL
@@ -0,0 +1,32 @@
+#ifndef MIK32_MEMORY_MAP_H_INCLUDED
+#define MIK32_MEMORY_MAP_H_INCLUDED
+
+/*
+ * Карта памяти периферии для сборки HAL на рабочей машине (MIK32_HAL_HOST).
+ * Область регистров отображается по тем же младшим адресам функцией HAL_Host_Init,
+ * обращения к ней перехватываются моделями блоков (mik32_hal_host.h).
+ */
+
+#define HOST_PERIPHERY_BASE_ADDRESS     0x00040000
+#define HOST_PERIPHERY_SIZE             0x00050000
+
+#define DMA_CONFIG_BASE_ADDRESS         0x00040000
+#define PM_BASE_ADDRESS                 0x00050000
+#define EPIC_BASE_ADDRESS               0x00050400
+#define TIMER32_0_BASE_ADDRESS          0x00050800
+#define PAD_CONFIG_BASE_ADDRESS         0x00050C00
+#define WU_BASE_ADDRESS                 0x00060000
+#define CRC_BASE_ADDRESS                0x00070000
+#define CRYPTO_BASE_ADDRESS             0x00080000
+#define SPI_0_BASE_ADDRESS              0x00081000
+#define SPI_1_BASE_ADDRESS              0x00081400
+#define UART_0_BASE_ADDRESS             0x00081800
+#define UART_1_BASE_ADDRESS             0x00081C00
+#define TIMER32_1_BASE_ADDRESS          0x00082800
+#define TIMER32_2_BASE_ADDRESS          0x00082C00
+#define GPIO_0_BASE_ADDRESS             0x00084000
+#define GPIO_1_BASE_ADDRESS             0x00084400
+#define GPIO_2_BASE_ADDRESS             0x00084800
+#define GPIO_IRQ_BASE_ADDRESS           0x00084C00
+
+#endif // MIK32_MEMORY_MAP_H_INCLUDED
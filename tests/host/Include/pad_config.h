@@ -0,0 +1,24 @@
+#ifndef PAD_CONFIG_H_INCLUDED
+#define PAD_CONFIG_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры настройки выводов без поведения */
+
+typedef struct
+{
+    volatile uint32_t PORT_0_CFG;
+    volatile uint32_t PORT_0_DS;
+    volatile uint32_t PORT_0_PUPD;
+    volatile uint32_t PORT_1_CFG;
+    volatile uint32_t PORT_1_DS;
+    volatile uint32_t PORT_1_PUPD;
+    volatile uint32_t PORT_2_CFG;
+    volatile uint32_t PORT_2_DS;
+    volatile uint32_t PORT_2_PUPD;
+} PAD_CONFIG_TypeDef;
+
+#define PAD_CONFIG  ((PAD_CONFIG_TypeDef *)PAD_CONFIG_BASE_ADDRESS)
+
+#endif // PAD_CONFIG_H_INCLUDED
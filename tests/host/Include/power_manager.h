@@ -0,0 +1,71 @@
+#ifndef POWER_MANAGER_H_INCLUDED
+#define POWER_MANAGER_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры PM без поведения: запись тактирования сохраняется в памяти, делители читаются как заданы тестом */
+
+typedef struct
+{
+    volatile uint32_t DIV_AHB;
+    volatile uint32_t DIV_APB_M;
+    volatile uint32_t DIV_APB_P;
+    volatile uint32_t CLK_AHB_SET;
+    volatile uint32_t CLK_AHB_CLEAR;
+    volatile uint32_t CLK_APB_M_SET;
+    volatile uint32_t CLK_APB_M_CLEAR;
+    volatile uint32_t CLK_APB_P_SET;
+    volatile uint32_t CLK_APB_P_CLEAR;
+    volatile uint32_t AHB_CLK_MUX;
+    volatile uint32_t WDT_CLK_MUX;
+    volatile uint32_t CPU_RTC_CLK_MUX;
+    volatile uint32_t TIMER_CFG;
+    volatile uint32_t FREQ_MASK;
+    volatile uint32_t FREQ_STATUS;
+    volatile uint32_t SLEEP_MODE;
+} PM_TypeDef;
+
+#define PM                              ((PM_TypeDef *)PM_BASE_ADDRESS)
+
+#define PM_CLOCK_AHB_CPU_M              (1 << 0)
+#define PM_CLOCK_AHB_EEPROM_M           (1 << 1)
+#define PM_CLOCK_AHB_RAM_M              (1 << 2)
+#define PM_CLOCK_AHB_SPIFI_M            (1 << 3)
+#define PM_CLOCK_AHB_TCB_M              (1 << 4)
+#define PM_CLOCK_AHB_DMA_M              (1 << 5)
+#define PM_CLOCK_AHB_CRYPTO_M           (1 << 6)
+#define PM_CLOCK_AHB_CRC32_M            (1 << 7)
+
+#define PM_CLOCK_APB_M_PM_M             (1 << 0)
+#define PM_CLOCK_APB_M_EPIC_M           (1 << 1)
+#define PM_CLOCK_APB_M_TIMER32_0_M      (1 << 2)
+#define PM_CLOCK_APB_M_PAD_CONFIG_M     (1 << 3)
+#define PM_CLOCK_APB_M_WDT_BUS_M        (1 << 4)
+#define PM_CLOCK_APB_M_OTP_CONTROLLER_M (1 << 5)
+#define PM_CLOCK_APB_M_PVD_CONTROL_M    (1 << 6)
+#define PM_CLOCK_APB_M_WU_M             (1 << 7)
+#define PM_CLOCK_APB_M_RTC_M            (1 << 8)
+
+#define PM_CLOCK_APB_P_WDT_M            (1 << 0)
+#define PM_CLOCK_APB_P_UART_0_M         (1 << 1)
+#define PM_CLOCK_APB_P_UART_1_M         (1 << 2)
+#define PM_CLOCK_APB_P_TIMER16_0_M      (1 << 3)
+#define PM_CLOCK_APB_P_TIMER16_1_M      (1 << 4)
+#define PM_CLOCK_APB_P_TIMER16_2_M      (1 << 5)
+#define PM_CLOCK_APB_P_TIMER32_1_M      (1 << 6)
+#define PM_CLOCK_APB_P_TIMER32_2_M      (1 << 7)
+#define PM_CLOCK_APB_P_SPI_0_M          (1 << 8)
+#define PM_CLOCK_APB_P_SPI_1_M          (1 << 9)
+#define PM_CLOCK_APB_P_I2C_0_M          (1 << 10)
+#define PM_CLOCK_APB_P_I2C_1_M          (1 << 11)
+#define PM_CLOCK_APB_P_GPIO_0_M         (1 << 12)
+#define PM_CLOCK_APB_P_GPIO_1_M         (1 << 13)
+#define PM_CLOCK_APB_P_GPIO_2_M         (1 << 14)
+#define PM_CLOCK_APB_P_ANALOG_REGS_M    (1 << 15)
+#define PM_CLOCK_APB_P_GPIO_IRQ_M       (1 << 16)
+
+#define PM_TIMER_CFG_MUX_TIMER_S(num)   (num)
+#define PM_TIMER_CFG_MUX_TIMER_M(num)   (0x3 << (num))
+
+#endif // POWER_MANAGER_H_INCLUDED
@@ -0,0 +1,11 @@
+#ifndef SCR1_CSR_ENCODING_H_INCLUDED
+#define SCR1_CSR_ENCODING_H_INCLUDED
+
+/* Биты CSR, используемые драйверами. На рабочей машине mstatus моделируется переменной HAL_Host_MStatus */
+
+#define MSTATUS_MIE     0x00000008
+#define MIP_MTIP        0x00000080
+#define MIE_MTIE        0x00000080
+#define MIE_MEIE        0x00000800
+
+#endif // SCR1_CSR_ENCODING_H_INCLUDED
@@ -0,0 +1,82 @@
+#ifndef SPI_H_INCLUDED
+#define SPI_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры SPI для модели на рабочей машине */
+
+typedef struct
+{
+    volatile uint32_t CONFIG;
+    volatile uint32_t INT_STATUS;
+    volatile uint32_t INT_ENABLE;
+    volatile uint32_t INT_DISABLE;
+    volatile uint32_t INT_MASK;
+    volatile uint32_t ENABLE;
+    volatile uint32_t DELAY;
+    volatile uint32_t TXDATA;
+    volatile uint32_t RXDATA;
+    volatile uint32_t SIC;
+    volatile uint32_t TX_THR;
+    volatile uint32_t _reserved[52];
+    volatile uint32_t ID;
+} SPI_TypeDef;
+
+#define SPI_0                               ((SPI_TypeDef *)SPI_0_BASE_ADDRESS)
+#define SPI_1                               ((SPI_TypeDef *)SPI_1_BASE_ADDRESS)
+
+#define SPI_CONFIG_MASTER_S                 0
+#define SPI_CONFIG_MASTER_M                 (1 << SPI_CONFIG_MASTER_S)
+#define SPI_CONFIG_SLAVE_M                  (0 << SPI_CONFIG_MASTER_S)
+#define SPI_CONFIG_CLK_POL_S                1
+#define SPI_CONFIG_CLK_POL_M                (1 << SPI_CONFIG_CLK_POL_S)
+#define SPI_CONFIG_CLK_PH_S                 2
+#define SPI_CONFIG_CLK_PH_M                 (1 << SPI_CONFIG_CLK_PH_S)
+#define SPI_CONFIG_BAUD_RATE_DIV_S          3
+#define SPI_CONFIG_BAUD_RATE_DIV_M          (0x7 << SPI_CONFIG_BAUD_RATE_DIV_S)
+#define SPI_CONFIG_DATA_SZ_S                7
+#define SPI_CONFIG_DATA_SZ_M                (0x3 << SPI_CONFIG_DATA_SZ_S)
+#define SPI_CONFIG_PERI_SEL_S               9
+#define SPI_CONFIG_PERI_SEL_M               (1 << SPI_CONFIG_PERI_SEL_S)
+#define SPI_CONFIG_CS_S                     10
+#define SPI_CONFIG_CS_M                     (0xF << SPI_CONFIG_CS_S)
+#define SPI_CONFIG_CS_NONE_M                (0xF << SPI_CONFIG_CS_S)
+#define SPI_CONFIG_MANUAL_CS_S              14
+#define SPI_CONFIG_MANUAL_CS_M              (1 << SPI_CONFIG_MANUAL_CS_S)
+
+#define SPI_INT_STATUS_RX_OVERFLOW_S        0
+#define SPI_INT_STATUS_RX_OVERFLOW_M        (1 << SPI_INT_STATUS_RX_OVERFLOW_S)
+#define SPI_INT_STATUS_MODE_FAIL_S          1
+#define SPI_INT_STATUS_MODE_FAIL_M          (1 << SPI_INT_STATUS_MODE_FAIL_S)
+#define SPI_INT_STATUS_TX_FIFO_NOT_FULL_S   2
+#define SPI_INT_STATUS_TX_FIFO_NOT_FULL_M   (1 << SPI_INT_STATUS_TX_FIFO_NOT_FULL_S)
+#define SPI_INT_STATUS_TX_FIFO_FULL_S       3
+#define SPI_INT_STATUS_TX_FIFO_FULL_M       (1 << SPI_INT_STATUS_TX_FIFO_FULL_S)
+#define SPI_INT_STATUS_RX_FIFO_NOT_EMPTY_S  4
+#define SPI_INT_STATUS_RX_FIFO_NOT_EMPTY_M  (1 << SPI_INT_STATUS_RX_FIFO_NOT_EMPTY_S)
+#define SPI_INT_STATUS_RX_FIFO_FULL_S       5
+#define SPI_INT_STATUS_RX_FIFO_FULL_M       (1 << SPI_INT_STATUS_RX_FIFO_FULL_S)
+#define SPI_INT_STATUS_TX_FIFO_UNDERFLOW_S  6
+#define SPI_INT_STATUS_TX_FIFO_UNDERFLOW_M  (1 << SPI_INT_STATUS_TX_FIFO_UNDERFLOW_S)
+#define SPI_INT_STATUS_SPI_ACTIVE_S         8
+#define SPI_INT_STATUS_SPI_ACTIVE_M         (1 << SPI_INT_STATUS_SPI_ACTIVE_S)
+
+#define SPI_ENABLE_S                        0
+#define SPI_ENABLE_M                        (1 << SPI_ENABLE_S)
+#define SPI_ENABLE_CLEAR_TX_FIFO_S          2
+#define SPI_ENABLE_CLEAR_TX_FIFO_M          (1 << SPI_ENABLE_CLEAR_TX_FIFO_S)
+#define SPI_ENABLE_CLEAR_RX_FIFO_S          3
+#define SPI_ENABLE_CLEAR_RX_FIFO_M          (1 << SPI_ENABLE_CLEAR_RX_FIFO_S)
+
+#define SPI_DELAY_INIT_S                    0
+#define SPI_DELAY_INIT_M                    (0xFF << SPI_DELAY_INIT_S)
+#define SPI_DELAY_INIT(v)                   (((v) << SPI_DELAY_INIT_S) & SPI_DELAY_INIT_M)
+#define SPI_DELAY_AFTER_S                   8
+#define SPI_DELAY_AFTER_M                   (0xFF << SPI_DELAY_AFTER_S)
+#define SPI_DELAY_AFTER(v)                  (((v) << SPI_DELAY_AFTER_S) & SPI_DELAY_AFTER_M)
+#define SPI_DELAY_BTWN_S                    16
+#define SPI_DELAY_BTWN_M                    (0xFF << SPI_DELAY_BTWN_S)
+#define SPI_DELAY_BTWN(v)                   (((v) << SPI_DELAY_BTWN_S) & SPI_DELAY_BTWN_M)
+
+#endif // SPI_H_INCLUDED
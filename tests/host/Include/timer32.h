@@ -0,0 +1,67 @@
+#ifndef TIMER32_H_INCLUDED
+#define TIMER32_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры Timer32 для модели на рабочей машине */
+
+typedef struct
+{
+    volatile uint32_t CNTRL;
+    volatile uint32_t OCR;
+    volatile uint32_t ICR;
+    volatile uint32_t _reserved;
+} TIMER32_CHANNEL_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t VALUE;
+    volatile uint32_t TOP;
+    volatile uint32_t PRESCALER;
+    volatile uint32_t CONTROL;
+    volatile uint32_t ENABLE;
+    volatile uint32_t INT_MASK;
+    volatile uint32_t INT_CLEAR;
+    volatile uint32_t INT_FLAGS;
+    volatile uint32_t _reserved[24];
+    TIMER32_CHANNEL_TypeDef CHANNELS[4];
+} TIMER32_TypeDef;
+
+#define TIMER32_0                           ((TIMER32_TypeDef *)TIMER32_0_BASE_ADDRESS)
+#define TIMER32_1                           ((TIMER32_TypeDef *)TIMER32_1_BASE_ADDRESS)
+#define TIMER32_2                           ((TIMER32_TypeDef *)TIMER32_2_BASE_ADDRESS)
+
+#define TIMER32_CONTROL_MODE_S              0
+#define TIMER32_CONTROL_MODE_M              (0x3 << TIMER32_CONTROL_MODE_S)
+#define TIMER32_CONTROL_CLOCK_S             2
+#define TIMER32_CONTROL_CLOCK_M             (0x3 << TIMER32_CONTROL_CLOCK_S)
+#define TIMER32_CONTROL_CLOCK_PRESCALER_M   (0x0 << TIMER32_CONTROL_CLOCK_S)
+#define TIMER32_CONTROL_CLOCK_TIM1_M        (0x1 << TIMER32_CONTROL_CLOCK_S)
+#define TIMER32_CONTROL_CLOCK_TIM2_M        (0x2 << TIMER32_CONTROL_CLOCK_S)
+#define TIMER32_CONTROL_CLOCK_TX_PIN_M      (0x3 << TIMER32_CONTROL_CLOCK_S)
+
+#define TIMER32_ENABLE_TIM_EN_S             0
+#define TIMER32_ENABLE_TIM_EN_M             (1 << TIMER32_ENABLE_TIM_EN_S)
+#define TIMER32_ENABLE_TIM_CLR_S            1
+#define TIMER32_ENABLE_TIM_CLR_M            (1 << TIMER32_ENABLE_TIM_CLR_S)
+
+#define TIMER32_INT_OVERFLOW_M              (1 << 0)
+#define TIMER32_INT_UNDERFLOW_M             (1 << 1)
+#define TIMER32_INT_OC_M(i)                 (1 << (2 + (i)))
+#define TIMER32_INT_IC_M(i)                 (1 << (6 + (i)))
+
+#define TIMER32_CH_CNTRL_MODE_S             0
+#define TIMER32_CH_CNTRL_MODE_M             (0x3 << TIMER32_CH_CNTRL_MODE_S)
+#define TIMER32_CH_CNTRL_CAPTURE_EDGE_S     2
+#define TIMER32_CH_CNTRL_CAPTURE_EDGE_M     (0x3 << TIMER32_CH_CNTRL_CAPTURE_EDGE_S)
+#define TIMER32_CH_CNTRL_INVERTED_PWM_S     4
+#define TIMER32_CH_CNTRL_INVERTED_PWM_M     (1 << TIMER32_CH_CNTRL_INVERTED_PWM_S)
+#define TIMER32_CH_CNTRL_ENABLE_S           5
+#define TIMER32_CH_CNTRL_ENABLE_M           (1 << TIMER32_CH_CNTRL_ENABLE_S)
+#define TIMER32_CH_CNTRL_CAPTURE_CLEAR_S    6
+#define TIMER32_CH_CNTRL_CAPTURE_CLEAR_M    (1 << TIMER32_CH_CNTRL_CAPTURE_CLEAR_S)
+#define TIMER32_CH_CNTRL_NOISE_S            7
+#define TIMER32_CH_CNTRL_NOISE_M            (1 << TIMER32_CH_CNTRL_NOISE_S)
+
+#endif // TIMER32_H_INCLUDED
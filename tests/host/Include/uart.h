@@ -0,0 +1,84 @@
+#ifndef UART_H_INCLUDED
+#define UART_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Регистры USART для модели на рабочей машине */
+
+typedef struct
+{
+    volatile uint32_t CONTROL1;
+    volatile uint32_t CONTROL2;
+    volatile uint32_t CONTROL3;
+    volatile uint32_t DIVIDER;
+    volatile uint32_t _reserved0[3];
+    volatile uint32_t FLAGS;
+    volatile uint32_t _reserved1;
+    volatile uint32_t RXDATA;
+    volatile uint32_t TXDATA;
+    volatile uint32_t MODEM;
+} UART_TypeDef;
+
+#define UART_0                          ((UART_TypeDef *)UART_0_BASE_ADDRESS)
+#define UART_1                          ((UART_TypeDef *)UART_1_BASE_ADDRESS)
+
+#define UART_CONTROL1_UE_M              (1 << 0)
+#define UART_CONTROL1_RE_M              (1 << 2)
+#define UART_CONTROL1_TE_M              (1 << 3)
+#define UART_CONTROL1_IDLEIE_M          (1 << 4)
+#define UART_CONTROL1_RXNEIE_M          (1 << 5)
+#define UART_CONTROL1_TCIE_M            (1 << 6)
+#define UART_CONTROL1_TXEIE_M           (1 << 7)
+#define UART_CONTROL1_PEIE_M            (1 << 8)
+#define UART_CONTROL1_PS_M              (1 << 9)
+#define UART_CONTROL1_PCE_M             (1 << 10)
+#define UART_CONTROL1_M0_M              (1 << 12)
+#define UART_CONTROL1_M1_M              (1 << 28)
+
+#define UART_CONTROL2_LBDIE_M           (1 << 6)
+#define UART_CONTROL2_LBCL_M            (1 << 8)
+#define UART_CONTROL2_CPHA_M            (1 << 9)
+#define UART_CONTROL2_CPOL_M            (1 << 10)
+#define UART_CONTROL2_CLKEN_M           (1 << 11)
+#define UART_CONTROL2_STOP_1_M          (1 << 13)
+#define UART_CONTROL2_LBM_M             (1 << 14)
+#define UART_CONTROL2_SWAP_M            (1 << 15)
+#define UART_CONTROL2_RXINV_M           (1 << 16)
+#define UART_CONTROL2_TXINV_M           (1 << 17)
+#define UART_CONTROL2_DATAINV_M         (1 << 18)
+#define UART_CONTROL2_MSBFIRST_M        (1 << 19)
+
+#define UART_CONTROL3_EIE_M             (1 << 0)
+#define UART_CONTROL3_HDSEL_M           (1 << 3)
+#define UART_CONTROL3_BKRQ_M            (1 << 4)
+#define UART_CONTROL3_DMAR_M            (1 << 6)
+#define UART_CONTROL3_DMAT_M            (1 << 7)
+#define UART_CONTROL3_RTSE_M            (1 << 8)
+#define UART_CONTROL3_CTSE_M            (1 << 9)
+#define UART_CONTROL3_CTSIE_M           (1 << 10)
+#define UART_CONTROL3_OVRDIS_M          (1 << 12)
+
+#define UART_FLAGS_PE_M                 (1 << 0)
+#define UART_FLAGS_FE_M                 (1 << 1)
+#define UART_FLAGS_NF_M                 (1 << 2)
+#define UART_FLAGS_ORE_M                (1 << 3)
+#define UART_FLAGS_IDLE_M               (1 << 4)
+#define UART_FLAGS_RXNE_M               (1 << 5)
+#define UART_FLAGS_TC_M                 (1 << 6)
+#define UART_FLAGS_TXE_M                (1 << 7)
+#define UART_FLAGS_LBDF_M               (1 << 8)
+#define UART_FLAGS_CTSIF_M              (1 << 9)
+#define UART_FLAGS_CTS_M                (1 << 10)
+#define UART_FLAGS_TEACK_M              (1 << 21)
+#define UART_FLAGS_REACK_M              (1 << 22)
+
+#define UART_MODEM_DTR_M                (1 << 0)
+#define UART_MODEM_DCD_M                (1 << 4)
+#define UART_MODEM_RI_M                 (1 << 5)
+#define UART_MODEM_DSR_M                (1 << 6)
+#define UART_MODEM_DCDIF_M              (1 << 8)
+#define UART_MODEM_RIIF_M               (1 << 9)
+#define UART_MODEM_DSRIF_M              (1 << 10)
+
+#endif // UART_H_INCLUDED
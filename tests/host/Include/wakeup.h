@@ -0,0 +1,9 @@
+#ifndef WAKEUP_H_INCLUDED
+#define WAKEUP_H_INCLUDED
+
+#include <stdint.h>
+#include "mik32_memory_map.h"
+
+/* Заглушка блока WU: драйверы, собираемые на рабочей машине, к нему не обращаются */
+
+#endif // WAKEUP_H_INCLUDED
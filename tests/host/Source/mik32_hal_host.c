@@ -0,0 +1,234 @@
+#define _GNU_SOURCE
+#include <signal.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal.h"
+#include "mik32_hal_gpio.h"
+
+
+#define HOST_EFLAGS_TF      0x100   /* Флаг пошагового выполнения x86_64 */
+#define HOST_PF_WRITE       0x2     /* Бит записи в коде ошибки страничного нарушения */
+
+volatile uint32_t HAL_Host_MStatus = MSTATUS_MIE;
+volatile uint32_t HAL_Host_Mie = 0;
+uint32_t HAL_Host_Failures = 0;
+
+/**
+ * @brief Модели, регистры которых перехватываются. Остальная область периферии - память без поведения.
+ */
+static HAL_Host_ModelTypeDef *const Models[] =
+{
+    &HAL_Host_CRC_Model,
+    &HAL_Host_Crypto_Model,
+    &HAL_Host_DMA_Model,
+    &HAL_Host_SPI_Model[0],
+    &HAL_Host_SPI_Model[1],
+    &HAL_Host_Timer32_Model[0],
+    &HAL_Host_Timer32_Model[1],
+    &HAL_Host_Timer32_Model[2],
+    &HAL_Host_USART_Model[0],
+    &HAL_Host_USART_Model[1],
+};
+
+#define HOST_MODEL_COUNT    (sizeof(Models) / sizeof(Models[0]))
+
+/**
+ * @brief Обращение, выполняемое в данный момент по шагу. Записывается в SIGSEGV, обрабатывается в SIGTRAP.
+ */
+static struct
+{
+    HAL_Host_ModelTypeDef *Model;
+    uint32_t Offset;
+    int Write;
+} Pending;
+
+static int Mapped = 0;
+static int Unlocked = 0;
+static volatile uint32_t AccessCount = 0;
+static uint32_t MicrosCount = 0;
+
+static void HAL_Host_Protect(int prot)
+{
+    mprotect((void *)HOST_PERIPHERY_BASE_ADDRESS, HOST_PERIPHERY_SIZE, prot);
+}
+
+static HAL_Host_ModelTypeDef *HAL_Host_FindModel(uintptr_t address)
+{
+    for (uint32_t i = 0; i < HOST_MODEL_COUNT; i++)
+    {
+        if ((address >= Models[i]->Base) && (address < Models[i]->Base + Models[i]->Size))
+        {
+            return Models[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Обращение к защищенной области периферии.
+ *
+ * Перед чтением вызывается обработчик Read модели. Область открывается, и инструкция выполняется
+ * повторно с флагом TF: после нее процессор формирует SIGTRAP.
+ */
+static void HAL_Host_SegvHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    uintptr_t address = (uintptr_t)info->si_addr;
+
+    if ((address < HOST_PERIPHERY_BASE_ADDRESS) || (address >= HOST_PERIPHERY_BASE_ADDRESS + HOST_PERIPHERY_SIZE))
+    {
+        /* Ошибка программы: повторное нарушение завершит процесс */
+        signal(sig, SIG_DFL);
+        return;
+    }
+
+    AccessCount++;
+    Pending.Model = HAL_Host_FindModel(address);
+    Pending.Write = (uc->uc_mcontext.gregs[REG_ERR] & HOST_PF_WRITE) != 0;
+    Pending.Offset = (Pending.Model != NULL) ? (uint32_t)(address - Pending.Model->Base) : 0;
+
+    HAL_Host_Protect(PROT_READ | PROT_WRITE);
+
+    if ((Pending.Model != NULL) && (Pending.Model->Read != NULL))
+    {
+        Pending.Model->Read(Pending.Model, Pending.Offset & ~3U);
+    }
+
+    uc->uc_mcontext.gregs[REG_EFL] |= HOST_EFLAGS_TF;
+}
+
+/**
+ * @brief Инструкция обращения выполнена: вызывается обработчик записи и область закрывается.
+ */
+static void HAL_Host_TrapHandler(int sig, siginfo_t *info, void *context)
+{
+    ucontext_t *uc = (ucontext_t *)context;
+    (void)sig;
+    (void)info;
+
+    uc->uc_mcontext.gregs[REG_EFL] &= ~HOST_EFLAGS_TF;
+
+    if (Pending.Write && (Pending.Model != NULL) && (Pending.Model->Write != NULL))
+    {
+        Pending.Model->Write(Pending.Model, Pending.Offset);
+    }
+    Pending.Model = NULL;
+
+    if (!Unlocked)
+    {
+        HAL_Host_Protect(PROT_NONE);
+    }
+}
+
+/**
+ * @brief Отобразить область периферии и сбросить модели.
+ *
+ * Область отображается по адресам HOST_PERIPHERY_BASE_ADDRESS, поэтому исполняемый файл собирается
+ * без PIE и адреса буферов DMA помещаются в 32 бита. Повторный вызов сбрасывает модели.
+ * @return HAL_ERROR, если область нельзя отобразить (vm.mmap_min_addr) или платформа не x86_64.
+ */
+HAL_StatusTypeDef HAL_Host_Init(void)
+{
+    if (!Mapped)
+    {
+        void *area = mmap((void *)HOST_PERIPHERY_BASE_ADDRESS, HOST_PERIPHERY_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (area != (void *)HOST_PERIPHERY_BASE_ADDRESS)
+        {
+            fprintf(stderr, "host: periphery area at 0x%08X is not available\n", HOST_PERIPHERY_BASE_ADDRESS);
+            return HAL_ERROR;
+        }
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_flags = SA_SIGINFO;
+        action.sa_sigaction = HAL_Host_SegvHandler;
+        sigaction(SIGSEGV, &action, NULL);
+        action.sa_sigaction = HAL_Host_TrapHandler;
+        sigaction(SIGTRAP, &action, NULL);
+
+        Mapped = 1;
+    }
+
+    HAL_Host_Unlock();
+    memset((void *)HOST_PERIPHERY_BASE_ADDRESS, 0, HOST_PERIPHERY_SIZE);
+    for (uint32_t i = 0; i < HOST_MODEL_COUNT; i++)
+    {
+        if (Models[i]->Reset != NULL)
+        {
+            Models[i]->Reset(Models[i]);
+        }
+    }
+    HAL_Host_Lock();
+
+    HAL_Host_MStatus = MSTATUS_MIE;
+    HAL_Host_Mie = 0;
+    AccessCount = 0;
+    MicrosCount = 0;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Открыть регистры для прямого обращения модели вне обработчиков (события со стороны блока).
+ */
+void HAL_Host_Unlock(void)
+{
+    Unlocked = 1;
+    HAL_Host_Protect(PROT_READ | PROT_WRITE);
+}
+
+/**
+ * @brief Закрыть регистры после @ref HAL_Host_Unlock.
+ */
+void HAL_Host_Lock(void)
+{
+    Unlocked = 0;
+    HAL_Host_Protect(PROT_NONE);
+}
+
+/**
+ * @brief Количество обращений программы к области периферии после @ref HAL_Host_Init.
+ */
+uint32_t HAL_Host_GetAccessCount(void)
+{
+    return AccessCount;
+}
+
+/*
+ * Функции блоков без моделей, которые вызывают собираемые драйверы. Тактирование и выводы
+ * на рабочей машине не настраиваются.
+ */
+
+/**
+ * @brief Частота системы модели - HSI32M без делителя.
+ */
+uint32_t HAL_PCC_GetSysClockFreq()
+{
+    return HSI_VALUE;
+}
+
+/**
+ * @brief Настройка выводов не выполняется.
+ */
+HAL_StatusTypeDef HAL_GPIO_Init(GPIO_TypeDef *GPIO_x, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIO_x;
+    (void)GPIO_Init;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Время для тайм-аутов драйверов: каждый вызов продвигает время на 1 мкс, поэтому ожидание
+ *        флага, который модель не установит, завершается через заданное число опросов.
+ */
+uint32_t HAL_Micros()
+{
+    return MicrosCount++;
+}
@@ -0,0 +1,126 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_crc32.h"
+#include "mik32_hal_crc32_ref.h"
+
+
+/**
+ * @brief Состояние модели CRC32: сдвиговый регистр, старший бит которого выдвигается первым.
+ */
+static uint32_t Remainder;
+
+/**
+ * @brief Перестановка битов и байтов записанного или читаемого значения (поля TOT и TOTR).
+ * @param value Значение.
+ * @param bytes Разрядность обращения, байт.
+ * @param mode Режим CRC_REVERSE_*.
+ * @return Значение после перестановки.
+ */
+static uint32_t HAL_Host_CRC_Transpose(uint32_t value, uint32_t bytes, uint32_t mode)
+{
+    if ((mode == CRC_REVERSE_BITS) || (mode == CRC_REVERSE_BITS_BYTES))
+    {
+        /* Биты каждого байта в обратном порядке */
+        uint32_t reflected = HAL_CRC_Ref_Reflect32(value);
+        value = (reflected >> 24) | ((reflected >> 8) & 0xFF00) | ((reflected << 8) & 0xFF0000) | (reflected << 24);
+    }
+
+    if ((mode == CRC_REVERSE_BITS_BYTES) || (mode == CRC_REVERSE_BYTES))
+    {
+        uint32_t swapped = 0;
+        for (uint32_t i = 0; i < bytes; i++)
+        {
+            swapped = (swapped << 8) | ((value >> (8 * i)) & 0xFF);
+        }
+        value = swapped;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Подать на блок записанное значение. Байты обрабатываются начиная с младшего, биты байта - со старшего.
+ */
+static void HAL_Host_CRC_Feed(uint32_t value, uint32_t bytes)
+{
+    value = HAL_Host_CRC_Transpose(value, bytes, (CRC->CTRL & CRC_CTRL_TOT_M) >> CRC_CTRL_TOT_S);
+
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        Remainder ^= ((value >> (8 * i)) & 0xFF) << 24;
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            Remainder = (Remainder & 0x80000000) ? ((Remainder << 1) ^ CRC->POLY) : (Remainder << 1);
+        }
+    }
+}
+
+static void HAL_Host_CRC_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    (void)model;
+
+    if (Offset == offsetof(CRC_TypeDef, DATA32))
+    {
+        uint32_t value = HAL_Host_CRC_Transpose(Remainder, 4, (CRC->CTRL & CRC_CTRL_TOTR_M) >> CRC_CTRL_TOTR_S);
+        if (CRC->CTRL & CRC_CTRL_FXOR_M)
+        {
+            value = ~value;
+        }
+        CRC->DATA32 = value;
+    }
+}
+
+static void HAL_Host_CRC_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    (void)model;
+
+    switch (Offset)
+    {
+    case offsetof(CRC_TypeDef, DATA32):
+        if (CRC->CTRL & CRC_CTRL_WAS_M)
+        {
+            Remainder = CRC->DATA32;
+        }
+        else
+        {
+            HAL_Host_CRC_Feed(CRC->DATA32, 4);
+        }
+        break;
+    case offsetof(CRC_TypeDef, DATA16):
+        HAL_Host_CRC_Feed(CRC->DATA16, 2);
+        break;
+    case offsetof(CRC_TypeDef, DATA8):
+        HAL_Host_CRC_Feed(CRC->DATA8, 1);
+        break;
+    case offsetof(CRC_TypeDef, CTRL):
+        /* Расчет выполняется сразу при записи, флаг BUSY всегда сброшен */
+        CRC->CTRL &= ~CRC_CTRL_BUSY_M;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_CRC_Reset(HAL_Host_ModelTypeDef *model)
+{
+    (void)model;
+    Remainder = 0;
+}
+
+/**
+ * @brief Модель блока CRC32.
+ *
+ * Поля TOT/TOTR переставляют биты и байты значения так же, как драйвер задает RefIn/RefOut
+ * (CRC_REFIN_FALSE - перестановка байтов, CRC_REFIN_TRUE - битов и байтов). Запись DATA32 при WAS = 1
+ * задает начальное значение.
+ */
+HAL_Host_ModelTypeDef HAL_Host_CRC_Model =
+{
+    .Name = "CRC",
+    .Base = CRC_BASE_ADDRESS,
+    .Size = sizeof(CRC_TypeDef),
+    .Read = HAL_Host_CRC_Read,
+    .Write = HAL_Host_CRC_Write,
+    .Reset = HAL_Host_CRC_Reset,
+};
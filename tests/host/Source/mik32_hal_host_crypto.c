@@ -0,0 +1,268 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_crypto.h"
+#include "mik32_hal_crypto_ref.h"
+#include "mik32_hal_crc32_ref.h"
+
+
+/**
+ * @brief Состояние модели крипто-блока: накопленные слова ключа, вектора инициализации и блока,
+ *        сцепление режимов CBC/CTR и результат, выдаваемый чтением BLOCK.
+ */
+typedef struct
+{
+    uint8_t Key[CRYPTO_REF_KEY_BYTES_MAX];
+    uint32_t KeyCount;
+    uint8_t Iv[CRYPTO_REF_BLOCK_BYTES_MAX];
+    uint32_t IvCount;
+    uint8_t Chain[CRYPTO_REF_BLOCK_BYTES_MAX];
+    uint8_t In[CRYPTO_REF_BLOCK_BYTES_MAX];
+    uint32_t InCount;
+    uint8_t Out[CRYPTO_REF_BLOCK_BYTES_MAX];
+    uint32_t OutIndex;
+    uint32_t OutCount;
+    uint32_t Blocks;
+    Crypto_Ref_KeyTypeDef RefKey;
+} HAL_Host_Crypto_StateTypeDef;
+
+static HAL_Host_Crypto_StateTypeDef State;
+
+static uint32_t HAL_Host_Crypto_Config(uint32_t mask, uint32_t shift)
+{
+    return (CRYPTO->CONFIG & mask) >> shift;
+}
+
+/**
+ * @brief Перестановка слова (поле SWAP_MODE). Все перестановки обратны сами себе.
+ */
+static uint32_t HAL_Host_Crypto_Swap(uint32_t word)
+{
+    switch (HAL_Host_Crypto_Config(CRYPTO_CONFIG_SWAP_MODE_M, CRYPTO_CONFIG_SWAP_MODE_S))
+    {
+    case CRYPTO_SWAP_MODE_HALFWORD:
+        return (word >> 16) | (word << 16);
+    case CRYPTO_SWAP_MODE_BYTE:
+        return (word >> 24) | ((word >> 8) & 0xFF00) | ((word << 8) & 0xFF0000) | (word << 24);
+    case CRYPTO_SWAP_MODE_BIT:
+        return HAL_CRC_Ref_Reflect32(word);
+    default:
+        return word;
+    }
+}
+
+/**
+ * @brief Смещение слова с номером загрузки index в массиве байтов (первый байт - старший).
+ *        При ORDER_MODE_MSW первым загружается старшее слово, при ORDER_MODE_LSW - младшее.
+ */
+static uint32_t HAL_Host_Crypto_Position(uint32_t index, uint32_t words)
+{
+    if (HAL_Host_Crypto_Config(CRYPTO_CONFIG_ORDER_MODE_M, CRYPTO_CONFIG_ORDER_MODE_S) == CRYPTO_ORDER_MODE_LSW)
+    {
+        index = words - 1 - index;
+    }
+
+    return 4 * index;
+}
+
+static void HAL_Host_Crypto_Load(uint8_t bytes[], uint32_t index, uint32_t words, uint32_t word)
+{
+    uint8_t *position = &bytes[HAL_Host_Crypto_Position(index, words)];
+
+    word = HAL_Host_Crypto_Swap(word);
+    position[0] = (uint8_t)(word >> 24);
+    position[1] = (uint8_t)(word >> 16);
+    position[2] = (uint8_t)(word >> 8);
+    position[3] = (uint8_t)word;
+}
+
+static uint32_t HAL_Host_Crypto_Unload(const uint8_t bytes[], uint32_t index, uint32_t words)
+{
+    const uint8_t *position = &bytes[HAL_Host_Crypto_Position(index, words)];
+    uint32_t word = ((uint32_t)position[0] << 24) | ((uint32_t)position[1] << 16) | ((uint32_t)position[2] << 8) | position[3];
+
+    return HAL_Host_Crypto_Swap(word);
+}
+
+/**
+ * @brief Обработать загруженный блок в режиме MODE_SEL. Счетчик CTR - весь блок, старший байт первый.
+ */
+static void HAL_Host_Crypto_Process(uint32_t bytes)
+{
+    uint32_t decode = CRYPTO->CONFIG & CRYPTO_CONFIG_DECODE_M;
+
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        State.Out[i] = State.In[i];
+    }
+
+    switch (HAL_Host_Crypto_Config(CRYPTO_CONFIG_MODE_SEL_M, CRYPTO_CONFIG_MODE_SEL_S))
+    {
+    case CRYPTO_CIPHER_MODE_ECB:
+        if (decode)
+        {
+            HAL_Crypto_Ref_DecryptBlock(&State.RefKey, State.Out);
+        }
+        else
+        {
+            HAL_Crypto_Ref_EncryptBlock(&State.RefKey, State.Out);
+        }
+        break;
+    case CRYPTO_CIPHER_MODE_CBC:
+        if (decode)
+        {
+            HAL_Crypto_Ref_DecryptBlock(&State.RefKey, State.Out);
+            for (uint32_t i = 0; i < bytes; i++)
+            {
+                State.Out[i] ^= State.Chain[i];
+                State.Chain[i] = State.In[i];
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < bytes; i++)
+            {
+                State.Out[i] ^= State.Chain[i];
+            }
+            HAL_Crypto_Ref_EncryptBlock(&State.RefKey, State.Out);
+            for (uint32_t i = 0; i < bytes; i++)
+            {
+                State.Chain[i] = State.Out[i];
+            }
+        }
+        break;
+    case CRYPTO_CIPHER_MODE_CTR:
+    {
+        uint8_t gamma[CRYPTO_REF_BLOCK_BYTES_MAX];
+
+        for (uint32_t i = 0; i < bytes; i++)
+        {
+            gamma[i] = State.Chain[i];
+        }
+        HAL_Crypto_Ref_EncryptBlock(&State.RefKey, gamma);
+        for (uint32_t i = 0; i < bytes; i++)
+        {
+            State.Out[i] ^= gamma[i];
+        }
+        for (uint32_t i = bytes; i > 0; i--)
+        {
+            if (++State.Chain[i - 1] != 0)
+            {
+                break;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    State.Blocks++;
+}
+
+static void HAL_Host_Crypto_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    (void)model;
+
+    switch (Offset)
+    {
+    case offsetof(CRYPTO_TypeDef, BLOCK):
+        /* Слова результата выдаются по одному на чтение */
+        if (State.OutIndex < State.OutCount)
+        {
+            CRYPTO->BLOCK = HAL_Host_Crypto_Unload(State.Out, State.OutIndex++, State.OutCount);
+        }
+        break;
+    case offsetof(CRYPTO_TypeDef, CONFIG):
+        /* Расчет выполняется сразу при загрузке, блок всегда готов */
+        CRYPTO->CONFIG |= CRYPTO_CONFIG_READY_M;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_Crypto_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    uint8_t algorithm = (uint8_t)HAL_Host_Crypto_Config(CRYPTO_CONFIG_CORE_SEL_M, CRYPTO_CONFIG_CORE_SEL_S);
+    uint32_t block_words = HAL_Crypto_Ref_BlockBytes(algorithm) / 4;
+    uint32_t key_words = HAL_Crypto_Ref_KeyBytes(algorithm) / 4;
+    (void)model;
+
+    switch (Offset)
+    {
+    case offsetof(CRYPTO_TypeDef, KEY):
+        HAL_Host_Crypto_Load(State.Key, State.KeyCount++, key_words, CRYPTO->KEY);
+        if (State.KeyCount >= key_words)
+        {
+            HAL_Crypto_Ref_SetKey(&State.RefKey, algorithm, State.Key);
+            State.KeyCount = 0;
+        }
+        break;
+    case offsetof(CRYPTO_TypeDef, INIT):
+        HAL_Host_Crypto_Load(State.Iv, State.IvCount++, block_words, CRYPTO->INIT);
+        if (State.IvCount >= block_words)
+        {
+            for (uint32_t i = 0; i < 4 * block_words; i++)
+            {
+                State.Chain[i] = State.Iv[i];
+            }
+            State.IvCount = 0;
+        }
+        break;
+    case offsetof(CRYPTO_TypeDef, BLOCK):
+        HAL_Host_Crypto_Load(State.In, State.InCount++, block_words, CRYPTO->BLOCK);
+        if (State.InCount >= block_words)
+        {
+            HAL_Host_Crypto_Process(4 * block_words);
+            State.InCount = 0;
+            State.OutIndex = 0;
+            State.OutCount = block_words;
+        }
+        break;
+    case offsetof(CRYPTO_TypeDef, CONFIG):
+        if (CRYPTO->CONFIG & CRYPTO_CONFIG_C_RESET_M)
+        {
+            State.KeyCount = 0;
+            State.IvCount = 0;
+            State.InCount = 0;
+            State.OutIndex = State.OutCount;
+            CRYPTO->CONFIG &= ~CRYPTO_CONFIG_C_RESET_M;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_Crypto_Reset(HAL_Host_ModelTypeDef *model)
+{
+    (void)model;
+    State = (HAL_Host_Crypto_StateTypeDef){0};
+}
+
+/**
+ * @brief Количество блоков, обработанных после @ref HAL_Host_Init.
+ */
+uint32_t HAL_Host_Crypto_GetBlocks(void)
+{
+    return State.Blocks;
+}
+
+/**
+ * @brief Модель крипто-блока.
+ *
+ * Шифры рассчитываются эталонным модулем mik32_hal_crypto_ref. Слова KEY, INIT и BLOCK накапливаются
+ * до длины ключа или блока выбранного алгоритма; порядок слов задает ORDER_MODE, перестановку в слове -
+ * SWAP_MODE. Режим CTR использует INIT (половина блока и нули) как счетчик на весь блок. Блок
+ * обрабатывается сразу после загрузки последнего слова, READY всегда установлен.
+ */
+HAL_Host_ModelTypeDef HAL_Host_Crypto_Model =
+{
+    .Name = "CRYPTO",
+    .Base = CRYPTO_BASE_ADDRESS,
+    .Size = sizeof(CRYPTO_TypeDef),
+    .Read = HAL_Host_Crypto_Read,
+    .Write = HAL_Host_Crypto_Write,
+    .Reset = HAL_Host_Crypto_Reset,
+};
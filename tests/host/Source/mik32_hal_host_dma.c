@@ -0,0 +1,254 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "dma_config.h"
+
+
+/**
+ * @brief Состояние канала модели DMA.
+ */
+typedef struct
+{
+    int Busy;               /* Канал выполняет пересылку */
+    int Irq;                /* Флаг локального прерывания */
+    int BusError;           /* Ошибка на шине: адрес источника или назначения вне памяти программы */
+    uint32_t Done;          /* Переслано байт */
+    uint32_t Src;           /* Адрес источника при запуске */
+    uint32_t Dst;           /* Адрес назначения при запуске */
+} HAL_Host_DMA_ChannelTypeDef;
+
+static HAL_Host_DMA_ChannelTypeDef Channels[DMA_CHANNEL_COUNT];
+static uint32_t Config;
+static int GlobalIrq;
+static int ErrorIrq;
+
+/**
+ * @brief Переслать байт канала с учетом инкремента и разрядности источника и назначения.
+ */
+static void HAL_Host_DMA_MoveByte(DMA_CHANNEL_TypeDef *regs, HAL_Host_DMA_ChannelTypeDef *channel, uint32_t index)
+{
+    uint32_t cfg = regs->CFG;
+    uint32_t read_size = 1U << ((cfg & DMA_CH_CFG_READ_SIZE_M) >> DMA_CH_CFG_READ_SIZE_S);
+    uint32_t write_size = 1U << ((cfg & DMA_CH_CFG_WRITE_SIZE_M) >> DMA_CH_CFG_WRITE_SIZE_S);
+    uint32_t src = channel->Src + ((cfg & DMA_CH_CFG_READ_INCREMENT_M) ? index : (index % read_size));
+    uint32_t dst = channel->Dst + ((cfg & DMA_CH_CFG_WRITE_INCREMENT_M) ? index : (index % write_size));
+
+    *(volatile uint8_t *)(uintptr_t)dst = *(volatile uint8_t *)(uintptr_t)src;
+}
+
+/**
+ * @brief Переслать Count байт канала и завершить пересылку после последнего.
+ */
+static void HAL_Host_DMA_Transfer(uint32_t index, uint32_t Count)
+{
+    DMA_CHANNEL_TypeDef *regs = &DMA_CONFIG->CHANNELS[index];
+    HAL_Host_DMA_ChannelTypeDef *channel = &Channels[index];
+    uint32_t length = regs->LEN + 1;
+
+    while ((Count-- != 0) && (channel->Done < length))
+    {
+        HAL_Host_DMA_MoveByte(regs, channel, channel->Done++);
+    }
+
+    if (channel->Done >= length)
+    {
+        channel->Busy = 0;
+        if (regs->CFG & DMA_CH_CFG_IRQ_EN_M)
+        {
+            channel->Irq = 1;
+            GlobalIrq = 1;
+        }
+    }
+}
+
+/**
+ * @brief Запуск канала записью CFG с битом ENABLE.
+ *
+ * Пересылка память - память выполняется сразу. Если источник или назначение - периферия, канал ждет
+ * запросов @ref HAL_Host_DMA_Request.
+ */
+static void HAL_Host_DMA_Start(uint32_t index)
+{
+    DMA_CHANNEL_TypeDef *regs = &DMA_CONFIG->CHANNELS[index];
+    HAL_Host_DMA_ChannelTypeDef *channel = &Channels[index];
+    uint32_t cfg = regs->CFG;
+
+    if ((cfg & DMA_CH_CFG_ENABLE_M) == 0)
+    {
+        channel->Busy = 0;
+        return;
+    }
+
+    if (channel->Busy)
+    {
+        return;
+    }
+
+    if ((regs->SRC < 0x1000) || (regs->DST < 0x1000))
+    {
+        channel->BusError = 1;
+        ErrorIrq = 1;
+        return;
+    }
+
+    channel->Busy = 1;
+    channel->Done = 0;
+    channel->Src = regs->SRC;
+    channel->Dst = regs->DST;
+
+    if ((cfg & DMA_CH_CFG_READ_MODE_M) && (cfg & DMA_CH_CFG_WRITE_MODE_M))
+    {
+        HAL_Host_DMA_Transfer(index, regs->LEN + 1);
+    }
+}
+
+static void HAL_Host_DMA_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    (void)model;
+
+    uint32_t index = Offset / sizeof(DMA_CHANNEL_TypeDef);
+    uint32_t field = Offset % sizeof(DMA_CHANNEL_TypeDef);
+    if ((index < DMA_CHANNEL_COUNT) && !(Config & DMA_CONFIG_CURRENT_VALUE_M) && (Channels[index].Src != 0)
+        && ((field == offsetof(DMA_CHANNEL_TypeDef, SRC)) || (field == offsetof(DMA_CHANNEL_TypeDef, DST))))
+    {
+        /* Текущий адрес: адрес запуска плюс количество пересланных байт при инкременте */
+        DMA_CHANNEL_TypeDef *regs = &DMA_CONFIG->CHANNELS[index];
+        HAL_Host_DMA_ChannelTypeDef *channel = &Channels[index];
+
+        if (field == offsetof(DMA_CHANNEL_TypeDef, SRC))
+        {
+            regs->SRC = channel->Src + ((regs->CFG & DMA_CH_CFG_READ_INCREMENT_M) ? channel->Done : 0);
+        }
+        else
+        {
+            regs->DST = channel->Dst + ((regs->CFG & DMA_CH_CFG_WRITE_INCREMENT_M) ? channel->Done : 0);
+        }
+        return;
+    }
+
+    if (Offset == offsetof(DMA_CONFIG_TypeDef, CONFIG_STATUS))
+    {
+        uint32_t status = 0;
+        for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+        {
+            status |= (Channels[i].Busy ? 0 : 1U) << (DMA_STATUS_READY_S + i);
+            status |= (Channels[i].Irq ? 1U : 0) << (DMA_STATUS_CHANNEL_IRQ_S + i);
+            status |= (Channels[i].BusError ? 1U : 0) << (DMA_STATUS_CHANNEL_BUS_ERROR_S + i);
+        }
+        status |= GlobalIrq ? DMA_STATUS_GLOBAL_IRQ_M : 0;
+        status |= ErrorIrq ? DMA_STATUS_ERROR_IRQ_M : 0;
+        DMA_CONFIG->CONFIG_STATUS = status;
+    }
+}
+
+static void HAL_Host_DMA_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    (void)model;
+
+    if (Offset == offsetof(DMA_CONFIG_TypeDef, CONFIG_STATUS))
+    {
+        uint32_t value = DMA_CONFIG->CONFIG_STATUS;
+
+        Config = value & (DMA_CONFIG_GLOBAL_IRQ_ENA_M | DMA_CONFIG_ERROR_IRQ_ENA_M | DMA_CONFIG_CURRENT_VALUE_M);
+        if (value & DMA_CONFIG_CLEAR_LOCAL_IRQ_M)
+        {
+            for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+            {
+                Channels[i].Irq = 0;
+            }
+        }
+        if (value & DMA_CONFIG_CLEAR_GLOBAL_IRQ_M)
+        {
+            GlobalIrq = 0;
+        }
+        if (value & DMA_CONFIG_CLEAR_ERROR_IRQ_M)
+        {
+            ErrorIrq = 0;
+            for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+            {
+                Channels[i].BusError = 0;
+            }
+        }
+        return;
+    }
+
+    uint32_t index = Offset / sizeof(DMA_CHANNEL_TypeDef);
+    if ((index < DMA_CHANNEL_COUNT) && ((Offset % sizeof(DMA_CHANNEL_TypeDef)) == offsetof(DMA_CHANNEL_TypeDef, CFG)))
+    {
+        HAL_Host_DMA_Start(index);
+    }
+}
+
+static void HAL_Host_DMA_Reset(HAL_Host_ModelTypeDef *model)
+{
+    (void)model;
+
+    for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+    {
+        Channels[i] = (HAL_Host_DMA_ChannelTypeDef){0};
+    }
+    Config = 0;
+    GlobalIrq = 0;
+    ErrorIrq = 0;
+}
+
+/**
+ * @brief Запрос периферийной линии: каждый ожидающий его канал пересылает одно слово своей разрядности.
+ * @param Request Номер линии (DMA_CHANNEL_*_REQUEST).
+ */
+void HAL_Host_DMA_Request(uint32_t Request)
+{
+    HAL_Host_Unlock();
+
+    for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+    {
+        uint32_t cfg = DMA_CONFIG->CHANNELS[i].CFG;
+
+        if (!Channels[i].Busy)
+        {
+            continue;
+        }
+
+        if (((cfg & DMA_CH_CFG_WRITE_MODE_M) == 0) && (((cfg & DMA_CH_CFG_WRITE_REQUEST_M) >> DMA_CH_CFG_WRITE_REQUEST_S) == Request))
+        {
+            HAL_Host_DMA_Transfer(i, 1U << ((cfg & DMA_CH_CFG_WRITE_SIZE_M) >> DMA_CH_CFG_WRITE_SIZE_S));
+        }
+        else if (((cfg & DMA_CH_CFG_READ_MODE_M) == 0) && (((cfg & DMA_CH_CFG_READ_REQUEST_M) >> DMA_CH_CFG_READ_REQUEST_S) == Request))
+        {
+            HAL_Host_DMA_Transfer(i, 1U << ((cfg & DMA_CH_CFG_READ_SIZE_M) >> DMA_CH_CFG_READ_SIZE_S));
+        }
+    }
+
+    HAL_Host_Lock();
+}
+
+/**
+ * @brief Маска каналов, выполняющих пересылку.
+ */
+uint32_t HAL_Host_DMA_GetBusyMask(void)
+{
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < DMA_CHANNEL_COUNT; i++)
+    {
+        mask |= (Channels[i].Busy ? 1U : 0) << i;
+    }
+    return mask;
+}
+
+/**
+ * @brief Модель контроллера DMA.
+ *
+ * Запись CFG с битом ENABLE в свободный канал запускает пересылку LEN + 1 байт: память - память сразу,
+ * с периферией - по одному слову на запрос линии. Запись DMA в регистры других моделей их обработчики
+ * не вызывает. Чтение CONFIG_STATUS возвращает готовность, флаги прерываний и ошибки каналов. При CURRENT_VALUE = 0
+ * чтение SRC и DST запущенного канала возвращает текущие адреса.
+ */
+HAL_Host_ModelTypeDef HAL_Host_DMA_Model =
+{
+    .Name = "DMA",
+    .Base = DMA_CONFIG_BASE_ADDRESS,
+    .Size = sizeof(DMA_CONFIG_TypeDef),
+    .Read = HAL_Host_DMA_Read,
+    .Write = HAL_Host_DMA_Write,
+    .Reset = HAL_Host_DMA_Reset,
+};
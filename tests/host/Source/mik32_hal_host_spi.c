@@ -0,0 +1,203 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "spi.h"
+
+
+#define HOST_SPI_FIFO_SIZE      8
+#define HOST_SPI_MODULE_ID      0x01090100
+#define HOST_SPI_IDLE_LINE      0xFF    /* Уровень MISO без ведомого */
+
+/**
+ * @brief Состояние модели SPI: буферы TX_FIFO и RX_FIFO, флаги, сбрасываемые чтением, и ведомое устройство.
+ */
+typedef struct
+{
+    uint8_t Tx[HOST_SPI_FIFO_SIZE];
+    uint32_t TxCount;
+    uint8_t Rx[HOST_SPI_FIFO_SIZE];
+    uint32_t RxHead;
+    uint32_t RxCount;
+    uint32_t Sticky;
+    uint32_t Shifted;
+    HAL_Host_SPI_SlaveTypeDef Slave;
+} HAL_Host_SPI_StateTypeDef;
+
+static HAL_Host_SPI_StateTypeDef State[2];
+
+static uint32_t HAL_Host_SPI_Index(HAL_Host_ModelTypeDef *model)
+{
+    return (uint32_t)(model - HAL_Host_SPI_Model);
+}
+
+static HAL_Host_SPI_StateTypeDef *HAL_Host_SPI_Find(SPI_TypeDef *spi)
+{
+    return &State[(spi == SPI_0) ? 0 : 1];
+}
+
+/**
+ * @brief Передать байты TX_FIFO ведомому, если модуль включен в режиме ведущего. Ответ ведомого
+ *        помещается в RX_FIFO, при заполненном RX_FIFO байт теряется и устанавливается RX_OVERFLOW.
+ */
+static void HAL_Host_SPI_Shift(SPI_TypeDef *spi, HAL_Host_SPI_StateTypeDef *state)
+{
+    if (!(spi->ENABLE & SPI_ENABLE_M) || !(spi->CONFIG & SPI_CONFIG_MASTER_M))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < state->TxCount; i++)
+    {
+        uint8_t received = (state->Slave != NULL) ? state->Slave(state->Tx[i]) : HOST_SPI_IDLE_LINE;
+
+        if (state->RxCount < HOST_SPI_FIFO_SIZE)
+        {
+            state->Rx[(state->RxHead + state->RxCount) % HOST_SPI_FIFO_SIZE] = received;
+            state->RxCount++;
+        }
+        else
+        {
+            state->Sticky |= SPI_INT_STATUS_RX_OVERFLOW_M;
+        }
+        state->Shifted++;
+    }
+    state->TxCount = 0;
+}
+
+static void HAL_Host_SPI_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    SPI_TypeDef *spi = (SPI_TypeDef *)model->Base;
+    HAL_Host_SPI_StateTypeDef *state = &State[HAL_Host_SPI_Index(model)];
+
+    switch (Offset)
+    {
+    case offsetof(SPI_TypeDef, INT_STATUS):
+    {
+        uint32_t status = state->Sticky;
+        if (state->TxCount < spi->TX_THR)
+        {
+            status |= SPI_INT_STATUS_TX_FIFO_NOT_FULL_M;
+        }
+        if (state->TxCount == HOST_SPI_FIFO_SIZE)
+        {
+            status |= SPI_INT_STATUS_TX_FIFO_FULL_M;
+        }
+        if (state->RxCount != 0)
+        {
+            status |= SPI_INT_STATUS_RX_FIFO_NOT_EMPTY_M;
+        }
+        if (state->RxCount == HOST_SPI_FIFO_SIZE)
+        {
+            status |= SPI_INT_STATUS_RX_FIFO_FULL_M;
+        }
+        spi->INT_STATUS = status;
+        /* RX_OVERFLOW и MODE_FAIL сбрасываются чтением */
+        state->Sticky = 0;
+        break;
+    }
+    case offsetof(SPI_TypeDef, RXDATA):
+        if (state->RxCount != 0)
+        {
+            spi->RXDATA = state->Rx[state->RxHead];
+            state->RxHead = (state->RxHead + 1) % HOST_SPI_FIFO_SIZE;
+            state->RxCount--;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_SPI_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    SPI_TypeDef *spi = (SPI_TypeDef *)model->Base;
+    HAL_Host_SPI_StateTypeDef *state = &State[HAL_Host_SPI_Index(model)];
+
+    switch (Offset)
+    {
+    case offsetof(SPI_TypeDef, ENABLE):
+        if (spi->ENABLE & SPI_ENABLE_CLEAR_TX_FIFO_M)
+        {
+            state->TxCount = 0;
+        }
+        if (spi->ENABLE & SPI_ENABLE_CLEAR_RX_FIFO_M)
+        {
+            state->RxCount = 0;
+            state->RxHead = 0;
+        }
+        spi->ENABLE &= ~(SPI_ENABLE_CLEAR_TX_FIFO_M | SPI_ENABLE_CLEAR_RX_FIFO_M);
+        HAL_Host_SPI_Shift(spi, state);
+        break;
+    case offsetof(SPI_TypeDef, TXDATA):
+        if (state->TxCount < HOST_SPI_FIFO_SIZE)
+        {
+            state->Tx[state->TxCount++] = (uint8_t)spi->TXDATA;
+        }
+        HAL_Host_SPI_Shift(spi, state);
+        break;
+    case offsetof(SPI_TypeDef, INT_ENABLE):
+        spi->INT_MASK |= spi->INT_ENABLE;
+        spi->INT_ENABLE = 0;
+        break;
+    case offsetof(SPI_TypeDef, INT_DISABLE):
+        spi->INT_MASK &= ~spi->INT_DISABLE;
+        spi->INT_DISABLE = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_SPI_Reset(HAL_Host_ModelTypeDef *model)
+{
+    SPI_TypeDef *spi = (SPI_TypeDef *)model->Base;
+
+    State[HAL_Host_SPI_Index(model)] = (HAL_Host_SPI_StateTypeDef){0};
+    spi->ID = HOST_SPI_MODULE_ID;
+}
+
+/**
+ * @brief Подключить модель ведомого устройства.
+ * @param spi Модуль SPI_0 или SPI_1.
+ * @param Slave Функция, возвращающая байт ответа на переданный байт. NULL - на линии MISO 0xFF.
+ */
+void HAL_Host_SPI_SetSlave(SPI_TypeDef *spi, HAL_Host_SPI_SlaveTypeDef Slave)
+{
+    HAL_Host_SPI_Find(spi)->Slave = Slave;
+}
+
+/**
+ * @brief Количество байтов, переданных ведомому после @ref HAL_Host_Init.
+ */
+uint32_t HAL_Host_SPI_GetShifted(SPI_TypeDef *spi)
+{
+    return HAL_Host_SPI_Find(spi)->Shifted;
+}
+
+/**
+ * @brief Модели модулей SPI_0, SPI_1 в режиме ведущего.
+ *
+ * Обмен выполняется сразу при записи TXDATA или включении модуля: каждый байт TX_FIFO передается
+ * ведомому, ответ помещается в RX_FIFO. Поэтому TX_FIFO включенного модуля всегда пуст.
+ * Флаги INT_STATUS вычисляются при чтении, RX_OVERFLOW сбрасывается чтением INT_STATUS.
+ * Запись INT_ENABLE и INT_DISABLE изменяет INT_MASK.
+ */
+HAL_Host_ModelTypeDef HAL_Host_SPI_Model[2] =
+{
+    {
+        .Name = "SPI_0",
+        .Base = SPI_0_BASE_ADDRESS,
+        .Size = sizeof(SPI_TypeDef),
+        .Read = HAL_Host_SPI_Read,
+        .Write = HAL_Host_SPI_Write,
+        .Reset = HAL_Host_SPI_Reset,
+    },
+    {
+        .Name = "SPI_1",
+        .Base = SPI_1_BASE_ADDRESS,
+        .Size = sizeof(SPI_TypeDef),
+        .Read = HAL_Host_SPI_Read,
+        .Write = HAL_Host_SPI_Write,
+        .Reset = HAL_Host_SPI_Reset,
+    },
+};
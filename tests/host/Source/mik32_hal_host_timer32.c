@@ -0,0 +1,211 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "timer32.h"
+
+
+#define HOST_TIMER32_CHANNELS       4
+#define HOST_TIMER32_MODE_COMPARE   0b01
+
+/**
+ * @brief Состояние модели Timer32: регистры, доступные только для чтения.
+ */
+typedef struct
+{
+    uint32_t Value;
+    uint32_t Flags;
+} HAL_Host_Timer32_StateTypeDef;
+
+static HAL_Host_Timer32_StateTypeDef State[3];
+
+static uint32_t HAL_Host_Timer32_Index(HAL_Host_ModelTypeDef *model)
+{
+    return (uint32_t)(model - HAL_Host_Timer32_Model);
+}
+
+static HAL_Host_ModelTypeDef *HAL_Host_Timer32_Find(TIMER32_TypeDef *timer)
+{
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (HAL_Host_Timer32_Model[i].Base == (uintptr_t)timer)
+        {
+            return &HAL_Host_Timer32_Model[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void HAL_Host_Timer32_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    TIMER32_TypeDef *timer = (TIMER32_TypeDef *)model->Base;
+    HAL_Host_Timer32_StateTypeDef *state = &State[HAL_Host_Timer32_Index(model)];
+
+    if (Offset == offsetof(TIMER32_TypeDef, VALUE))
+    {
+        timer->VALUE = state->Value;
+    }
+    else if (Offset == offsetof(TIMER32_TypeDef, INT_FLAGS))
+    {
+        timer->INT_FLAGS = state->Flags;
+    }
+}
+
+static void HAL_Host_Timer32_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    TIMER32_TypeDef *timer = (TIMER32_TypeDef *)model->Base;
+    HAL_Host_Timer32_StateTypeDef *state = &State[HAL_Host_Timer32_Index(model)];
+
+    switch (Offset)
+    {
+    case offsetof(TIMER32_TypeDef, ENABLE):
+        if (timer->ENABLE & TIMER32_ENABLE_TIM_CLR_M)
+        {
+            state->Value = 0;
+            timer->ENABLE &= ~TIMER32_ENABLE_TIM_CLR_M;
+        }
+        break;
+    case offsetof(TIMER32_TypeDef, INT_CLEAR):
+        state->Flags &= ~timer->INT_CLEAR;
+        timer->INT_CLEAR = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_Timer32_Reset(HAL_Host_ModelTypeDef *model)
+{
+    State[HAL_Host_Timer32_Index(model)] = (HAL_Host_Timer32_StateTypeDef){0};
+}
+
+/**
+ * @brief Количество тактов от значения счетчика до следующего достижения значения target.
+ */
+static uint64_t HAL_Host_Timer32_Distance(uint32_t value, uint32_t target, uint32_t top)
+{
+    if (target > value)
+    {
+        return target - value;
+    }
+
+    return ((uint64_t)top - value + 1) + target;
+}
+
+/**
+ * @brief Продвинуть счетчик таймера.
+ *
+ * Счетчик считает вперед от 0 до TOP, предделитель не учитывается: один такт - одно изменение VALUE.
+ * При переходе TOP -> 0 устанавливается флаг переполнения, при равенстве VALUE и OCR включенного канала
+ * сравнения - флаг OC канала. Продвижение останавливается, как только установлен разрешенный в INT_MASK флаг.
+ * @param timer Таймер TIMER32_0, TIMER32_1 или TIMER32_2.
+ * @param Ticks Наибольшее количество тактов.
+ * @return Количество пройденных тактов. Если таймер остановлен, время проходит без счета и возвращается Ticks.
+ */
+uint32_t HAL_Host_Timer32_Run(TIMER32_TypeDef *timer, uint32_t Ticks)
+{
+    HAL_Host_ModelTypeDef *model = HAL_Host_Timer32_Find(timer);
+    HAL_Host_Timer32_StateTypeDef *state = &State[HAL_Host_Timer32_Index(model)];
+    uint32_t elapsed = 0;
+
+    HAL_Host_Unlock();
+
+    while ((elapsed < Ticks) && (timer->ENABLE & TIMER32_ENABLE_TIM_EN_M) && ((state->Flags & timer->INT_MASK) == 0))
+    {
+        uint32_t top = timer->TOP;
+        uint64_t step = HAL_Host_Timer32_Distance(state->Value, 0, top);
+
+        for (uint32_t i = 0; i < HOST_TIMER32_CHANNELS; i++)
+        {
+            uint32_t cntrl = timer->CHANNELS[i].CNTRL;
+            if ((cntrl & TIMER32_CH_CNTRL_ENABLE_M) && (((cntrl & TIMER32_CH_CNTRL_MODE_M) >> TIMER32_CH_CNTRL_MODE_S) == HOST_TIMER32_MODE_COMPARE)
+                && (timer->CHANNELS[i].OCR <= top))
+            {
+                uint64_t distance = HAL_Host_Timer32_Distance(state->Value, timer->CHANNELS[i].OCR, top);
+                step = (distance < step) ? distance : step;
+            }
+        }
+
+        if (step > Ticks - elapsed)
+        {
+            state->Value += Ticks - elapsed;
+            elapsed = Ticks;
+            break;
+        }
+
+        elapsed += (uint32_t)step;
+        state->Value = (uint32_t)(((uint64_t)state->Value + step) % ((uint64_t)top + 1));
+
+        if (state->Value == 0)
+        {
+            state->Flags |= TIMER32_INT_OVERFLOW_M;
+        }
+        for (uint32_t i = 0; i < HOST_TIMER32_CHANNELS; i++)
+        {
+            uint32_t cntrl = timer->CHANNELS[i].CNTRL;
+            if ((cntrl & TIMER32_CH_CNTRL_ENABLE_M) && (((cntrl & TIMER32_CH_CNTRL_MODE_M) >> TIMER32_CH_CNTRL_MODE_S) == HOST_TIMER32_MODE_COMPARE)
+                && (timer->CHANNELS[i].OCR == state->Value))
+            {
+                state->Flags |= TIMER32_INT_OC_M(i);
+            }
+        }
+    }
+
+    if (!(timer->ENABLE & TIMER32_ENABLE_TIM_EN_M))
+    {
+        elapsed = Ticks;
+    }
+
+    HAL_Host_Lock();
+
+    return elapsed;
+}
+
+/**
+ * @brief Проверить, установлен ли флаг прерывания таймера, разрешенный в INT_MASK.
+ */
+int HAL_Host_Timer32_IsPending(TIMER32_TypeDef *timer)
+{
+    HAL_Host_ModelTypeDef *model = HAL_Host_Timer32_Find(timer);
+    int pending;
+
+    HAL_Host_Unlock();
+    pending = (State[HAL_Host_Timer32_Index(model)].Flags & timer->INT_MASK) != 0;
+    HAL_Host_Lock();
+
+    return pending;
+}
+
+/**
+ * @brief Модели таймеров TIMER32_0, TIMER32_1, TIMER32_2.
+ *
+ * VALUE и INT_FLAGS доступны только для чтения и изменяются @ref HAL_Host_Timer32_Run. Запись TIM_CLR
+ * обнуляет счетчик, запись INT_CLEAR сбрасывает флаги.
+ */
+HAL_Host_ModelTypeDef HAL_Host_Timer32_Model[3] =
+{
+    {
+        .Name = "TIMER32_0",
+        .Base = TIMER32_0_BASE_ADDRESS,
+        .Size = sizeof(TIMER32_TypeDef),
+        .Read = HAL_Host_Timer32_Read,
+        .Write = HAL_Host_Timer32_Write,
+        .Reset = HAL_Host_Timer32_Reset,
+    },
+    {
+        .Name = "TIMER32_1",
+        .Base = TIMER32_1_BASE_ADDRESS,
+        .Size = sizeof(TIMER32_TypeDef),
+        .Read = HAL_Host_Timer32_Read,
+        .Write = HAL_Host_Timer32_Write,
+        .Reset = HAL_Host_Timer32_Reset,
+    },
+    {
+        .Name = "TIMER32_2",
+        .Base = TIMER32_2_BASE_ADDRESS,
+        .Size = sizeof(TIMER32_TypeDef),
+        .Read = HAL_Host_Timer32_Read,
+        .Write = HAL_Host_Timer32_Write,
+        .Reset = HAL_Host_Timer32_Reset,
+    },
+};
@@ -0,0 +1,188 @@
+#include <stddef.h>
+
+#include "mik32_hal_host.h"
+#include "uart.h"
+
+
+/* Флаги, сбрасываемые записью 1 в FLAGS. RXNE сбрасывается чтением RXDATA, TXE - не сбрасывается */
+#define HOST_USART_FLAGS_W1C    (UART_FLAGS_PE_M | UART_FLAGS_FE_M | UART_FLAGS_NF_M | UART_FLAGS_ORE_M | UART_FLAGS_IDLE_M | \
+                                 UART_FLAGS_TC_M | UART_FLAGS_LBDF_M | UART_FLAGS_CTSIF_M)
+
+/**
+ * @brief Состояние модели USART: флаги, принятый байт и линия TX.
+ */
+typedef struct
+{
+    uint32_t Flags;
+    uint32_t Rx;
+    uint32_t Transmitted;
+    HAL_Host_USART_LineTypeDef Line;
+} HAL_Host_USART_StateTypeDef;
+
+static HAL_Host_USART_StateTypeDef State[2];
+
+static uint32_t HAL_Host_USART_Index(HAL_Host_ModelTypeDef *model)
+{
+    return (uint32_t)(model - HAL_Host_USART_Model);
+}
+
+static HAL_Host_USART_StateTypeDef *HAL_Host_USART_Find(UART_TypeDef *uart)
+{
+    return &State[(uart == UART_0) ? 0 : 1];
+}
+
+static uint32_t HAL_Host_USART_Enabled(UART_TypeDef *uart, uint32_t direction)
+{
+    return (uart->CONTROL1 & (UART_CONTROL1_UE_M | direction)) == (UART_CONTROL1_UE_M | direction);
+}
+
+/**
+ * @brief Прием байта включенным приемником. Если предыдущий байт не прочитан, устанавливается ORE
+ *        и байт теряется, при OVRDIS байт перезаписывается.
+ */
+static void HAL_Host_USART_Deliver(UART_TypeDef *uart, HAL_Host_USART_StateTypeDef *state, uint32_t data)
+{
+    if (!HAL_Host_USART_Enabled(uart, UART_CONTROL1_RE_M))
+    {
+        return;
+    }
+
+    if ((state->Flags & UART_FLAGS_RXNE_M) && !(uart->CONTROL3 & UART_CONTROL3_OVRDIS_M))
+    {
+        state->Flags |= UART_FLAGS_ORE_M;
+        return;
+    }
+
+    state->Rx = data;
+    state->Flags |= UART_FLAGS_RXNE_M;
+}
+
+static void HAL_Host_USART_Read(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    UART_TypeDef *uart = (UART_TypeDef *)model->Base;
+    HAL_Host_USART_StateTypeDef *state = &State[HAL_Host_USART_Index(model)];
+
+    switch (Offset)
+    {
+    case offsetof(UART_TypeDef, FLAGS):
+    {
+        uint32_t flags = state->Flags;
+        if (HAL_Host_USART_Enabled(uart, UART_CONTROL1_TE_M))
+        {
+            flags |= UART_FLAGS_TEACK_M;
+        }
+        if (HAL_Host_USART_Enabled(uart, UART_CONTROL1_RE_M))
+        {
+            flags |= UART_FLAGS_REACK_M;
+        }
+        uart->FLAGS = flags;
+        break;
+    }
+    case offsetof(UART_TypeDef, RXDATA):
+        uart->RXDATA = state->Rx;
+        state->Flags &= ~UART_FLAGS_RXNE_M;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_USART_Write(HAL_Host_ModelTypeDef *model, uint32_t Offset)
+{
+    UART_TypeDef *uart = (UART_TypeDef *)model->Base;
+    HAL_Host_USART_StateTypeDef *state = &State[HAL_Host_USART_Index(model)];
+
+    switch (Offset)
+    {
+    case offsetof(UART_TypeDef, TXDATA):
+        if (HAL_Host_USART_Enabled(uart, UART_CONTROL1_TE_M))
+        {
+            uint32_t data = uart->TXDATA & 0x1FF;
+
+            state->Transmitted++;
+            if (state->Line != NULL)
+            {
+                state->Line(data);
+            }
+            if (uart->CONTROL2 & UART_CONTROL2_LBM_M)
+            {
+                HAL_Host_USART_Deliver(uart, state, data);
+            }
+            state->Flags |= UART_FLAGS_TC_M;
+        }
+        else
+        {
+            /* Передатчик выключен: данные не передаются, TC не установится */
+            state->Flags &= ~UART_FLAGS_TC_M;
+        }
+        break;
+    case offsetof(UART_TypeDef, FLAGS):
+        state->Flags &= ~(uart->FLAGS & HOST_USART_FLAGS_W1C);
+        uart->FLAGS = state->Flags;
+        break;
+    default:
+        break;
+    }
+}
+
+static void HAL_Host_USART_Reset(HAL_Host_ModelTypeDef *model)
+{
+    State[HAL_Host_USART_Index(model)] = (HAL_Host_USART_StateTypeDef){.Flags = UART_FLAGS_TXE_M | UART_FLAGS_TC_M};
+}
+
+/**
+ * @brief Подключить модель линии TX.
+ * @param uart Модуль UART_0 или UART_1.
+ * @param Line Функция, вызываемая для каждого переданного байта. NULL - байты не наблюдаются.
+ */
+void HAL_Host_USART_SetLine(UART_TypeDef *uart, HAL_Host_USART_LineTypeDef Line)
+{
+    HAL_Host_USART_Find(uart)->Line = Line;
+}
+
+/**
+ * @brief Принять байт с линии RX (событие со стороны внешнего устройства).
+ * @param uart Модуль UART_0 или UART_1.
+ * @param Data Принятые данные.
+ */
+void HAL_Host_USART_Receive(UART_TypeDef *uart, uint32_t Data)
+{
+    HAL_Host_Unlock();
+    HAL_Host_USART_Deliver(uart, HAL_Host_USART_Find(uart), Data);
+    HAL_Host_Lock();
+}
+
+/**
+ * @brief Количество байтов, переданных после @ref HAL_Host_Init.
+ */
+uint32_t HAL_Host_USART_GetTransmitted(UART_TypeDef *uart)
+{
+    return HAL_Host_USART_Find(uart)->Transmitted;
+}
+
+/**
+ * @brief Модели модулей UART_0, UART_1.
+ *
+ * Передача выполняется сразу при записи TXDATA включенным передатчиком (UE и TE): байт передается
+ * на линию, в режиме LBM - на свой приемник, и устанавливается TC. TEACK и REACK повторяют UE и TE/RE.
+ * Флаги ошибок и TC сбрасываются записью 1 в FLAGS, RXNE - чтением RXDATA.
+ */
+HAL_Host_ModelTypeDef HAL_Host_USART_Model[2] =
+{
+    {
+        .Name = "UART_0",
+        .Base = UART_0_BASE_ADDRESS,
+        .Size = sizeof(UART_TypeDef),
+        .Read = HAL_Host_USART_Read,
+        .Write = HAL_Host_USART_Write,
+        .Reset = HAL_Host_USART_Reset,
+    },
+    {
+        .Name = "UART_1",
+        .Base = UART_1_BASE_ADDRESS,
+        .Size = sizeof(UART_TypeDef),
+        .Read = HAL_Host_USART_Read,
+        .Write = HAL_Host_USART_Write,
+        .Reset = HAL_Host_USART_Reset,
+    },
+};
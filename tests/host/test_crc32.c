@@ -0,0 +1,99 @@
+#include <string.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_crc32.h"
+#include "mik32_hal_crc32_ref.h"
+
+
+/**
+ * @brief Модель CRC с контрольным значением для строки "123456789".
+ */
+typedef struct
+{
+    const char *Name;
+    uint32_t Poly;
+    uint32_t Init;
+    uint8_t InputReverse;
+    uint8_t OutputReverse;
+    uint8_t OutputInversion;
+    uint32_t Check;
+} CRC_TestCaseTypeDef;
+
+static const CRC_TestCaseTypeDef Cases[] =
+{
+    {"CRC-32",        0x04C11DB7, 0xFFFFFFFF, CRC_REFIN_TRUE,  CRC_REFOUT_TRUE,  CRC_OUTPUTINVERSION_ON,  0xCBF43926},
+    {"CRC-32/BZIP2",  0x04C11DB7, 0xFFFFFFFF, CRC_REFIN_FALSE, CRC_REFOUT_FALSE, CRC_OUTPUTINVERSION_ON,  0xFC891918},
+    {"CRC-32C",       0x1EDC6F41, 0xFFFFFFFF, CRC_REFIN_TRUE,  CRC_REFOUT_TRUE,  CRC_OUTPUTINVERSION_ON,  0xE3069283},
+    {"CRC-32/MPEG-2", 0x04C11DB7, 0xFFFFFFFF, CRC_REFIN_FALSE, CRC_REFOUT_FALSE, CRC_OUTPUTINVERSION_OFF, 0x0376E6E7},
+    {"CRC-32/JAMCRC", 0x04C11DB7, 0xFFFFFFFF, CRC_REFIN_TRUE,  CRC_REFOUT_TRUE,  CRC_OUTPUTINVERSION_OFF, 0x340BC6D9},
+    {"CRC-32/POSIX",  0x04C11DB7, 0x00000000, CRC_REFIN_FALSE, CRC_REFOUT_FALSE, CRC_OUTPUTINVERSION_ON,  0x765E7680},
+};
+
+static uint8_t Message[CRC_MAX_BYTES];
+
+static void CRC_SetConfig(CRC_HandleTypeDef *hcrc, CRC_Ref_ConfigTypeDef *ref, const CRC_TestCaseTypeDef *test)
+{
+    hcrc->Instance = CRC;
+    hcrc->Poly = test->Poly;
+    hcrc->Init = test->Init;
+    hcrc->InputReverse = test->InputReverse;
+    hcrc->OutputReverse = test->OutputReverse;
+    hcrc->OutputInversion = test->OutputInversion;
+
+    ref->Poly = test->Poly;
+    ref->Init = test->Init;
+    ref->RefIn = (test->InputReverse == CRC_REFIN_TRUE);
+    ref->RefOut = (test->OutputReverse == CRC_REFOUT_TRUE);
+    ref->XorOut = (test->OutputInversion == CRC_OUTPUTINVERSION_ON) ? 0xFFFFFFFF : 0;
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    for (uint32_t i = 0; i < CRC_MAX_BYTES; i++)
+    {
+        Message[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    for (uint32_t c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++)
+    {
+        const CRC_TestCaseTypeDef *test = &Cases[c];
+        CRC_HandleTypeDef hcrc;
+        CRC_Ref_ConfigTypeDef ref;
+
+        CRC_SetConfig(&hcrc, &ref, test);
+        HAL_CRC_Init(&hcrc);
+
+        /* Контрольное значение: 9 байт - два слова DATA32 и DATA8 */
+        HAL_CRC_WriteData(&hcrc, (uint8_t *)"123456789", 9);
+        uint32_t hw = HAL_CRC_ReadCRC(&hcrc);
+        uint32_t sw = HAL_CRC_Ref_Calculate(&ref, (const uint8_t *)"123456789", 9);
+        printf("%-14s block 0x%08X ref 0x%08X check 0x%08X\n", test->Name, hw, sw, test->Check);
+        HAL_HOST_CHECK(hw == test->Check);
+        HAL_HOST_CHECK(sw == test->Check);
+
+        /* Все длины до CRC_MAX_BYTES: хвосты DATA16 и DATA8 */
+        for (uint32_t length = 0; length <= CRC_MAX_BYTES; length++)
+        {
+            HAL_CRC_WriteData(&hcrc, Message, length);
+            HAL_HOST_CHECK(HAL_CRC_ReadCRC(&hcrc) == HAL_CRC_Ref_Calculate(&ref, Message, length));
+        }
+
+        /* Слова в порядке, в котором их формирует HAL_CRC_WriteData */
+        uint32_t words[CRC_MAX_WORDS];
+        for (uint32_t i = 0; i < CRC_MAX_WORDS; i++)
+        {
+            words[i] = ((uint32_t)Message[4 * i] << 24) | ((uint32_t)Message[4 * i + 1] << 16) | ((uint32_t)Message[4 * i + 2] << 8) | Message[4 * i + 3];
+        }
+        HAL_CRC_WriteData32(&hcrc, words, CRC_MAX_WORDS);
+        HAL_HOST_CHECK(HAL_CRC_ReadCRC(&hcrc) == HAL_CRC_Ref_Calculate(&ref, Message, CRC_MAX_BYTES));
+    }
+
+    printf("register accesses: %u, failures: %u\n", HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
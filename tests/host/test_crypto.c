@@ -0,0 +1,280 @@
+#include <string.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_crypto.h"
+#include "mik32_hal_crypto_ref.h"
+
+
+#define CRYPTO_TEST_BLOCKS      8
+
+/**
+ * @brief Тестовый пример стандарта: ключ, вектор инициализации и первые блоки открытого и шифрованного текста.
+ */
+typedef struct
+{
+    const char *Name;
+    uint8_t Algorithm;
+    uint8_t CipherMode;
+    const char *Key;
+    const char *Iv;
+    const char *Plain;
+    const char *Cipher;
+} Crypto_TestCaseTypeDef;
+
+static const Crypto_TestCaseTypeDef Cases[] =
+{
+    /* ГОСТ Р 34.12-2015, приложения А.1 и А.2 */
+    {"kuznechik-ecb", CRYPTO_ALG_KUZNECHIK, CRYPTO_CIPHER_MODE_ECB,
+        "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef", "",
+        "1122334455667700ffeeddccbbaa9988", "7f679d90bebc24305a468d42b9d4edcd"},
+    {"magma-ecb", CRYPTO_ALG_MAGMA, CRYPTO_CIPHER_MODE_ECB,
+        "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", "",
+        "fedcba9876543210", "4ee901e5c2d8ca3d"},
+    /* ГОСТ Р 34.13-2015, режим гаммирования */
+    {"kuznechik-ctr", CRYPTO_ALG_KUZNECHIK, CRYPTO_CIPHER_MODE_CTR,
+        "8899aabbccddeeff0011223344556677fedcba98765432100123456789abcdef", "1234567890abcef0",
+        "1122334455667700ffeeddccbbaa9988", "f195d8bec10ed1dbd57b5fa240bda1b8"},
+    {"magma-ctr", CRYPTO_ALG_MAGMA, CRYPTO_CIPHER_MODE_CTR,
+        "ffeeddccbbaa99887766554433221100f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", "12345678",
+        "92def06b3c130a59", "4e98110c97b7b93c"},
+    /* FIPS-197, приложение C.1; SP 800-38A, F.2.1 */
+    {"aes-ecb", CRYPTO_ALG_AES, CRYPTO_CIPHER_MODE_ECB,
+        "000102030405060708090a0b0c0d0e0f", "",
+        "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a"},
+    {"aes-cbc", CRYPTO_ALG_AES, CRYPTO_CIPHER_MODE_CBC,
+        "2b7e151628aed2a6abf7158809cf4f3c", "000102030405060708090a0b0c0d0e0f",
+        "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51",
+        "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"},
+};
+
+/**
+ * @brief Строка шестнадцатеричных цифр в слова, первое слово - старшее.
+ * @return Количество слов.
+ */
+static uint32_t Crypto_ParseWords(const char *hex, uint32_t words[])
+{
+    uint32_t count = strlen(hex) / 8;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        words[i] = 0;
+        for (uint32_t j = 0; j < 8; j++)
+        {
+            char c = hex[8 * i + j];
+            words[i] = (words[i] << 4) | (uint32_t)((c <= '9') ? (c - '0') : (c - 'a' + 10));
+        }
+    }
+
+    return count;
+}
+
+static void Crypto_WordsToBytes(const uint32_t words[], uint32_t count, uint8_t bytes[])
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        bytes[4 * i] = (uint8_t)(words[i] >> 24);
+        bytes[4 * i + 1] = (uint8_t)(words[i] >> 16);
+        bytes[4 * i + 2] = (uint8_t)(words[i] >> 8);
+        bytes[4 * i + 3] = (uint8_t)words[i];
+    }
+}
+
+static void Crypto_Setup(Crypto_HandleTypeDef *hcrypto, uint8_t algorithm, uint8_t mode, uint32_t key[], uint32_t iv[], uint32_t iv_length)
+{
+    hcrypto->Instance = CRYPTO;
+    hcrypto->Algorithm = algorithm;
+    hcrypto->CipherMode = mode;
+    HAL_Crypto_Init(hcrypto);
+    HAL_Crypto_SetKey(hcrypto, key);
+    if (mode != CRYPTO_CIPHER_MODE_ECB)
+    {
+        HAL_Crypto_SetIV(hcrypto, iv, iv_length);
+    }
+}
+
+/**
+ * @brief Сравнить шифрование и расшифрование драйвером с примером стандарта.
+ */
+static void Crypto_CheckVector(const Crypto_TestCaseTypeDef *test)
+{
+    Crypto_HandleTypeDef hcrypto = {.SwapMode = CRYPTO_SWAP_MODE_NONE, .OrderMode = CRYPTO_ORDER_MODE_MSW};
+    uint32_t key[MAXIMUM_KEY_LENGTH];
+    uint32_t iv[CRYPTO_BLOCK_AES];
+    uint32_t plain[2 * CRYPTO_BLOCK_AES];
+    uint32_t cipher[2 * CRYPTO_BLOCK_AES];
+    uint32_t result[2 * CRYPTO_BLOCK_AES];
+
+    Crypto_ParseWords(test->Key, key);
+    uint32_t iv_length = Crypto_ParseWords(test->Iv, iv);
+    uint32_t length = Crypto_ParseWords(test->Plain, plain);
+    Crypto_ParseWords(test->Cipher, cipher);
+
+    Crypto_Setup(&hcrypto, test->Algorithm, test->CipherMode, key, iv, iv_length);
+    HAL_Crypto_Encode(&hcrypto, plain, result, length);
+    int encoded = (memcmp(result, cipher, length * 4) == 0);
+
+    Crypto_Setup(&hcrypto, test->Algorithm, test->CipherMode, key, iv, iv_length);
+    HAL_Crypto_Decode(&hcrypto, cipher, result, length);
+    int decoded = (memcmp(result, plain, length * 4) == 0);
+
+    printf("%-14s encode %s decode %s\n", test->Name, encoded ? "ok" : "FAIL", decoded ? "ok" : "FAIL");
+    HAL_HOST_CHECK(encoded);
+    HAL_HOST_CHECK(decoded);
+}
+
+/**
+ * @brief Шифрование нескольких блоков в режимах CBC и CTR: сцепление блоков по эталонному шифру.
+ */
+static void Crypto_CheckChaining(uint8_t algorithm, uint8_t mode)
+{
+    Crypto_HandleTypeDef hcrypto = {.SwapMode = CRYPTO_SWAP_MODE_NONE, .OrderMode = CRYPTO_ORDER_MODE_MSW};
+    Crypto_Ref_KeyTypeDef ref;
+    uint32_t block_words = HAL_Crypto_Ref_BlockBytes(algorithm) / 4;
+    uint32_t length = CRYPTO_TEST_BLOCKS * block_words;
+    uint32_t key[MAXIMUM_KEY_LENGTH];
+    uint32_t iv[CRYPTO_BLOCK_AES];
+    uint32_t iv_length = (mode == CRYPTO_CIPHER_MODE_CTR) ? (block_words >> 1) : block_words;
+    uint32_t plain[CRYPTO_TEST_BLOCKS * CRYPTO_BLOCK_AES];
+    uint32_t cipher[CRYPTO_TEST_BLOCKS * CRYPTO_BLOCK_AES];
+    uint32_t result[CRYPTO_TEST_BLOCKS * CRYPTO_BLOCK_AES];
+    uint8_t bytes[CRYPTO_REF_KEY_BYTES_MAX];
+    uint8_t chain[CRYPTO_REF_BLOCK_BYTES_MAX] = {0};
+
+    for (uint32_t i = 0; i < MAXIMUM_KEY_LENGTH; i++)
+    {
+        key[i] = 0x01234567 * (i + 1);
+    }
+    for (uint32_t i = 0; i < CRYPTO_BLOCK_AES; i++)
+    {
+        iv[i] = 0xA5A5A5A5 ^ (i << 8);
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        plain[i] = 0x9E3779B9 * (i + 7);
+    }
+
+    Crypto_WordsToBytes(key, HAL_Crypto_Ref_KeyBytes(algorithm) / 4, bytes);
+    HAL_Crypto_Ref_SetKey(&ref, algorithm, bytes);
+    Crypto_WordsToBytes(iv, iv_length, chain);
+
+    /* Ожидаемый шифротекст по блокам */
+    for (uint32_t block = 0; block < CRYPTO_TEST_BLOCKS; block++)
+    {
+        uint8_t data[CRYPTO_REF_BLOCK_BYTES_MAX];
+        uint8_t gamma[CRYPTO_REF_BLOCK_BYTES_MAX];
+        uint32_t block_bytes = 4 * block_words;
+
+        Crypto_WordsToBytes(&plain[block * block_words], block_words, data);
+        if (mode == CRYPTO_CIPHER_MODE_CBC)
+        {
+            for (uint32_t i = 0; i < block_bytes; i++)
+            {
+                data[i] ^= chain[i];
+            }
+            HAL_Crypto_Ref_EncryptBlock(&ref, data);
+            memcpy(chain, data, block_bytes);
+        }
+        else
+        {
+            memcpy(gamma, chain, block_bytes);
+            HAL_Crypto_Ref_EncryptBlock(&ref, gamma);
+            for (uint32_t i = 0; i < block_bytes; i++)
+            {
+                data[i] ^= gamma[i];
+            }
+            /* Приращение счетчика: вектор инициализации занимает старшую половину блока */
+            for (uint32_t i = block_bytes; i > 0; i--)
+            {
+                if (++chain[i - 1] != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t w = 0; w < block_words; w++)
+        {
+            cipher[block * block_words + w] = ((uint32_t)data[4 * w] << 24) | ((uint32_t)data[4 * w + 1] << 16) |
+                                              ((uint32_t)data[4 * w + 2] << 8) | data[4 * w + 3];
+        }
+    }
+
+    Crypto_Setup(&hcrypto, algorithm, mode, key, iv, iv_length);
+    HAL_Crypto_Encode(&hcrypto, plain, result, length);
+    HAL_HOST_CHECK(memcmp(result, cipher, length * 4) == 0);
+
+    Crypto_Setup(&hcrypto, algorithm, mode, key, iv, iv_length);
+    HAL_Crypto_Decode(&hcrypto, cipher, result, length);
+    HAL_HOST_CHECK(memcmp(result, plain, length * 4) == 0);
+}
+
+/**
+ * @brief Порядок слов LSW и перестановка байтов: драйвер передает слова в обратном порядке
+ *        с обратным порядком байтов, результат совпадает с примером после той же перестановки.
+ */
+static void Crypto_CheckOrderSwap(const Crypto_TestCaseTypeDef *test)
+{
+    Crypto_HandleTypeDef hcrypto = {.SwapMode = CRYPTO_SWAP_MODE_BYTE, .OrderMode = CRYPTO_ORDER_MODE_LSW};
+    uint32_t key[MAXIMUM_KEY_LENGTH];
+    uint32_t plain[CRYPTO_BLOCK_AES];
+    uint32_t cipher[CRYPTO_BLOCK_AES];
+    uint32_t swapped_key[MAXIMUM_KEY_LENGTH];
+    uint32_t swapped_plain[CRYPTO_BLOCK_AES];
+    uint32_t result[CRYPTO_BLOCK_AES];
+
+    uint32_t key_length = Crypto_ParseWords(test->Key, key);
+    uint32_t length = Crypto_ParseWords(test->Plain, plain);
+    Crypto_ParseWords(test->Cipher, cipher);
+
+    for (uint32_t i = 0; i < key_length; i++)
+    {
+        swapped_key[i] = __builtin_bswap32(key[key_length - 1 - i]);
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        swapped_plain[i] = __builtin_bswap32(plain[length - 1 - i]);
+    }
+
+    Crypto_Setup(&hcrypto, test->Algorithm, CRYPTO_CIPHER_MODE_ECB, swapped_key, NULL, 0);
+    HAL_Crypto_Encode(&hcrypto, swapped_plain, result, length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        HAL_HOST_CHECK(result[i] == __builtin_bswap32(cipher[length - 1 - i]));
+    }
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    for (uint32_t c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++)
+    {
+        Crypto_CheckVector(&Cases[c]);
+    }
+
+    for (uint8_t alg = CRYPTO_ALG_KUZNECHIK; alg <= CRYPTO_ALG_AES; alg++)
+    {
+        Crypto_CheckChaining(alg, CRYPTO_CIPHER_MODE_CBC);
+        Crypto_CheckChaining(alg, CRYPTO_CIPHER_MODE_CTR);
+    }
+
+    Crypto_CheckOrderSwap(&Cases[0]);
+    Crypto_CheckOrderSwap(&Cases[1]);
+    Crypto_CheckOrderSwap(&Cases[4]);
+
+    /* Текст не кратен блоку: драйвер не загружает блок */
+    Crypto_HandleTypeDef hcrypto = {.Instance = CRYPTO, .Algorithm = CRYPTO_ALG_AES, .CipherMode = CRYPTO_CIPHER_MODE_ECB,
+                                    .SwapMode = CRYPTO_SWAP_MODE_NONE, .OrderMode = CRYPTO_ORDER_MODE_MSW};
+    uint32_t text[CRYPTO_BLOCK_AES + 1] = {0};
+    uint32_t blocks = HAL_Host_Crypto_GetBlocks();
+    HAL_Crypto_Init(&hcrypto);
+    HAL_Crypto_Encode(&hcrypto, text, text, CRYPTO_BLOCK_AES + 1);
+    HAL_HOST_CHECK(HAL_Host_Crypto_GetBlocks() == blocks);
+
+    printf("blocks: %u, register accesses: %u, failures: %u\n", HAL_Host_Crypto_GetBlocks(), HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
@@ -0,0 +1,102 @@
+#include <string.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_dma.h"
+
+
+#define DMA_TEST_LENGTH     64
+
+static uint8_t Source[DMA_TEST_LENGTH];
+static uint8_t Destination[DMA_TEST_LENGTH];
+
+static DMA_InitTypeDef hdma;
+static DMA_ChannelHandleTypeDef hdma_ch;
+
+static void DMA_ChannelConfig(HAL_DMA_ChannelModeTypeDef WriteMode, HAL_DMA_ChannelIncTypeDef ReadInc, HAL_DMA_ChannelSizeTypeDef Size)
+{
+    hdma_ch.dma = &hdma;
+    hdma_ch.ChannelInit.Channel = DMA_CHANNEL_2;
+    hdma_ch.ChannelInit.Priority = DMA_CHANNEL_PRIORITY_HIGH;
+
+    hdma_ch.ChannelInit.ReadMode = DMA_CHANNEL_MODE_MEMORY;
+    hdma_ch.ChannelInit.ReadInc = ReadInc;
+    hdma_ch.ChannelInit.ReadSize = Size;
+    hdma_ch.ChannelInit.ReadBurstSize = Size;
+    hdma_ch.ChannelInit.ReadRequest = DMA_CHANNEL_SPI_0_REQUEST;
+    hdma_ch.ChannelInit.ReadAck = DMA_CHANNEL_ACK_DISABLE;
+
+    hdma_ch.ChannelInit.WriteMode = WriteMode;
+    hdma_ch.ChannelInit.WriteInc = DMA_CHANNEL_INC_ENABLE;
+    hdma_ch.ChannelInit.WriteSize = Size;
+    hdma_ch.ChannelInit.WriteBurstSize = Size;
+    hdma_ch.ChannelInit.WriteRequest = DMA_CHANNEL_SPI_0_REQUEST;
+    hdma_ch.ChannelInit.WriteAck = DMA_CHANNEL_ACK_DISABLE;
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    for (uint32_t i = 0; i < DMA_TEST_LENGTH; i++)
+    {
+        Source[i] = (uint8_t)(0xA5 ^ (i * 7));
+    }
+
+    hdma.Instance = DMA_CONFIG;
+    hdma.CurrentValue = DMA_CURRENT_VALUE_ENABLE;
+    HAL_HOST_CHECK(HAL_DMA_Init(&hdma) == HAL_OK);
+    HAL_HOST_CHECK(HAL_Host_MStatus & MSTATUS_MIE);
+
+    /* Память - память словами: пересылка выполняется при записи CFG */
+    DMA_ChannelConfig(DMA_CHANNEL_MODE_MEMORY, DMA_CHANNEL_INC_ENABLE, DMA_CHANNEL_SIZE_WORD);
+    HAL_DMA_LocalIRQEnable(&hdma_ch, DMA_IRQ_ENABLE);
+    HAL_DMA_Start(&hdma_ch, Source, Destination, DMA_TEST_LENGTH - 1);
+    HAL_HOST_CHECK(HAL_DMA_Wait(&hdma_ch, DMA_TIMEOUT_DEFAULT) == HAL_OK);
+    HAL_HOST_CHECK(memcmp(Source, Destination, DMA_TEST_LENGTH) == 0);
+    HAL_HOST_CHECK(HAL_DMA_GetChannelIrq(&hdma_ch) == 1);
+    HAL_HOST_CHECK(HAL_DMA_GetBusError(&hdma_ch) == 0);
+
+    HAL_DMA_ClearLocalIrq(&hdma);
+    HAL_HOST_CHECK(HAL_DMA_GetChannelIrq(&hdma_ch) == 0);
+
+    /* Заполнение: адрес источника не инкрементируется */
+    memset(Destination, 0, sizeof(Destination));
+    DMA_ChannelConfig(DMA_CHANNEL_MODE_MEMORY, DMA_CHANNEL_INC_DISABLE, DMA_CHANNEL_SIZE_BYTE);
+    HAL_DMA_Start(&hdma_ch, Source, Destination, DMA_TEST_LENGTH - 1);
+    HAL_HOST_CHECK(HAL_DMA_Wait(&hdma_ch, DMA_TIMEOUT_DEFAULT) == HAL_OK);
+    for (uint32_t i = 0; i < DMA_TEST_LENGTH; i++)
+    {
+        HAL_HOST_CHECK(Destination[i] == Source[0]);
+    }
+
+    /* Назначение - периферия: одно слово на запрос линии SPI_0 */
+    memset(Destination, 0, sizeof(Destination));
+    DMA_ChannelConfig(DMA_CHANNEL_MODE_PERIPHERY, DMA_CHANNEL_INC_ENABLE, DMA_CHANNEL_SIZE_HALFWORD);
+    HAL_DMA_Start(&hdma_ch, Source, Destination, DMA_TEST_LENGTH - 1);
+    for (uint32_t i = 0; i < DMA_TEST_LENGTH / 2; i++)
+    {
+        HAL_HOST_CHECK(HAL_DMA_GetChannelReadyStatus(&hdma_ch) == 0);
+        HAL_HOST_CHECK(HAL_DMA_Wait(&hdma_ch, 1) == HAL_TIMEOUT);
+        HAL_Host_DMA_Request(DMA_CHANNEL_USART_0_REQUEST);
+        HAL_Host_DMA_Request(DMA_CHANNEL_SPI_0_REQUEST);
+        HAL_HOST_CHECK(Destination[2 * i + 1] == Source[2 * i + 1]);
+    }
+    HAL_HOST_CHECK(HAL_DMA_GetChannelReadyStatus(&hdma_ch) == 1);
+    HAL_HOST_CHECK(memcmp(Source, Destination, DMA_TEST_LENGTH) == 0);
+
+    /* Остановка канала до окончания пересылки */
+    HAL_DMA_Start(&hdma_ch, Source, Destination, DMA_TEST_LENGTH - 1);
+    HAL_Host_DMA_Request(DMA_CHANNEL_SPI_0_REQUEST);
+    HAL_HOST_CHECK(HAL_Host_DMA_GetBusyMask() == (1 << DMA_CHANNEL_2));
+    HAL_DMA_ChannelDisable(&hdma_ch);
+    HAL_HOST_CHECK(HAL_Host_DMA_GetBusyMask() == 0);
+
+    HAL_HOST_CHECK(HAL_Host_MStatus & MSTATUS_MIE);
+
+    printf("register accesses: %u, failures: %u\n", HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
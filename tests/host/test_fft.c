@@ -0,0 +1,90 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_fft.h"
+
+
+/* Допустимая ошибка выхода в младших разрядах Q15: округление на каждом этапе и в поворотах */
+#define FFT_TOLERANCE       4
+
+static q15_t Buffer[2 * FFT_MAX_LENGTH];
+static q15_t Input[FFT_MAX_LENGTH];
+
+/**
+ * @brief Сравнить результат с ДПФ в double, деленным на Length.
+ * @return Наибольшая ошибка в младших разрядах Q15.
+ */
+static double FFT_MaxError(uint32_t length)
+{
+    double error = 0;
+
+    for (uint32_t k = 0; k < length; k++)
+    {
+        double re = 0, im = 0;
+        for (uint32_t n = 0; n < length; n++)
+        {
+            double phase = -2.0 * M_PI * (double)((k * n) % length) / length;
+            re += Input[n] * cos(phase);
+            im += Input[n] * sin(phase);
+        }
+        re /= length;
+        im /= length;
+
+        double dr = fabs(Buffer[2 * k] - re);
+        double di = fabs(Buffer[2 * k + 1] - im);
+        error = (dr > error) ? dr : error;
+        error = (di > error) ? di : error;
+    }
+
+    return error;
+}
+
+static void FFT_Check(FFT_HandleTypeDef *hfft, const char *name)
+{
+    for (uint32_t n = 0; n < hfft->Length; n++)
+    {
+        Buffer[2 * n] = Input[n];
+        Buffer[2 * n + 1] = 0;
+    }
+    HAL_FFT_Forward(hfft, Buffer);
+
+    double error = FFT_MaxError(hfft->Length);
+    printf("%-10s L=%-4u max error %.2f LSB\n", name, hfft->Length, error);
+    HAL_HOST_CHECK(error <= FFT_TOLERANCE);
+}
+
+int main()
+{
+    srand(1);
+
+    for (uint16_t length = FFT_MIN_LENGTH; length <= FFT_MAX_LENGTH; length <<= 1)
+    {
+        FFT_HandleTypeDef hfft;
+        HAL_HOST_CHECK(HAL_FFT_Init(&hfft, length) == HAL_OK);
+
+        /* Меандр с периодом Length / 2 от +1 до -1: первая бабочка дает (32767 + 32768) / 2 > 32767 */
+        for (uint32_t n = 0; n < length; n++)
+        {
+            Input[n] = (((n * 4) / length) & 1) ? DSP_Q15_MIN : DSP_Q15_MAX;
+        }
+        FFT_Check(&hfft, "square");
+
+        /* Чередование +1 и -1: вся энергия в бине Length / 2 */
+        for (uint32_t n = 0; n < length; n++)
+        {
+            Input[n] = (n & 1) ? DSP_Q15_MIN : DSP_Q15_MAX;
+        }
+        FFT_Check(&hfft, "nyquist");
+
+        for (uint32_t n = 0; n < length; n++)
+        {
+            Input[n] = (q15_t)(rand() & 0xFFFF);
+        }
+        FFT_Check(&hfft, "random");
+    }
+
+    printf("failures: %u\n", HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
@@ -0,0 +1,144 @@
+#include <string.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal_spi.h"
+
+
+#define SPI_TEST_LENGTH     37
+#define SPI_TEST_IRQ_LIMIT  1000
+
+/**
+ * @brief Принятые ведомым байты.
+ */
+static uint8_t SlaveReceived[64];
+static uint32_t SlaveCount;
+static uint8_t SlaveLast;
+
+/**
+ * @brief Ведомое устройство - сдвиговый регистр: отвечает предыдущим принятым байтом с инверсией.
+ */
+static uint8_t SPI_Slave(uint8_t Data)
+{
+    uint8_t response = (uint8_t)~SlaveLast;
+
+    if (SlaveCount < sizeof(SlaveReceived))
+    {
+        SlaveReceived[SlaveCount] = Data;
+    }
+    SlaveCount++;
+    SlaveLast = Data;
+
+    return response;
+}
+
+static void SPI_SlaveReset(void)
+{
+    SlaveCount = 0;
+    SlaveLast = 0;
+    HAL_Host_SPI_SetSlave(SPI_0, SPI_Slave);
+}
+
+/**
+ * @brief Ожидаемый ответ ведомого на передачу tx.
+ */
+static void SPI_Expected(const uint8_t tx[], uint8_t rx[], uint32_t length)
+{
+    uint8_t last = 0;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        rx[i] = (uint8_t)~last;
+        last = tx[i];
+    }
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    SPI_HandleTypeDef hspi = {0};
+    uint8_t tx[SPI_TEST_LENGTH];
+    uint8_t rx[SPI_TEST_LENGTH];
+    uint8_t expected[SPI_TEST_LENGTH];
+
+    for (uint32_t i = 0; i < SPI_TEST_LENGTH; i++)
+    {
+        tx[i] = (uint8_t)(i * 29 + 3);
+    }
+    SPI_Expected(tx, expected, SPI_TEST_LENGTH);
+
+    hspi.Instance = SPI_0;
+    hspi.Init.SPI_Mode = HAL_SPI_MODE_MASTER;
+    hspi.Init.BaudRateDiv = SPI_BAUDRATE_DIV64;
+    hspi.Init.CLKPhase = SPI_PHASE_ON;
+    hspi.Init.CLKPolarity = SPI_POLARITY_HIGH;
+    hspi.Init.Decoder = SPI_DECODER_NONE;
+    hspi.Init.ManualCS = SPI_MANUALCS_OFF;
+    hspi.Init.ChipSelect = SPI_CS_1;
+    hspi.Init.ThresholdTX = SPI_THRESHOLD_DEFAULT;
+
+    HAL_HOST_CHECK(HAL_SPI_Init(&hspi) == HAL_OK);
+    HAL_HOST_CHECK(HAL_SPI_ReadModuleID(&hspi) == 0x01090100);
+    HAL_HOST_CHECK(SPI_0->CONFIG == (SPI_CONFIG_MASTER_M | (SPI_BAUDRATE_DIV64 << SPI_CONFIG_BAUD_RATE_DIV_S) |
+                                     SPI_CONFIG_CLK_PH_M | SPI_CONFIG_CLK_POL_M | (SPI_CS_1 << SPI_CONFIG_CS_S)));
+    HAL_HOST_CHECK(SPI_0->DELAY == SPI_DELAY_BTWN(1));
+    HAL_HOST_CHECK(SPI_0->TX_THR == SPI_THRESHOLD_DEFAULT);
+    HAL_HOST_CHECK(!(SPI_0->ENABLE & SPI_ENABLE_M));
+
+    /* Недопустимый порог TX_FIFO */
+    SPI_HandleTypeDef hspi_bad = hspi;
+    hspi_bad.Init.ThresholdTX = SPI_BUFFER_SIZE + 1;
+    HAL_HOST_CHECK(HAL_SPI_Init(&hspi_bad) == HAL_ERROR);
+    HAL_HOST_CHECK(HAL_SPI_Init(&hspi) == HAL_OK);
+
+    /* Обмен опросом: каждый принятый байт - ответ на предыдущий переданный */
+    SPI_SlaveReset();
+    memset(rx, 0, sizeof(rx));
+    HAL_HOST_CHECK(HAL_SPI_Exchange(&hspi, tx, rx, SPI_TEST_LENGTH, SPI_TIMEOUT_DEFAULT) == HAL_OK);
+    HAL_HOST_CHECK(SlaveCount == SPI_TEST_LENGTH);
+    HAL_HOST_CHECK(memcmp(SlaveReceived, tx, SPI_TEST_LENGTH) == 0);
+    HAL_HOST_CHECK(memcmp(rx, expected, SPI_TEST_LENGTH) == 0);
+    /* Автоматический CS: модуль выключен после обмена */
+    HAL_HOST_CHECK(!(SPI_0->ENABLE & SPI_ENABLE_M));
+
+    /* Передача без приема: RX_FIFO переполняется, флаг сбрасывается чтением в конце передачи */
+    SPI_SlaveReset();
+    HAL_HOST_CHECK(HAL_SPI_Transmit(&hspi, tx, SPI_TEST_LENGTH, SPI_TIMEOUT_DEFAULT) == HAL_OK);
+    HAL_HOST_CHECK(SlaveCount == SPI_TEST_LENGTH);
+    HAL_HOST_CHECK(memcmp(SlaveReceived, tx, SPI_TEST_LENGTH) == 0);
+    HAL_HOST_CHECK(!(SPI_0->INT_STATUS & SPI_INT_STATUS_RX_OVERFLOW_M));
+
+    /* Тайм-аут: модуль в режиме ведомого не передает, RX_FIFO остается пустым */
+    SPI_HandleTypeDef hspi_slave = hspi;
+    hspi_slave.Init.SPI_Mode = HAL_SPI_MODE_SLAVE;
+    HAL_HOST_CHECK(HAL_SPI_Init(&hspi_slave) == HAL_OK);
+    SPI_SlaveReset();
+    HAL_HOST_CHECK(HAL_SPI_Exchange(&hspi_slave, tx, rx, 4, 100) == HAL_TIMEOUT);
+    HAL_HOST_CHECK(SlaveCount == 0);
+
+    /* Обмен по прерываниям: обработчик вызывается, пока обмен не завершится */
+    HAL_HOST_CHECK(HAL_SPI_Init(&hspi) == HAL_OK);
+    SPI_SlaveReset();
+    memset(rx, 0, sizeof(rx));
+    HAL_HOST_CHECK(HAL_SPI_Exchange_IT(&hspi, tx, rx, SPI_TEST_LENGTH) == HAL_OK);
+    HAL_HOST_CHECK(SPI_0->INT_MASK == (SPI_INT_STATUS_RX_OVERFLOW_M | SPI_INT_STATUS_MODE_FAIL_M |
+                                       SPI_INT_STATUS_TX_FIFO_NOT_FULL_M | SPI_INT_STATUS_RX_FIFO_NOT_EMPTY_M));
+    uint32_t irq = 0;
+    while ((hspi.State != HAL_SPI_STATE_END) && (hspi.State != HAL_SPI_STATE_ERROR) && (irq < SPI_TEST_IRQ_LIMIT))
+    {
+        HAL_SPI_IRQHandler(&hspi);
+        irq++;
+    }
+    HAL_HOST_CHECK(hspi.State == HAL_SPI_STATE_END);
+    HAL_HOST_CHECK(hspi.ErrorCode == HAL_SPI_ERROR_NONE);
+    HAL_HOST_CHECK(SPI_0->INT_MASK == 0);
+    HAL_HOST_CHECK(memcmp(rx, expected, SPI_TEST_LENGTH) == 0);
+
+    printf("shifted: %u, interrupts: %u, register accesses: %u, failures: %u\n",
+           HAL_Host_SPI_GetShifted(SPI_0), irq, HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
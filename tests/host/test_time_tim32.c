@@ -0,0 +1,72 @@
+#include "mik32_hal_host.h"
+#include "mik32_hal_timer32.h"
+
+
+#define TIME_OVERFLOWS      3
+
+/**
+ * @brief Продвинуть таймер системных часов до переполнения.
+ */
+static void Time_RunToOverflow(void)
+{
+    while (!HAL_Host_Timer32_IsPending(TIMER32_1))
+    {
+        HAL_Host_Timer32_Run(TIMER32_1, 0xFFFFFFFF);
+    }
+}
+
+/**
+ * @brief Прерывание линии TIMER32_1 в EPIC.
+ */
+static void Time_Interrupt(void)
+{
+    EPIC->RAW_STATUS = 1 << EPIC_TIMER32_1_INDEX;
+    HAL_Time_TIM32_InterruptHandler();
+    EPIC->RAW_STATUS = 0;
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    HAL_Time_TIM32_Init(TIMER32_1);
+    HAL_HOST_CHECK(HAL_Host_Mie & MIE_MEIE);
+    HAL_HOST_CHECK(EPIC->MASK_LEVEL_SET & HAL_EPIC_TIMER32_1_MASK);
+    HAL_HOST_CHECK(TIMER32_1->INT_MASK == TIMER32_INT_OVERFLOW_M);
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == 0);
+
+    HAL_Host_Timer32_Run(TIMER32_1, 1000);
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == 1000);
+    HAL_HOST_CHECK(HAL_Time_TIM32_Micros() == 1000);
+
+    /* Необработанное переполнение учитывается при чтении */
+    Time_RunToOverflow();
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == (1ULL << 32));
+
+    /* Прерывание другой линии не изменяет время */
+    HAL_Time_TIM32_InterruptHandler();
+    HAL_HOST_CHECK(HAL_Host_Timer32_IsPending(TIMER32_1));
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == (1ULL << 32));
+
+    Time_Interrupt();
+    HAL_HOST_CHECK(!HAL_Host_Timer32_IsPending(TIMER32_1));
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == (1ULL << 32));
+
+    /* Несколько периодов счетчика без чтения времени: переполнения считает прерывание */
+    for (uint32_t i = 0; i < TIME_OVERFLOWS; i++)
+    {
+        Time_RunToOverflow();
+        Time_Interrupt();
+    }
+    HAL_Host_Timer32_Run(TIMER32_1, 500);
+    HAL_HOST_CHECK(HAL_Time_TIM32_Ticks64() == (((uint64_t)(TIME_OVERFLOWS + 1) << 32) | 500));
+
+    HAL_HOST_CHECK(HAL_Host_MStatus & MSTATUS_MIE);
+
+    printf("register accesses: %u, failures: %u\n", HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
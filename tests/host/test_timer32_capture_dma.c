@@ -0,0 +1,176 @@
+#include "mik32_hal_host.h"
+#include "mik32_hal_timer32_capture_dma.h"
+
+
+#define CAPTURE_TOP         0xFFFF
+#define CAPTURE_SIZE        8
+#define CAPTURE_TICK_FREQ   1000000
+#define CAPTURE_PERIOD      30000
+#define CAPTURE_HIGH        7500
+#define CAPTURE_START       100
+
+/**
+ * @brief Захват одного фронта: таймер, канал захвата, канал DMA и буфер.
+ */
+typedef struct
+{
+    TIMER32_HandleTypeDef htimer32;
+    TIMER32_CHANNEL_HandleTypeDef hchannel;
+    DMA_ChannelHandleTypeDef hdma;
+    Timer32_CaptureDMA_HandleTypeDef hcapture;
+    uint32_t Buffer[CAPTURE_SIZE];
+    uint32_t Request;
+} Capture_TypeDef;
+
+static DMA_InitTypeDef hdma;
+static Capture_TypeDef Rise;
+static Capture_TypeDef Fall;
+
+static void Capture_Init(Capture_TypeDef *c, TIMER32_TypeDef *timer, HAL_DMA_ChannelIndexTypeDef channel, uint32_t request)
+{
+    c->htimer32.Instance = timer;
+    c->htimer32.Top = CAPTURE_TOP;
+    c->htimer32.Clock.Source = TIMER32_SOURCE_PRESCALER;
+    c->htimer32.Clock.Prescaler = 0;
+    c->htimer32.CountMode = TIMER32_COUNTMODE_FORWARD;
+    c->htimer32.State = TIMER32_STATE_DISABLE;
+    HAL_HOST_CHECK(HAL_Timer32_Init(&c->htimer32) == HAL_OK);
+
+    c->hchannel.TimerInstance = timer;
+    c->hchannel.ChannelIndex = TIMER32_CHANNEL_0;
+    c->hchannel.PWM_Invert = TIMER32_CHANNEL_NON_INVERTED_PWM;
+    c->hchannel.Mode = TIMER32_CHANNEL_MODE_CAPTURE;
+    c->hchannel.CaptureEdge = TIMER32_CHANNEL_CAPTUREEDGE_RISING;
+    c->hchannel.OCR = 0;
+    c->hchannel.Noise = TIMER32_CHANNEL_FILTER_OFF;
+    HAL_HOST_CHECK(HAL_Timer32_Channel_Init(&c->hchannel) == HAL_OK);
+
+    c->hdma.dma = &hdma;
+    c->hdma.ChannelInit.Channel = channel;
+    c->hdma.ChannelInit.Priority = DMA_CHANNEL_PRIORITY_HIGH;
+
+    c->hcapture.htimer32 = &c->htimer32;
+    c->hcapture.hchannel = &c->hchannel;
+    c->hcapture.hdma = &c->hdma;
+    c->hcapture.Buffer = c->Buffer;
+    c->hcapture.Size = CAPTURE_SIZE;
+    c->hcapture.TickFreq = CAPTURE_TICK_FREQ;
+    c->Request = request;
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Init(&c->hcapture) == HAL_OK);
+}
+
+/**
+ * @brief Захват фронта в момент Time: значение ICR по модулю периода таймера пересылается DMA.
+ *
+ * Если канал DMA заполнил буфер, вызывается обработчик прерывания DMA.
+ */
+static void Capture_Edge(Capture_TypeDef *c, uint64_t Time)
+{
+    HAL_Host_Unlock();
+    c->hchannel.Instance->ICR = (uint32_t)(Time % (CAPTURE_TOP + 1));
+    HAL_Host_Lock();
+
+    HAL_Host_DMA_Request(c->Request);
+
+    if (HAL_DMA_GetChannelIrq(&c->hdma) && HAL_DMA_GetChannelReadyStatus(&c->hdma))
+    {
+        HAL_Timer32_CaptureDMA_IRQHandler(&c->hcapture);
+    }
+}
+
+/**
+ * @brief Фронты сигнала с периодом CAPTURE_PERIOD и высоким уровнем CAPTURE_HIGH.
+ * @param Edge Номер первого периода.
+ * @param Count Количество периодов.
+ * @param WithFall 1 - захватываются оба фронта, 0 - только нарастающие.
+ */
+static void Capture_Signal(uint32_t Edge, uint32_t Count, int WithFall)
+{
+    for (uint32_t i = Edge; i < Edge + Count; i++)
+    {
+        uint64_t rise = CAPTURE_START + (uint64_t)i * CAPTURE_PERIOD;
+        Capture_Edge(&Rise, rise);
+        if (WithFall)
+        {
+            Capture_Edge(&Fall, rise + CAPTURE_HIGH);
+        }
+    }
+}
+
+int main()
+{
+    Timer32_CaptureDMA_StatsTypeDef stats;
+
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    hdma.Instance = DMA_CONFIG;
+    hdma.CurrentValue = DMA_CURRENT_VALUE_ENABLE;
+    HAL_DMA_Init(&hdma);
+
+    Capture_Init(&Rise, TIMER32_1, DMA_CHANNEL_0, DMA_CHANNEL_TIMER32_1_REQUEST);
+    Capture_Init(&Fall, TIMER32_2, DMA_CHANNEL_1, DMA_CHANNEL_TIMER32_2_REQUEST);
+
+    /* Период по одному фронту: значения ICR переходят через Top */
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Start(&Rise.hcapture) == HAL_OK);
+    Capture_Signal(0, 6, 0);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetCount(&Rise.hcapture) == 6);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Available(&Rise.hcapture) == 6);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetStats(&Rise.hcapture, &stats, 0) == HAL_OK);
+    HAL_HOST_CHECK(stats.Count == 5);
+    HAL_HOST_CHECK(stats.PeriodMin == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(stats.PeriodMax == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(stats.PeriodMean == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(stats.Frequency == (uint32_t)((uint64_t)CAPTURE_TICK_FREQ * 1000 / CAPTURE_PERIOD));
+    HAL_HOST_CHECK(Rise.hcapture.Last == CAPTURE_START + 5ULL * CAPTURE_PERIOD);
+
+    /* Следующая пачка продолжает время последнего захвата, буфер заполняется по кругу */
+    Capture_Signal(6, 5, 0);
+    HAL_HOST_CHECK(Rise.hcapture.Laps == 1);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetStats(&Rise.hcapture, &stats, 0) == HAL_OK);
+    HAL_HOST_CHECK(stats.Count == 5);
+    HAL_HOST_CHECK(stats.PeriodMean == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(Rise.hcapture.Last == CAPTURE_START + 10ULL * CAPTURE_PERIOD);
+
+    /* Переполнение буфера: перезаписанные захваты пропускаются, время последнего захвата сбрасывается */
+    Capture_Signal(11, CAPTURE_SIZE + 3, 0);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Available(&Rise.hcapture) == CAPTURE_SIZE);
+    HAL_HOST_CHECK(Rise.hcapture.Overruns == 3);
+    HAL_HOST_CHECK(!Rise.hcapture.HasLast);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetStats(&Rise.hcapture, &stats, 0) == HAL_OK);
+    HAL_HOST_CHECK(stats.Count == CAPTURE_SIZE - 1);
+    HAL_HOST_CHECK(stats.PeriodMean == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Available(&Rise.hcapture) == 0);
+    HAL_Timer32_CaptureDMA_Stop(&Rise.hcapture);
+
+    /* Коэффициент заполнения по двум захватам */
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_StartSync(&Rise.hcapture, &Fall.hcapture) == HAL_OK);
+    Capture_Signal(0, 5, 1);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetDutyStats(&Rise.hcapture, &Fall.hcapture, &stats, 0) == HAL_OK);
+    HAL_HOST_CHECK(stats.Count == 4);
+    HAL_HOST_CHECK(stats.PeriodMean == CAPTURE_PERIOD);
+    HAL_HOST_CHECK(stats.HighMean == CAPTURE_HIGH);
+    HAL_HOST_CHECK(stats.Duty == ((uint32_t)CAPTURE_HIGH << 16) / CAPTURE_PERIOD);
+    /* Спадающий фронт после последнего нарастающего остается в буфере */
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_Available(&Fall.hcapture) == 1);
+
+    Capture_Signal(5, 3, 1);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetDutyStats(&Rise.hcapture, &Fall.hcapture, &stats, 0) == HAL_OK);
+    HAL_HOST_CHECK(stats.Count == 3);
+    HAL_HOST_CHECK(stats.HighMean == CAPTURE_HIGH);
+
+    /* Потеря захватов в одном из потоков */
+    Capture_Signal(8, CAPTURE_SIZE + 1, 1);
+    HAL_HOST_CHECK(HAL_Timer32_CaptureDMA_GetDutyStats(&Rise.hcapture, &Fall.hcapture, &stats, 0) == HAL_ERROR);
+    HAL_HOST_CHECK(Rise.hcapture.Overruns != 0);
+
+    HAL_Timer32_CaptureDMA_Stop(&Rise.hcapture);
+    HAL_Timer32_CaptureDMA_Stop(&Fall.hcapture);
+    HAL_HOST_CHECK(HAL_Host_DMA_GetBusyMask() == 0);
+
+    printf("register accesses: %u, failures: %u\n", HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
@@ -0,0 +1,116 @@
+#include "mik32_hal_host.h"
+#include "mik32_hal_timer32_pwm_dma.h"
+
+
+#define PWM_TOP     999
+
+static const uint32_t Sequence[] = {100, 200, 300, 400};
+static const uint32_t Single[] = {500};
+
+static TIMER32_HandleTypeDef htimer32;
+static TIMER32_CHANNEL_HandleTypeDef hchannel;
+static DMA_InitTypeDef hdma;
+static DMA_ChannelHandleTypeDef hdma_ch;
+static Timer32_PWM_DMA_HandleTypeDef hpwm_dma;
+
+static uint32_t Callbacks;
+
+static void PWM_Callback(Timer32_PWM_DMA_HandleTypeDef *h)
+{
+    (void)h;
+    Callbacks++;
+}
+
+/**
+ * @brief Период ШИМ: переполнение таймера формирует запрос DMA, затем обрабатывается прерывание DMA.
+ */
+static void PWM_Period(void)
+{
+    while (!HAL_Host_Timer32_IsPending(TIMER32_1))
+    {
+        HAL_Host_Timer32_Run(TIMER32_1, PWM_TOP + 1);
+    }
+    HAL_Host_DMA_Request(DMA_CHANNEL_TIMER32_1_REQUEST);
+    HAL_Timer32_InterruptFlags_ClearMask(&htimer32, TIMER32_INT_OVERFLOW_M);
+    HAL_Timer32_PWM_DMA_IRQHandler(&hpwm_dma);
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    hdma.Instance = DMA_CONFIG;
+    hdma.CurrentValue = DMA_CURRENT_VALUE_ENABLE;
+    HAL_DMA_Init(&hdma);
+    hdma_ch.dma = &hdma;
+    hdma_ch.ChannelInit.Channel = DMA_CHANNEL_1;
+    hdma_ch.ChannelInit.Priority = DMA_CHANNEL_PRIORITY_HIGH;
+
+    htimer32.Instance = TIMER32_1;
+    htimer32.Top = PWM_TOP;
+    htimer32.Clock.Source = TIMER32_SOURCE_PRESCALER;
+    htimer32.Clock.Prescaler = 0;
+    htimer32.CountMode = TIMER32_COUNTMODE_FORWARD;
+    htimer32.State = TIMER32_STATE_DISABLE;
+    HAL_HOST_CHECK(HAL_Timer32_Init(&htimer32) == HAL_OK);
+
+    hchannel.TimerInstance = TIMER32_1;
+    hchannel.ChannelIndex = TIMER32_CHANNEL_0;
+    hchannel.PWM_Invert = TIMER32_CHANNEL_NON_INVERTED_PWM;
+    hchannel.Mode = TIMER32_CHANNEL_MODE_PWM;
+    hchannel.CaptureEdge = TIMER32_CHANNEL_CAPTUREEDGE_RISING;
+    hchannel.OCR = 0;
+    hchannel.Noise = TIMER32_CHANNEL_FILTER_OFF;
+    HAL_HOST_CHECK(HAL_Timer32_Channel_Init(&hchannel) == HAL_OK);
+
+    hpwm_dma.htimer32 = &htimer32;
+    hpwm_dma.hchannel = &hchannel;
+    hpwm_dma.hdma = &hdma_ch;
+    hpwm_dma.CpltCallback = PWM_Callback;
+    HAL_HOST_CHECK(HAL_Timer32_PWM_DMA_Init(&hpwm_dma) == HAL_OK);
+    HAL_DMA_LocalIRQEnable(&hdma_ch, DMA_IRQ_ENABLE);
+
+    /* Однократный вывод: по слову за период, после последнего маска переполнения снимается */
+    HAL_HOST_CHECK(HAL_Timer32_PWM_DMA_Start(&hpwm_dma, Sequence, 4, 0) == HAL_OK);
+    HAL_HOST_CHECK(hchannel.Instance->OCR == Sequence[0]);
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        HAL_HOST_CHECK(TIMER32_1->INT_MASK & TIMER32_INT_OVERFLOW_M);
+        PWM_Period();
+        HAL_HOST_CHECK(hchannel.Instance->OCR == Sequence[i]);
+    }
+    HAL_HOST_CHECK(hpwm_dma.Passes == 1);
+    HAL_HOST_CHECK(Callbacks == 1);
+    HAL_HOST_CHECK(!HAL_Timer32_PWM_DMA_IsBusy(&hpwm_dma));
+    HAL_HOST_CHECK((TIMER32_1->INT_MASK & TIMER32_INT_OVERFLOW_M) == 0);
+
+    /* Буфер из одного слова: проход завершается в HAL_Timer32_PWM_DMA_Start */
+    HAL_HOST_CHECK(HAL_Timer32_PWM_DMA_Start(&hpwm_dma, Single, 1, 0) == HAL_OK);
+    HAL_HOST_CHECK(hchannel.Instance->OCR == Single[0]);
+    HAL_HOST_CHECK(hpwm_dma.Passes == 1);
+    HAL_HOST_CHECK(Callbacks == 2);
+    HAL_HOST_CHECK(!HAL_Timer32_PWM_DMA_IsBusy(&hpwm_dma));
+    HAL_HOST_CHECK((TIMER32_1->INT_MASK & TIMER32_INT_OVERFLOW_M) == 0);
+
+    /* Повтор буфера из одного слова: слово пересылается DMA каждый период */
+    HAL_HOST_CHECK(HAL_Timer32_PWM_DMA_Start(&hpwm_dma, Single, 1, 1) == HAL_OK);
+    HAL_HOST_CHECK(hpwm_dma.Loop == 1);
+    HAL_HOST_CHECK(HAL_Timer32_PWM_DMA_IsBusy(&hpwm_dma));
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        PWM_Period();
+    }
+    HAL_HOST_CHECK(hpwm_dma.Passes == 4);
+    HAL_HOST_CHECK(TIMER32_1->INT_MASK & TIMER32_INT_OVERFLOW_M);
+
+    HAL_Timer32_PWM_DMA_Stop(&hpwm_dma);
+    HAL_HOST_CHECK(!HAL_Timer32_PWM_DMA_IsBusy(&hpwm_dma));
+    HAL_HOST_CHECK((TIMER32_1->INT_MASK & TIMER32_INT_OVERFLOW_M) == 0);
+
+    printf("register accesses: %u, failures: %u\n", HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
@@ -0,0 +1,111 @@
+#include "mik32_hal_host.h"
+#include "mik32_hal_timer32_wheel.h"
+
+
+#define WHEEL_IDLE_OVERFLOWS    7
+#define WHEEL_BOUNDARY          (1ULL << TIMER32_WHEEL_RANGE_BITS)
+#define WHEEL_BOUNDARY_LEAD     1001
+#define WHEEL_BOUNDARY_DELAY    2000
+#define WHEEL_DELAY             1000
+#define WHEEL_PERIOD            (3UL << 30)
+#define WHEEL_FIRES             16
+#define WHEEL_MAX_INTERRUPTS    256
+
+static TIMER32_HandleTypeDef htimer32;
+static Timer32_Wheel_HandleTypeDef hwheel;
+static Timer32_Wheel_TimerTypeDef timer;
+
+static uint32_t Fired;
+static uint64_t FiredAt[WHEEL_FIRES];
+
+static void Wheel_Callback(Timer32_Wheel_TimerTypeDef *t)
+{
+    (void)t;
+    if (Fired < WHEEL_FIRES)
+    {
+        FiredAt[Fired] = HAL_Timer32_Wheel_GetTime(&hwheel);
+    }
+    Fired++;
+}
+
+/**
+ * @brief Продвинуть таймер до ближайшего разрешенного прерывания и вызвать обработчик колеса.
+ */
+static void Wheel_RunToInterrupt(void)
+{
+    while (!HAL_Host_Timer32_IsPending(TIMER32_1))
+    {
+        HAL_Host_Timer32_Run(TIMER32_1, 0xFFFFFFFF);
+    }
+    HAL_Timer32_Wheel_IRQHandler(&hwheel);
+}
+
+/**
+ * @brief Обрабатывать прерывания, пока таймер не сработает Count раз.
+ */
+static void Wheel_RunToFired(uint32_t Count)
+{
+    for (uint32_t i = 0; (i < WHEEL_MAX_INTERRUPTS) && (Fired < Count); i++)
+    {
+        Wheel_RunToInterrupt();
+    }
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    htimer32.Instance = TIMER32_1;
+    htimer32.Clock.Source = TIMER32_SOURCE_PRESCALER;
+    htimer32.Clock.Prescaler = 0;
+    hwheel.htimer32 = &htimer32;
+    hwheel.ChannelIndex = TIMER32_CHANNEL_0;
+    HAL_HOST_CHECK(HAL_Timer32_Wheel_Init(&hwheel) == HAL_OK);
+
+    /* Простой без таймеров: обрабатываются только переполнения, Now колеса не изменяется */
+    for (uint32_t i = 0; i < WHEEL_IDLE_OVERFLOWS; i++)
+    {
+        Wheel_RunToInterrupt();
+    }
+    HAL_HOST_CHECK(hwheel.High == WHEEL_IDLE_OVERFLOWS);
+    HAL_HOST_CHECK(hwheel.Now == 0);
+
+    /* Однократный таймер, время которого за границей 2^35 тактов: список Far */
+    timer.Callback = Wheel_Callback;
+    HAL_Host_Timer32_Run(TIMER32_1, 0xFFFFFFFF - WHEEL_BOUNDARY_LEAD);
+    uint64_t start = HAL_Timer32_Wheel_GetTime(&hwheel);
+    HAL_HOST_CHECK(start == WHEEL_BOUNDARY - WHEEL_BOUNDARY_LEAD - 1);
+    HAL_HOST_CHECK(HAL_Timer32_Wheel_Start(&hwheel, &timer, WHEEL_BOUNDARY_DELAY, 0) == HAL_OK);
+    HAL_HOST_CHECK(timer.Level == TIMER32_WHEEL_LEVELS);
+
+    Wheel_RunToFired(1);
+    HAL_HOST_CHECK(Fired == 1);
+    HAL_HOST_CHECK(FiredAt[0] == start + WHEEL_BOUNDARY_DELAY);
+    HAL_HOST_CHECK(!HAL_Timer32_Wheel_IsActive(&timer));
+
+    /* Периодический таймер: срабатывания переходят границу 2^36 тактов */
+    Fired = 0;
+    start = HAL_Timer32_Wheel_GetTime(&hwheel);
+    HAL_HOST_CHECK(HAL_Timer32_Wheel_Start(&hwheel, &timer, WHEEL_DELAY, WHEEL_PERIOD) == HAL_OK);
+    HAL_HOST_CHECK(timer.Level < TIMER32_WHEEL_LEVELS - 1);
+
+    Wheel_RunToFired(WHEEL_FIRES);
+    HAL_HOST_CHECK(Fired == WHEEL_FIRES);
+    for (uint32_t i = 0; i < WHEEL_FIRES; i++)
+    {
+        HAL_HOST_CHECK(FiredAt[i] == start + WHEEL_DELAY + (uint64_t)i * WHEEL_PERIOD);
+    }
+    HAL_HOST_CHECK(FiredAt[WHEEL_FIRES - 1] > 2 * WHEEL_BOUNDARY);
+
+    HAL_Timer32_Wheel_Stop(&hwheel, &timer);
+    HAL_HOST_CHECK(!HAL_Timer32_Wheel_IsActive(&timer));
+    HAL_HOST_CHECK(HAL_Host_MStatus & MSTATUS_MIE);
+
+    printf("last fired at %llu, register accesses: %u, failures: %u\n", (unsigned long long)FiredAt[WHEEL_FIRES - 1],
+           HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}
@@ -0,0 +1,104 @@
+#include <string.h>
+
+#include "mik32_hal_host.h"
+#include "mik32_hal.h"
+#include "mik32_hal_usart.h"
+
+
+#define USART_TEST_BAUDRATE     115200
+#define USART_TEST_TIMEOUT      1000
+
+/**
+ * @brief Байты, переданные на линию TX.
+ */
+static char Line[64];
+static uint32_t LineCount;
+
+static void USART_Line(uint32_t Data)
+{
+    if (LineCount < sizeof(Line))
+    {
+        Line[LineCount++] = (char)Data;
+    }
+}
+
+static void USART_Setup(USART_HandleTypeDef *husart, UART_TypeDef *instance, HAL_USART_EnableDisable_enum transmitting,
+                        HAL_USART_EnableDisable_enum lbm)
+{
+    memset(husart, 0, sizeof(*husart));
+    husart->Instance = instance;
+    husart->transmitting = transmitting;
+    husart->receiving = Enable;
+    husart->frame = Frame_8bit;
+    husart->stop_bit = StopBit_1;
+    husart->lbm = lbm;
+    husart->baudrate = USART_TEST_BAUDRATE;
+}
+
+int main()
+{
+    if (HAL_Host_Init() != HAL_OK)
+    {
+        return HAL_HOST_SKIP_CODE;
+    }
+
+    USART_HandleTypeDef husart;
+    char message[] = "MIK32 host USART";
+    char received[sizeof(message)];
+    char data = 0;
+
+    /* Внутренняя петля LBM: каждый переданный байт принимается своим приемником */
+    USART_Setup(&husart, UART_0, Enable, Enable);
+    HAL_HOST_CHECK(HAL_USART_Init(&husart) == HAL_OK);
+    HAL_HOST_CHECK(UART_0->DIVIDER == HSI_VALUE / USART_TEST_BAUDRATE);
+    HAL_HOST_CHECK((UART_0->CONTROL1 & (UART_CONTROL1_UE_M | UART_CONTROL1_TE_M | UART_CONTROL1_RE_M)) ==
+                   (UART_CONTROL1_UE_M | UART_CONTROL1_TE_M | UART_CONTROL1_RE_M));
+    HAL_HOST_CHECK(UART_0->CONTROL2 == UART_CONTROL2_LBM_M);
+
+    for (uint32_t i = 0; i < strlen(message); i++)
+    {
+        HAL_HOST_CHECK(HAL_USART_Transmit(&husart, message[i], USART_TIMEOUT_DEFAULT));
+        HAL_HOST_CHECK(HAL_USART_Receive(&husart, &received[i], USART_TIMEOUT_DEFAULT));
+        HAL_HOST_CHECK(received[i] == message[i]);
+    }
+    HAL_HOST_CHECK(HAL_Host_USART_GetTransmitted(UART_0) == strlen(message));
+    HAL_HOST_CHECK(!HAL_USART_ReceiveOverwrite_ReadFlag(&husart));
+
+    /* Строка на линию TX */
+    USART_Setup(&husart, UART_1, Enable, Disable);
+    HAL_HOST_CHECK(HAL_USART_Init(&husart) == HAL_OK);
+    HAL_Host_USART_SetLine(UART_1, USART_Line);
+    HAL_HOST_CHECK(HAL_USART_Print(&husart, message, USART_TIMEOUT_DEFAULT));
+    HAL_HOST_CHECK((LineCount == strlen(message)) && (memcmp(Line, message, LineCount) == 0));
+    HAL_HOST_CHECK(!HAL_USART_RXNE_ReadFlag(&husart));
+
+    /* Прием с линии RX: второй непрочитанный байт теряется с флагом ORE */
+    HAL_Host_USART_Receive(UART_1, 'a');
+    HAL_Host_USART_Receive(UART_1, 'b');
+    HAL_HOST_CHECK(HAL_USART_ReceiveOverwrite_ReadFlag(&husart));
+    HAL_USART_ReceiveOverwrite_ClearFlag(&husart);
+    HAL_HOST_CHECK(!HAL_USART_ReceiveOverwrite_ReadFlag(&husart));
+    HAL_HOST_CHECK(HAL_USART_RXNE_ReadFlag(&husart));
+    HAL_HOST_CHECK(HAL_USART_Read(&husart, received, 1, USART_TEST_TIMEOUT));
+    HAL_HOST_CHECK(received[0] == 'a');
+
+    /* Тайм-аут приема: данных нет */
+    HAL_HOST_CHECK(!HAL_USART_Receive(&husart, &data, USART_TEST_TIMEOUT));
+
+    /* Тайм-аут передачи: передатчик выключен, TC не устанавливается */
+    USART_Setup(&husart, UART_1, Disable, Disable);
+    HAL_HOST_CHECK(HAL_USART_Init(&husart) == HAL_OK);
+    LineCount = 0;
+    HAL_HOST_CHECK(!HAL_USART_Transmit(&husart, 'x', USART_TEST_TIMEOUT));
+    HAL_HOST_CHECK(LineCount == 0);
+
+    /* Скорость выше частоты APB_P / 16 */
+    USART_Setup(&husart, UART_0, Enable, Disable);
+    husart.baudrate = HSI_VALUE / 8;
+    HAL_HOST_CHECK(HAL_USART_Init(&husart) == HAL_ERROR);
+
+    printf("transmitted: %u, register accesses: %u, failures: %u\n",
+           HAL_Host_USART_GetTransmitted(UART_0) + HAL_Host_USART_GetTransmitted(UART_1), HAL_Host_GetAccessCount(), HAL_Host_Failures);
+
+    return HAL_Host_Failures != 0;
+}